@@ -0,0 +1,256 @@
+/* address_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "address_avx.h"
+#include "sha256_avx.h"
+#include <string.h>
+#include <stdbool.h>
+#include <stdalign.h>
+
+#define BASE58_PAYLOAD_LEN 21   // version byte + HASH160
+#define BASE58_DECODED_LEN 25   // payload + 4-byte checksum
+#define BASE58_MAX_DECODED_LEN 84 // longest supported decoding (BIP32 extended keys are 82)
+#define BASE58_MAX_LIMBS 21
+#define BECH32_MAX_LEN 90
+
+static const int8_t base58_map[128] = {
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1, 0, 1, 2, 3, 4, 5, 6, 7, 8,-1,-1,-1,-1,-1,-1,
+    -1, 9,10,11,12,13,14,15,16,-1,17,18,19,20,21,-1,
+    22,23,24,25,26,27,28,29,30,31,32,-1,-1,-1,-1,-1,
+    -1,33,34,35,36,37,38,39,40,41,42,43,-1,44,45,46,
+    47,48,49,50,51,52,53,54,55,56,57,-1,-1,-1,-1,-1
+};
+
+static const int8_t bech32_map[128] = {
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    15,-1,10,17,21,20,26,30, 7, 5,-1,-1,-1,-1,-1,-1,
+    -1,29,-1,24,13,25, 9, 8,23,-1,18,22,31,27,19,-1,
+     1, 0, 3,16,11,28,12,14, 6, 4, 2,-1,-1,-1,-1,-1,
+    -1,29,-1,24,13,25, 9, 8,23,-1,18,22,31,27,19,-1,
+     1, 0, 3,16,11,28,12,14, 6, 4, 2,-1,-1,-1,-1,-1
+};
+
+#define BECH32_CONST  0x00000001u
+#define BECH32M_CONST 0x2bc830a3u
+
+// Decodes a Base58 string that must expand to exactly out_len bytes (at most BASE58_MAX_DECODED_LEN).
+// Characters are consumed 5 at a time (58^5 < 2^32) so every limb update is a single 64-bit multiply-add.
+static bool base58_decode(const char* str, size_t len, uint8_t* out, size_t out_len) {
+    if (len == 0 || out_len > BASE58_MAX_DECODED_LEN || len > out_len * 138 / 100 + 1) return false;
+    const size_t limb_count = (out_len + 3) / 4;
+
+    size_t zeros = 0;
+    while (zeros < len && str[zeros] == '1') zeros++;
+
+    uint32_t limbs[BASE58_MAX_LIMBS] = {0}; // little-endian limbs
+    size_t i = zeros;
+    while (i < len) {
+        uint32_t mul = 1, add = 0;
+        for (int k = 0; k < 5 && i < len; k++, i++) {
+            unsigned char ch = (unsigned char)str[i];
+            if (ch >= 128 || base58_map[ch] < 0) return false;
+            mul *= 58;
+            add = add * 58 + (uint32_t)base58_map[ch];
+        }
+        uint64_t carry = add;
+        for (size_t l = 0; l < limb_count; l++) {
+            uint64_t t = (uint64_t)limbs[l] * mul + carry;
+            limbs[l] = (uint32_t)t;
+            carry = t >> 32;
+        }
+        if (carry) return false;
+    }
+
+    uint8_t be[BASE58_MAX_LIMBS * 4];
+    for (size_t l = 0; l < limb_count; l++) {
+        uint32_t v = limbs[limb_count - 1 - l];
+        be[l * 4 + 0] = (uint8_t)(v >> 24);
+        be[l * 4 + 1] = (uint8_t)(v >> 16);
+        be[l * 4 + 2] = (uint8_t)(v >> 8);
+        be[l * 4 + 3] = (uint8_t)v;
+    }
+    size_t skip = 0;
+    while (skip < limb_count * 4 && be[skip] == 0) skip++;
+    size_t value_len = limb_count * 4 - skip;
+    if (zeros + value_len != out_len) return false;
+
+    memset(out, 0, zeros);
+    memcpy(out + zeros, be + skip, value_len);
+    return true;
+}
+
+static uint32_t bech32_polymod_step(uint32_t pre) {
+    uint8_t b = (uint8_t)(pre >> 25);
+    return ((pre & 0x1FFFFFF) << 5) ^
+        (-((b >> 0) & 1) & 0x3b6a57b2UL) ^
+        (-((b >> 1) & 1) & 0x26508e6dUL) ^
+        (-((b >> 2) & 1) & 0x1ea119faUL) ^
+        (-((b >> 3) & 1) & 0x3d4233ddUL) ^
+        (-((b >> 4) & 1) & 0x2a1462b3UL);
+}
+
+// BIP173 / BIP350 segwit address decoding.
+static bool segwit_decode(const char* str, size_t len, const char* expected_hrp, AddressDecoded* out) {
+    if (len < 8 || len > BECH32_MAX_LEN) return false;
+
+    bool has_lower = false, has_upper = false;
+    size_t sep = 0;
+    for (size_t i = 0; i < len; i++) {
+        unsigned char ch = (unsigned char)str[i];
+        if (ch < 33 || ch > 126) return false;
+        if (ch >= 'a' && ch <= 'z') has_lower = true;
+        if (ch >= 'A' && ch <= 'Z') has_upper = true;
+        if (ch == '1') sep = i;
+    }
+    if (has_lower && has_upper) return false;
+    if (sep == 0 || len - sep - 1 < 7) return false; // version + 6 checksum characters
+
+    char hrp[BECH32_MAX_LEN];
+    for (size_t i = 0; i < sep; i++) hrp[i] = (str[i] >= 'A' && str[i] <= 'Z') ? (char)(str[i] - 'A' + 'a') : str[i];
+    if (expected_hrp && (strlen(expected_hrp) != sep || memcmp(hrp, expected_hrp, sep) != 0)) return false;
+
+    uint32_t chk = 1;
+    for (size_t i = 0; i < sep; i++) chk = bech32_polymod_step(chk) ^ ((unsigned char)hrp[i] >> 5);
+    chk = bech32_polymod_step(chk);
+    for (size_t i = 0; i < sep; i++) chk = bech32_polymod_step(chk) ^ ((unsigned char)hrp[i] & 0x1f);
+
+    uint8_t data[BECH32_MAX_LEN];
+    size_t data_len = len - sep - 1;
+    for (size_t i = 0; i < data_len; i++) {
+        unsigned char ch = (unsigned char)str[sep + 1 + i];
+        int8_t v = bech32_map[ch];
+        if (v < 0) return false;
+        data[i] = (uint8_t)v;
+        chk = bech32_polymod_step(chk) ^ (uint32_t)v;
+    }
+
+    uint8_t witness_version = data[0];
+    if (witness_version > 16) return false;
+    if (chk != (witness_version == 0 ? BECH32_CONST : BECH32M_CONST)) return false;
+
+    // Regroup 5-bit values (minus version and checksum) into bytes, without padding.
+    uint32_t acc = 0;
+    int bits = 0;
+    size_t program_len = 0;
+    for (size_t i = 1; i < data_len - 6; i++) {
+        acc = (acc << 5) | data[i];
+        bits += 5;
+        if (bits >= 8) {
+            bits -= 8;
+            if (program_len == ADDRESS_MAX_PROGRAM) return false;
+            out->program[program_len++] = (uint8_t)(acc >> bits);
+        }
+    }
+    if (bits >= 5 || ((acc << (8 - bits)) & 0xff)) return false;
+    if (program_len < 2) return false;
+    if (witness_version == 0 && program_len != 20 && program_len != 32) return false;
+
+    out->kind = ADDRESS_KIND_SEGWIT;
+    out->version = witness_version;
+    out->program_len = (uint8_t)program_len;
+    return true;
+}
+
+uint8_t address_decode_validate_8(const char* const addresses[8], const size_t lengths[8], const char* expected_hrp, AddressDecoded out[8]) {
+    if (!addresses || !out) return 0;
+
+    uint8_t decoded[8][BASE58_DECODED_LEN];
+    const uint8_t* payloads[8] = {NULL};
+    uint8_t base58_lanes = 0;
+    uint8_t valid = 0;
+
+    // 1. Scalar parse of every lane; segwit lanes are fully validated here.
+    for (int lane = 0; lane < 8; lane++) {
+        memset(&out[lane], 0, sizeof(out[lane]));
+        const char* str = addresses[lane];
+        if (!str) continue;
+        size_t len = lengths ? lengths[lane] : strlen(str);
+
+        if (segwit_decode(str, len, expected_hrp, &out[lane])) {
+            valid |= (uint8_t)(1u << lane);
+        } else {
+            memset(&out[lane], 0, sizeof(out[lane]));
+            if (base58_decode(str, len, decoded[lane], BASE58_DECODED_LEN)) {
+                payloads[lane] = decoded[lane];
+                base58_lanes |= (uint8_t)(1u << lane);
+            }
+        }
+    }
+
+    // 2. Base58Check: checksum = first 4 bytes of SHA256(SHA256(payload)), all lanes at once.
+    if (base58_lanes) {
+        alignas(32) uint8_t first[8][32];
+        alignas(32) uint8_t second[8][32];
+        const uint8_t* first_ptrs[8];
+        sha256_avx8_hash_short(payloads, BASE58_PAYLOAD_LEN, first);
+        for (int lane = 0; lane < 8; lane++) first_ptrs[lane] = first[lane];
+        sha256_avx8_hash_short(first_ptrs, 32, second);
+
+        for (int lane = 0; lane < 8; lane++) {
+            if (!(base58_lanes & (1u << lane))) continue;
+            if (memcmp(second[lane], decoded[lane] + BASE58_PAYLOAD_LEN, 4) != 0) continue;
+            out[lane].kind = ADDRESS_KIND_BASE58;
+            out[lane].version = decoded[lane][0];
+            out[lane].program_len = 20;
+            memcpy(out[lane].program, decoded[lane] + 1, 20);
+            valid |= (uint8_t)(1u << lane);
+        }
+    }
+    return valid;
+}
+
+size_t address_decode_validate_batch(const char* const* addresses, const size_t* lengths, size_t count,
+                                     const char* expected_hrp, AddressDecoded* out, uint8_t* valid_masks) {
+    if (!addresses || !out) return 0;
+    size_t valid_count = 0;
+
+    for (size_t base = 0; base < count; base += 8) {
+        size_t n = count - base < 8 ? count - base : 8;
+        const char* lane_addrs[8] = {NULL};
+        size_t lane_lens[8] = {0};
+        AddressDecoded lane_out[8];
+
+        for (size_t i = 0; i < n; i++) {
+            lane_addrs[i] = addresses[base + i];
+            lane_lens[i] = lengths ? lengths[base + i] : (lane_addrs[i] ? strlen(lane_addrs[i]) : 0);
+        }
+        uint8_t mask = address_decode_validate_8(lane_addrs, lane_lens, expected_hrp, lane_out);
+        memcpy(out + base, lane_out, n * sizeof(AddressDecoded));
+        if (valid_masks) valid_masks[base / 8] = mask;
+        valid_count += (size_t)__builtin_popcount(mask);
+    }
+    return valid_count;
+}
+
+bool base58check_decode(const char* str, size_t len, uint8_t* payload, size_t payload_len) {
+    uint8_t decoded[BASE58_MAX_DECODED_LEN];
+    if (!str || !payload || payload_len + 4 > sizeof(decoded)) return false;
+    if (!base58_decode(str, len, decoded, payload_len + 4)) return false;
+
+    // Single message: the scalar path, rather than eight lanes for one checksum.
+    uint8_t checksum[32];
+    sha256_hash_single(decoded, payload_len, checksum);
+    sha256_hash_single(checksum, 32, checksum);
+    if (memcmp(checksum, decoded + payload_len, 4) != 0) return false;
+    memcpy(payload, decoded, payload_len);
+    return true;
+}
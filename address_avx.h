@@ -0,0 +1,80 @@
+/* address_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef ADDRESS_AVX_H
+#define ADDRESS_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADDRESS_KIND_INVALID 0
+#define ADDRESS_KIND_BASE58  1 // Base58Check, P2PKH / P2SH
+#define ADDRESS_KIND_SEGWIT  2 // Bech32 (v0) / Bech32m (v1+)
+
+#define ADDRESS_MAX_PROGRAM 40
+
+typedef struct {
+    uint8_t kind;        // ADDRESS_KIND_*
+    uint8_t version;     // Base58 version byte, or witness version
+    uint8_t program_len; // 20 for Base58 payloads, 2..40 for witness programs
+    uint8_t program[ADDRESS_MAX_PROGRAM]; // HASH160 or witness program
+} AddressDecoded;
+
+/**
+* @brief Decodes and validates 8 addresses at once.
+* Base58Check checksums (double SHA-256 of the 21-byte payload) are computed on all lanes with the AVX2 SHA-256 kernel.
+* Bech32/Bech32m addresses are checked with the BIP173/BIP350 checksum and witness program rules.
+* @param addresses Eight address strings. A NULL entry is reported as invalid.
+* @param lengths Eight string lengths, or NULL to use strlen().
+* @param expected_hrp Human-readable part that segwit addresses must carry (e.g. "bc"), or NULL to accept any.
+* @param out Eight decoded results. Invalid lanes are zeroed with kind = ADDRESS_KIND_INVALID.
+* @return Validity mask, bit i set when lane i is a valid address.
+*/
+uint8_t address_decode_validate_8(const char* const addresses[8], const size_t lengths[8], const char* expected_hrp, AddressDecoded out[8]);
+
+/**
+* @brief Decodes and validates an arbitrary number of addresses, 8 lanes at a time.
+* @param addresses Address strings.
+* @param lengths String lengths, or NULL to use strlen().
+* @param count Number of addresses.
+* @param expected_hrp See address_decode_validate_8().
+* @param out Decoded results, one per address.
+* @param valid_masks Output of (count + 7) / 8 validity masks, one per batch of 8. May be NULL.
+* @return Number of valid addresses.
+*/
+size_t address_decode_validate_batch(const char* const* addresses, const size_t* lengths, size_t count,
+                                     const char* expected_hrp, AddressDecoded* out, uint8_t* valid_masks);
+
+/**
+* @brief Decodes one Base58Check string with a fixed payload length (e.g. 78 bytes for a BIP32 extended key).
+* @param payload Output buffer of payload_len bytes (version bytes included, checksum stripped).
+* @param payload_len Expected payload length, at most 80.
+* @return true when the string decodes to exactly payload_len + 4 bytes and the checksum matches.
+*/
+bool base58check_decode(const char* str, size_t len, uint8_t* payload, size_t payload_len);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // ADDRESS_AVX_H
@@ -0,0 +1,95 @@
+/* address_test.c
+ * gcc -O3 -mavx2 -march=native address_test.c address_avx.c sha256_avx.c -o address_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "address_avx.h"
+
+typedef struct {
+    const char* address;
+    int kind;            // expected ADDRESS_KIND_*
+    int version;
+    const char* program; // expected program as hex
+} AddressTestCase;
+
+static void to_hex(const uint8_t* data, size_t len, char* out) {
+    for (size_t i = 0; i < len; i++) sprintf(out + i * 2, "%02x", data[i]);
+    out[len * 2] = '\0';
+}
+
+int main() {
+    printf("--- Correctness Test (Batched Address Decode + Checksum Validation) ---\n");
+
+    const AddressTestCase test_cases[8] = {
+        {"1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa", ADDRESS_KIND_BASE58, 0x00, "62e907b15cbf27d5425399ebf6f0fb50ebb88f18"},
+        {"3CNHUhP3uyB9EUtRLsmvFUmvGdjGdkTxJw", ADDRESS_KIND_BASE58, 0x05, "751e76e8199196d454941c45d1b3a323f1433bd6"},
+        {"bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4", ADDRESS_KIND_SEGWIT, 0, "751e76e8199196d454941c45d1b3a323f1433bd6"},
+        {"BC1QQQQSYQCYQ5RQWZQFPG9SCRGWPUGPZYSNZS23V9CCRYDPK8QARC0SZRTJT7", ADDRESS_KIND_SEGWIT, 0, "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"},
+        {"bc1pyqsjygeyy5nzw2pf9g4jctfw9ucrzv3nxs6nvdec8yark0pa8clsg387r2", ADDRESS_KIND_SEGWIT, 1, "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"},
+        {"1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNb", ADDRESS_KIND_INVALID, 0, ""},  // bad Base58 checksum
+        {"tb1qw508d6qejxtdg4y5r3zarvary0c5xw7kxpjzsx", ADDRESS_KIND_INVALID, 0, ""}, // wrong network for hrp "bc"
+        {"bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5", ADDRESS_KIND_INVALID, 0, ""}, // bad Bech32 checksum
+    };
+
+    const char* addrs[8];
+    for (int i = 0; i < 8; i++) addrs[i] = test_cases[i].address;
+
+    AddressDecoded decoded[8];
+    uint8_t mask = address_decode_validate_8(addrs, NULL, "bc", decoded);
+
+    int failed_tests = 0;
+    char hex[ADDRESS_MAX_PROGRAM * 2 + 1];
+    for (int i = 0; i < 8; i++) {
+        const AddressTestCase* tc = &test_cases[i];
+        int is_valid = (mask >> i) & 1;
+        to_hex(decoded[i].program, decoded[i].program_len, hex);
+
+        int ok = (is_valid == (tc->kind != ADDRESS_KIND_INVALID)) && decoded[i].kind == tc->kind;
+        if (ok && is_valid) ok = decoded[i].version == tc->version && strcmp(hex, tc->program) == 0;
+
+        printf("Test Case %d:\n", i);
+        printf("  Input:    \"%s\"\n", tc->address);
+        printf("  Expected: %s %s\n", tc->kind == ADDRESS_KIND_INVALID ? "invalid" : "valid", tc->program);
+        printf("  Result:   %s %s\n", is_valid ? "valid" : "invalid", hex);
+        if (ok) {
+            printf("  Status:   \x1b[32mPASS\x1b[0m\n\n");
+        } else {
+            printf("  Status:   \x1b[31mFAIL\x1b[0m\n\n");
+            failed_tests++;
+        }
+    }
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll 8 tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d out of 8 tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (Batched Validation) ---\n");
+    const size_t NUM_ADDRESSES = 2000000;
+    const char** bulk = (const char**)malloc(NUM_ADDRESSES * sizeof(const char*));
+    AddressDecoded* bulk_out = (AddressDecoded*)malloc(NUM_ADDRESSES * sizeof(AddressDecoded));
+    if (!bulk || !bulk_out) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return 1;
+    }
+    for (size_t i = 0; i < NUM_ADDRESSES; i++) bulk[i] = test_cases[i % 5].address;
+
+    clock_t start = clock();
+    size_t valid_count = address_decode_validate_batch(bulk, NULL, NUM_ADDRESSES, "bc", bulk_out, NULL);
+    clock_t end = clock();
+
+    double total_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("Addresses validated: %zu (%zu valid)\n", NUM_ADDRESSES, valid_count);
+    printf("Total time: %.4f seconds\n", total_time);
+    printf("Performance: %.2f Million Addresses/sec\n", (double)NUM_ADDRESSES / total_time / 1e6);
+
+    free(bulk);
+    free(bulk_out);
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,438 @@
+/* blkfile_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "blkfile_avx.h"
+#include "sha256_avx.h"
+#include "sha256_avx_soa.h"
+
+#include <immintrin.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdalign.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define BLK_BATCH_TXS 4096   // transactions hashed together before the pending blocks are reported
+#define BLK_SORT_BUCKETS 32  // messages of 32 blocks or more share the last bucket
+
+// --- Parsing ---
+
+static bool read_compact_size(const uint8_t* data, size_t avail, size_t* pos, uint64_t* value) {
+    size_t p = *pos;
+    if (p >= avail) return false;
+    uint8_t first = data[p++];
+    size_t extra = first < 0xfd ? 0 : first == 0xfd ? 2 : first == 0xfe ? 4 : 8;
+    if (avail - p < extra) return false;
+    uint64_t v = first < 0xfd ? first : 0;
+    for (size_t i = 0; i < extra; i++) v |= (uint64_t)data[p + i] << (8 * i);
+    *pos = p + extra;
+    *value = v;
+    return true;
+}
+
+// Advances *pos by n bytes if they are available.
+static bool skip_bytes(size_t avail, size_t* pos, uint64_t n) {
+    if (n > avail - *pos) return false;
+    *pos += (size_t)n;
+    return true;
+}
+
+size_t blk_parse_tx(const uint8_t* data, size_t avail, BlkTxRef* tx) {
+    if (!data || !tx || avail < 10) return 0;
+    size_t p = 4;
+    bool segwit = data[4] == 0x00 && data[5] != 0x00; // marker + flag
+    if (segwit) p = 6;
+
+    uint64_t n_in, n_out, n;
+    if (!read_compact_size(data, avail, &p, &n_in) || n_in > avail / 41) return 0;
+    for (uint64_t i = 0; i < n_in; i++) {
+        if (!skip_bytes(avail, &p, 36) || !read_compact_size(data, avail, &p, &n) ||
+            !skip_bytes(avail, &p, n) || !skip_bytes(avail, &p, 4)) return 0;
+    }
+    if (!read_compact_size(data, avail, &p, &n_out) || n_out > avail / 9) return 0;
+    for (uint64_t i = 0; i < n_out; i++) {
+        if (!skip_bytes(avail, &p, 8) || !read_compact_size(data, avail, &p, &n) || !skip_bytes(avail, &p, n)) return 0;
+    }
+    size_t witness_start = p;
+    if (segwit) {
+        for (uint64_t i = 0; i < n_in; i++) {
+            uint64_t items;
+            if (!read_compact_size(data, avail, &p, &items) || items > avail) return 0;
+            for (uint64_t j = 0; j < items; j++) {
+                if (!read_compact_size(data, avail, &p, &n) || !skip_bytes(avail, &p, n)) return 0;
+            }
+        }
+    }
+    if (!skip_bytes(avail, &p, 4) || p > UINT32_MAX) return 0;
+
+    tx->data = data;
+    tx->size = (uint32_t)p;
+    tx->witness_start = (uint32_t)witness_start;
+    tx->segwit = segwit;
+    return p;
+}
+
+// --- Lane scheduler ---
+
+// One SHA-256 message: up to three discontiguous pieces of a serialization.
+typedef struct {
+    const uint8_t* piece[3];
+    uint32_t piece_len[3];
+    uint32_t pieces;
+    uint32_t len;
+    uint32_t nblocks;
+    uint8_t* out;
+} HashJob;
+
+typedef struct {
+    const HashJob* job;
+    size_t block;      // next block index
+    uint32_t piece;    // piece containing the current offset
+    size_t piece_base; // message offset of that piece
+} LaneCursor;
+
+// Copies message bytes [offset, offset + n) into dst, walking the pieces from the lane's cursor.
+static void copy_message_bytes(LaneCursor* c, size_t offset, size_t n, uint8_t* dst) {
+    const HashJob* job = c->job;
+    while (n) {
+        while (offset >= c->piece_base + job->piece_len[c->piece]) c->piece_base += job->piece_len[c->piece++];
+        size_t in_piece = offset - c->piece_base;
+        size_t take = job->piece_len[c->piece] - in_piece;
+        if (take > n) take = n;
+        memcpy(dst, job->piece[c->piece] + in_piece, take);
+        dst += take;
+        offset += take;
+        n -= take;
+    }
+}
+
+// Returns a pointer to the lane's next 64-byte block: straight into the source when the block lies
+// inside one piece, otherwise assembled (with padding) in `staging`.
+static const uint8_t* lane_block(LaneCursor* c, uint8_t staging[64]) {
+    const HashJob* job = c->job;
+    size_t offset = c->block * 64;
+    if (offset + 64 <= job->len) {
+        while (offset >= c->piece_base + job->piece_len[c->piece]) c->piece_base += job->piece_len[c->piece++];
+        size_t in_piece = offset - c->piece_base;
+        if (in_piece + 64 <= job->piece_len[c->piece]) return job->piece[c->piece] + in_piece;
+        copy_message_bytes(c, offset, 64, staging);
+        return staging;
+    }
+    memset(staging, 0, 64);
+    size_t remaining = offset < job->len ? job->len - offset : 0;
+    if (remaining) copy_message_bytes(c, offset, remaining, staging);
+    if (offset <= job->len) staging[remaining] = 0x80;
+    if (c->block == job->nblocks - 1) {
+        uint64_t bit_length = __builtin_bswap64((uint64_t)job->len * 8);
+        memcpy(staging + 56, &bit_length, 8);
+    }
+    return staging;
+}
+
+// First SHA-256 of every job. Lanes are refilled as soon as their message completes.
+static void hash_jobs(const HashJob* jobs, const uint32_t* order, size_t count) {
+    alignas(64) static const uint8_t idle_block[64];
+    alignas(64) uint8_t staging[8][64];
+    alignas(32) uint8_t digests[8][32];
+    alignas(32) __m256i state[8], iv[8], w[16];
+    LaneCursor lanes[8];
+    size_t next = 0;
+    int active = 0;
+
+    sha256_avx8_soa_init(iv);
+    memcpy(state, iv, sizeof(state));
+    for (int lane = 0; lane < 8; lane++) {
+        lanes[lane].job = next < count ? &jobs[order[next++]] : NULL;
+        lanes[lane].block = lanes[lane].piece = 0;
+        lanes[lane].piece_base = 0;
+        if (lanes[lane].job) active++;
+    }
+
+    while (active) {
+        const uint8_t* ptrs[8];
+        uint32_t finishing = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            LaneCursor* c = &lanes[lane];
+            if (!c->job) {
+                ptrs[lane] = idle_block;
+                continue;
+            }
+            ptrs[lane] = lane_block(c, staging[lane]);
+            if (++c->block == c->job->nblocks) finishing |= 1u << lane;
+        }
+        sha256_avx8_soa_load(w, ptrs);
+        sha256_avx8_soa_transform(state, w);
+        if (!finishing) continue;
+
+        sha256_avx8_soa_store(state, digests);
+        int32_t reset[8];
+        for (int lane = 0; lane < 8; lane++) {
+            reset[lane] = (finishing >> lane) & 1 ? -1 : 0;
+            if (!reset[lane]) continue;
+            LaneCursor* c = &lanes[lane];
+            memcpy(c->job->out, digests[lane], 32);
+            c->job = next < count ? &jobs[order[next++]] : NULL;
+            c->block = c->piece = 0;
+            c->piece_base = 0;
+            if (!c->job) active--;
+        }
+        __m256i mask = _mm256_loadu_si256((const __m256i*)reset);
+        for (int i = 0; i < 8; i++) state[i] = _mm256_blendv_epi8(state[i], iv[i], mask);
+    }
+}
+
+static void init_job(HashJob* job, uint8_t* out) {
+    job->len = 0;
+    for (uint32_t i = 0; i < job->pieces; i++) job->len += job->piece_len[i];
+    job->nblocks = (job->len + 9 + 63) / 64;
+    job->out = out;
+}
+
+int blk_hash_txs(const BlkTxRef* txs, size_t count, BlkTxHashes* out, BlkFileStats* stats) {
+    if (!txs || !out) return -1;
+    if (count == 0) return 0;
+
+    size_t max_jobs = 2 * count;
+    HashJob* jobs = (HashJob*)malloc(max_jobs * sizeof(HashJob));
+    uint32_t* order = (uint32_t*)malloc(max_jobs * sizeof(uint32_t));
+    uint8_t (*first)[32] = (uint8_t (*)[32])malloc(max_jobs * 32);
+    if (!jobs || !order || !first || max_jobs > UINT32_MAX) {
+        free(jobs);
+        free(order);
+        free(first);
+        return -1;
+    }
+
+    // Job 2i is the txid preimage of transaction i, job 2i+1 its wtxid preimage (segwit only).
+    size_t njobs = 0;
+    uint64_t total_blocks = 0;
+    size_t bucket_count[BLK_SORT_BUCKETS] = {0};
+    for (size_t i = 0; i < count; i++) {
+        const BlkTxRef* tx = &txs[i];
+        HashJob* job = &jobs[njobs++];
+        if (tx->segwit) {
+            job->piece[0] = tx->data;                     // version
+            job->piece_len[0] = 4;
+            job->piece[1] = tx->data + 6;                 // inputs and outputs
+            job->piece_len[1] = tx->witness_start - 6;
+            job->piece[2] = tx->data + tx->size - 4;      // lock time
+            job->piece_len[2] = 4;
+            job->pieces = 3;
+            init_job(job, first[njobs - 1]);
+
+            job = &jobs[njobs++];
+            job->piece[0] = tx->data;
+            job->piece_len[0] = tx->size;
+            job->pieces = 1;
+            init_job(job, first[njobs - 1]);
+        } else {
+            job->piece[0] = tx->data;
+            job->piece_len[0] = tx->size;
+            job->pieces = 1;
+            init_job(job, first[njobs - 1]);
+        }
+    }
+
+    // Counting sort by padded block count, longest first, so the short messages fill in the tail.
+    for (size_t j = 0; j < njobs; j++) {
+        size_t b = jobs[j].nblocks < BLK_SORT_BUCKETS ? jobs[j].nblocks : BLK_SORT_BUCKETS - 1;
+        bucket_count[b]++;
+        total_blocks += jobs[j].nblocks;
+    }
+    size_t bucket_start[BLK_SORT_BUCKETS], pos = 0;
+    for (int b = BLK_SORT_BUCKETS - 1; b >= 0; b--) {
+        bucket_start[b] = pos;
+        pos += bucket_count[b];
+    }
+    for (size_t j = 0; j < njobs; j++) {
+        size_t b = jobs[j].nblocks < BLK_SORT_BUCKETS ? jobs[j].nblocks : BLK_SORT_BUCKETS - 1;
+        order[bucket_start[b]++] = (uint32_t)j;
+    }
+
+    hash_jobs(jobs, order, njobs);
+
+    // Second SHA-256 over the 32-byte first digests, 8 at a time, written back in place.
+    for (size_t base = 0; base < njobs; base += 8) {
+        const uint8_t* ptrs[8];
+        alignas(32) uint8_t second[8][32];
+        size_t n = njobs - base < 8 ? njobs - base : 8;
+        for (size_t lane = 0; lane < 8; lane++) ptrs[lane] = first[base + (lane < n ? lane : 0)];
+        sha256_avx8_hash_short(ptrs, 32, second);
+        memcpy(first[base], second, n * 32);
+    }
+
+    size_t j = 0;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(out[i].txid, first[j++], 32);
+        memcpy(out[i].wtxid, txs[i].segwit ? first[j++] : out[i].txid, 32);
+    }
+    if (stats) stats->sha256_blocks += total_blocks;
+
+    free(jobs);
+    free(order);
+    free(first);
+    return 0;
+}
+
+// --- Block file scanning ---
+
+typedef struct {
+    uint64_t file_offset;
+    const uint8_t* header;
+    size_t tx_start;
+    size_t tx_count;
+} PendingBlock;
+
+typedef struct {
+    BlkTxRef* txs;
+    size_t tx_count, tx_cap;
+    PendingBlock* blocks;
+    size_t block_count, block_cap;
+    BlkTxHashes* hashes;
+    size_t hash_cap;
+} ScanBatch;
+
+static bool grow(void** array, size_t* cap, size_t need, size_t elem) {
+    if (need <= *cap) return true;
+    size_t new_cap = *cap ? *cap : 64;
+    while (new_cap < need) new_cap *= 2;
+    void* p = realloc(*array, new_cap * elem);
+    if (!p) return false;
+    *array = p;
+    *cap = new_cap;
+    return true;
+}
+
+// Hashes everything pending, reports the blocks in order and empties the batch.
+static int flush_batch(ScanBatch* batch, BlkBlockCallback callback, void* user, BlkFileStats* stats) {
+    if (batch->block_count == 0) return 0;
+    if (!grow((void**)&batch->hashes, &batch->hash_cap, batch->tx_count, sizeof(BlkTxHashes))) return -1;
+    if (blk_hash_txs(batch->txs, batch->tx_count, batch->hashes, stats) != 0) return -1;
+
+    for (size_t base = 0; base < batch->block_count; base += 8) {
+        size_t n = batch->block_count - base < 8 ? batch->block_count - base : 8;
+        const uint8_t* headers[8];
+        size_t lengths[8] = {80, 80, 80, 80, 80, 80, 80, 80};
+        alignas(32) uint8_t once[8][32], block_hashes[8][32];
+        const uint8_t* once_ptrs[8];
+        for (size_t lane = 0; lane < 8; lane++) {
+            headers[lane] = batch->blocks[base + (lane < n ? lane : 0)].header;
+            once_ptrs[lane] = once[lane];
+        }
+        sha256_avx8_hash_lanes(NULL, 0, headers, lengths, once);
+        sha256_avx8_hash_short(once_ptrs, 32, block_hashes);
+
+        for (size_t lane = 0; lane < n; lane++) {
+            const PendingBlock* pb = &batch->blocks[base + lane];
+            BlkBlockInfo info;
+            info.file_offset = pb->file_offset;
+            info.header = pb->header;
+            memcpy(info.block_hash, block_hashes[lane], 32);
+            info.tx_count = pb->tx_count;
+            info.txs = batch->txs + pb->tx_start;
+            info.hashes = batch->hashes + pb->tx_start;
+            if (callback) callback(user, &info);
+        }
+    }
+    batch->tx_count = 0;
+    batch->block_count = 0;
+    return 0;
+}
+
+static int scan_records(ScanBatch* batch, const uint8_t* data, size_t size, uint32_t magic,
+                        BlkBlockCallback callback, void* user, BlkFileStats* stats) {
+    size_t pos = 0;
+    while (size - pos >= 8) {
+        uint32_t record_magic, record_size;
+        memcpy(&record_magic, data + pos, 4);
+        memcpy(&record_size, data + pos + 4, 4);
+        if (record_magic == 0) break; // preallocated, never written
+        if (record_magic != magic || record_size < 81 || record_size > size - pos - 8) return -1;
+
+        const uint8_t* block = data + pos + 8;
+        size_t p = 80;
+        uint64_t ntx;
+        if (!read_compact_size(block, record_size, &p, &ntx) || ntx > record_size / 10) return -1;
+        if (!grow((void**)&batch->txs, &batch->tx_cap, batch->tx_count + ntx, sizeof(BlkTxRef)) ||
+            !grow((void**)&batch->blocks, &batch->block_cap, batch->block_count + 1, sizeof(PendingBlock))) return -1;
+
+        PendingBlock* pb = &batch->blocks[batch->block_count++];
+        pb->file_offset = pos + 8;
+        pb->header = block;
+        pb->tx_start = batch->tx_count;
+        pb->tx_count = (size_t)ntx;
+        for (uint64_t i = 0; i < ntx; i++) {
+            BlkTxRef* tx = &batch->txs[batch->tx_count++];
+            size_t used = blk_parse_tx(block + p, record_size - p, tx);
+            if (!used) return -1;
+            p += used;
+            if (stats && tx->segwit) stats->segwit_transactions++;
+        }
+        if (p != record_size) return -1;
+        if (stats) {
+            stats->blocks++;
+            stats->transactions += ntx;
+            stats->bytes += record_size;
+        }
+
+        pos += 8 + (size_t)record_size;
+        if (batch->tx_count >= BLK_BATCH_TXS && flush_batch(batch, callback, user, stats) != 0) return -1;
+    }
+    // Anything after the last record must be zero padding.
+    for (size_t i = pos; i < size; i++) {
+        if (data[i]) return -1;
+    }
+    return flush_batch(batch, callback, user, stats);
+}
+
+int blkfile_scan(const uint8_t* data, size_t size, uint32_t magic,
+                 BlkBlockCallback callback, void* user, BlkFileStats* stats) {
+    if (!data && size) return -1;
+    ScanBatch batch;
+    memset(&batch, 0, sizeof(batch));
+    int rc = scan_records(&batch, data, size, magic, callback, user, stats);
+    free(batch.txs);
+    free(batch.blocks);
+    free(batch.hashes);
+    return rc;
+}
+
+int blkfile_scan_path(const char* path, uint32_t magic,
+                      BlkBlockCallback callback, void* user, BlkFileStats* stats) {
+    if (!path) return -1;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    int rc = blkfile_scan((const uint8_t*)map, (size_t)st.st_size, magic, callback, user, stats);
+    munmap(map, (size_t)st.st_size);
+    return rc;
+}
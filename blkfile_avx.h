@@ -0,0 +1,112 @@
+/* blkfile_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef BLKFILE_AVX_H
+#define BLKFILE_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bitcoin Core block files (blk*.dat): records of [4-byte network magic][4-byte LE size][serialized block].
+// Transactions are parsed in place (zero-copy) and their txids/wtxids are computed with the 8-lane SHA-256.
+// All hashes are in internal byte order (reverse of the hex shown by explorers).
+
+#define BLK_MAGIC_MAINNET  0xD9B4BEF9u
+#define BLK_MAGIC_TESTNET3 0x0709110Bu
+#define BLK_MAGIC_SIGNET   0x40CF030Au
+#define BLK_MAGIC_REGTEST  0xDAB5BFFAu
+
+// A parsed transaction: the serialization at `data`, and where the stripped (txid) serialization
+// skips the segwit marker/flag and the witness data.
+typedef struct {
+    const uint8_t* data;
+    uint32_t size;          // full serialization length (the wtxid preimage)
+    uint32_t witness_start; // offset where the witness data begins (segwit only)
+    bool segwit;
+} BlkTxRef;
+
+typedef struct {
+    uint8_t txid[32];
+    uint8_t wtxid[32]; // equal to txid for transactions without witness data
+} BlkTxHashes;
+
+typedef struct {
+    uint64_t file_offset;    // offset of the block's 80-byte header in the file
+    const uint8_t* header;   // 80-byte block header (inside the mapping)
+    uint8_t block_hash[32];
+    size_t tx_count;
+    const BlkTxRef* txs;
+    const BlkTxHashes* hashes;
+} BlkBlockInfo;
+
+typedef struct {
+    uint64_t blocks;
+    uint64_t transactions;
+    uint64_t segwit_transactions;
+    uint64_t bytes;
+    uint64_t sha256_blocks; // compressions spent on txids and wtxids (first SHA-256 only)
+} BlkFileStats;
+
+// Called once per block, in file order. The pointers are valid only during the call.
+typedef void (*BlkBlockCallback)(void* user, const BlkBlockInfo* block);
+
+/**
+* @brief Parses one serialized transaction.
+* @return The number of bytes consumed, or 0 if the data is truncated or malformed.
+*/
+size_t blk_parse_tx(const uint8_t* data, size_t avail, BlkTxRef* tx);
+
+/**
+* @brief Computes txids and wtxids of `count` parsed transactions.
+* Messages are sorted by padded block count and streamed through the 8 lanes; a lane that finishes
+* is refilled with the next message immediately. Blocks that lie inside one contiguous piece of the
+* serialization are hashed straight from the source; only boundary and padding blocks are staged.
+* @param stats If not NULL, sha256_blocks is incremented by the number of compressions.
+* @return 0 on success, -1 on allocation failure.
+*/
+int blk_hash_txs(const BlkTxRef* txs, size_t count, BlkTxHashes* out, BlkFileStats* stats);
+
+/**
+* @brief Parses a block file image and reports every block through `callback`.
+* Transactions of consecutive blocks are hashed together in batches so the lanes stay full.
+* Trailing zero bytes (preallocated space) end the scan.
+* @param magic Expected network magic, e.g. BLK_MAGIC_MAINNET.
+* @param stats If not NULL, receives the counters for this image (accumulated, not reset).
+* @return 0 on success, -1 on a bad magic, truncated or malformed record, or allocation failure.
+*/
+int blkfile_scan(const uint8_t* data, size_t size, uint32_t magic,
+                 BlkBlockCallback callback, void* user, BlkFileStats* stats);
+
+/**
+* @brief Memory-maps the file at `path` read-only and runs blkfile_scan() over it.
+* Obfuscated block files (Bitcoin Core -blocksxor) must be de-obfuscated first.
+* @return 0 on success, -1 on an I/O or parse error.
+*/
+int blkfile_scan_path(const char* path, uint32_t magic,
+                      BlkBlockCallback callback, void* user, BlkFileStats* stats);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // BLKFILE_AVX_H
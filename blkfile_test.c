@@ -0,0 +1,271 @@
+/* blkfile_test.c
+ * gcc -O3 -mavx2 -march=native blkfile_test.c blkfile_avx.c sha256_avx.c -o blkfile_test -lcrypto
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <openssl/sha.h>
+
+#include "blkfile_avx.h"
+
+// --- Synthetic block file writer ---
+
+typedef struct {
+    uint8_t* data;
+    size_t len, cap;
+} Buffer;
+
+static void put(Buffer* b, const void* p, size_t n) {
+    if (b->len + n > b->cap) {
+        b->cap = (b->len + n) * 2;
+        b->data = (uint8_t*)realloc(b->data, b->cap);
+    }
+    memcpy(b->data + b->len, p, n);
+    b->len += n;
+}
+
+static void put_u32(Buffer* b, uint32_t v) { put(b, &v, 4); }
+
+static void put_compact(Buffer* b, uint64_t v) {
+    uint8_t tmp[9];
+    if (v < 0xfd) { tmp[0] = (uint8_t)v; put(b, tmp, 1); }
+    else if (v <= 0xffff) { tmp[0] = 0xfd; memcpy(tmp + 1, &v, 2); put(b, tmp, 3); }
+    else { tmp[0] = 0xfe; memcpy(tmp + 1, &v, 4); put(b, tmp, 5); }
+}
+
+static void put_random(Buffer* b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        uint8_t c = (uint8_t)rand();
+        put(b, &c, 1);
+    }
+}
+
+static void put_hex(Buffer* b, const char* hex) {
+    for (size_t i = 0; hex[2 * i]; i++) {
+        uint8_t c;
+        sscanf(hex + 2 * i, "%2hhx", &c);
+        put(b, &c, 1);
+    }
+}
+
+// Appends a random transaction and its expected hashes (computed from explicit serializations).
+static void put_random_tx(Buffer* b, int segwit, uint8_t txid[32], uint8_t wtxid[32]) {
+    Buffer stripped = {0}, full = {0}, witness = {0};
+    int n_in = 1 + rand() % 4, n_out = 1 + rand() % 4;
+    put_u32(&stripped, 2);
+    put_compact(&stripped, (uint64_t)n_in);
+    for (int i = 0; i < n_in; i++) {
+        put_random(&stripped, 36);
+        size_t script = (size_t)(rand() % 6 == 0 ? rand() % 600 : rand() % 110);
+        put_compact(&stripped, script);
+        put_random(&stripped, script);
+        put_u32(&stripped, 0xfffffffd);
+        int items = rand() % 4;
+        put_compact(&witness, (uint64_t)items);
+        for (int j = 0; j < items; j++) {
+            size_t item = (size_t)(rand() % 8 == 0 ? rand() % 400 : rand() % 73);
+            put_compact(&witness, item);
+            put_random(&witness, item);
+        }
+    }
+    put_compact(&stripped, (uint64_t)n_out);
+    for (int i = 0; i < n_out; i++) {
+        put_random(&stripped, 8);
+        size_t script = (size_t)(rand() % 40);
+        put_compact(&stripped, script);
+        put_random(&stripped, script);
+    }
+    uint32_t lock_time = (uint32_t)rand();
+
+    put(&full, stripped.data, 4);
+    if (segwit) put(&full, "\x00\x01", 2);
+    put(&full, stripped.data + 4, stripped.len - 4);
+    if (segwit) put(&full, witness.data, witness.len);
+    put_u32(&full, lock_time);
+    put_u32(&stripped, lock_time);
+
+    uint8_t once[32];
+    SHA256(stripped.data, stripped.len, once);
+    SHA256(once, 32, txid);
+    SHA256(full.data, full.len, once);
+    SHA256(once, 32, wtxid);
+    put(b, full.data, full.len);
+    free(stripped.data);
+    free(full.data);
+    free(witness.data);
+}
+
+typedef struct {
+    uint8_t (*txid)[32];
+    uint8_t (*wtxid)[32];
+    uint8_t (*block_hash)[32];
+    size_t* block_tx_count;
+    size_t tx_count, block_count;
+} Expected;
+
+// Appends one framed block record with `ntx` random transactions.
+static void put_random_block(Buffer* file, Expected* exp, size_t ntx) {
+    Buffer block = {0};
+    put_u32(&block, 0x20000000);
+    put_random(&block, 72);
+    put_u32(&block, (uint32_t)rand());
+    put_compact(&block, ntx);
+    for (size_t i = 0; i < ntx; i++) {
+        put_random_tx(&block, rand() % 3 != 0, exp->txid[exp->tx_count], exp->wtxid[exp->tx_count]);
+        exp->tx_count++;
+    }
+    uint8_t once[32];
+    SHA256(block.data, 80, once);
+    SHA256(once, 32, exp->block_hash[exp->block_count]);
+    exp->block_tx_count[exp->block_count++] = ntx;
+    put_u32(file, BLK_MAGIC_REGTEST);
+    put_u32(file, (uint32_t)block.len);
+    put(file, block.data, block.len);
+    free(block.data);
+}
+
+typedef struct {
+    const Expected* exp;
+    size_t next_tx, next_block;
+    int mismatches;
+} CheckState;
+
+static void check_block(void* user, const BlkBlockInfo* block) {
+    CheckState* st = (CheckState*)user;
+    const Expected* exp = st->exp;
+    if (st->next_block >= exp->block_count || block->tx_count != exp->block_tx_count[st->next_block] ||
+        memcmp(block->block_hash, exp->block_hash[st->next_block], 32) != 0) st->mismatches++;
+    st->next_block++;
+    for (size_t i = 0; i < block->tx_count; i++, st->next_tx++) {
+        if (st->next_tx >= exp->tx_count ||
+            memcmp(block->hashes[i].txid, exp->txid[st->next_tx], 32) != 0 ||
+            memcmp(block->hashes[i].wtxid, exp->wtxid[st->next_tx], 32) != 0) st->mismatches++;
+    }
+}
+
+static void from_display_hex(const char* hex, uint8_t out[32]) {
+    for (int i = 0; i < 32; i++) sscanf(hex + 2 * (31 - i), "%2hhx", &out[i]);
+}
+
+static int report(const char* name, int ok) {
+    printf("  %-52s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+int main() {
+    printf("--- Correctness Test (Block File txid/wtxid Extraction) ---\n");
+    int failed_tests = 0;
+    srand(31);
+
+    // The genesis block: its only transaction's txid is also the Merkle root.
+    Buffer genesis = {0};
+    put_u32(&genesis, 1);
+    put_hex(&genesis, "0000000000000000000000000000000000000000000000000000000000000000");
+    put_hex(&genesis, "3ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa4b1e5e4a");
+    put_hex(&genesis, "29ab5f49ffff001d1dac2b7c01");
+    put_hex(&genesis, "01000000010000000000000000000000000000000000000000000000000000000000000000ffffffff4d04ffff001d0104"
+                      "455468652054696d65732030332f4a616e2f32303039204368616e63656c6c6f72206f6e206272696e6b206f66207365"
+                      "636f6e64206261696c6f757420666f722062616e6b73ffffffff0100f2052a01000000434104678afdb0fe5548271967"
+                      "f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef38c4f35504e51ec112de5c384df7ba0b8d578a4c"
+                      "702b6bf11d5fac00000000");
+    Buffer genesis_file = {0};
+    put_u32(&genesis_file, BLK_MAGIC_MAINNET);
+    put_u32(&genesis_file, (uint32_t)genesis.len);
+    put(&genesis_file, genesis.data, genesis.len);
+    put(&genesis_file, "\0\0\0\0\0\0\0\0\0\0\0\0", 12); // preallocated tail
+
+    Expected gexp = {0};
+    uint8_t g_txid[1][32], g_hash[1][32];
+    size_t g_count[1] = {1};
+    from_display_hex("4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b", g_txid[0]);
+    from_display_hex("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f", g_hash[0]);
+    gexp.txid = g_txid;
+    gexp.wtxid = g_txid;
+    gexp.block_hash = g_hash;
+    gexp.block_tx_count = g_count;
+    gexp.tx_count = gexp.block_count = 1;
+    CheckState st = {&gexp, 0, 0, 0};
+    int rc = blkfile_scan(genesis_file.data, genesis_file.len, BLK_MAGIC_MAINNET, check_block, &st, NULL);
+    failed_tests += report("Genesis block txid and block hash", rc == 0 && st.mismatches == 0 && st.next_block == 1);
+
+    // Random blocks written to real files in a temporary directory, then scanned through mmap.
+    const size_t MAX_TXS = 20000, MAX_BLOCKS = 200;
+    Expected exp;
+    exp.txid = (uint8_t (*)[32])malloc(MAX_TXS * 32);
+    exp.wtxid = (uint8_t (*)[32])malloc(MAX_TXS * 32);
+    exp.block_hash = (uint8_t (*)[32])malloc(MAX_BLOCKS * 32);
+    exp.block_tx_count = (size_t*)malloc(MAX_BLOCKS * sizeof(size_t));
+    exp.tx_count = exp.block_count = 0;
+
+    char dir[] = "/tmp/blkfile_testXXXXXX";
+    if (!mkdtemp(dir)) {
+        fprintf(stderr, "mkdtemp failed.\n");
+        return 1;
+    }
+    char paths[2][64];
+    size_t file_tx_start[2], file_block_start[2];
+    for (int f = 0; f < 2; f++) {
+        Buffer file = {0};
+        file_tx_start[f] = exp.tx_count;
+        file_block_start[f] = exp.block_count;
+        for (int b = 0; b < 60; b++) put_random_block(&file, &exp, 1 + (size_t)(rand() % 150));
+        snprintf(paths[f], sizeof(paths[f]), "%s/blk%05d.dat", dir, f);
+        FILE* fp = fopen(paths[f], "wb");
+        fwrite(file.data, 1, file.len, fp);
+        fclose(fp);
+        free(file.data);
+    }
+    for (int f = 0; f < 2; f++) {
+        BlkFileStats stats;
+        memset(&stats, 0, sizeof(stats));
+        CheckState fs = {&exp, file_tx_start[f], file_block_start[f], 0};
+        rc = blkfile_scan_path(paths[f], BLK_MAGIC_REGTEST, check_block, &fs, &stats);
+        char name[64];
+        snprintf(name, sizeof(name), "blk%05d.dat: %llu blocks, %llu txs match", f,
+                 (unsigned long long)stats.blocks, (unsigned long long)stats.transactions);
+        size_t end_tx = f == 0 ? file_tx_start[1] : exp.tx_count;
+        failed_tests += report(name, rc == 0 && fs.mismatches == 0 && fs.next_tx == end_tx);
+    }
+
+    // Wrong network magic and a truncated record are rejected.
+    failed_tests += report("Wrong magic rejected", blkfile_scan_path(paths[0], BLK_MAGIC_MAINNET, NULL, NULL, NULL) != 0);
+    failed_tests += report("Truncated record rejected",
+                           blkfile_scan(genesis_file.data, genesis.len, BLK_MAGIC_MAINNET, NULL, NULL, NULL) != 0);
+    for (int f = 0; f < 2; f++) unlink(paths[f]);
+    rmdir(dir);
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (In-memory block image, txid + wtxid) ---\n");
+    Buffer image = {0};
+    exp.tx_count = exp.block_count = 0;
+    for (int b = 0; b < 100; b++) put_random_block(&image, &exp, 150);
+    const int NUM_ITERATIONS = 50;
+    BlkFileStats stats;
+    memset(&stats, 0, sizeof(stats));
+    clock_t start = clock();
+    for (int i = 0; i < NUM_ITERATIONS; i++) blkfile_scan(image.data, image.len, BLK_MAGIC_REGTEST, NULL, NULL, &stats);
+    clock_t end = clock();
+
+    double total_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("Total transactions: %llu (%.1f MB)\n", (unsigned long long)stats.transactions, stats.bytes / 1e6);
+    printf("Total time: %.4f seconds\n", total_time);
+    printf("Performance: %.2f Million tx/sec, %.1f MB/s\n", stats.transactions / total_time / 1e6, stats.bytes / total_time / 1e6);
+
+    free(image.data);
+    free(genesis.data);
+    free(genesis_file.data);
+    free(exp.txid);
+    free(exp.wtxid);
+    free(exp.block_hash);
+    free(exp.block_tx_count);
+    return failed_tests == 0 ? 0 : 1;
+}
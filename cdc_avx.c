@@ -0,0 +1,366 @@
+/* cdc_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "cdc_avx.h"
+#include "sha256_avx_soa.h"
+
+#include <immintrin.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdalign.h>
+
+struct CdcStream {
+    CdcParams params;
+    uint32_t mask_s, mask_l;
+    CdcChunkCallback callback;
+    void* user;
+    uint8_t* buf;          // CDC_STREAM_BUFFER bytes; buf[0] is always a chunk boundary
+    size_t fill;
+    uint64_t buf_offset;   // stream offset of buf[0]
+    uint64_t* strict;      // candidate bitmaps over buf
+    uint64_t* loose;
+    uint32_t* lengths;
+    uint8_t (*digests)[32];
+    CdcChunk* chunks;
+    size_t max_chunks;
+};
+
+// --- Gear hash ---
+
+static alignas(32) uint32_t gear[256];
+static int gear_ready = 0;
+
+// Deterministic table (splitmix64), so chunk boundaries are stable across runs and builds.
+static void init_gear(void) {
+    if (gear_ready) return;
+    uint64_t x = 0x8891689ull;
+    for (int i = 0; i < 256; i++) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        gear[i] = (uint32_t)((z ^ (z >> 31)) >> 32);
+    }
+    gear_ready = 1;
+}
+
+const uint32_t* cdc_gear_table(void) {
+    init_gear();
+    return gear;
+}
+
+// The top bits of the hash depend on the most bytes, so the masks select those.
+static int resolve_params(const CdcParams* in, CdcParams* out, uint32_t* mask_s, uint32_t* mask_l) {
+    CdcParams p = {CDC_DEFAULT_MIN, CDC_DEFAULT_AVG, CDC_DEFAULT_MAX};
+    if (in) p = *in;
+    if (p.min_size < 64 || p.avg_size <= p.min_size || p.max_size <= p.avg_size || p.max_size > CDC_STREAM_BUFFER ||
+        (p.avg_size & (p.avg_size - 1)) != 0) return -1;
+    int bits = __builtin_ctz(p.avg_size);
+    if (bits < 4 || bits > 28) return -1;
+    *mask_s = ~0u << (32 - (bits + 2));
+    *mask_l = ~0u << (32 - (bits - 2));
+    *out = p;
+    init_gear();
+    return 0;
+}
+
+static inline void set_bit(uint64_t* bitmap, size_t pos) {
+    bitmap[pos >> 6] |= 1ull << (pos & 63);
+}
+
+// Marks every position whose hash matches the loose mask in `loose`, and the strict mask in `strict`.
+// The input is split into 8 segments hashed in parallel; each segment starts with the 32 bytes before
+// it so its hashes equal those of a sequential pass. Hashes of the first 31 bytes of the input only
+// see the bytes from the start and are never used: cut points lie at least min_size bytes in.
+static void scan_candidates(const uint8_t* data, size_t len, uint32_t mask_s, uint32_t mask_l,
+                            uint64_t* strict, uint64_t* loose) {
+    memset(strict, 0, ((len + 63) / 64) * 8);
+    memset(loose, 0, ((len + 63) / 64) * 8);
+    size_t seg = (len / 8) & ~(size_t)3;
+    size_t tail = 0;
+    uint32_t h = 0;
+    if (seg >= 64 && seg <= INT32_MAX / 8) {
+        const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+        const __m256i vmask_s = _mm256_set1_epi32((int)mask_s);
+        const __m256i vmask_l = _mm256_set1_epi32((int)mask_l);
+        const __m256i starts = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((int)seg));
+        __m256i hv = _mm256_setzero_si256();
+
+        // Warm-up over the 32 bytes before each segment; lane 0 has none and restarts from 0.
+        for (int t = -32; t < 0; t += 4) {
+            __m256i idx = _mm256_max_epi32(_mm256_add_epi32(starts, _mm256_set1_epi32(t)), _mm256_setzero_si256());
+            __m256i v = _mm256_i32gather_epi32((const int*)data, idx, 1);
+            for (int k = 0; k < 4; k++) {
+                __m256i g = _mm256_i32gather_epi32((const int*)gear, _mm256_and_si256(_mm256_srli_epi32(v, 8 * k), byte_mask), 4);
+                hv = _mm256_add_epi32(_mm256_slli_epi32(hv, 1), g);
+            }
+        }
+        hv = _mm256_blend_epi32(hv, _mm256_setzero_si256(), 0x01);
+
+        alignas(32) uint32_t lanes_h[8];
+        alignas(32) uint32_t lane_start[8];
+        _mm256_store_si256((__m256i*)lane_start, starts);
+        for (size_t t = 0; t < seg; t += 4) {
+            __m256i v = _mm256_i32gather_epi32((const int*)data, _mm256_add_epi32(starts, _mm256_set1_epi32((int)t)), 1);
+            for (int k = 0; k < 4; k++) {
+                __m256i g = _mm256_i32gather_epi32((const int*)gear, _mm256_and_si256(_mm256_srli_epi32(v, 8 * k), byte_mask), 4);
+                hv = _mm256_add_epi32(_mm256_slli_epi32(hv, 1), g);
+                __m256i hit = _mm256_cmpeq_epi32(_mm256_and_si256(hv, vmask_l), _mm256_setzero_si256());
+                unsigned m = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(hit));
+                if (!m) continue;
+                __m256i hit_s = _mm256_cmpeq_epi32(_mm256_and_si256(hv, vmask_s), _mm256_setzero_si256());
+                unsigned ms = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(hit_s));
+                while (m) {
+                    int lane = __builtin_ctz(m);
+                    m &= m - 1;
+                    size_t pos = lane_start[lane] + t + (size_t)k;
+                    set_bit(loose, pos);
+                    if ((ms >> lane) & 1) set_bit(strict, pos);
+                }
+            }
+        }
+        _mm256_store_si256((__m256i*)lanes_h, hv);
+        h = lanes_h[7];
+        tail = 8 * seg;
+    }
+    for (size_t i = tail; i < len; i++) {
+        h = (h << 1) + gear[data[i]];
+        if (h & mask_l) continue;
+        set_bit(loose, i);
+        if (!(h & mask_s)) set_bit(strict, i);
+    }
+}
+
+// First set bit in [from, to), or SIZE_MAX.
+static size_t find_first(const uint64_t* bitmap, size_t from, size_t to) {
+    if (from >= to) return SIZE_MAX;
+    size_t w = from >> 6;
+    uint64_t bits = bitmap[w] & (~0ull << (from & 63));
+    for (;;) {
+        if (bits) {
+            size_t pos = (w << 6) + (size_t)__builtin_ctzll(bits);
+            return pos < to ? pos : SIZE_MAX;
+        }
+        if (((++w) << 6) >= to) return SIZE_MAX;
+        bits = bitmap[w];
+    }
+}
+
+static size_t select_cuts(const CdcParams* p, const uint64_t* strict, const uint64_t* loose, size_t len, int final,
+                          uint32_t* lengths, size_t max_chunks, size_t* consumed) {
+    size_t c = 0, n = 0;
+    while (n < max_chunks && c < len) {
+        size_t remain = len - c, cut = 0;
+        // Position i ends a chunk of i + 1 - c bytes.
+        size_t normal_end = c + p->avg_size < len ? c + p->avg_size : len;
+        size_t i = find_first(strict, c + p->min_size - 1, normal_end);
+        if (i == SIZE_MAX && normal_end == c + p->avg_size) {
+            size_t max_end = c + p->max_size - 1 < len ? c + p->max_size - 1 : len;
+            i = find_first(loose, normal_end, max_end);
+        }
+        if (i != SIZE_MAX) cut = i + 1 - c;
+        else if (remain >= p->max_size) cut = p->max_size;
+        else if (final) cut = remain;
+        else break; // the next cut may lie in data not seen yet
+        lengths[n++] = (uint32_t)cut;
+        c += cut;
+    }
+    *consumed = c;
+    return n;
+}
+
+size_t cdc_find_chunks(const CdcParams* params, const uint8_t* data, size_t len, int final,
+                       uint32_t* lengths, size_t max_chunks, size_t* consumed) {
+    CdcParams p;
+    uint32_t mask_s, mask_l;
+    *consumed = 0;
+    if (!data || !lengths || resolve_params(params, &p, &mask_s, &mask_l) != 0) return 0;
+    size_t words = (len + 63) / 64;
+    uint64_t* strict = (uint64_t*)malloc((words ? words : 1) * 16);
+    if (!strict) return 0;
+    uint64_t* loose = strict + (words ? words : 1);
+    scan_candidates(data, len, mask_s, mask_l, strict, loose);
+    size_t n = select_cuts(&p, strict, loose, len, final, lengths, max_chunks, consumed);
+    free(strict);
+    return n;
+}
+
+// --- Chunk hashing ---
+
+typedef struct {
+    const uint8_t* data;
+    size_t len;
+    size_t nblocks;
+    size_t block;
+    size_t index;
+} ChunkLane;
+
+// The lane's next block: straight from the chunk, or its padding assembled in `staging`.
+static const uint8_t* chunk_block(const ChunkLane* c, uint8_t staging[64]) {
+    size_t offset = c->block * 64;
+    if (offset + 64 <= c->len) return c->data + offset;
+    memset(staging, 0, 64);
+    size_t remaining = offset < c->len ? c->len - offset : 0;
+    if (remaining) memcpy(staging, c->data + offset, remaining);
+    if (offset <= c->len) staging[remaining] = 0x80;
+    if (c->block == c->nblocks - 1) {
+        uint64_t bit_length = __builtin_bswap64((uint64_t)c->len * 8);
+        memcpy(staging + 56, &bit_length, 8);
+    }
+    return staging;
+}
+
+void cdc_hash_chunks(const uint8_t* data, const uint32_t* lengths, size_t count, uint8_t (*digests)[32]) {
+    alignas(64) static const uint8_t idle_block[64];
+    alignas(64) uint8_t staging[8][64];
+    alignas(32) uint8_t out[8][32];
+    alignas(32) __m256i state[8], iv[8], w[16];
+    ChunkLane lanes[8];
+    size_t next = 0, offset = 0;
+    int active = 0;
+
+    sha256_avx8_soa_init(iv);
+    memcpy(state, iv, sizeof(state));
+    for (int lane = 0; lane < 8; lane++) {
+        ChunkLane* c = &lanes[lane];
+        c->data = NULL;
+        if (next == count) continue;
+        c->data = data + offset;
+        c->len = lengths[next];
+        c->nblocks = (c->len + 9 + 63) / 64;
+        c->block = 0;
+        c->index = next++;
+        offset += c->len;
+        active++;
+    }
+
+    while (active) {
+        const uint8_t* ptrs[8];
+        uint32_t finishing = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            ChunkLane* c = &lanes[lane];
+            if (!c->data) {
+                ptrs[lane] = idle_block;
+                continue;
+            }
+            ptrs[lane] = chunk_block(c, staging[lane]);
+            if (++c->block == c->nblocks) finishing |= 1u << lane;
+        }
+        sha256_avx8_soa_load(w, ptrs);
+        sha256_avx8_soa_transform(state, w);
+        if (!finishing) continue;
+
+        sha256_avx8_soa_store(state, out);
+        int32_t reset[8];
+        for (int lane = 0; lane < 8; lane++) {
+            reset[lane] = (finishing >> lane) & 1 ? -1 : 0;
+            if (!reset[lane]) continue;
+            ChunkLane* c = &lanes[lane];
+            memcpy(digests[c->index], out[lane], 32);
+            if (next == count) {
+                c->data = NULL;
+                active--;
+                continue;
+            }
+            c->data = data + offset;
+            c->len = lengths[next];
+            c->nblocks = (c->len + 9 + 63) / 64;
+            c->block = 0;
+            c->index = next++;
+            offset += c->len;
+        }
+        __m256i mask = _mm256_loadu_si256((const __m256i*)reset);
+        for (int i = 0; i < 8; i++) state[i] = _mm256_blendv_epi8(state[i], iv[i], mask);
+    }
+}
+
+// --- Streaming ---
+
+CdcStream* cdc_stream_create(const CdcParams* params, CdcChunkCallback callback, void* user) {
+    CdcStream* s = (CdcStream*)calloc(1, sizeof(CdcStream));
+    if (!s) return NULL;
+    if (resolve_params(params, &s->params, &s->mask_s, &s->mask_l) != 0) {
+        free(s);
+        return NULL;
+    }
+    s->callback = callback;
+    s->user = user;
+    s->max_chunks = CDC_STREAM_BUFFER / s->params.min_size + 1;
+    s->buf = (uint8_t*)malloc(CDC_STREAM_BUFFER);
+    s->strict = (uint64_t*)malloc(CDC_STREAM_BUFFER / 64 * 8);
+    s->loose = (uint64_t*)malloc(CDC_STREAM_BUFFER / 64 * 8);
+    s->lengths = (uint32_t*)malloc(s->max_chunks * sizeof(uint32_t));
+    s->digests = (uint8_t (*)[32])malloc(s->max_chunks * 32);
+    s->chunks = (CdcChunk*)malloc(s->max_chunks * sizeof(CdcChunk));
+    if (!s->buf || !s->strict || !s->loose || !s->lengths || !s->digests || !s->chunks) {
+        cdc_stream_free(s);
+        return NULL;
+    }
+    return s;
+}
+
+// Chunks and hashes the buffer, reports the chunks and keeps the unfinished tail at the front.
+static void process_buffer(CdcStream* s, int final) {
+    scan_candidates(s->buf, s->fill, s->mask_s, s->mask_l, s->strict, s->loose);
+    size_t consumed;
+    size_t n = select_cuts(&s->params, s->strict, s->loose, s->fill, final, s->lengths, s->max_chunks, &consumed);
+    if (n) {
+        cdc_hash_chunks(s->buf, s->lengths, n, s->digests);
+        uint64_t offset = s->buf_offset;
+        for (size_t i = 0; i < n; i++) {
+            s->chunks[i].offset = offset;
+            s->chunks[i].length = s->lengths[i];
+            memcpy(s->chunks[i].digest, s->digests[i], 32);
+            offset += s->lengths[i];
+        }
+        if (s->callback) s->callback(s->user, s->chunks, n);
+    }
+    memmove(s->buf, s->buf + consumed, s->fill - consumed);
+    s->fill -= consumed;
+    s->buf_offset += consumed;
+}
+
+int cdc_stream_update(CdcStream* s, const uint8_t* data, size_t len) {
+    if (!s || (!data && len)) return -1;
+    while (len) {
+        size_t take = CDC_STREAM_BUFFER - s->fill;
+        if (take > len) take = len;
+        memcpy(s->buf + s->fill, data, take);
+        s->fill += take;
+        data += take;
+        len -= take;
+        // The tail left after a pass is shorter than max_size, so every pass frees most of the buffer.
+        if (s->fill == CDC_STREAM_BUFFER) process_buffer(s, 0);
+    }
+    return 0;
+}
+
+int cdc_stream_finish(CdcStream* s) {
+    if (!s) return -1;
+    if (s->fill) process_buffer(s, 1);
+    return 0;
+}
+
+void cdc_stream_free(CdcStream* s) {
+    if (!s) return;
+    free(s->buf);
+    free(s->strict);
+    free(s->loose);
+    free(s->lengths);
+    free(s->digests);
+    free(s->chunks);
+    free(s);
+}
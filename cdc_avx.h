@@ -0,0 +1,111 @@
+/* cdc_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef CDC_AVX_H
+#define CDC_AVX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Compile-time check to ensure AVX2 is enabled
+#if !defined(__AVX2__)
+#error "This implementation requires AVX2 support. Please compile with -mavx2."
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Content-defined chunking for deduplication, with SHA-256 of every chunk on the 8 AVX2 lanes.
+//
+// The rolling hash is a 32-bit gear hash, h = (h << 1) + gear[byte], so the value at a position only
+// depends on the 32 bytes ending there and chunk boundaries resynchronize after an insertion. It is
+// evaluated with AVX2 over 8 segments of the input at once. Cut points follow FastCDC's normalized
+// chunking: a chunk is at least min_size bytes, must match the stricter mask (log2(avg) + 2 bits)
+// up to avg_size bytes, the looser one (log2(avg) - 2 bits) after that, and is cut at max_size.
+
+#define CDC_DEFAULT_MIN (4u << 10)
+#define CDC_DEFAULT_AVG (16u << 10)
+#define CDC_DEFAULT_MAX (64u << 10)
+#define CDC_STREAM_BUFFER (8u << 20) // bytes buffered by a CdcStream between chunking passes
+
+typedef struct {
+    uint32_t min_size; // at least 64
+    uint32_t avg_size; // a power of two, min_size < avg_size < max_size
+    uint32_t max_size; // at most CDC_STREAM_BUFFER
+} CdcParams;
+
+typedef struct {
+    uint64_t offset; // in the stream
+    uint32_t length;
+    uint8_t digest[32];
+} CdcChunk;
+
+// Called with the chunks of each pass, in stream order. The array is valid only during the call.
+typedef void (*CdcChunkCallback)(void* user, const CdcChunk* chunks, size_t count);
+
+typedef struct CdcStream CdcStream;
+
+/**
+* @brief The 256-entry gear table used by the rolling hash (for reference implementations).
+*/
+const uint32_t* cdc_gear_table(void);
+
+/**
+* @brief Splits data, which starts at a chunk boundary, into chunks.
+* @param params Chunk sizes, or NULL for the defaults.
+* @param final Nonzero if the data ends the stream; the remainder then becomes the last chunk.
+*        Otherwise chunking stops where more data could still move the next cut point.
+* @param lengths Receives up to max_chunks chunk lengths.
+* @param consumed Receives the total length of the returned chunks.
+* @return The number of chunks, or 0 with *consumed = 0 on invalid parameters or allocation failure.
+*/
+size_t cdc_find_chunks(const CdcParams* params, const uint8_t* data, size_t len, int final,
+                       uint32_t* lengths, size_t max_chunks, size_t* consumed);
+
+/**
+* @brief SHA-256 of count consecutive chunks of data. The chunks are streamed through the 8 lanes and
+*        a lane is refilled with the next chunk as soon as its chunk completes. Full blocks are read
+*        straight from data; only the padding blocks are staged.
+*/
+void cdc_hash_chunks(const uint8_t* data, const uint32_t* lengths, size_t count, uint8_t (*digests)[32]);
+
+/**
+* @brief Creates a streaming chunker. Chunks are reported through callback as they are completed.
+* @param params Chunk sizes, or NULL for the defaults.
+* @return The stream, or NULL on invalid parameters or allocation failure.
+*/
+CdcStream* cdc_stream_create(const CdcParams* params, CdcChunkCallback callback, void* user);
+
+/**
+* @brief Appends data to the stream. Returns 0, or -1 on failure.
+*/
+int cdc_stream_update(CdcStream* stream, const uint8_t* data, size_t len);
+
+/**
+* @brief Chunks and reports everything still buffered. Returns 0, or -1 on failure.
+*/
+int cdc_stream_finish(CdcStream* stream);
+
+void cdc_stream_free(CdcStream* stream);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // CDC_AVX_H
@@ -0,0 +1,176 @@
+/*
+* cdc_hash.c
+*
+* Splits files (or stdin) into content-defined chunks and prints one "<offset> <length> <sha256>" line
+* per chunk, for deduplication. The gear rolling hash runs with AVX2 over 8 segments of each buffered
+* window and the chunks are hashed on the 8 SHA-256 lanes, a lane being refilled as its chunk ends.
+*
+* Compilation instructions:
+* gcc -O3 -mavx2 -march=native cdc_hash.c cdc_avx.c sha256_avx.c hex_avx.c -o cdc_hash
+*
+* Usage:
+* ./cdc_hash [-m min] [-a avg] [-x max] [-s] [file ...]     (no file or "-" reads stdin)
+*   -m/-a/-x  chunk sizes in bytes (defaults 4096/16384/65536; avg must be a power of two)
+*   -s        print only a per-file summary (chunks, unique chunks, bytes, throughput)
+* Each file is chunked independently and offsets restart at 0.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+
+#include "cdc_avx.h"
+#include "hex_avx.h"
+
+#define READ_CHUNK (4 << 20)
+
+typedef struct {
+    int summary;
+    char* out;
+    size_t out_cap;
+    unsigned long long chunks, bytes;
+    uint8_t (*seen)[32]; // digests for the unique count (-s)
+    size_t seen_count, seen_cap;
+    int failed;
+} Output;
+
+static int write_all(int fd, const char* data, size_t len) {
+    while (len) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        data += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static void on_chunks(void* user, const CdcChunk* chunks, size_t count) {
+    Output* o = (Output*)user;
+    o->chunks += count;
+    for (size_t i = 0; i < count; i++) o->bytes += chunks[i].length;
+    if (o->summary) {
+        if (o->seen_count + count > o->seen_cap) {
+            size_t cap = (o->seen_count + count) * 2;
+            uint8_t (*seen)[32] = (uint8_t (*)[32])realloc(o->seen, cap * 32);
+            if (!seen) {
+                o->failed = 1;
+                return;
+            }
+            o->seen = seen;
+            o->seen_cap = cap;
+        }
+        for (size_t i = 0; i < count; i++) memcpy(o->seen[o->seen_count++], chunks[i].digest, 32);
+        return;
+    }
+    // "<20-digit offset> <10-digit length> <64 hex>\n" at most
+    size_t need = count * 100;
+    if (need > o->out_cap) {
+        char* out = (char*)realloc(o->out, need);
+        if (!out) {
+            o->failed = 1;
+            return;
+        }
+        o->out = out;
+        o->out_cap = need;
+    }
+    char* p = o->out;
+    for (size_t i = 0; i < count; i++) {
+        p += sprintf(p, "%llu %u ", (unsigned long long)chunks[i].offset, chunks[i].length);
+        hex_encode_avx2(chunks[i].digest, 32, p);
+        p += 64;
+        *p++ = '\n';
+    }
+    if (write_all(STDOUT_FILENO, o->out, (size_t)(p - o->out)) != 0) o->failed = 1;
+}
+
+static int cmp_digest(const void* a, const void* b) {
+    return memcmp(a, b, 32);
+}
+
+static int process_fd(const CdcParams* params, Output* o, int fd, uint8_t* buf) {
+    CdcStream* s = cdc_stream_create(params, on_chunks, o);
+    if (!s) return -1;
+    int rc = 0;
+    for (;;) {
+        ssize_t n = read(fd, buf, READ_CHUNK);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            rc = -1;
+            break;
+        }
+        if (n == 0) break;
+        cdc_stream_update(s, buf, (size_t)n);
+        if (o->failed) break;
+    }
+    if (rc == 0) cdc_stream_finish(s);
+    cdc_stream_free(s);
+    return rc == 0 && !o->failed ? 0 : -1;
+}
+
+int main(int argc, char** argv) {
+    CdcParams params = {CDC_DEFAULT_MIN, CDC_DEFAULT_AVG, CDC_DEFAULT_MAX};
+    Output o;
+    memset(&o, 0, sizeof(o));
+    int argi = 1;
+    for (; argi < argc && argv[argi][0] == '-' && argv[argi][1]; argi++) {
+        if (strcmp(argv[argi], "-s") == 0) o.summary = 1;
+        else if (strcmp(argv[argi], "-m") == 0 && argi + 1 < argc) params.min_size = (uint32_t)strtoul(argv[++argi], NULL, 10);
+        else if (strcmp(argv[argi], "-a") == 0 && argi + 1 < argc) params.avg_size = (uint32_t)strtoul(argv[++argi], NULL, 10);
+        else if (strcmp(argv[argi], "-x") == 0 && argi + 1 < argc) params.max_size = (uint32_t)strtoul(argv[++argi], NULL, 10);
+        else {
+            fprintf(stderr, "Usage: %s [-m min] [-a avg] [-x max] [-s] [file ...]\n", argv[0]);
+            return 1;
+        }
+    }
+    CdcStream* probe = cdc_stream_create(&params, NULL, NULL);
+    if (!probe) {
+        fprintf(stderr, "Error: invalid chunk sizes (need 64 <= min < avg < max <= %u, avg a power of two)\n", CDC_STREAM_BUFFER);
+        return 1;
+    }
+    cdc_stream_free(probe);
+
+    uint8_t* buf = (uint8_t*)malloc(READ_CHUNK);
+    if (!buf) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return 1;
+    }
+    const char* stdin_name[] = {"-"};
+    const char* const* files = argi < argc ? (const char* const*)(argv + argi) : stdin_name;
+    int nfiles = argi < argc ? argc - argi : 1;
+    int rc = 0;
+    for (int f = 0; f < nfiles && rc == 0; f++) {
+        int fd = strcmp(files[f], "-") == 0 ? STDIN_FILENO : open(files[f], O_RDONLY);
+        if (fd < 0) {
+            fprintf(stderr, "Error: cannot open %s\n", files[f]);
+            rc = 1;
+            break;
+        }
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        o.chunks = o.bytes = 0;
+        o.seen_count = 0;
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        if (process_fd(&params, &o, fd, buf) != 0) {
+            fprintf(stderr, "Error: I/O failure on %s\n", files[f]);
+            rc = 1;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (fd != STDIN_FILENO) close(fd);
+        if (rc == 0 && o.summary) {
+            qsort(o.seen, o.seen_count, 32, cmp_digest);
+            size_t unique = o.seen_count ? 1 : 0;
+            for (size_t i = 1; i < o.seen_count; i++) unique += memcmp(o.seen[i - 1], o.seen[i], 32) != 0;
+            double secs = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+            printf("%s: %llu chunks (%zu unique), %llu bytes, %.2f GB/s\n", files[f], o.chunks, unique, o.bytes,
+                   secs > 0 ? (double)o.bytes / secs / 1e9 : 0.0);
+        }
+    }
+    free(buf);
+    free(o.out);
+    free(o.seen);
+    return rc;
+}
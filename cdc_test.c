@@ -0,0 +1,224 @@
+/* cdc_test.c
+ * gcc -O3 -mavx2 -march=native cdc_test.c cdc_avx.c sha256_avx.c -o cdc_test -lcrypto
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <openssl/sha.h>
+
+#include "cdc_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+// Sequential reference: one gear hash over the whole input, the same cut rules.
+static size_t ref_chunks(const CdcParams* p, const uint8_t* data, size_t len, uint32_t* lengths) {
+    const uint32_t* gear = cdc_gear_table();
+    int bits = __builtin_ctz(p->avg_size);
+    uint32_t mask_s = ~0u << (32 - (bits + 2)), mask_l = ~0u << (32 - (bits - 2));
+    uint32_t h = 0;
+    size_t c = 0, n = 0;
+    for (size_t i = 0; i < len; i++) {
+        h = (h << 1) + gear[data[i]];
+        size_t chunk = i + 1 - c;
+        int cut = 0;
+        if (chunk < p->min_size) cut = 0;
+        else if (chunk <= p->avg_size) cut = !(h & mask_s);
+        else if (chunk < p->max_size) cut = !(h & mask_l);
+        else cut = 1;
+        if (cut) {
+            lengths[n++] = (uint32_t)chunk;
+            c = i + 1;
+        }
+    }
+    if (c < len) lengths[n++] = (uint32_t)(len - c);
+    return n;
+}
+
+typedef struct {
+    CdcChunk* chunks;
+    size_t count, cap;
+} Collector;
+
+static void collect(void* user, const CdcChunk* chunks, size_t count) {
+    Collector* col = (Collector*)user;
+    if (col->count + count > col->cap) {
+        col->cap = (col->count + count) * 2;
+        col->chunks = (CdcChunk*)realloc(col->chunks, col->cap * sizeof(CdcChunk));
+    }
+    memcpy(col->chunks + col->count, chunks, count * sizeof(CdcChunk));
+    col->count += count;
+}
+
+// Streams data in pieces of random size; returns the collected chunks.
+static Collector stream_chunks(const CdcParams* p, const uint8_t* data, size_t len, size_t max_piece) {
+    Collector col = {NULL, 0, 0};
+    CdcStream* s = cdc_stream_create(p, collect, &col);
+    size_t pos = 0;
+    while (pos < len) {
+        size_t piece = 1 + (size_t)rand() % max_piece;
+        if (piece > len - pos) piece = len - pos;
+        cdc_stream_update(s, data + pos, piece);
+        pos += piece;
+    }
+    cdc_stream_finish(s);
+    cdc_stream_free(s);
+    return col;
+}
+
+static int same_as_reference(const CdcParams* p, const uint8_t* data, size_t len, size_t max_piece) {
+    uint32_t* ref = (uint32_t*)malloc((len / 64 + 2) * sizeof(uint32_t));
+    size_t n = ref_chunks(p, data, len, ref);
+    Collector col = stream_chunks(p, data, len, max_piece);
+    int ok = col.count == n;
+    uint64_t offset = 0;
+    for (size_t i = 0; ok && i < n; i++) {
+        uint8_t digest[32];
+        SHA256(data + offset, ref[i], digest);
+        if (col.chunks[i].offset != offset || col.chunks[i].length != ref[i] || memcmp(col.chunks[i].digest, digest, 32) != 0) ok = 0;
+        offset += ref[i];
+    }
+    free(ref);
+    free(col.chunks);
+    return ok;
+}
+
+int main() {
+    printf("--- Correctness Test (Content-Defined Chunking + 8-lane SHA-256) ---\n");
+    int failed_tests = 0;
+    srand(1);
+    const size_t LEN = 20u << 20; // spans several stream buffers
+    uint8_t* data = (uint8_t*)malloc(LEN + 100);
+    for (size_t i = 0; i < LEN; i++) data[i] = (uint8_t)rand();
+
+    const CdcParams def = {CDC_DEFAULT_MIN, CDC_DEFAULT_AVG, CDC_DEFAULT_MAX};
+    const CdcParams small = {1024, 4096, 16384};
+
+    // One-shot chunking against the sequential reference.
+    {
+        uint32_t* ref = (uint32_t*)malloc((LEN / 64 + 2) * sizeof(uint32_t));
+        uint32_t* got = (uint32_t*)malloc((LEN / 64 + 2) * sizeof(uint32_t));
+        size_t consumed;
+        size_t n_ref = ref_chunks(&def, data, LEN, ref);
+        size_t n = cdc_find_chunks(NULL, data, LEN, 1, got, LEN / 64 + 2, &consumed);
+        failed_tests += report("cdc_find_chunks matches the sequential reference",
+                               n == n_ref && consumed == LEN && memcmp(got, ref, n * 4) == 0);
+
+        int bounds_ok = 1;
+        for (size_t i = 0; i + 1 < n; i++) {
+            if (got[i] < def.min_size || got[i] > def.max_size) bounds_ok = 0;
+        }
+        double mean = (double)LEN / (double)n;
+        printf("    (%zu chunks, mean %.0f bytes)\n", n, mean);
+        failed_tests += report("Chunk sizes within [min, max], mean near avg", bounds_ok && mean > def.avg_size / 2 && mean < def.avg_size * 2);
+
+        size_t n_partial = cdc_find_chunks(NULL, data, 1u << 20, 0, got, LEN / 64 + 2, &consumed);
+        failed_tests += report("Non-final data: stops at the last certain cut",
+                               n_partial > 0 && memcmp(got, ref, n_partial * 4) == 0 && (1u << 20) - consumed < def.max_size);
+        free(ref);
+        free(got);
+    }
+
+    failed_tests += report("Stream, random pieces up to 1 MiB (default sizes)", same_as_reference(&def, data, LEN, 1 << 20));
+    failed_tests += report("Stream, random pieces up to 100 bytes (1K/4K/16K)", same_as_reference(&small, data, 3u << 20, 100));
+
+    // Low-entropy inputs: zeros never match the masks (forced max cuts), short periods do.
+    {
+        uint8_t* low = (uint8_t*)malloc(9u << 20);
+        memset(low, 0, 9u << 20);
+        int ok = same_as_reference(&def, low, 9u << 20, 1 << 20);
+        for (size_t i = 0; i < (9u << 20); i++) low[i] = (uint8_t)(i % 7 == 0 ? 0xAA : i % 13);
+        ok &= same_as_reference(&small, low, 9u << 20, 1 << 20);
+        failed_tests += report("Zero-filled and periodic inputs", ok);
+        free(low);
+    }
+
+    {
+        int ok = same_as_reference(&def, data, 0, 1) && same_as_reference(&def, data, 100, 7) &&
+                 same_as_reference(&def, data, CDC_DEFAULT_MAX, 4096) && same_as_reference(&def, data, CDC_DEFAULT_MAX + 1, 4096);
+        failed_tests += report("Empty, tiny and max-size-edge streams", ok);
+    }
+
+    // Deduplication: after an insertion the boundaries resynchronize, so most chunks are shared.
+    {
+        const size_t DLEN = 8u << 20;
+        uint8_t* edited = (uint8_t*)malloc(DLEN + 100);
+        memcpy(edited, data, DLEN / 2);
+        for (int i = 0; i < 100; i++) edited[DLEN / 2 + (size_t)i] = (uint8_t)rand();
+        memcpy(edited + DLEN / 2 + 100, data + DLEN / 2, DLEN / 2);
+        Collector a = stream_chunks(&def, data, DLEN, 1 << 20);
+        Collector b = stream_chunks(&def, edited, DLEN + 100, 1 << 20);
+        size_t shared = 0;
+        for (size_t i = 0; i < b.count; i++) {
+            for (size_t j = 0; j < a.count; j++) {
+                if (memcmp(a.chunks[j].digest, b.chunks[i].digest, 32) == 0) {
+                    shared++;
+                    break;
+                }
+            }
+        }
+        printf("    (%zu of %zu chunks unchanged after a 100-byte insertion)\n", shared, b.count);
+        failed_tests += report("Insertion changes at most 3 chunks", b.count - shared <= 3);
+        free(a.chunks);
+        free(b.chunks);
+        free(edited);
+    }
+
+    {
+        const CdcParams bad1 = {4096, 12000, 65536}, bad2 = {16, 64, 128}, bad3 = {4096, 16384, 16384};
+        failed_tests += report("Invalid parameters rejected",
+                               !cdc_stream_create(&bad1, NULL, NULL) && !cdc_stream_create(&bad2, NULL, NULL) &&
+                               !cdc_stream_create(&bad3, NULL, NULL));
+    }
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (20 MiB random data x 5, default sizes) ---\n");
+    const int ROUNDS = 5;
+    uint32_t* lengths = (uint32_t*)malloc((LEN / 64 + 2) * sizeof(uint32_t));
+    size_t n = 0, consumed;
+
+    clock_t start = clock();
+    for (int r = 0; r < ROUNDS; r++) n = cdc_find_chunks(NULL, data, LEN, 1, lengths, LEN / 64 + 2, &consumed);
+    double simd_chunk = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int r = 0; r < ROUNDS; r++) n = ref_chunks(&def, data, LEN, lengths);
+    double scalar_chunk = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        Collector col = stream_chunks(&def, data, LEN, 1 << 20);
+        free(col.chunks);
+    }
+    double pipeline = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    uint8_t digest[32];
+    start = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        size_t off = 0;
+        for (size_t i = 0; i < n; i++) {
+            SHA256(data + off, lengths[i], digest);
+            off += lengths[i];
+        }
+    }
+    double openssl_hash = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    double total = (double)LEN * ROUNDS / 1e9;
+    printf("AVX2 gear chunking:               %.2f GB/s\n", total / simd_chunk);
+    printf("Sequential gear chunking:         %.2f GB/s (%.2fx slower)\n", total / scalar_chunk, scalar_chunk / simd_chunk);
+    printf("Stream (chunking + 8-lane SHA-256): %.2f GB/s\n", total / pipeline);
+    printf("Sequential gear + OpenSSL SHA256 per chunk: %.2f GB/s\n", total / (scalar_chunk + openssl_hash));
+    free(lengths);
+    free(data);
+    return failed_tests == 0 ? 0 : 1;
+}
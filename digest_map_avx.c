@@ -0,0 +1,350 @@
+/* digest_map_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "digest_map_avx.h"
+#include "ripemd160_avx_soa.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdalign.h>
+
+#define CTRL_EMPTY   0x80
+#define CTRL_DELETED 0xFE
+#define MIN_GROUPS   4
+#define ARENA_SHIFT  12 // 4096 values per arena block
+#define ARENA_BLOCK  ((size_t)1 << ARENA_SHIFT)
+#define NO_SLOT      SIZE_MAX
+
+struct DigestMap {
+    uint32_t key_len;
+    uint32_t value_size;
+    uint32_t slot_size;     // key || uint32 value index
+    size_t group_mask;      // groups - 1 (a power of two)
+    uint8_t* ctrl;          // 16 control bytes per group, 16-byte aligned
+    uint8_t* slots;
+    size_t size;            // keys
+    size_t used;            // keys + tombstones
+    size_t growth_limit;    // 7/8 of the slots
+    uint8_t** arena;
+    size_t arena_blocks, arena_cap;
+    uint32_t next_value;    // first value index never handed out
+    uint32_t* free_values;  // recycled value indices
+    size_t free_count, free_cap;
+};
+
+// --- Control groups ---
+
+static inline uint64_t load_u64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint64_t key_hash(const uint8_t* key) { return load_u64(key); }
+
+static inline uint8_t hash_tag(uint64_t h) { return (uint8_t)(h & 0x7f); }
+
+static inline size_t hash_group(const DigestMap* m, uint64_t h) { return (size_t)(h >> 7) & m->group_mask; }
+
+static inline uint32_t match_tag(const uint8_t* ctrl, uint8_t tag) {
+    __m128i g = _mm_load_si128((const __m128i*)ctrl);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)tag)));
+}
+
+static inline uint32_t match_empty(const uint8_t* ctrl) {
+    __m128i g = _mm_load_si128((const __m128i*)ctrl);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)CTRL_EMPTY)));
+}
+
+// Empty or deleted: the control bytes with the top bit set.
+static inline uint32_t match_free(const uint8_t* ctrl) {
+    return (uint32_t)_mm_movemask_epi8(_mm_load_si128((const __m128i*)ctrl));
+}
+
+// Keys are at least 8 bytes: compare 8-byte words, the last one overlapping the previous.
+static inline bool key_equal(const uint8_t* a, const uint8_t* b, size_t len) {
+    size_t i = 0;
+    for (; i + 8 < len; i += 8) {
+        if (load_u64(a + i) != load_u64(b + i)) return false;
+    }
+    return load_u64(a + len - 8) == load_u64(b + len - 8);
+}
+
+static inline uint8_t* slot_at(const DigestMap* m, size_t slot) { return m->slots + slot * m->slot_size; }
+
+static inline uint32_t slot_value_index(const DigestMap* m, size_t slot) {
+    uint32_t idx;
+    memcpy(&idx, slot_at(m, slot) + m->key_len, 4);
+    return idx;
+}
+
+static inline void* value_at(const DigestMap* m, uint32_t idx) {
+    return m->arena[idx >> ARENA_SHIFT] + (size_t)(idx & (ARENA_BLOCK - 1)) * m->value_size;
+}
+
+// Probes from the key's home group (triangular steps over groups, which visit every group of a
+// power-of-two table) until the key or an empty slot is found.
+static size_t find_slot(const DigestMap* m, const uint8_t* key, uint64_t h) {
+    size_t g = hash_group(m, h);
+    uint8_t tag = hash_tag(h);
+    for (size_t step = 1;; step++) {
+        const uint8_t* ctrl = m->ctrl + g * DIGEST_MAP_GROUP;
+        for (uint32_t bits = match_tag(ctrl, tag); bits; bits &= bits - 1) {
+            size_t slot = g * DIGEST_MAP_GROUP + (size_t)__builtin_ctz(bits);
+            if (key_equal(slot_at(m, slot), key, m->key_len)) return slot;
+        }
+        if (match_empty(ctrl)) return NO_SLOT;
+        g = (g + step) & m->group_mask;
+    }
+}
+
+// First free slot on the probe sequence of h (the table always has empty slots).
+static size_t free_slot(const DigestMap* m, uint64_t h) {
+    size_t g = hash_group(m, h);
+    for (size_t step = 1;; step++) {
+        uint32_t bits = match_free(m->ctrl + g * DIGEST_MAP_GROUP);
+        if (bits) return g * DIGEST_MAP_GROUP + (size_t)__builtin_ctz(bits);
+        g = (g + step) & m->group_mask;
+    }
+}
+
+static int alloc_table(DigestMap* m, size_t groups) {
+    size_t nslots = groups * DIGEST_MAP_GROUP;
+    uint8_t* ctrl = (uint8_t*)aligned_alloc(DIGEST_MAP_GROUP, nslots);
+    uint8_t* slots = (uint8_t*)malloc(nslots * m->slot_size);
+    if (!ctrl || !slots) {
+        free(ctrl);
+        free(slots);
+        return -1;
+    }
+    memset(ctrl, CTRL_EMPTY, nslots);
+    m->ctrl = ctrl;
+    m->slots = slots;
+    m->group_mask = groups - 1;
+    m->growth_limit = nslots - nslots / 8;
+    return 0;
+}
+
+// Moves every key into a table of `groups` groups, dropping the tombstones. Values stay where they are.
+static int rehash(DigestMap* m, size_t groups) {
+    uint8_t* old_ctrl = m->ctrl;
+    uint8_t* old_slots = m->slots;
+    size_t old_slots_count = (m->group_mask + 1) * DIGEST_MAP_GROUP;
+    size_t old_mask = m->group_mask, old_limit = m->growth_limit;
+    if (alloc_table(m, groups) != 0) {
+        m->ctrl = old_ctrl;
+        m->slots = old_slots;
+        m->group_mask = old_mask;
+        m->growth_limit = old_limit;
+        return -1;
+    }
+    for (size_t i = 0; i < old_slots_count; i++) {
+        if (old_ctrl[i] & 0x80) continue;
+        const uint8_t* src = old_slots + i * m->slot_size;
+        uint64_t h = key_hash(src);
+        size_t slot = free_slot(m, h);
+        m->ctrl[slot] = hash_tag(h);
+        memcpy(slot_at(m, slot), src, m->slot_size);
+    }
+    m->used = m->size;
+    free(old_ctrl);
+    free(old_slots);
+    return 0;
+}
+
+// --- Value arena ---
+
+static int alloc_value(DigestMap* m, uint32_t* idx) {
+    if (m->free_count) {
+        *idx = m->free_values[--m->free_count];
+    } else {
+        if (m->next_value == UINT32_MAX) return -1;
+        if ((m->next_value >> ARENA_SHIFT) == m->arena_blocks) {
+            if (m->arena_blocks == m->arena_cap) {
+                size_t cap = m->arena_cap ? 2 * m->arena_cap : 16;
+                uint8_t** arena = (uint8_t**)realloc(m->arena, cap * sizeof(uint8_t*));
+                if (!arena) return -1;
+                m->arena = arena;
+                m->arena_cap = cap;
+            }
+            uint8_t* block = (uint8_t*)malloc(ARENA_BLOCK * m->value_size);
+            if (!block) return -1;
+            m->arena[m->arena_blocks++] = block;
+        }
+        *idx = m->next_value++;
+    }
+    memset(value_at(m, *idx), 0, m->value_size);
+    return 0;
+}
+
+static int release_value(DigestMap* m, uint32_t idx) {
+    if (m->free_count == m->free_cap) {
+        size_t cap = m->free_cap ? 2 * m->free_cap : 64;
+        uint32_t* list = (uint32_t*)realloc(m->free_values, cap * sizeof(uint32_t));
+        if (!list) return -1;
+        m->free_values = list;
+        m->free_cap = cap;
+    }
+    m->free_values[m->free_count++] = idx;
+    return 0;
+}
+
+// --- Public API ---
+
+DigestMap* digest_map_create(uint32_t key_len, uint32_t value_size, size_t expected) {
+    if (key_len < 8 || key_len > DIGEST_MAP_MAX_KEY_LEN || value_size == 0) return NULL;
+    DigestMap* m = (DigestMap*)calloc(1, sizeof(DigestMap));
+    if (!m) return NULL;
+    m->key_len = key_len;
+    m->value_size = value_size;
+    m->slot_size = key_len + 4;
+    size_t groups = MIN_GROUPS;
+    while (groups * DIGEST_MAP_GROUP - groups * DIGEST_MAP_GROUP / 8 < expected) groups *= 2;
+    if (alloc_table(m, groups) != 0) {
+        free(m);
+        return NULL;
+    }
+    return m;
+}
+
+void digest_map_free(DigestMap* map) {
+    if (!map) return;
+    for (size_t i = 0; i < map->arena_blocks; i++) free(map->arena[i]);
+    free(map->arena);
+    free(map->free_values);
+    free(map->ctrl);
+    free(map->slots);
+    free(map);
+}
+
+size_t digest_map_size(const DigestMap* map) { return map ? map->size : 0; }
+
+void* digest_map_insert(DigestMap* map, const uint8_t* key, bool* inserted) {
+    if (inserted) *inserted = false;
+    uint64_t h = key_hash(key);
+    size_t slot = find_slot(map, key, h);
+    if (slot != NO_SLOT) return value_at(map, slot_value_index(map, slot));
+
+    slot = free_slot(map, h);
+    if (map->ctrl[slot] == CTRL_EMPTY && map->used >= map->growth_limit) {
+        // Grow when at least half of the limit is live keys, otherwise only purge the tombstones.
+        size_t groups = map->group_mask + 1;
+        if (rehash(map, map->size >= map->growth_limit / 2 ? 2 * groups : groups) != 0) return NULL;
+        slot = free_slot(map, h);
+    }
+    uint32_t idx;
+    if (alloc_value(map, &idx) != 0) return NULL;
+    if (map->ctrl[slot] == CTRL_EMPTY) map->used++;
+    map->ctrl[slot] = hash_tag(h);
+    memcpy(slot_at(map, slot), key, map->key_len);
+    memcpy(slot_at(map, slot) + map->key_len, &idx, 4);
+    map->size++;
+    if (inserted) *inserted = true;
+    return value_at(map, idx);
+}
+
+void* digest_map_find(const DigestMap* map, const uint8_t* key) {
+    size_t slot = find_slot(map, key, key_hash(key));
+    return slot == NO_SLOT ? NULL : value_at(map, slot_value_index(map, slot));
+}
+
+bool digest_map_erase(DigestMap* map, const uint8_t* key) {
+    size_t slot = find_slot(map, key, key_hash(key));
+    if (slot == NO_SLOT) return false;
+    if (release_value(map, slot_value_index(map, slot)) != 0) return false;
+    // A group that still has an empty slot never ended a probe, so the slot can become empty again.
+    const uint8_t* ctrl = map->ctrl + (slot & ~(size_t)(DIGEST_MAP_GROUP - 1));
+    if (match_empty(ctrl)) {
+        map->ctrl[slot] = CTRL_EMPTY;
+        map->used--;
+    } else {
+        map->ctrl[slot] = CTRL_DELETED;
+    }
+    map->size--;
+    return true;
+}
+
+void digest_map_foreach(const DigestMap* map, void (*fn)(const uint8_t* key, void* value, void* user), void* user) {
+    size_t nslots = (map->group_mask + 1) * DIGEST_MAP_GROUP;
+    for (size_t i = 0; i < nslots; i++) {
+        if (map->ctrl[i] & 0x80) continue;
+        fn(slot_at(map, i), value_at(map, slot_value_index(map, i)), user);
+    }
+}
+
+// Stages 2 and 3 of a batched lookup, after the control groups of all lanes were prefetched: match the
+// tags and prefetch the first candidate slot of every lane, then compare the keys. A lane whose home
+// group neither holds the key nor ends the probe continues with the scalar probe.
+static uint8_t find_8_prefetched(const DigestMap* m, const uint8_t* const keys[8], const uint64_t h[8],
+                                 void* values[8]) {
+    uint32_t cand[8];
+    for (int lane = 0; lane < 8; lane++) {
+        size_t g = hash_group(m, h[lane]);
+        cand[lane] = match_tag(m->ctrl + g * DIGEST_MAP_GROUP, hash_tag(h[lane]));
+        if (cand[lane]) __builtin_prefetch(slot_at(m, g * DIGEST_MAP_GROUP + (size_t)__builtin_ctz(cand[lane])));
+    }
+    uint8_t found = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        size_t g = hash_group(m, h[lane]);
+        size_t slot = NO_SLOT;
+        for (uint32_t bits = cand[lane]; bits; bits &= bits - 1) {
+            size_t s = g * DIGEST_MAP_GROUP + (size_t)__builtin_ctz(bits);
+            if (key_equal(slot_at(m, s), keys[lane], m->key_len)) {
+                slot = s;
+                break;
+            }
+        }
+        if (slot == NO_SLOT && !match_empty(m->ctrl + g * DIGEST_MAP_GROUP)) slot = find_slot(m, keys[lane], h[lane]);
+        values[lane] = slot == NO_SLOT ? NULL : value_at(m, slot_value_index(m, slot));
+        if (values[lane]) {
+            __builtin_prefetch(values[lane]);
+            found |= (uint8_t)(1u << lane);
+        }
+    }
+    return found;
+}
+
+uint8_t digest_map_find_8(const DigestMap* map, const uint8_t* const keys[8], void* values[8]) {
+    uint64_t h[8];
+    for (int lane = 0; lane < 8; lane++) {
+        h[lane] = key_hash(keys[lane]);
+        __builtin_prefetch(map->ctrl + hash_group(map, h[lane]) * DIGEST_MAP_GROUP);
+    }
+    return find_8_prefetched(map, keys, h, values);
+}
+
+uint8_t digest_map_find_h160_soa(const DigestMap* map, const __m256i h160[5], void* values[8]) {
+    if (map->key_len != 20) {
+        for (int lane = 0; lane < 8; lane++) values[lane] = NULL;
+        return 0;
+    }
+    // Digest bytes 0..7 are the little-endian words h160[0] and h160[1]: the hash needs no transpose.
+    alignas(32) uint32_t lo[8], hi[8];
+    _mm256_store_si256((__m256i*)lo, h160[0]);
+    _mm256_store_si256((__m256i*)hi, h160[1]);
+    uint64_t h[8];
+    for (int lane = 0; lane < 8; lane++) {
+        h[lane] = (uint64_t)hi[lane] << 32 | lo[lane];
+        __builtin_prefetch(map->ctrl + hash_group(map, h[lane]) * DIGEST_MAP_GROUP);
+    }
+    // The transpose for the key compares overlaps the control-group loads.
+    uint8_t digests[8][20];
+    const uint8_t* keys[8];
+    ripemd160_avx8_soa_store(h160, digests);
+    for (int lane = 0; lane < 8; lane++) keys[lane] = digests[lane];
+    return find_8_prefetched(map, keys, h, values);
+}
@@ -0,0 +1,113 @@
+/* digest_map_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef DIGEST_MAP_AVX_H
+#define DIGEST_MAP_AVX_H
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Compile-time check to ensure AVX2 is enabled
+#if !defined(__AVX2__)
+#error "This implementation requires AVX2 support. Please compile with -mavx2."
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// In-memory open-addressing map from fixed-length digests (20-byte HASH160, 32-byte SHA-256) to
+// fixed-size values, in the style of a Swiss table.
+//
+// Slots are grouped by 16; each group has 16 control bytes (empty, deleted, or a 7-bit tag of the key)
+// that are matched against the tag with one vector compare, so a probe touches the key of a slot only
+// when its tag matches. Digests are uniformly random, so the first 8 key bytes are used directly as
+// the hash: the low 7 bits are the tag and the bits above select the group.
+//
+// Values live in an arena of fixed-size slots that never moves: the pointer returned for a key stays
+// valid until that key is erased or the map is freed, across any number of insertions and rehashes.
+// Not thread-safe for concurrent writers; concurrent lookups without writers are fine.
+
+#define DIGEST_MAP_GROUP 16
+#define DIGEST_MAP_MAX_KEY_LEN 64
+
+typedef struct DigestMap DigestMap;
+
+/**
+* @brief Creates an empty map.
+* @param key_len Key length in bytes (8..DIGEST_MAP_MAX_KEY_LEN), e.g. 20 or 32.
+* @param value_size Bytes of value per key (at least 1).
+* @param expected Number of keys to size the table for (0 for the minimum); the table grows as needed.
+* @return The map, or NULL on invalid arguments or allocation failure.
+*/
+DigestMap* digest_map_create(uint32_t key_len, uint32_t value_size, size_t expected);
+
+/**
+* @brief Frees the map and all of its values.
+*/
+void digest_map_free(DigestMap* map);
+
+/** @brief Number of keys in the map. */
+size_t digest_map_size(const DigestMap* map);
+
+/**
+* @brief Finds the value of key, inserting a zeroed value if the key is absent.
+* @param inserted Optional, set to true when the key was added.
+* @return The value (value_size bytes), or NULL on allocation failure.
+*/
+void* digest_map_insert(DigestMap* map, const uint8_t* key, bool* inserted);
+
+/**
+* @brief Looks up one key.
+* @return The value, or NULL if the key is absent.
+*/
+void* digest_map_find(const DigestMap* map, const uint8_t* key);
+
+/**
+* @brief Looks up eight keys, overlapping their memory accesses: the control groups of all lanes are
+* prefetched first, then the key slots their tags select, and only then are the keys compared.
+* @param values Per-lane outputs (NULL for misses).
+* @return Bit mask of the lanes whose key was found.
+*/
+uint8_t digest_map_find_8(const DigestMap* map, const uint8_t* const keys[8], void* values[8]);
+
+/**
+* @brief digest_map_find_8() for 8 HASH160 digests as a RIPEMD-160 state in SoA form, straight from
+* ripemd160_avx8_soa_hash_digest(). The hash comes from the first two state words without a transpose.
+* The map must have 20-byte keys (otherwise nothing is found).
+*/
+uint8_t digest_map_find_h160_soa(const DigestMap* map, const __m256i h160[5], void* values[8]);
+
+/**
+* @brief Removes a key; its value slot is recycled by a later insertion.
+* @return true if the key was present.
+*/
+bool digest_map_erase(DigestMap* map, const uint8_t* key);
+
+/**
+* @brief Calls fn for every (key, value), in table order. The map must not be modified during the walk.
+*/
+void digest_map_foreach(const DigestMap* map, void (*fn)(const uint8_t* key, void* value, void* user), void* user);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // DIGEST_MAP_AVX_H
@@ -0,0 +1,236 @@
+/* digest_map_test.c
+ * gcc -O3 -mavx2 -march=native digest_map_test.c digest_map_avx.c ripemd160_avx.c -o digest_map_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "digest_map_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+static void random_bytes(uint8_t* out, size_t len) {
+    for (size_t i = 0; i < len; i++) out[i] = (uint8_t)rand();
+}
+
+static uint64_t load_u64(const void* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static void count_entries(const uint8_t* key, void* value, void* user) {
+    (void)key;
+    (void)value;
+    (*(size_t*)user)++;
+}
+
+// Baseline: separate chaining with one allocation per node, the shape of std::unordered_map.
+typedef struct Node {
+    struct Node* next;
+    uint8_t key[20];
+    uint64_t value;
+} Node;
+
+typedef struct {
+    Node** buckets;
+    size_t mask;
+} ChainedMap;
+
+static void chained_insert(ChainedMap* c, const uint8_t key[20], uint64_t value) {
+    Node* n = (Node*)malloc(sizeof(Node));
+    memcpy(n->key, key, 20);
+    n->value = value;
+    size_t b = (size_t)(load_u64(key) * 0x9E3779B97F4A7C15ull >> 20) & c->mask;
+    n->next = c->buckets[b];
+    c->buckets[b] = n;
+}
+
+static Node* chained_find(const ChainedMap* c, const uint8_t key[20]) {
+    size_t b = (size_t)(load_u64(key) * 0x9E3779B97F4A7C15ull >> 20) & c->mask;
+    for (Node* n = c->buckets[b]; n; n = n->next) {
+        if (memcmp(n->key, key, 20) == 0) return n;
+    }
+    return NULL;
+}
+
+int main() {
+    printf("--- Correctness Test (Swiss-table Digest Map) ---\n");
+    int failed_tests = 0;
+    srand(1);
+
+    const size_t N = 200000;
+    uint8_t (*keys)[20] = (uint8_t(*)[20])malloc(2 * N * 20);
+    random_bytes(keys[0], 2 * N * 20); // keys[N..2N) are never inserted
+    DigestMap* map = digest_map_create(20, 8, 0);
+
+    // Value pointers taken while the table is small must survive every later rehash.
+    uint64_t* early[64];
+    int insert_bad = 0;
+    for (size_t i = 0; i < N; i++) {
+        bool inserted;
+        uint64_t* v = (uint64_t*)digest_map_insert(map, keys[i], &inserted);
+        if (!v || !inserted || *v != 0) insert_bad++;
+        else *v = i;
+        if (i < 64) early[i] = v;
+    }
+    bool again;
+    insert_bad += digest_map_insert(map, keys[5], &again) != early[5] || again;
+    failed_tests += report("200000 inserts, re-insert returns the same value", insert_bad == 0 && digest_map_size(map) == N);
+
+    int find_bad = 0;
+    for (size_t i = 0; i < 2 * N; i++) {
+        uint64_t* v = (uint64_t*)digest_map_find(map, keys[i]);
+        if (i < N ? (!v || *v != i) : v != NULL) find_bad++;
+    }
+    for (size_t i = 0; i < 64; i++) find_bad += digest_map_find(map, keys[i]) != early[i];
+    failed_tests += report("Hits, misses, and value pointers stable across growth", find_bad == 0);
+
+    // Batched lookups, mixed hits and misses, against single lookups.
+    int batch_bad = 0;
+    for (int round = 0; round < 20000; round++) {
+        const uint8_t* ptrs[8];
+        void* values[8];
+        for (int lane = 0; lane < 8; lane++) ptrs[lane] = keys[(size_t)rand() % (2 * N)];
+        uint8_t mask = digest_map_find_8(map, ptrs, values);
+        for (int lane = 0; lane < 8; lane++) {
+            void* want = digest_map_find(map, ptrs[lane]);
+            if (values[lane] != want || (((mask >> lane) & 1) != (want != NULL))) batch_bad++;
+        }
+    }
+    failed_tests += report("digest_map_find_8 matches digest_map_find", batch_bad == 0);
+
+    // The same through a RIPEMD-160 state in SoA form (little-endian words, lane i = digest i).
+    int soa_bad = 0;
+    for (int round = 0; round < 20000; round++) {
+        uint32_t words[5][8];
+        const uint8_t* ptrs[8];
+        for (int lane = 0; lane < 8; lane++) {
+            ptrs[lane] = keys[(size_t)rand() % (2 * N)];
+            for (int w = 0; w < 5; w++) memcpy(&words[w][lane], ptrs[lane] + 4 * w, 4);
+        }
+        __m256i h160[5];
+        for (int w = 0; w < 5; w++) h160[w] = _mm256_loadu_si256((const __m256i*)words[w]);
+        void* values[8];
+        uint8_t mask = digest_map_find_h160_soa(map, h160, values);
+        for (int lane = 0; lane < 8; lane++) {
+            void* want = digest_map_find(map, ptrs[lane]);
+            if (values[lane] != want || (((mask >> lane) & 1) != (want != NULL))) soa_bad++;
+        }
+    }
+    failed_tests += report("digest_map_find_h160_soa matches digest_map_find", soa_bad == 0);
+
+    // Erase every other key, then insert fresh keys: tombstones and recycled value slots.
+    int erase_bad = 0;
+    for (size_t i = 0; i < N; i += 2) erase_bad += !digest_map_erase(map, keys[i]);
+    erase_bad += digest_map_erase(map, keys[0]); // already gone
+    for (size_t i = 0; i < N; i++) {
+        uint64_t* v = (uint64_t*)digest_map_find(map, keys[i]);
+        if (i % 2 == 0 ? v != NULL : (!v || *v != i)) erase_bad++;
+    }
+    for (size_t i = N; i < N + N / 2; i++) {
+        uint64_t* v = (uint64_t*)digest_map_insert(map, keys[i], NULL);
+        if (!v || *v != 0) erase_bad++;
+        else *v = i;
+    }
+    for (size_t i = 1; i < N + N / 2; i += (i < N ? 2 : 1)) {
+        uint64_t* v = (uint64_t*)digest_map_find(map, keys[i]);
+        if (!v || *v != i) erase_bad++;
+    }
+    size_t walked = 0;
+    digest_map_foreach(map, count_entries, &walked);
+    failed_tests += report("Erase, reinsert and foreach keep every key consistent", erase_bad == 0 && walked == N && digest_map_size(map) == N);
+    digest_map_free(map);
+
+    // 32-byte keys whose first 8 bytes (the whole hash) are identical: one long probe chain.
+    {
+        DigestMap* m32 = digest_map_create(32, 4, 0);
+        uint8_t k[300][32];
+        int bad = 0;
+        for (int i = 0; i < 300; i++) {
+            random_bytes(k[i], 32);
+            memset(k[i], 0xAB, 8);
+            uint32_t* v = (uint32_t*)digest_map_insert(m32, k[i], NULL);
+            if (!v) bad++;
+            else *v = (uint32_t)i;
+        }
+        for (int i = 0; i < 300; i += 3) bad += !digest_map_erase(m32, k[i]);
+        for (int i = 0; i < 300; i++) {
+            uint32_t* v = (uint32_t*)digest_map_find(m32, k[i]);
+            if (i % 3 == 0 ? v != NULL : (!v || *v != (uint32_t)i)) bad++;
+        }
+        failed_tests += report("32-byte keys with colliding hashes", bad == 0 && digest_map_size(m32) == 200);
+        failed_tests += report("Invalid key or value sizes rejected",
+                               digest_map_create(4, 8, 0) == NULL && digest_map_create(20, 0, 0) == NULL);
+        digest_map_free(m32);
+    }
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    const size_t M = 4000000, LOOKUPS = 8000000;
+    printf("--- Performance Benchmark (%zu HASH160 keys, %zu lookups, 50%% hits) ---\n", M, LOOKUPS);
+    uint8_t (*big)[20] = (uint8_t(*)[20])malloc(2 * M * 20);
+    random_bytes(big[0], 2 * M * 20);
+    size_t* order = (size_t*)malloc(LOOKUPS * sizeof(size_t));
+    for (size_t i = 0; i < LOOKUPS; i++) order[i] = ((size_t)rand() << 16 ^ (size_t)rand()) % (2 * M);
+
+    map = digest_map_create(20, 8, M);
+    clock_t start = clock();
+    for (size_t i = 0; i < M; i++) *(uint64_t*)digest_map_insert(map, big[i], NULL) = i;
+    double insert_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    ChainedMap chained = {(Node**)calloc(1u << 22, sizeof(Node*)), (1u << 22) - 1};
+    start = clock();
+    for (size_t i = 0; i < M; i++) chained_insert(&chained, big[i], i);
+    double chained_insert_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    size_t chained_hits = 0;
+    start = clock();
+    for (size_t i = 0; i < LOOKUPS; i++) chained_hits += chained_find(&chained, big[order[i]]) != NULL;
+    double chained_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    size_t hits = 0;
+    start = clock();
+    for (size_t i = 0; i < LOOKUPS; i++) hits += digest_map_find(map, big[order[i]]) != NULL;
+    double single = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    size_t hits8 = 0;
+    start = clock();
+    for (size_t i = 0; i < LOOKUPS; i += 8) {
+        const uint8_t* ptrs[8];
+        void* values[8];
+        for (int lane = 0; lane < 8; lane++) ptrs[lane] = big[order[i + lane]];
+        hits8 += (size_t)__builtin_popcount(digest_map_find_8(map, ptrs, values));
+    }
+    double batched = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Insert: digest map %.1f M/s, chained map %.1f M/s\n", M / insert_time / 1e6, M / chained_insert_time / 1e6);
+    printf("Chained map (node per key):  %.1f M lookups/sec (%zu hits)\n", LOOKUPS / chained_time / 1e6, chained_hits);
+    printf("digest_map_find:             %.1f M lookups/sec (%.2fx)\n", LOOKUPS / single / 1e6, chained_time / single);
+    printf("digest_map_find_8:           %.1f M lookups/sec (%.2fx, %zu/%zu hits)\n", LOOKUPS / batched / 1e6,
+           chained_time / batched, hits8, hits);
+
+    for (size_t b = 0; b <= chained.mask; b++) {
+        for (Node* n = chained.buckets[b]; n;) {
+            Node* next = n->next;
+            free(n);
+            n = next;
+        }
+    }
+    free(chained.buckets);
+    digest_map_free(map);
+    free(order);
+    free(big);
+    free(keys);
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,626 @@
+/* ec_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "ec_avx.h"
+#include "sha256_avx_soa.h"
+#include "ripemd160_avx_soa.h"
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define M26 0x3FFFFFF
+#define M22 0x3FFFFF
+
+// Limbs of 2p, used by fe8_sub so that every limb of a + 2p - b stays non-negative.
+static const uint32_t two_p[10] = {0x7FFF85E, 0x7FFFF7E, 0x7FFFFFE, 0x7FFFFFE, 0x7FFFFFE,
+                                   0x7FFFFFE, 0x7FFFFFE, 0x7FFFFFE, 0x7FFFFFE, 0x7FFFFE};
+
+static const uint8_t G_X[32] = {0x79, 0xBE, 0x66, 0x7E, 0xF9, 0xDC, 0xBB, 0xAC, 0x55, 0xA0, 0x62, 0x95, 0xCE, 0x87, 0x0B, 0x07,
+                                0x02, 0x9B, 0xFC, 0xDB, 0x2D, 0xCE, 0x28, 0xD9, 0x59, 0xF2, 0x81, 0x5B, 0x16, 0xF8, 0x17, 0x98};
+static const uint8_t G_Y[32] = {0x48, 0x3A, 0xDA, 0x77, 0x26, 0xA3, 0xC4, 0x65, 0x5D, 0xA4, 0xFB, 0xFC, 0x0E, 0x11, 0x08, 0xA8,
+                                0xFD, 0x17, 0xB4, 0x48, 0xA6, 0x85, 0x54, 0x19, 0x9C, 0x47, 0xD0, 0x8F, 0xFB, 0x10, 0xD4, 0xB8};
+static const uint8_t P_BYTES[32] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF, 0xFC, 0x2F};
+
+// --- Field elements ---
+
+// words[0] is the most significant big-endian word; limb k takes bits 26k .. 26k+25.
+static inline void words_to_limbs(Fe8* r, const __m256i words[8]) {
+    for (int k = 0; k < 10; k++) {
+        __m256i acc = _mm256_setzero_si256();
+        for (int j = 0; j < 8; j++) {
+            int shift = 32 * j - 26 * k; // where bit 0 of word j (from the bottom) lands in limb k
+            if (shift >= 26 || shift <= -32) continue;
+            const __m256i w = words[7 - j];
+            acc = _mm256_or_si256(acc, shift >= 0 ? _mm256_slli_epi32(w, shift) : _mm256_srli_epi32(w, -shift));
+        }
+        r->n[k] = _mm256_and_si256(acc, _mm256_set1_epi32(M26));
+    }
+}
+
+// Inverse of words_to_limbs for a fully reduced element.
+static inline void limbs_to_words(__m256i words[8], const Fe8* a) {
+    for (int j = 0; j < 8; j++) {
+        __m256i acc = _mm256_setzero_si256();
+        for (int k = 0; k < 10; k++) {
+            int shift = 26 * k - 32 * j; // where bit 0 of limb k lands in word j
+            if (shift >= 32 || shift <= -26) continue;
+            acc = _mm256_or_si256(acc, shift >= 0 ? _mm256_slli_epi32(a->n[k], shift) : _mm256_srli_epi32(a->n[k], -shift));
+        }
+        words[7 - j] = acc;
+    }
+}
+
+void fe8_set_b32(Fe8* r, const uint8_t* const in[8]) {
+    __m256i words[8];
+    sha256_avx8_soa_load_digests(words, in);
+    words_to_limbs(r, words);
+}
+
+void fe8_set_int(Fe8* r, uint32_t v) {
+    r->n[0] = _mm256_set1_epi32((int)(v & M26));
+    r->n[1] = _mm256_set1_epi32((int)(v >> 26));
+    for (int k = 2; k < 10; k++) r->n[k] = _mm256_setzero_si256();
+}
+
+void fe8_add(Fe8* r, const Fe8* a, const Fe8* b) {
+    for (int k = 0; k < 10; k++) r->n[k] = _mm256_add_epi32(a->n[k], b->n[k]);
+}
+
+void fe8_sub(Fe8* r, const Fe8* a, const Fe8* b) {
+    for (int k = 0; k < 10; k++) {
+        r->n[k] = _mm256_sub_epi32(_mm256_add_epi32(a->n[k], _mm256_set1_epi32((int)two_p[k])), b->n[k]);
+    }
+}
+
+// One carry pass, then the bits above 2^256 (limb 9 holds 22) are folded back as x * 0x1000003D1.
+static inline void carry_fold_32(__m256i n[10]) {
+    const __m256i m26 = _mm256_set1_epi32(M26);
+    for (int k = 0; k < 9; k++) {
+        n[k + 1] = _mm256_add_epi32(n[k + 1], _mm256_srli_epi32(n[k], 26));
+        n[k] = _mm256_and_si256(n[k], m26);
+    }
+    __m256i x = _mm256_srli_epi32(n[9], 22);
+    n[9] = _mm256_and_si256(n[9], _mm256_set1_epi32(M22));
+    n[0] = _mm256_add_epi32(n[0], _mm256_mullo_epi32(x, _mm256_set1_epi32(0x3D1)));
+    n[1] = _mm256_add_epi32(n[1], _mm256_slli_epi32(x, 6));
+}
+
+static inline void carry_32(__m256i n[10]) {
+    const __m256i m26 = _mm256_set1_epi32(M26);
+    for (int k = 0; k < 9; k++) {
+        n[k + 1] = _mm256_add_epi32(n[k + 1], _mm256_srli_epi32(n[k], 26));
+        n[k] = _mm256_and_si256(n[k], m26);
+    }
+}
+
+void fe8_reduce(Fe8* r) {
+    carry_fold_32(r->n);
+    carry_32(r->n);
+}
+
+void fe8_normalize(Fe8* r) {
+    fe8_reduce(r);
+    carry_fold_32(r->n); // now < 2^256
+    carry_32(r->n);
+
+    // r >= p  <=>  r + (2^256 - p) carries into bit 256.
+    __m256i t[10];
+    memcpy(t, r->n, sizeof(t));
+    t[0] = _mm256_add_epi32(t[0], _mm256_set1_epi32(0x3D1));
+    t[1] = _mm256_add_epi32(t[1], _mm256_set1_epi32(0x40));
+    carry_32(t);
+    __m256i over = _mm256_cmpeq_epi32(_mm256_srli_epi32(t[9], 22), _mm256_set1_epi32(1));
+    t[9] = _mm256_and_si256(t[9], _mm256_set1_epi32(M22));
+    for (int k = 0; k < 10; k++) r->n[k] = _mm256_blendv_epi8(r->n[k], t[k], over);
+}
+
+// Reduces a 19-limb product held as 64-bit accumulators (4 lanes) to 10 weak limbs.
+static inline void reduce_wide(__m256i c[20]) {
+    const __m256i m26 = _mm256_set1_epi64x(M26);
+    for (int i = 0; i < 18; i++) {
+        c[i + 1] = _mm256_add_epi64(c[i + 1], _mm256_srli_epi64(c[i], 26));
+        c[i] = _mm256_and_si256(c[i], m26);
+    }
+    c[19] = _mm256_srli_epi64(c[18], 26);
+    c[18] = _mm256_and_si256(c[18], m26);
+
+    // 2^260 = 0x3D10 + 2^36 (mod p): limb i >= 10 adds 0x3D10 * c to limb i-10 and c << 10 to limb i-9.
+    const __m256i r0 = _mm256_set1_epi64x(0x3D10);
+    for (int i = 10; i < 19; i++) {
+        c[i - 10] = _mm256_add_epi64(c[i - 10], _mm256_mul_epu32(c[i], r0));
+        c[i - 9] = _mm256_add_epi64(c[i - 9], _mm256_slli_epi64(c[i], 10));
+    }
+    // Limb 19 would spill into limb 10 again, so its 2^270 part is folded directly: 2^270 = 0xF44000 + 2^46.
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(c[19], r0));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(c[19], _mm256_set1_epi64x(0xF44000)));
+    c[1] = _mm256_add_epi64(c[1], _mm256_slli_epi64(c[19], 20));
+
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 9; i++) {
+            c[i + 1] = _mm256_add_epi64(c[i + 1], _mm256_srli_epi64(c[i], 26));
+            c[i] = _mm256_and_si256(c[i], m26);
+        }
+        if (round == 1) break;
+        __m256i x = _mm256_srli_epi64(c[9], 22);
+        c[9] = _mm256_and_si256(c[9], _mm256_set1_epi64x(M22));
+        c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(x, _mm256_set1_epi64x(0x3D1)));
+        c[1] = _mm256_add_epi64(c[1], _mm256_slli_epi64(x, 6));
+    }
+}
+
+// Even lanes sit in the low halves of the 64-bit elements, odd lanes are shifted down; both are
+// multiplied with _mm256_mul_epu32 and packed back into 32-bit lanes at the end.
+static inline void pack_halves(Fe8* r, const __m256i even[20], const __m256i odd[20]) {
+    for (int k = 0; k < 10; k++) r->n[k] = _mm256_or_si256(even[k], _mm256_slli_epi64(odd[k], 32));
+}
+
+void fe8_mul(Fe8* r, const Fe8* a, const Fe8* b) {
+    __m256i ae[10], ao[10], be[10], bo[10], ce[20], co[20];
+    for (int k = 0; k < 10; k++) {
+        ae[k] = a->n[k];
+        ao[k] = _mm256_srli_epi64(a->n[k], 32);
+        be[k] = b->n[k];
+        bo[k] = _mm256_srli_epi64(b->n[k], 32);
+    }
+    for (int k = 0; k < 20; k++) ce[k] = co[k] = _mm256_setzero_si256();
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            ce[i + j] = _mm256_add_epi64(ce[i + j], _mm256_mul_epu32(ae[i], be[j]));
+            co[i + j] = _mm256_add_epi64(co[i + j], _mm256_mul_epu32(ao[i], bo[j]));
+        }
+    }
+    reduce_wide(ce);
+    reduce_wide(co);
+    pack_halves(r, ce, co);
+}
+
+void fe8_sqr(Fe8* r, const Fe8* a) {
+    __m256i ae[10], ao[10], ae2[10], ao2[10], ce[20], co[20];
+    for (int k = 0; k < 10; k++) {
+        ae[k] = a->n[k];
+        ao[k] = _mm256_srli_epi64(a->n[k], 32);
+        ae2[k] = _mm256_add_epi64(ae[k], ae[k]); // limbs < 2^28, so the doubled value still fits the low 32 bits
+        ao2[k] = _mm256_add_epi64(ao[k], ao[k]);
+    }
+    for (int k = 0; k < 20; k++) ce[k] = co[k] = _mm256_setzero_si256();
+    for (int i = 0; i < 10; i++) {
+        ce[2 * i] = _mm256_add_epi64(ce[2 * i], _mm256_mul_epu32(ae[i], ae[i]));
+        co[2 * i] = _mm256_add_epi64(co[2 * i], _mm256_mul_epu32(ao[i], ao[i]));
+        for (int j = i + 1; j < 10; j++) {
+            ce[i + j] = _mm256_add_epi64(ce[i + j], _mm256_mul_epu32(ae2[i], ae[j]));
+            co[i + j] = _mm256_add_epi64(co[i + j], _mm256_mul_epu32(ao2[i], ao[j]));
+        }
+    }
+    reduce_wide(ce);
+    reduce_wide(co);
+    pack_halves(r, ce, co);
+}
+
+static inline void fe8_sqr_n(Fe8* r, const Fe8* a, int n) {
+    fe8_sqr(r, a);
+    for (int i = 1; i < n; i++) fe8_sqr(r, r);
+}
+
+// The exponents p - 2 and (p + 1) / 4 are built from runs of 1 bits of lengths 2, 22 and 223; this
+// computes x_n = a^(2^n - 1) for those n (the addition chain of libsecp256k1).
+static void fe8_pow_runs(const Fe8* a, Fe8* x2, Fe8* x22, Fe8* x223) {
+    Fe8 x3, x6, x9, x11, x44, x88, x176, x220;
+    fe8_sqr(x2, a);
+    fe8_mul(x2, x2, a);
+    fe8_sqr(&x3, x2);
+    fe8_mul(&x3, &x3, a);
+    fe8_sqr_n(&x6, &x3, 3);
+    fe8_mul(&x6, &x6, &x3);
+    fe8_sqr_n(&x9, &x6, 3);
+    fe8_mul(&x9, &x9, &x3);
+    fe8_sqr_n(&x11, &x9, 2);
+    fe8_mul(&x11, &x11, x2);
+    fe8_sqr_n(x22, &x11, 11);
+    fe8_mul(x22, x22, &x11);
+    fe8_sqr_n(&x44, x22, 22);
+    fe8_mul(&x44, &x44, x22);
+    fe8_sqr_n(&x88, &x44, 44);
+    fe8_mul(&x88, &x88, &x44);
+    fe8_sqr_n(&x176, &x88, 88);
+    fe8_mul(&x176, &x176, &x88);
+    fe8_sqr_n(&x220, &x176, 44);
+    fe8_mul(&x220, &x220, &x44);
+    fe8_sqr_n(x223, &x220, 3);
+    fe8_mul(x223, x223, &x3);
+}
+
+void fe8_inv(Fe8* r, const Fe8* a) {
+    Fe8 x2, x22, x223, t;
+    fe8_pow_runs(a, &x2, &x22, &x223);
+    fe8_sqr_n(&t, &x223, 23);
+    fe8_mul(&t, &t, &x22);
+    fe8_sqr_n(&t, &t, 5);
+    fe8_mul(&t, &t, a);
+    fe8_sqr_n(&t, &t, 3);
+    fe8_mul(&t, &t, &x2);
+    fe8_sqr_n(&t, &t, 2);
+    fe8_mul(r, &t, a);
+}
+
+uint8_t fe8_sqrt(Fe8* r, const Fe8* a) {
+    // p = 3 mod 4, so a^((p + 1) / 4) is a root whenever one exists.
+    Fe8 in = *a, x2, x22, x223, t;
+    fe8_pow_runs(&in, &x2, &x22, &x223);
+    fe8_sqr_n(&t, &x223, 23);
+    fe8_mul(&t, &t, &x22);
+    fe8_sqr_n(&t, &t, 6);
+    fe8_mul(&t, &t, &x2);
+    fe8_sqr(&t, &t);
+    fe8_sqr(r, &t);
+    fe8_sqr(&t, r);
+    return fe8_equal(&t, &in);
+}
+
+uint8_t fe8_equal(const Fe8* a, const Fe8* b) {
+    Fe8 x = *a, y = *b;
+    fe8_normalize(&x);
+    fe8_normalize(&y);
+    __m256i eq = _mm256_set1_epi32(-1);
+    for (int k = 0; k < 10; k++) eq = _mm256_and_si256(eq, _mm256_cmpeq_epi32(x.n[k], y.n[k]));
+    return (uint8_t)_mm256_movemask_ps(_mm256_castsi256_ps(eq));
+}
+
+void fe8_to_words(__m256i words[8], const Fe8* a) {
+    Fe8 t = *a;
+    fe8_normalize(&t);
+    limbs_to_words(words, &t);
+}
+
+void fe8_get_b32(uint8_t out[8][32], const Fe8* a) {
+    __m256i words[8];
+    fe8_to_words(words, a);
+    sha256_avx8_soa_store(words, out); // the same big-endian transposed store as a SHA-256 digest
+}
+
+// --- Affine points ---
+
+void ge8_set_uncompressed(Ge8* r, const uint8_t* const pubkeys[8]) {
+    const uint8_t* xs[8];
+    const uint8_t* ys[8];
+    for (int lane = 0; lane < 8; lane++) {
+        xs[lane] = pubkeys[lane] + 1;
+        ys[lane] = pubkeys[lane] + 33;
+    }
+    fe8_set_b32(&r->x, xs);
+    fe8_set_b32(&r->y, ys);
+}
+
+static inline void fe8_blend(Fe8* r, const Fe8* a, const Fe8* b, __m256i mask) {
+    for (int k = 0; k < 10; k++) r->n[k] = _mm256_blendv_epi8(a->n[k], b->n[k], mask);
+}
+
+static inline __m256i lane_mask(uint8_t bits) {
+    const __m256i sel = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(bits), sel), sel);
+}
+
+uint8_t ge8_set_compressed(Ge8* r, const uint8_t* const pubkeys[8]) {
+    const uint8_t* xs[8];
+    uint8_t valid = 0, odd = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        const uint8_t* key = pubkeys[lane];
+        xs[lane] = key + 1;
+        if ((key[0] == 0x02 || key[0] == 0x03) && memcmp(key + 1, P_BYTES, 32) < 0) valid |= (uint8_t)(1u << lane);
+        if (key[0] & 1) odd |= (uint8_t)(1u << lane);
+    }
+    // y^2 = x^3 + 7; one square-root chain for all 8 lanes, then the root with the requested parity.
+    Fe8 x2, y2, seven, neg;
+    fe8_set_b32(&r->x, xs);
+    fe8_sqr(&x2, &r->x);
+    fe8_mul(&y2, &x2, &r->x);
+    fe8_set_int(&seven, 7);
+    fe8_add(&y2, &y2, &seven);
+    fe8_reduce(&y2);
+    valid &= fe8_sqrt(&r->y, &y2);
+    fe8_normalize(&r->y);
+    alignas(32) uint32_t low[8];
+    _mm256_store_si256((__m256i*)low, r->y.n[0]);
+    uint8_t flip = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        if ((low[lane] & 1) != (uint32_t)((odd >> lane) & 1)) flip |= (uint8_t)(1u << lane);
+    }
+    if (flip) {
+        Fe8 zero;
+        fe8_set_int(&zero, 0);
+        fe8_sub(&neg, &zero, &r->y);
+        fe8_reduce(&neg);
+        fe8_blend(&r->y, &r->y, &neg, lane_mask(flip));
+    }
+    return valid;
+}
+
+int ge8_add_affine_batch(Ge8* r, const Ge8* a, const Ge8* b, size_t count, bool b_shared, uint8_t* infinity_masks) {
+    if (count == 0) return 0;
+    Fe8* num = (Fe8*)aligned_alloc(32, 3 * count * sizeof(Fe8));
+    if (!num) return -1;
+    Fe8* den = num + count;
+    Fe8* acc = den + count;
+
+    // Slopes: (y2 - y1) / (x2 - x1), or 3 x1^2 / (2 y1) where the points are equal.
+    for (size_t g = 0; g < count; g++) {
+        const Ge8* p = &a[g];
+        const Ge8* q = &b[b_shared ? 0 : g];
+        uint8_t same_x = fe8_equal(&p->x, &q->x);
+        uint8_t same_y = same_x ? fe8_equal(&p->y, &q->y) : 0;
+        uint8_t dbl = same_x & same_y, inf = same_x & (uint8_t)~same_y;
+        fe8_sub(&num[g], &q->y, &p->y);
+        fe8_sub(&den[g], &q->x, &p->x);
+        if (dbl) {
+            Fe8 x2, n3, y2;
+            fe8_sqr(&x2, &p->x);
+            fe8_add(&n3, &x2, &x2);
+            fe8_add(&n3, &n3, &x2);
+            fe8_add(&y2, &p->y, &p->y);
+            __m256i m = lane_mask(dbl);
+            fe8_blend(&num[g], &num[g], &n3, m);
+            fe8_blend(&den[g], &den[g], &y2, m);
+        }
+        if (inf) {
+            Fe8 one;
+            fe8_set_int(&one, 1);
+            fe8_blend(&den[g], &den[g], &one, lane_mask(inf)); // keeps the batch product invertible
+        }
+        if (infinity_masks) infinity_masks[g] = inf;
+        fe8_reduce(&den[g]);
+        acc[g] = den[g];
+        if (g) fe8_mul(&acc[g], &acc[g - 1], &den[g]);
+    }
+
+    // One inversion for all groups, then walk back: 1/den[g] = acc[g-1] / acc[g].
+    Fe8 inv;
+    fe8_inv(&inv, &acc[count - 1]);
+    for (size_t g = count; g-- > 0;) {
+        Fe8 den_inv, lambda, l2, t;
+        if (g) {
+            fe8_mul(&den_inv, &inv, &acc[g - 1]);
+            fe8_mul(&inv, &inv, &den[g]);
+        } else {
+            den_inv = inv;
+        }
+        const Ge8* p = &a[g];
+        const Ge8* q = &b[b_shared ? 0 : g];
+        fe8_mul(&lambda, &num[g], &den_inv);
+        fe8_sqr(&l2, &lambda);
+        Fe8 x3, y3;
+        fe8_sub(&t, &l2, &p->x);
+        fe8_reduce(&t);
+        fe8_sub(&x3, &t, &q->x);
+        fe8_reduce(&x3);
+        fe8_sub(&t, &p->x, &x3);
+        fe8_mul(&t, &lambda, &t);
+        fe8_sub(&y3, &t, &p->y);
+        fe8_reduce(&y3);
+        r[g].x = x3;
+        r[g].y = y3;
+    }
+    free(num);
+    return 0;
+}
+
+void ge8_get_compressed(uint8_t out[8][33], const Ge8* p) {
+    uint8_t x[8][32];
+    Fe8 y = p->y;
+    fe8_normalize(&y);
+    alignas(32) uint32_t low[8];
+    _mm256_store_si256((__m256i*)low, y.n[0]);
+    fe8_get_b32(x, &p->x);
+    for (int lane = 0; lane < 8; lane++) {
+        out[lane][0] = (uint8_t)(0x02 | (low[lane] & 1));
+        memcpy(out[lane] + 1, x[lane], 32);
+    }
+}
+
+// Message words of `prefix || X` shifted by one byte: word i = X[i-1] << 24 | X[i] >> 8.
+static inline __m256i shifted_word(__m256i hi, __m256i lo) {
+    return _mm256_or_si256(_mm256_slli_epi32(hi, 24), _mm256_srli_epi32(lo, 8));
+}
+
+static inline void hash160_finish(__m256i state[8], uint8_t out[8][20]) {
+    __m256i h[5];
+    ripemd160_avx8_soa_hash_digest(h, state);
+    ripemd160_avx8_soa_store(h, out);
+}
+
+// SHA-256 blocks of both encodings, built from the coordinate words: 0x02|parity || X (one block) and
+// 0x04 || X || Y (two blocks).
+static void hash160_compressed_words(const __m256i X[8], const __m256i Y[8], uint8_t out[8][20]) {
+    __m256i w[16], state[8];
+    __m256i prefix = _mm256_or_si256(_mm256_set1_epi32(0x02), _mm256_and_si256(Y[7], _mm256_set1_epi32(1)));
+    w[0] = shifted_word(prefix, X[0]);
+    for (int i = 1; i < 8; i++) w[i] = shifted_word(X[i - 1], X[i]);
+    w[8] = _mm256_or_si256(_mm256_slli_epi32(X[7], 24), _mm256_set1_epi32(0x800000));
+    for (int i = 9; i < 15; i++) w[i] = _mm256_setzero_si256();
+    w[15] = _mm256_set1_epi32(33 * 8);
+    sha256_avx8_soa_init(state);
+    sha256_avx8_soa_transform(state, w);
+    hash160_finish(state, out);
+}
+
+static void hash160_uncompressed_words(const __m256i X[8], const __m256i Y[8], uint8_t out[8][20]) {
+    __m256i w[16], state[8];
+    w[0] = shifted_word(_mm256_set1_epi32(0x04), X[0]);
+    for (int i = 1; i < 8; i++) w[i] = shifted_word(X[i - 1], X[i]);
+    w[8] = shifted_word(X[7], Y[0]);
+    for (int i = 9; i < 16; i++) w[i] = shifted_word(Y[i - 9], Y[i - 8]);
+    sha256_avx8_soa_init(state);
+    sha256_avx8_soa_transform(state, w);
+    w[0] = _mm256_or_si256(_mm256_slli_epi32(Y[7], 24), _mm256_set1_epi32(0x800000));
+    for (int i = 1; i < 15; i++) w[i] = _mm256_setzero_si256();
+    w[15] = _mm256_set1_epi32(65 * 8);
+    sha256_avx8_soa_transform(state, w);
+    hash160_finish(state, out);
+}
+
+void ge8_hash160_compressed(const Ge8* p, uint8_t out[8][20]) {
+    __m256i X[8], Y[8];
+    fe8_to_words(X, &p->x);
+    fe8_to_words(Y, &p->y);
+    hash160_compressed_words(X, Y, out);
+}
+
+void ge8_hash160_uncompressed(const Ge8* p, uint8_t out[8][20]) {
+    __m256i X[8], Y[8];
+    fe8_to_words(X, &p->x);
+    fe8_to_words(Y, &p->y);
+    hash160_uncompressed_words(X, Y, out);
+}
+
+void ge8_hash160_both(const Ge8* p, uint8_t compressed[8][20], uint8_t uncompressed[8][20]) {
+    __m256i X[8], Y[8];
+    fe8_to_words(X, &p->x);
+    fe8_to_words(Y, &p->y);
+    hash160_compressed_words(X, Y, compressed);
+    hash160_uncompressed_words(X, Y, uncompressed);
+}
+
+size_t ge8_hash160_decompress_batch(const uint8_t (*keys)[33], size_t count, uint8_t (*compressed)[20],
+                                    uint8_t (*uncompressed)[20], uint8_t* valid) {
+    size_t total = 0;
+    for (size_t base = 0; base < count; base += 8) {
+        size_t cnt = count - base < 8 ? count - base : 8;
+        const uint8_t* ptrs[8];
+        for (size_t lane = 0; lane < 8; lane++) ptrs[lane] = keys[base + (lane < cnt ? lane : 0)];
+        Ge8 p;
+        uint8_t ok = ge8_set_compressed(&p, ptrs);
+        uint8_t comp[8][20], uncomp[8][20];
+        ge8_hash160_both(&p, comp, uncomp);
+        for (size_t lane = 0; lane < cnt; lane++) {
+            int lane_ok = (ok >> lane) & 1;
+            if (lane_ok) {
+                memcpy(compressed[base + lane], comp[lane], 20);
+                memcpy(uncompressed[base + lane], uncomp[lane], 20);
+            } else {
+                memset(compressed[base + lane], 0, 20);
+                memset(uncompressed[base + lane], 0, 20);
+            }
+            if (valid) valid[base + lane] = (uint8_t)lane_ok;
+            total += (size_t)lane_ok;
+        }
+    }
+    return total;
+}
+
+// --- Sequential keys ---
+
+static void ge8_broadcast(Ge8* r, const uint8_t x[32], const uint8_t y[32]) {
+    const uint8_t* xs[8] = {x, x, x, x, x, x, x, x};
+    const uint8_t* ys[8] = {y, y, y, y, y, y, y, y};
+    fe8_set_b32(&r->x, xs);
+    fe8_set_b32(&r->y, ys);
+}
+
+static void ge8_blend(Ge8* r, const Ge8* a, const Ge8* b, uint8_t lanes) {
+    __m256i m = lane_mask(lanes);
+    fe8_blend(&r->x, &a->x, &b->x, m);
+    fe8_blend(&r->y, &a->y, &b->y, m);
+}
+
+static void ge8_rotate_up(Ge8* r, const Ge8* a) {
+    const __m256i idx = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+    for (int k = 0; k < 10; k++) {
+        r->x.n[k] = _mm256_permutevar8x32_epi32(a->x.n[k], idx);
+        r->y.n[k] = _mm256_permutevar8x32_epi32(a->y.n[k], idx);
+    }
+}
+
+int ge8_walk_init(Ge8Walk* walk, const uint8_t start_pubkey[65], size_t groups) {
+    if (!walk || !start_pubkey || groups == 0) return -1;
+    memset(walk, 0, sizeof(*walk));
+    Ge8* table = (Ge8*)aligned_alloc(32, groups * sizeof(Ge8));
+    walk->points = (Ge8*)aligned_alloc(32, groups * sizeof(Ge8));
+    if (!table || !walk->points) {
+        free(table);
+        free(walk->points);
+        walk->points = NULL;
+        return -1;
+    }
+    walk->groups = groups;
+
+    // 1G..8G, each in every lane, then gathered into one group (lane j = (j+1)G).
+    Ge8 g, m, row;
+    uint8_t xs[8][32], ys[8][32], mx[8][32], my[8][32];
+    int rc = 0;
+    ge8_broadcast(&g, G_X, G_Y);
+    m = g;
+    for (int j = 0; j < 8; j++) {
+        if (j) rc |= ge8_add_affine_batch(&m, &m, &g, 1, true, NULL);
+        fe8_get_b32(mx, &m.x);
+        fe8_get_b32(my, &m.y);
+        memcpy(xs[j], mx[0], 32);
+        memcpy(ys[j], my[0], 32);
+    }
+    Ge8 g8;
+    ge8_broadcast(&g8, xs[7], ys[7]);
+    const uint8_t* px[8];
+    const uint8_t* py[8];
+    for (int j = 0; j < 8; j++) {
+        px[j] = xs[j];
+        py[j] = ys[j];
+    }
+    fe8_set_b32(&row.x, px);
+    fe8_set_b32(&row.y, py);
+
+    // table[g] lane j = (8g + j + 1)G; the last row also holds the step in lane 7.
+    table[0] = row;
+    for (size_t t = 1; t < groups; t++) rc |= ge8_add_affine_batch(&table[t], &table[t - 1], &g8, 1, true, NULL);
+
+    // Offsets (8g + j)G: rotate each row up one lane and take lane 0 from the previous row's lane 7.
+    // Lane 0 of the first group (offset 0) gets G as a placeholder and is replaced by the start point.
+    Ge8 start;
+    const uint8_t* sp[8] = {start_pubkey, start_pubkey, start_pubkey, start_pubkey, start_pubkey, start_pubkey, start_pubkey, start_pubkey};
+    ge8_set_uncompressed(&start, sp);
+    for (size_t t = 0; t < groups; t++) {
+        Ge8 offsets, prev;
+        ge8_rotate_up(&offsets, &table[t]);
+        if (t) ge8_rotate_up(&prev, &table[t - 1]);
+        else prev = g;
+        ge8_blend(&offsets, &offsets, &prev, 0x01);
+        walk->points[t] = offsets;
+    }
+    rc |= ge8_add_affine_batch(walk->points, walk->points, &start, groups, true, NULL);
+    ge8_blend(&walk->points[0], &walk->points[0], &start, 0x01);
+    if (rc != 0) {
+        free(table);
+        ge8_walk_free(walk);
+        return -1;
+    }
+
+    // Step: (8 * groups)G = lane 7 of table[groups - 1], in every lane.
+    fe8_get_b32(mx, &table[groups - 1].x);
+    fe8_get_b32(my, &table[groups - 1].y);
+    ge8_broadcast(&walk->step, mx[7], my[7]);
+    free(table);
+    return 0;
+}
+
+int ge8_walk_next(Ge8Walk* walk) {
+    if (!walk || !walk->points) return -1;
+    return ge8_add_affine_batch(walk->points, walk->points, &walk->step, walk->groups, true, NULL);
+}
+
+void ge8_walk_free(Ge8Walk* walk) {
+    if (!walk) return;
+    free(walk->points);
+    walk->points = NULL;
+    walk->groups = 0;
+}
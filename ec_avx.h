@@ -0,0 +1,184 @@
+/* ec_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef EC_AVX_H
+#define EC_AVX_H
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Compile-time check to ensure AVX2 is enabled
+#if !defined(__AVX2__)
+#error "This implementation requires AVX2 support. Please compile with -mavx2."
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 8-lane secp256k1 field and affine point arithmetic.
+//
+// An Fe8 holds 8 independent field elements mod p = 2^256 - 2^32 - 977 as 10 limbs of 26 bits
+// (limb 9: 22 bits), limb k of lane i in 32-bit element i of n[k] - the lane layout of the SHA-256
+// SoA state, so coordinates become SHA-256 message words with shifts only. Products are accumulated
+// in 64-bit halves (even/odd lanes) with _mm256_mul_epu32 and folded with 2^256 = 0x1000003D1 (mod p).
+//
+// Bounds ("weak" = what fe8_mul/fe8_sqr/fe8_reduce/fe8_set_b32 return: limbs < 2^26, limb 9 < 2^23):
+//   fe8_add/fe8_sub take weak operands; their results may be fed to fe8_mul/fe8_sqr (limbs < 2^28)
+//   but must go through fe8_reduce before another fe8_add/fe8_sub.
+// Not constant-time in the point functions (lanes are compared); intended for public-key enumeration.
+
+typedef struct {
+    __m256i n[10];
+} Fe8;
+
+typedef struct {
+    Fe8 x, y;
+} Ge8; // 8 affine points (never the point at infinity)
+
+/**
+* @brief Loads 8 big-endian 32-byte values (reduced mod p if they are >= p).
+*/
+void fe8_set_b32(Fe8* r, const uint8_t* const in[8]);
+
+/**
+* @brief Writes the fully reduced values as 8 big-endian 32-byte strings.
+*/
+void fe8_get_b32(uint8_t out[8][32], const Fe8* a);
+
+/** @brief Sets every lane to the same small integer. */
+void fe8_set_int(Fe8* r, uint32_t v);
+
+/** @brief r = a + b (no carry propagation). */
+void fe8_add(Fe8* r, const Fe8* a, const Fe8* b);
+
+/** @brief r = a - b, computed as a + 2p - b. */
+void fe8_sub(Fe8* r, const Fe8* a, const Fe8* b);
+
+/** @brief r = a * b mod p (weak result). r may alias a or b. */
+void fe8_mul(Fe8* r, const Fe8* a, const Fe8* b);
+
+/** @brief r = a^2 mod p (weak result), with the cross products doubled instead of computed twice. */
+void fe8_sqr(Fe8* r, const Fe8* a);
+
+/** @brief Carries and folds the bits above 2^256 back in (weak result). */
+void fe8_reduce(Fe8* r);
+
+/** @brief Fully reduces mod p (unique representation, < p). */
+void fe8_normalize(Fe8* r);
+
+/** @brief r = a^(p-2) = 1/a (0 for a = 0), the fixed addition chain of libsecp256k1. */
+void fe8_inv(Fe8* r, const Fe8* a);
+
+/**
+* @brief r = a^((p+1)/4), a square root of a when one exists (the same addition chain for all 8 lanes).
+* @return Lane mask (bit i for lane i) of the lanes where a is a square, i.e. r^2 == a.
+*/
+uint8_t fe8_sqrt(Fe8* r, const Fe8* a);
+
+/**
+* @brief Lane mask (bit i for lane i) of a == b (both are reduced internally, the inputs are unchanged).
+*/
+uint8_t fe8_equal(const Fe8* a, const Fe8* b);
+
+/**
+* @brief The fully reduced values as 8 big-endian 32-bit words per lane in SoA form (word 0 most
+* significant), i.e. the layout of a SHA-256 state in sha256_avx_soa.h.
+*/
+void fe8_to_words(__m256i words[8], const Fe8* a);
+
+/**
+* @brief Loads 8 points from 65-byte uncompressed encodings (0x04 || x || y); no curve check.
+*/
+void ge8_set_uncompressed(Ge8* r, const uint8_t* const pubkeys[8]);
+
+/**
+* @brief Decompresses 8 33-byte encodings (0x02/0x03 || x): y = sqrt(x^3 + 7) with the parity of the prefix.
+* @return Lane mask of the valid keys (known prefix, x < p, x on the curve); other lanes are unspecified.
+*/
+uint8_t ge8_set_compressed(Ge8* r, const uint8_t* const pubkeys[8]);
+
+/**
+* @brief Affine additions r[g] = a[g] + b[g] (or + b[0] for every g when b_shared) for count groups of
+* 8 lanes, with one field inversion for the whole call (Montgomery's batch-inversion trick).
+* Lanes where a == b are doubled. r may alias a or b.
+* @param infinity_masks Optional output, one byte per group: bit i set when the lane's result is the
+* point at infinity (a == -b); its coordinates are then unspecified.
+* @return 0 on success, -1 if scratch memory could not be allocated.
+*/
+int ge8_add_affine_batch(Ge8* r, const Ge8* a, const Ge8* b, size_t count, bool b_shared, uint8_t* infinity_masks);
+
+/**
+* @brief HASH160 of the 33-byte compressed encodings of 8 points, with the SHA-256 message words built
+* from the coordinate limbs in registers (no serialization).
+*/
+void ge8_hash160_compressed(const Ge8* p, uint8_t out[8][20]);
+
+/**
+* @brief HASH160 of the 65-byte uncompressed encodings (two SHA-256 blocks) of 8 points.
+*/
+void ge8_hash160_uncompressed(const Ge8* p, uint8_t out[8][20]);
+
+/**
+* @brief Writes the 33-byte compressed encodings of 8 points.
+*/
+void ge8_get_compressed(uint8_t out[8][33], const Ge8* p);
+
+/**
+* @brief HASH160 of both encodings of 8 points; the coordinates are converted to message words once.
+*/
+void ge8_hash160_both(const Ge8* p, uint8_t compressed[8][20], uint8_t uncompressed[8][20]);
+
+/**
+* @brief HASH160 of the compressed and the uncompressed encoding of count 33-byte keys, 8 at a time:
+* batch decompression, then both SHA-256 block layouts straight from the coordinates in registers.
+* The uncompressed key is never serialized.
+* @param valid Optional, one byte per key: 1 if it decoded, 0 if not (its digests are then zeroed).
+* @return The number of valid keys.
+*/
+size_t ge8_hash160_decompress_batch(const uint8_t (*keys)[33], size_t count, uint8_t (*compressed)[20],
+                                    uint8_t (*uncompressed)[20], uint8_t* valid);
+
+// Sequential public keys: `groups` groups of 8 lanes hold the points of keys k .. k + 8*groups - 1,
+// and each step adds (8*groups)*G to every lane with a single batched inversion.
+typedef struct {
+    size_t groups;
+    Ge8* points; // groups entries; lane i of group g is key k + 8g + i
+    Ge8 step;    // (8 * groups) * G in every lane
+} Ge8Walk;
+
+/**
+* @brief Sets up the walk from the point of key k (65-byte uncompressed, e.g. from secp256k1_ec_pubkey_create).
+* The multiples of G are computed with the 8-lane arithmetic. The range must not reach a multiple of the group order.
+* @return 0 on success, -1 on allocation failure or groups == 0.
+*/
+int ge8_walk_init(Ge8Walk* walk, const uint8_t start_pubkey[65], size_t groups);
+
+/** @brief Advances every lane by 8 * groups keys. */
+int ge8_walk_next(Ge8Walk* walk);
+
+/** @brief Frees the walk's points. */
+void ge8_walk_free(Ge8Walk* walk);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // EC_AVX_H
@@ -0,0 +1,447 @@
+/* ec_test.c
+ * gcc -O3 -mavx2 -march=native ec_test.c ec_avx.c sha256_avx.c ripemd160_avx.c -o ec_test -lsecp256k1 -lcrypto
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdalign.h>
+#include <secp256k1.h>
+#include <openssl/bn.h>
+#include <openssl/sha.h>
+#include <openssl/ripemd.h>
+
+#include "ec_avx.h"
+#include "sha256_avx.h"
+#include "ripemd160_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+static BIGNUM* P;
+static BIGNUM* N;
+static BN_CTX* bn_ctx;
+
+static void random_bytes(uint8_t* out, size_t len) {
+    for (size_t i = 0; i < len; i++) out[i] = (uint8_t)rand();
+}
+
+// Edge values mixed into the random field inputs: 0, 1, p - 1, p, p + 1 and 2^256 - 1.
+static void field_input(uint8_t out[32], int kind) {
+    BIGNUM* v = BN_new();
+    switch (kind) {
+    case 0: BN_zero(v); break;
+    case 1: BN_one(v); break;
+    case 2: BN_copy(v, P); BN_sub_word(v, 1); break;
+    case 3: BN_copy(v, P); break;
+    case 4: BN_copy(v, P); BN_add_word(v, 1); break;
+    case 5: BN_set_bit(v, 256); BN_sub_word(v, 1); break;
+    default: random_bytes(out, 32); BN_free(v); return;
+    }
+    BN_bn2binpad(v, out, 32);
+    BN_free(v);
+}
+
+typedef enum { OP_MUL, OP_SQR, OP_ADD, OP_SUB, OP_INV, OP_SQRT } FieldOp;
+
+static void field_ref(FieldOp op, const uint8_t a[32], const uint8_t b[32], uint8_t* out) {
+    BIGNUM* x = BN_bin2bn(a, 32, NULL);
+    BIGNUM* y = BN_bin2bn(b, 32, NULL);
+    BIGNUM* r = BN_new();
+    switch (op) {
+    case OP_MUL: BN_mod_mul(r, x, y, P, bn_ctx); break;
+    case OP_SQR: BN_mod_sqr(r, x, P, bn_ctx); break;
+    case OP_ADD: BN_mod_add(r, x, y, P, bn_ctx); break;
+    case OP_SUB: BN_mod_sub(r, x, y, P, bn_ctx); break;
+    case OP_INV:
+        BN_nnmod(x, x, P, bn_ctx);
+        if (BN_is_zero(x)) BN_zero(r);
+        else BN_mod_inverse(r, x, P, bn_ctx);
+        break;
+    case OP_SQRT: { // a^((p+1)/4); out[32] is 1 if that is a root
+        BIGNUM* e = BN_dup(P);
+        BIGNUM* sq = BN_new();
+        BN_add_word(e, 1);
+        BN_rshift(e, e, 2);
+        BN_nnmod(x, x, P, bn_ctx);
+        BN_mod_exp(r, x, e, P, bn_ctx);
+        BN_mod_sqr(sq, r, P, bn_ctx);
+        out[32] = BN_cmp(sq, x) == 0;
+        BN_free(e);
+        BN_free(sq);
+        break;
+    }
+    }
+    BN_bn2binpad(r, out, 32);
+    BN_free(x);
+    BN_free(y);
+    BN_free(r);
+}
+
+static int field_case(FieldOp op, int rounds) {
+    int bad = 0;
+    alignas(32) Fe8 a, b, r;
+    uint8_t in_a[8][32], in_b[8][32], out[8][32], ref[33];
+    uint8_t roots = 0;
+    const uint8_t* pa[8];
+    const uint8_t* pb[8];
+    for (int round = 0; round < rounds; round++) {
+        for (int lane = 0; lane < 8; lane++) {
+            field_input(in_a[lane], rand() % 12);
+            field_input(in_b[lane], rand() % 12);
+            pa[lane] = in_a[lane];
+            pb[lane] = in_b[lane];
+        }
+        fe8_set_b32(&a, pa);
+        fe8_set_b32(&b, pb);
+        switch (op) {
+        case OP_MUL: fe8_mul(&r, &a, &b); break;
+        case OP_SQR: fe8_sqr(&r, &a); break;
+        case OP_ADD: fe8_add(&r, &a, &b); fe8_reduce(&r); break;
+        case OP_SUB: fe8_sub(&r, &a, &b); fe8_reduce(&r); break;
+        case OP_INV: fe8_inv(&r, &a); break;
+        case OP_SQRT: roots = fe8_sqrt(&r, &a); break;
+        }
+        fe8_get_b32(out, &r);
+        for (int lane = 0; lane < 8; lane++) {
+            field_ref(op, in_a[lane], in_b[lane], ref);
+            if (memcmp(out[lane], ref, 32) != 0) bad++;
+            if (op == OP_SQRT && ((roots >> lane) & 1) != ref[32]) bad++;
+        }
+    }
+    return bad;
+}
+
+static void pubkey_of(const secp256k1_context* ctx, const uint8_t seckey[32], uint8_t out[65], uint8_t comp[33]) {
+    secp256k1_pubkey pk;
+    size_t len = 65;
+    secp256k1_ec_pubkey_create(ctx, &pk, seckey);
+    secp256k1_ec_pubkey_serialize(ctx, out, &len, &pk, SECP256K1_EC_UNCOMPRESSED);
+    if (comp) {
+        len = 33;
+        secp256k1_ec_pubkey_serialize(ctx, comp, &len, &pk, SECP256K1_EC_COMPRESSED);
+    }
+}
+
+// key + add (mod n) as 32 big-endian bytes.
+static void scalar_add(const uint8_t key[32], uint64_t add, uint8_t out[32]) {
+    BIGNUM* k = BN_bin2bn(key, 32, NULL);
+    BN_add_word(k, add);
+    BN_nnmod(k, k, N, bn_ctx);
+    BN_bn2binpad(k, out, 32);
+    BN_free(k);
+}
+
+int main() {
+    printf("--- Correctness Test (8-lane secp256k1 Field and Point Arithmetic) ---\n");
+    int failed_tests = 0;
+    srand(1);
+    bn_ctx = BN_CTX_new();
+    P = BN_new();
+    N = BN_new();
+    BN_hex2bn(&P, "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+    BN_hex2bn(&N, "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141");
+    secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+
+    failed_tests += report("fe8_mul matches BN_mod_mul (edge values included)", field_case(OP_MUL, 2000) == 0);
+    failed_tests += report("fe8_sqr matches BN_mod_sqr", field_case(OP_SQR, 2000) == 0);
+    failed_tests += report("fe8_add + fe8_reduce matches BN_mod_add", field_case(OP_ADD, 2000) == 0);
+    failed_tests += report("fe8_sub + fe8_reduce matches BN_mod_sub", field_case(OP_SUB, 2000) == 0);
+    failed_tests += report("fe8_inv matches BN_mod_inverse (0 maps to 0)", field_case(OP_INV, 100) == 0);
+    failed_tests += report("fe8_sqrt matches BN_mod_exp, square lanes flagged", field_case(OP_SQRT, 100) == 0);
+
+    // Long dependency chain of mixed operations, kept within the documented bounds.
+    {
+        alignas(32) Fe8 x, y, t;
+        uint8_t in_x[8][32], in_y[8][32], out[8][32], ref[32];
+        const uint8_t* px[8];
+        const uint8_t* py[8];
+        for (int lane = 0; lane < 8; lane++) {
+            random_bytes(in_x[lane], 32);
+            random_bytes(in_y[lane], 32);
+            px[lane] = in_x[lane];
+            py[lane] = in_y[lane];
+        }
+        fe8_set_b32(&x, px);
+        fe8_set_b32(&y, py);
+        int bad = 0;
+        for (int i = 0; i < 500; i++) {
+            fe8_sub(&t, &x, &y);    // x <- (x - y) * y + x^2
+            fe8_mul(&t, &t, &y);
+            fe8_sqr(&x, &x);
+            fe8_add(&x, &x, &t);
+            fe8_reduce(&x);
+            for (int lane = 0; lane < 8; lane++) {
+                uint8_t d[32], s[32];
+                field_ref(OP_SUB, in_x[lane], in_y[lane], d);
+                field_ref(OP_MUL, d, in_y[lane], d);
+                field_ref(OP_SQR, in_x[lane], in_x[lane], s);
+                field_ref(OP_ADD, s, d, in_x[lane]);
+            }
+        }
+        fe8_get_b32(out, &x);
+        for (int lane = 0; lane < 8; lane++) {
+            memcpy(ref, in_x[lane], 32);
+            if (memcmp(out[lane], ref, 32) != 0) bad++;
+        }
+        failed_tests += report("500-step mixed operation chain", bad == 0);
+    }
+
+    // Point additions against libsecp256k1, including doubling and P + (-P) lanes.
+    {
+        const size_t GROUPS = 64;
+        Ge8* a = (Ge8*)aligned_alloc(32, GROUPS * sizeof(Ge8));
+        Ge8* b = (Ge8*)aligned_alloc(32, GROUPS * sizeof(Ge8));
+        uint8_t (*ka)[32] = (uint8_t (*)[32])malloc(GROUPS * 8 * 32);
+        uint8_t (*kb)[32] = (uint8_t (*)[32])malloc(GROUPS * 8 * 32);
+        uint8_t (*pa)[65] = (uint8_t (*)[65])malloc(GROUPS * 8 * 65);
+        uint8_t (*pb)[65] = (uint8_t (*)[65])malloc(GROUPS * 8 * 65);
+        uint8_t masks[64];
+        for (size_t i = 0; i < GROUPS * 8; i++) {
+            random_bytes(ka[i], 32);
+            ka[i][0] &= 0x7f;
+            if (i % 17 == 3) memcpy(kb[i], ka[i], 32);  // doubling
+            else if (i % 29 == 5) {                    // b = -a
+                BIGNUM* k = BN_bin2bn(ka[i], 32, NULL);
+                BN_sub(k, N, k);
+                BN_bn2binpad(k, kb[i], 32);
+                BN_free(k);
+            } else {
+                random_bytes(kb[i], 32);
+                kb[i][0] &= 0x7f;
+            }
+            pubkey_of(ctx, ka[i], pa[i], NULL);
+            pubkey_of(ctx, kb[i], pb[i], NULL);
+        }
+        for (size_t g = 0; g < GROUPS; g++) {
+            const uint8_t* ptr_a[8];
+            const uint8_t* ptr_b[8];
+            for (int lane = 0; lane < 8; lane++) {
+                ptr_a[lane] = pa[g * 8 + (size_t)lane];
+                ptr_b[lane] = pb[g * 8 + (size_t)lane];
+            }
+            ge8_set_uncompressed(&a[g], ptr_a);
+            ge8_set_uncompressed(&b[g], ptr_b);
+        }
+        ge8_add_affine_batch(a, a, b, GROUPS, false, masks);
+        int bad = 0, inf_bad = 0;
+        for (size_t g = 0; g < GROUPS; g++) {
+            uint8_t comp[8][33];
+            ge8_get_compressed(comp, &a[g]);
+            for (int lane = 0; lane < 8; lane++) {
+                size_t i = g * 8 + (size_t)lane;
+                int is_inf = i % 17 != 3 && i % 29 == 5;
+                if (((masks[g] >> lane) & 1) != is_inf) inf_bad++;
+                if (is_inf) continue;
+                uint8_t sum[32], ref65[65], ref33[33];
+                BIGNUM* x = BN_bin2bn(ka[i], 32, NULL);
+                BIGNUM* y = BN_bin2bn(kb[i], 32, NULL);
+                BN_mod_add(x, x, y, N, bn_ctx);
+                BN_bn2binpad(x, sum, 32);
+                BN_free(x);
+                BN_free(y);
+                pubkey_of(ctx, sum, ref65, ref33);
+                if (memcmp(comp[lane], ref33, 33) != 0) bad++;
+            }
+        }
+        failed_tests += report("Batch affine add matches libsecp256k1 (64 groups)", bad == 0);
+        failed_tests += report("Doubling lanes handled, P + (-P) lanes flagged", inf_bad == 0);
+        free(a);
+        free(b);
+        free(ka);
+        free(kb);
+        free(pa);
+        free(pb);
+    }
+
+    // Sequential keys and the fused HASH160 against libsecp256k1 + OpenSSL.
+    {
+        uint8_t starts[2][32] = {{0}};
+        starts[0][31] = 1; // key 1: the first lanes are G, 2G, ... (doubling inside the setup)
+        random_bytes(starts[1], 32);
+        starts[1][0] &= 0x7f;
+        int key_bad = 0, hash_bad = 0;
+        for (int s = 0; s < 2; s++) {
+            uint8_t start_pub[65];
+            pubkey_of(ctx, starts[s], start_pub, NULL);
+            Ge8Walk walk;
+            const size_t GROUPS = 5;
+            ge8_walk_init(&walk, start_pub, GROUPS);
+            for (int step = 0; step < 3; step++) {
+                for (size_t g = 0; g < GROUPS; g++) {
+                    uint8_t comp[8][33], h_comp[8][20], h_uncomp[8][20];
+                    ge8_get_compressed(comp, &walk.points[g]);
+                    ge8_hash160_compressed(&walk.points[g], h_comp);
+                    ge8_hash160_uncompressed(&walk.points[g], h_uncomp);
+                    for (int lane = 0; lane < 8; lane++) {
+                        uint8_t key[32], ref65[65], ref33[33], sha[32], ref_h[20];
+                        scalar_add(starts[s], (uint64_t)step * GROUPS * 8 + g * 8 + (uint64_t)lane, key);
+                        pubkey_of(ctx, key, ref65, ref33);
+                        if (memcmp(comp[lane], ref33, 33) != 0) key_bad++;
+                        SHA256(ref33, 33, sha);
+                        RIPEMD160(sha, 32, ref_h);
+                        if (memcmp(h_comp[lane], ref_h, 20) != 0) hash_bad++;
+                        SHA256(ref65, 65, sha);
+                        RIPEMD160(sha, 32, ref_h);
+                        if (memcmp(h_uncomp[lane], ref_h, 20) != 0) hash_bad++;
+                    }
+                }
+                ge8_walk_next(&walk);
+            }
+            ge8_walk_free(&walk);
+        }
+        failed_tests += report("Sequential keys (from key 1 and a random key)", key_bad == 0);
+        failed_tests += report("HASH160 from limbs (compressed, uncompressed)", hash_bad == 0);
+    }
+
+    // Batch decompression: both HASH160 forms against libsecp256k1 parse/serialize + OpenSSL.
+    {
+        const size_t COUNT = 1003;
+        uint8_t (*keys)[33] = (uint8_t(*)[33])malloc(COUNT * 33);
+        uint8_t (*h_comp)[20] = (uint8_t(*)[20])malloc(COUNT * 20);
+        uint8_t (*h_uncomp)[20] = (uint8_t(*)[20])malloc(COUNT * 20);
+        uint8_t* valid = (uint8_t*)malloc(COUNT);
+        uint8_t seckey[32], pub65[65];
+        size_t expect_valid = 0;
+        for (size_t i = 0; i < COUNT; i++) {
+            do random_bytes(seckey, 32); while (!secp256k1_ec_seckey_verify(ctx, seckey));
+            pubkey_of(ctx, seckey, pub65, keys[i]);
+            switch (i % 50) {
+            case 7: keys[i][0] = 0x04; break;                     // not a compressed prefix
+            case 13: memset(keys[i] + 1, 0xff, 32); break;        // x >= p
+            case 21: field_input(keys[i] + 1, 3); break;          // x == p
+            case 29: keys[i][32] ^= 1; break;                      // usually off the curve
+            }
+            secp256k1_pubkey pk;
+            expect_valid += secp256k1_ec_pubkey_parse(ctx, &pk, keys[i], 33);
+        }
+        size_t got_valid = ge8_hash160_decompress_batch((const uint8_t(*)[33])keys, COUNT, h_comp, h_uncomp, valid);
+        int flag_bad = 0, hash_bad = 0;
+        for (size_t i = 0; i < COUNT; i++) {
+            secp256k1_pubkey pk;
+            int ok = secp256k1_ec_pubkey_parse(ctx, &pk, keys[i], 33);
+            if (valid[i] != ok) flag_bad++;
+            if (!ok) continue;
+            uint8_t ser[65], sha[32], ref_h[20];
+            size_t len = 65;
+            secp256k1_ec_pubkey_serialize(ctx, ser, &len, &pk, SECP256K1_EC_UNCOMPRESSED);
+            SHA256(ser, 65, sha);
+            RIPEMD160(sha, 32, ref_h);
+            if (memcmp(h_uncomp[i], ref_h, 20) != 0) hash_bad++;
+            SHA256(keys[i], 33, sha);
+            RIPEMD160(sha, 32, ref_h);
+            if (memcmp(h_comp[i], ref_h, 20) != 0) hash_bad++;
+        }
+        failed_tests += report("Decompression validity matches secp256k1_ec_pubkey_parse", flag_bad == 0 && got_valid == expect_valid);
+        failed_tests += report("Decompressed HASH160 (both forms) of 1003 keys", hash_bad == 0);
+        free(keys);
+        free(h_comp);
+        free(h_uncomp);
+        free(valid);
+    }
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (sequential keys -> compressed HASH160) ---\n");
+    uint8_t key[32] = {0}, pub65[65], pub33[33];
+    key[31] = 1;
+    const int LIB_KEYS = 100000;
+    clock_t start = clock();
+    for (int i = 0; i < LIB_KEYS; i += 8) {
+        uint8_t comps[8][33], sha[8][32], h[8][20];
+        const uint8_t* ptrs[8];
+        size_t lens[8];
+        for (int lane = 0; lane < 8; lane++) {
+            key[31] = (uint8_t)(i + lane + 1);
+            key[30] = (uint8_t)((i + lane + 1) >> 8);
+            key[29] = (uint8_t)((i + lane + 1) >> 16);
+            pubkey_of(ctx, key, pub65, comps[lane]);
+            ptrs[lane] = comps[lane];
+            lens[lane] = 32;
+        }
+        sha256_avx8_hash_short(ptrs, 33, sha);
+        for (int lane = 0; lane < 8; lane++) ptrs[lane] = sha[lane];
+        ripemd160_multi_hash_lanes(ptrs, lens, h);
+    }
+    double lib_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    (void)pub33;
+
+    key[29] = key[30] = 0;
+    key[31] = 1;
+    pubkey_of(ctx, key, pub65, NULL);
+    Ge8Walk walk;
+    const size_t WALK_GROUPS = 128;
+    const int STEPS = 200;
+    start = clock();
+    ge8_walk_init(&walk, pub65, WALK_GROUPS);
+    uint8_t h[8][20];
+    for (int step = 0; step < STEPS; step++) {
+        for (size_t g = 0; g < WALK_GROUPS; g++) ge8_hash160_compressed(&walk.points[g], h);
+        ge8_walk_next(&walk);
+    }
+    double walk_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    ge8_walk_free(&walk);
+    double walk_keys = (double)WALK_GROUPS * 8 * STEPS;
+
+    printf("secp256k1_ec_pubkey_create + serialize + 8-lane HASH160: %.0f Thousand keys/sec\n", LIB_KEYS / lib_time / 1e3);
+    printf("8-lane walk (%zu groups per inversion) + HASH160 from limbs: %.0f Thousand keys/sec (%.1fx)\n",
+           WALK_GROUPS, walk_keys / walk_time / 1e3, (walk_keys / walk_time) / (LIB_KEYS / lib_time));
+
+    // Compressed keys from chain data -> HASH160 of both encodings.
+    const size_t DEC_KEYS = 100000; // a multiple of 8
+    uint8_t (*dec_keys)[33] = (uint8_t(*)[33])malloc(DEC_KEYS * 33);
+    uint8_t (*dec_comp)[20] = (uint8_t(*)[20])malloc(DEC_KEYS * 20);
+    uint8_t (*dec_uncomp)[20] = (uint8_t(*)[20])malloc(DEC_KEYS * 20);
+    key[29] = key[30] = 0;
+    key[31] = 1;
+    pubkey_of(ctx, key, pub65, NULL);
+    ge8_walk_init(&walk, pub65, WALK_GROUPS);
+    for (size_t i = 0; i < DEC_KEYS; i += 8 * WALK_GROUPS) {
+        for (size_t g = 0; g < WALK_GROUPS && i + 8 * g < DEC_KEYS; g++) {
+            ge8_get_compressed((uint8_t(*)[33])dec_keys[i + 8 * g], &walk.points[g]);
+        }
+        ge8_walk_next(&walk);
+    }
+    ge8_walk_free(&walk);
+    start = clock();
+    for (size_t i = 0; i < DEC_KEYS; i += 8) {
+        uint8_t ser[8][65], sha[8][32];
+        const uint8_t* ptrs[8];
+        size_t lens[8];
+        for (int lane = 0; lane < 8; lane++) {
+            secp256k1_pubkey pk;
+            size_t len = 65;
+            secp256k1_ec_pubkey_parse(ctx, &pk, dec_keys[i + lane], 33);
+            secp256k1_ec_pubkey_serialize(ctx, ser[lane], &len, &pk, SECP256K1_EC_UNCOMPRESSED);
+            ptrs[lane] = dec_keys[i + lane];
+            lens[lane] = 65;
+        }
+        sha256_avx8_hash_short(ptrs, 33, sha);
+        for (int lane = 0; lane < 8; lane++) ptrs[lane] = ser[lane];
+        sha256_avx8_hash_lanes(NULL, 0, ptrs, lens, sha);
+    }
+    double parse_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    ge8_hash160_decompress_batch((const uint8_t(*)[33])dec_keys, DEC_KEYS, dec_comp, dec_uncomp, NULL);
+    double dec_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("pubkey_parse + serialize + SHA-256 of both forms: %.0f Thousand keys/sec\n", DEC_KEYS / parse_time / 1e3);
+    printf("8-lane decompression + HASH160 of both forms:      %.0f Thousand keys/sec (%.1fx)\n",
+           DEC_KEYS / dec_time / 1e3, parse_time / dec_time);
+    free(dec_keys);
+    free(dec_comp);
+    free(dec_uncomp);
+
+    secp256k1_context_destroy(ctx);
+    BN_free(P);
+    BN_free(N);
+    BN_CTX_free(bn_ctx);
+    return failed_tests == 0 ? 0 : 1;
+}
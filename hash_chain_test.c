@@ -0,0 +1,151 @@
+/* hash_chain_test.c
+ * gcc -O3 -mavx2 -march=native hash_chain_test.c sha256_avx.c ripemd160_avx.c -o hash_chain_test -lcrypto
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <openssl/sha.h>
+#include <openssl/ripemd.h>
+
+#include "sha256_avx.h"
+#include "ripemd160_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+static void sha256_chain_ref(const uint8_t seed[32], uint64_t n, uint8_t out[32]) {
+    memcpy(out, seed, 32);
+    for (uint64_t i = 0; i < n; i++) SHA256(out, 32, out);
+}
+
+static void ripemd160_chain_ref(const uint8_t seed[20], uint64_t n, uint8_t out[20]) {
+    uint8_t tmp[20];
+    memcpy(out, seed, 20);
+    for (uint64_t i = 0; i < n; i++) {
+        RIPEMD160(out, 20, tmp);
+        memcpy(out, tmp, 20);
+    }
+}
+
+int main() {
+    printf("--- Correctness Test (Iterated SHA-256 / RIPEMD-160 Chains) ---\n");
+    int failed_tests = 0;
+    srand(1);
+    uint8_t seeds[8][32];
+    const uint8_t* ptrs[8];
+    for (int lane = 0; lane < 8; lane++) {
+        for (int i = 0; i < 32; i++) seeds[lane][i] = (uint8_t)rand();
+        ptrs[lane] = seeds[lane];
+    }
+
+    const uint64_t count_sets[4][8] = {
+        {1, 1, 1, 1, 1, 1, 1, 1},
+        {1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000},
+        {0, 1, 2, 3, 500, 17, 999, 64},   // independent counts, including 0
+        {0, 0, 0, 0, 0, 0, 0, 0},
+    };
+    const char* names[4] = {"n = 1 in every lane", "n = 1000 in every lane", "Independent counts (0, 1, 2, 3, 500, ...)", "n = 0 copies the seed"};
+    for (int set = 0; set < 4; set++) {
+        uint8_t out[8][32], ref[32], out20[8][20], ref20[20];
+        sha256_avx8_iterate(ptrs, count_sets[set], out);
+        ripemd160_multi_iterate(ptrs, count_sets[set], out20);
+        int sha_bad = 0, rmd_bad = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            sha256_chain_ref(seeds[lane], count_sets[set][lane], ref);
+            ripemd160_chain_ref(seeds[lane], count_sets[set][lane], ref20);
+            if (memcmp(out[lane], ref, 32) != 0) sha_bad++;
+            if (memcmp(out20[lane], ref20, 20) != 0) rmd_bad++;
+        }
+        char label[96];
+        snprintf(label, sizeof(label), "SHA-256^n: %s", names[set]);
+        failed_tests += report(label, sha_bad == 0);
+        snprintf(label, sizeof(label), "RIPEMD-160^n: %s", names[set]);
+        failed_tests += report(label, rmd_bad == 0);
+    }
+
+    // Chains compose: iterating a, then b more times, equals iterating a + b.
+    {
+        const uint64_t a[8] = {5, 0, 9, 100, 1, 2, 3, 4}, b[8] = {7, 3, 0, 28, 1, 2, 3, 4};
+        uint64_t ab[8];
+        for (int lane = 0; lane < 8; lane++) ab[lane] = a[lane] + b[lane];
+        uint8_t mid[8][32], out[8][32], direct[8][32];
+        const uint8_t* mid_ptrs[8];
+        sha256_avx8_iterate(ptrs, a, mid);
+        for (int lane = 0; lane < 8; lane++) mid_ptrs[lane] = mid[lane];
+        sha256_avx8_iterate(mid_ptrs, b, out);
+        sha256_avx8_iterate(ptrs, ab, direct);
+        failed_tests += report("Chains compose: H^a then H^b equals H^(a+b)", memcmp(out, direct, sizeof(out)) == 0);
+    }
+
+    // Missing arguments are ignored by both lane APIs, leaving the output untouched.
+    {
+        const uint64_t counts[8] = {1, 1, 1, 1, 1, 1, 1, 1};
+        const size_t lens[8] = {32, 32, 32, 32, 32, 32, 32, 32};
+        uint8_t out[8][32], rmd[8][20];
+        memset(out, 0xAB, sizeof(out));
+        memset(rmd, 0xAB, sizeof(rmd));
+        sha256_avx8_iterate(NULL, counts, out);
+        sha256_avx8_iterate(ptrs, NULL, out);
+        sha256_avx8_hash_lanes(NULL, 0, NULL, lens, out);
+        ripemd160_multi_iterate(NULL, counts, rmd);
+        ripemd160_multi_iterate(ptrs, NULL, rmd);
+        ripemd160_multi_hash_lanes(NULL, lens, rmd);
+        ripemd160_multi_hash_lanes(ptrs, NULL, rmd);
+        int untouched = 1;
+        for (size_t i = 0; i < sizeof(out); i++) untouched &= ((uint8_t*)out)[i] == 0xAB;
+        for (size_t i = 0; i < sizeof(rmd); i++) untouched &= ((uint8_t*)rmd)[i] == 0xAB;
+        failed_tests += report("NULL arguments are ignored by the lane APIs", untouched);
+    }
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (8 lanes x 1M iterations) ---\n");
+    const uint64_t N = 1000000;
+    const uint64_t counts[8] = {N, N, N, N, N, N, N, N};
+    uint8_t out[8][32], cur[8][32];
+    const uint8_t* cur_ptrs[8];
+
+    clock_t start = clock();
+    sha256_avx8_iterate(ptrs, counts, out);
+    double iter_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // The same chain through the one-shot API: store, re-pad and reload every step.
+    memcpy(cur, seeds, sizeof(cur));
+    for (int lane = 0; lane < 8; lane++) cur_ptrs[lane] = cur[lane];
+    start = clock();
+    for (uint64_t i = 0; i < N; i++) sha256_avx8_hash_short(cur_ptrs, 32, cur);
+    double short_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    uint8_t out20[8][20];
+    start = clock();
+    ripemd160_multi_iterate(ptrs, counts, out20);
+    double rmd_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    uint8_t rmd_cur[8][20];
+    const uint8_t* rmd_ptrs[8];
+    size_t lens[8];
+    for (int lane = 0; lane < 8; lane++) {
+        memcpy(rmd_cur[lane], seeds[lane], 20);
+        rmd_ptrs[lane] = rmd_cur[lane];
+        lens[lane] = 20;
+    }
+    start = clock();
+    for (uint64_t i = 0; i < N; i++) ripemd160_multi_hash_lanes(rmd_ptrs, lens, rmd_cur);
+    double rmd_lanes_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("sha256_avx8_iterate:      %.4f seconds (%.1f Million steps/sec)\n", iter_time, N * 8.0 / iter_time / 1e6);
+    printf("sha256_avx8_hash_short:   %.4f seconds (%.1f Million steps/sec, %.2fx slower)\n", short_time, N * 8.0 / short_time / 1e6, short_time / iter_time);
+    printf("ripemd160_multi_iterate:  %.4f seconds (%.1f Million steps/sec)\n", rmd_time, N * 8.0 / rmd_time / 1e6);
+    printf("ripemd160_multi_hash_lanes: %.4f seconds (%.1f Million steps/sec, %.2fx slower)\n", rmd_lanes_time, N * 8.0 / rmd_lanes_time / 1e6, rmd_lanes_time / rmd_time);
+    printf("One-shot loops agree with the iterated results: %s\n", memcmp(out, cur, sizeof(cur)) == 0 && memcmp(out20, rmd_cur, sizeof(out20)) == 0 ? "yes" : "NO");
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+/* hash_drbg_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#include "hash_drbg_avx.h"
+#include "sha256_avx.h"
+#include "sha256_avx_soa.h"
+
+#include <immintrin.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Rounds of a Hashgen block that only depend on its first 12 words (bytes 0..47 of V + i).
+#define HEAD_ROUNDS 12
+
+typedef struct {
+    const uint8_t* data;
+    size_t len;
+} Piece;
+
+// Adds a big-endian number into acc, modulo 2^(8 * acc_len).
+static void add_be(uint8_t* acc, size_t acc_len, const uint8_t* x, size_t x_len) {
+    unsigned carry = 0;
+    for (size_t i = 0; i < acc_len; i++) {
+        unsigned sum = acc[acc_len - 1 - i] + carry + (i < x_len ? x[x_len - 1 - i] : 0);
+        acc[acc_len - 1 - i] = (uint8_t)sum;
+        carry = sum >> 8;
+    }
+}
+
+static void add_u64_be(uint8_t* acc, size_t acc_len, uint64_t v) {
+    uint8_t x[8];
+    for (int i = 0; i < 8; i++) x[i] = (uint8_t)(v >> (56 - 8 * i));
+    add_be(acc, acc_len, x, 8);
+}
+
+// Concatenates the pieces after `head` reserved bytes.
+static uint8_t* join(const Piece* pieces, int n, size_t head, size_t* len) {
+    size_t total = head;
+    for (int i = 0; i < n; i++) total += pieces[i].len;
+    uint8_t* buf = malloc(total);
+    if (!buf) return NULL;
+    uint8_t* p = buf + head;
+    for (int i = 0; i < n; i++) {
+        if (pieces[i].len) memcpy(p, pieces[i].data, pieces[i].len);
+        p += pieces[i].len;
+    }
+    *len = total;
+    return buf;
+}
+
+// SHA-256 of the concatenated pieces (scalar: one message).
+static int hash_pieces(const Piece* pieces, int n, uint8_t out[32]) {
+    size_t len;
+    uint8_t* msg = join(pieces, n, 0, &len);
+    if (!msg) return -1;
+    sha256_hash_single(msg, len, out);
+    free(msg);
+    return 0;
+}
+
+// Hash_df(input, 440): SHA256(1 || 440 || input) || SHA256(2 || 440 || input), truncated.
+static int hash_df(const Piece* pieces, int n, uint8_t out[HASH_DRBG_SEED_LEN]) {
+    size_t len;
+    uint8_t* msg = join(pieces, n, 5, &len);
+    if (!msg) return -1;
+    static const uint8_t bits[4] = {0x00, 0x00, 0x01, 0xB8}; // 440
+    uint8_t second[32];
+    memcpy(msg + 1, bits, 4);
+    msg[0] = 1;
+    sha256_hash_single(msg, len, out);
+    msg[0] = 2;
+    sha256_hash_single(msg, len, second);
+    memcpy(out + 32, second, HASH_DRBG_SEED_LEN - 32);
+    free(msg);
+    return 0;
+}
+
+// V and C from freshly derived seed material (instantiate and reseed).
+static int derive_state(HashDrbg* drbg, const Piece* seed_material, int n) {
+    uint8_t v[HASH_DRBG_SEED_LEN];
+    if (hash_df(seed_material, n, v) != 0) return -1;
+    static const uint8_t zero = 0x00;
+    Piece c_input[2] = {{&zero, 1}, {v, sizeof(v)}};
+    if (hash_df(c_input, 2, drbg->C) != 0) return -1;
+    memcpy(drbg->V, v, sizeof(v));
+    drbg->reseed_counter = 1;
+    return 0;
+}
+
+static inline uint32_t load_be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+// Broadcasts the first 12 words of the block of `data` and runs the rounds that only depend on them.
+static void hashgen_head(const uint8_t data[HASH_DRBG_SEED_LEN], __m256i w[16], __m256i working[8]) {
+    __m256i iv[8];
+    sha256_avx8_soa_init(iv);
+    for (int i = 0; i < HEAD_ROUNDS; i++) w[i] = _mm256_set1_epi32((int)load_be32(data + 4 * i));
+    w[14] = _mm256_setzero_si256();
+    w[15] = _mm256_set1_epi32(HASH_DRBG_SEED_LEN * 8);
+    sha256_avx8_soa_rounds_head(working, iv, w, HEAD_ROUNDS);
+}
+
+// Copies up to 8 digests to out; a full batch goes out with non-temporal stores when nt is set.
+static void emit(uint8_t digests[8][32], uint8_t* out, size_t len, int nt) {
+    if (nt && len == 256) {
+        for (int lane = 0; lane < 8; lane++) {
+            _mm256_stream_si256((__m256i*)(out + 32 * lane), _mm256_load_si256((const __m256i*)digests[lane]));
+        }
+    } else {
+        memcpy(out, digests, len);
+    }
+}
+
+// Hashgen: out = SHA256(V) || SHA256(V + 1) || ..., 8 values per compression. Lane i of a batch differs
+// from the batch base only in the low 56 bits (the last two block words), unless adding i carries past
+// them; such a batch is hashed from full blocks, and the shared head is rebuilt after it.
+static void hashgen(const uint8_t V[HASH_DRBG_SEED_LEN], uint8_t* out, size_t len, int nt) {
+    uint8_t data[HASH_DRBG_SEED_LEN];
+    memcpy(data, V, sizeof(data));
+    alignas(32) uint8_t digests[8][32];
+    __m256i w[16], working[8], state[8];
+    hashgen_head(data, w, working);
+
+    for (size_t pos = 0; pos < len; pos += 256) {
+        uint64_t low = 0;
+        for (int i = 48; i < HASH_DRBG_SEED_LEN; i++) low = (low << 8) | data[i];
+        sha256_avx8_soa_init(state);
+        if (low + 7 < (1ull << 56)) {
+            alignas(32) uint32_t w12[8], w13[8];
+            for (int lane = 0; lane < 8; lane++) {
+                uint64_t v = low + (uint64_t)lane;
+                w12[lane] = (uint32_t)(v >> 24);
+                w13[lane] = (uint32_t)(v << 8) | 0x80;
+            }
+            w[12] = _mm256_load_si256((const __m256i*)w12);
+            w[13] = _mm256_load_si256((const __m256i*)w13);
+            sha256_avx8_soa_transform_from(state, working, w, HEAD_ROUNDS);
+        } else {
+            uint8_t blocks[8][64];
+            const uint8_t* ptrs[8];
+            __m256i full[16];
+            for (int lane = 0; lane < 8; lane++) {
+                memset(blocks[lane], 0, 64);
+                memcpy(blocks[lane], data, HASH_DRBG_SEED_LEN);
+                add_u64_be(blocks[lane], HASH_DRBG_SEED_LEN, (uint64_t)lane);
+                blocks[lane][HASH_DRBG_SEED_LEN] = 0x80;
+                blocks[lane][62] = (HASH_DRBG_SEED_LEN * 8) >> 8;
+                blocks[lane][63] = (uint8_t)(HASH_DRBG_SEED_LEN * 8);
+                ptrs[lane] = blocks[lane];
+            }
+            sha256_avx8_soa_load(full, ptrs);
+            sha256_avx8_soa_transform(state, full);
+        }
+        sha256_avx8_soa_store(state, digests);
+        emit(digests, out + pos, len - pos < 256 ? len - pos : 256, nt);
+
+        add_u64_be(data, HASH_DRBG_SEED_LEN, 8);
+        if (low + 8 >= (1ull << 56)) hashgen_head(data, w, working);
+    }
+}
+
+int hash_drbg_instantiate(HashDrbg* drbg, const uint8_t* entropy, size_t entropy_len, const uint8_t* nonce, size_t nonce_len,
+                          const uint8_t* personalization, size_t personalization_len) {
+    if (!drbg || !entropy || entropy_len < HASH_DRBG_MIN_ENTROPY) return -1;
+    if ((nonce_len && !nonce) || (personalization_len && !personalization)) return -1;
+    Piece seed[3] = {{entropy, entropy_len}, {nonce, nonce_len}, {personalization, personalization_len}};
+    if (derive_state(drbg, seed, 3) != 0) return -1;
+    drbg->reseed_interval = HASH_DRBG_DEFAULT_RESEED_INTERVAL;
+    drbg->entropy = NULL;
+    drbg->entropy_ctx = NULL;
+    return 0;
+}
+
+void hash_drbg_set_reseed(HashDrbg* drbg, uint64_t interval, HashDrbgEntropyFn entropy, void* entropy_ctx) {
+    if (!drbg) return;
+    if (interval == 0) interval = 1;
+    drbg->reseed_interval = interval < HASH_DRBG_MAX_RESEED_INTERVAL ? interval : HASH_DRBG_MAX_RESEED_INTERVAL;
+    drbg->entropy = entropy;
+    drbg->entropy_ctx = entropy_ctx;
+}
+
+int hash_drbg_reseed(HashDrbg* drbg, const uint8_t* entropy, size_t entropy_len, const uint8_t* additional, size_t additional_len) {
+    if (!drbg || !entropy || entropy_len < HASH_DRBG_MIN_ENTROPY || (additional_len && !additional)) return -1;
+    static const uint8_t one = 0x01;
+    uint8_t v[HASH_DRBG_SEED_LEN];
+    memcpy(v, drbg->V, sizeof(v));
+    Piece seed[4] = {{&one, 1}, {v, sizeof(v)}, {entropy, entropy_len}, {additional, additional_len}};
+    return derive_state(drbg, seed, 4);
+}
+
+// Generate with the output written non-temporally or not.
+static int generate(HashDrbg* drbg, uint8_t* out, size_t len, const uint8_t* additional, size_t additional_len, int nt) {
+    if (!drbg || (len && !out) || len > HASH_DRBG_MAX_REQUEST || (additional_len && !additional)) return -1;
+    if (drbg->reseed_counter > drbg->reseed_interval) {
+        uint8_t entropy[HASH_DRBG_MIN_ENTROPY];
+        if (!drbg->entropy || drbg->entropy(drbg->entropy_ctx, entropy, sizeof(entropy)) != 0) return 1;
+        int rc = hash_drbg_reseed(drbg, entropy, sizeof(entropy), additional, additional_len);
+        explicit_bzero(entropy, sizeof(entropy));
+        if (rc != 0) return 1;
+        additional_len = 0; // consumed by the reseed
+    }
+    if (additional_len) {
+        static const uint8_t two = 0x02;
+        uint8_t w[32];
+        Piece input[3] = {{&two, 1}, {drbg->V, HASH_DRBG_SEED_LEN}, {additional, additional_len}};
+        if (hash_pieces(input, 3, w) != 0) return -1;
+        add_be(drbg->V, HASH_DRBG_SEED_LEN, w, sizeof(w));
+    }
+    if (len) hashgen(drbg->V, out, len, nt);
+
+    static const uint8_t three = 0x03;
+    uint8_t h[32];
+    Piece input[2] = {{&three, 1}, {drbg->V, HASH_DRBG_SEED_LEN}};
+    if (hash_pieces(input, 2, h) != 0) return -1;
+    add_be(drbg->V, HASH_DRBG_SEED_LEN, h, sizeof(h));
+    add_be(drbg->V, HASH_DRBG_SEED_LEN, drbg->C, HASH_DRBG_SEED_LEN);
+    add_u64_be(drbg->V, HASH_DRBG_SEED_LEN, drbg->reseed_counter);
+    drbg->reseed_counter++;
+    return 0;
+}
+
+int hash_drbg_generate(HashDrbg* drbg, uint8_t* out, size_t len, const uint8_t* additional, size_t additional_len) {
+    return generate(drbg, out, len, additional, additional_len, 0);
+}
+
+int hash_drbg_fill(HashDrbg* drbg, uint8_t* out, size_t len) {
+    if (!drbg || (len && !out)) return -1;
+    int nt = len >= HASH_DRBG_NT_THRESHOLD && ((uintptr_t)out & 31) == 0;
+    int rc = 0;
+    for (size_t pos = 0; pos < len && rc == 0; pos += HASH_DRBG_MAX_REQUEST) {
+        size_t n = len - pos < HASH_DRBG_MAX_REQUEST ? len - pos : HASH_DRBG_MAX_REQUEST;
+        rc = generate(drbg, out + pos, n, NULL, 0, nt);
+    }
+    if (nt) _mm_sfence();
+    return rc;
+}
+
+void hash_drbg_uninstantiate(HashDrbg* drbg) {
+    if (drbg) explicit_bzero(drbg, sizeof(*drbg));
+}
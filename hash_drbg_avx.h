@@ -0,0 +1,104 @@
+/* hash_drbg_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef HASH_DRBG_AVX_H
+#define HASH_DRBG_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Compile-time check to ensure AVX2 is enabled
+#if !defined(__AVX2__)
+#error "This implementation requires AVX2 support. Please compile with -mavx2."
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// SP 800-90A Hash_DRBG with SHA-256 (security strength 256, seedlen 440 bits), for bulk deterministic
+// test data and nonces. The output stream Hash(V) || Hash(V + 1) || ... is produced 8 counter values per
+// compression call. V + i is a single block that differs between consecutive values only in its last two
+// words, so the first 12 rounds of the block are run once per request and every lane resumes from that
+// midstate (sha256_avx8_soa_transform_from).
+
+#define HASH_DRBG_SEED_LEN 55                              // seedlen / 8
+#define HASH_DRBG_MIN_ENTROPY 32                           // bytes of entropy input, at least
+#define HASH_DRBG_MAX_REQUEST 65536                        // bytes per generate request (2^19 bits)
+#define HASH_DRBG_DEFAULT_RESEED_INTERVAL (1ull << 20)     // generate requests between reseeds
+#define HASH_DRBG_MAX_RESEED_INTERVAL (1ull << 48)
+#define HASH_DRBG_NT_THRESHOLD (1u << 20)                  // hash_drbg_fill streams past the cache from here on
+
+// Supplies fresh entropy for an automatic reseed; returns 0 on success.
+typedef int (*HashDrbgEntropyFn)(void* ctx, uint8_t* buf, size_t len);
+
+typedef struct {
+    uint8_t V[HASH_DRBG_SEED_LEN];
+    uint8_t C[HASH_DRBG_SEED_LEN];
+    uint64_t reseed_counter;
+    uint64_t reseed_interval;
+    HashDrbgEntropyFn entropy;   // NULL: generate reports that a reseed is required instead
+    void* entropy_ctx;
+} HashDrbg;
+
+/**
+* @brief Instantiates the DRBG from entropy || nonce || personalization (any of the latter two may be empty).
+* The reseed interval is HASH_DRBG_DEFAULT_RESEED_INTERVAL, without an entropy source.
+* @return 0 on success, -1 on invalid arguments (less than HASH_DRBG_MIN_ENTROPY bytes of entropy) or allocation failure.
+*/
+int hash_drbg_instantiate(HashDrbg* drbg, const uint8_t* entropy, size_t entropy_len, const uint8_t* nonce, size_t nonce_len,
+                          const uint8_t* personalization, size_t personalization_len);
+
+/**
+* @brief Sets the reseed schedule: after `interval` generate requests (at most HASH_DRBG_MAX_RESEED_INTERVAL)
+* the DRBG reseeds itself with HASH_DRBG_MIN_ENTROPY bytes from `entropy`, or, when it is NULL, refuses
+* to generate until hash_drbg_reseed is called.
+*/
+void hash_drbg_set_reseed(HashDrbg* drbg, uint64_t interval, HashDrbgEntropyFn entropy, void* entropy_ctx);
+
+/**
+* @brief Reseeds from entropy || additional input.
+* @return 0 on success, -1 on invalid arguments or allocation failure.
+*/
+int hash_drbg_reseed(HashDrbg* drbg, const uint8_t* entropy, size_t entropy_len, const uint8_t* additional, size_t additional_len);
+
+/**
+* @brief One generate request of up to HASH_DRBG_MAX_REQUEST bytes.
+* @param additional Optional additional input (NULL/0 for none).
+* @return 0 on success, 1 if a reseed is required (or the entropy source failed), -1 on invalid arguments.
+*/
+int hash_drbg_generate(HashDrbg* drbg, uint8_t* out, size_t len, const uint8_t* additional, size_t additional_len);
+
+/**
+* @brief Fills a buffer of any size with consecutive generate requests of HASH_DRBG_MAX_REQUEST bytes,
+* reseeding on the schedule. From HASH_DRBG_NT_THRESHOLD bytes on, and when out is 32-byte aligned,
+* the output is written with non-temporal stores so that it does not evict the working set.
+* @return 0 on success, otherwise the failing hash_drbg_generate status (the buffer is then partly filled).
+*/
+int hash_drbg_fill(HashDrbg* drbg, uint8_t* out, size_t len);
+
+/**
+* @brief Clears the internal state.
+*/
+void hash_drbg_uninstantiate(HashDrbg* drbg);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // HASH_DRBG_AVX_H
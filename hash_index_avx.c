@@ -0,0 +1,628 @@
+/* hash_index_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "hash_index_avx.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define HASH_INDEX_MAGIC "HIDX0001"
+#define HASH_INDEX_HEADER_SIZE 64
+#define HASH_INDEX_OFFSET_BYTES 5               // payload offsets are 40-bit
+#define HASH_INDEX_MAX_FANOUT_BITS 17           // at most 1 MiB of fanout table
+#define HASH_INDEX_MIN_MEMORY ((size_t)1 << 20)
+#define HASH_INDEX_WRITE_BUFFER ((size_t)1 << 16)
+
+// --- Little helpers ---
+
+static inline uint64_t load_be64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return __builtin_bswap64(v);
+}
+
+static inline uint64_t load_le64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline void store_le64(uint8_t* p, uint64_t v) { memcpy(p, &v, 8); }
+
+static size_t put_leb128(uint8_t* out, uint64_t v) {
+    size_t n = 0;
+    do {
+        uint8_t byte = v & 0x7f;
+        v >>= 7;
+        out[n++] = byte | (v ? 0x80 : 0);
+    } while (v);
+    return n;
+}
+
+// Returns the number of bytes read, or 0 if the value is truncated or longer than 10 bytes.
+static size_t get_leb128(const uint8_t* in, size_t avail, uint64_t* v) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < avail && i < 10; i++) {
+        result |= (uint64_t)(in[i] & 0x7f) << (7 * i);
+        if (!(in[i] & 0x80)) {
+            *v = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+static int write_all(int fd, const void* data, size_t len, uint64_t offset) {
+    const uint8_t* p = (const uint8_t*)data;
+    while (len) {
+        ssize_t n = pwrite(fd, p, len, (off_t)offset);
+        if (n <= 0) return -1;
+        p += n;
+        len -= (size_t)n;
+        offset += (uint64_t)n;
+    }
+    return 0;
+}
+
+// --- Builder ---
+//
+// Temporary record format: key || LEB128 payload length || payload.
+
+struct HashIndexBuilder {
+    char* path;
+    uint32_t key_len;
+    size_t memory_limit;
+    uint8_t* buffer;
+    size_t buffer_len;
+    FILE* spill[256]; // partitions by the first key byte, created on the first spill
+    bool spilled;
+    uint64_t count;
+    uint64_t payload_bytes; // size of the payload section
+    int error;
+};
+
+// Anonymous temporary file next to the output (unlinked at once, so it never outlives the process).
+static FILE* create_temp_file(const char* path) {
+    size_t len = strlen(path) + 16;
+    char* name = (char*)malloc(len);
+    if (!name) return NULL;
+    snprintf(name, len, "%s.tmpXXXXXX", path);
+    int fd = mkstemp(name);
+    if (fd < 0) {
+        free(name);
+        return NULL;
+    }
+    unlink(name);
+    free(name);
+    FILE* f = fdopen(fd, "w+b");
+    if (!f) close(fd);
+    return f;
+}
+
+HashIndexBuilder* hash_index_builder_create(const char* path, uint32_t key_len, size_t memory_limit) {
+    if (!path || key_len < 8 || key_len > HASH_INDEX_MAX_KEY_LEN) return NULL;
+    HashIndexBuilder* b = (HashIndexBuilder*)calloc(1, sizeof(HashIndexBuilder));
+    if (!b) return NULL;
+    b->path = strdup(path);
+    b->key_len = key_len;
+    b->memory_limit = memory_limit < HASH_INDEX_MIN_MEMORY ? HASH_INDEX_MIN_MEMORY : memory_limit;
+    b->buffer = (uint8_t*)malloc(b->memory_limit);
+    if (!b->path || !b->buffer) {
+        free(b->path);
+        free(b->buffer);
+        free(b);
+        return NULL;
+    }
+    return b;
+}
+
+static size_t record_size(const uint8_t* rec, size_t avail, uint32_t key_len) {
+    uint64_t payload_len;
+    if (avail < key_len) return 0;
+    size_t n = get_leb128(rec + key_len, avail - key_len, &payload_len);
+    if (!n || payload_len > avail - key_len - n) return 0;
+    return key_len + n + (size_t)payload_len;
+}
+
+// Appends every buffered record to the partition of its first key byte.
+static int spill_buffer(HashIndexBuilder* b) {
+    if (!b->spilled) {
+        for (int i = 0; i < 256; i++) {
+            b->spill[i] = create_temp_file(b->path);
+            if (!b->spill[i]) return -1;
+        }
+        b->spilled = true;
+    }
+    size_t pos = 0;
+    while (pos < b->buffer_len) {
+        size_t n = record_size(b->buffer + pos, b->buffer_len - pos, b->key_len);
+        if (fwrite(b->buffer + pos, 1, n, b->spill[b->buffer[pos]]) != n) return -1;
+        pos += n;
+    }
+    b->buffer_len = 0;
+    return 0;
+}
+
+int hash_index_builder_add(HashIndexBuilder* b, const uint8_t* key, const uint8_t* payload, size_t payload_len) {
+    if (!b || !key || (payload_len && !payload)) return -1;
+    if (b->error) return -1;
+    uint8_t header[10];
+    size_t header_len = put_leb128(header, payload_len);
+    size_t rec_len = b->key_len + header_len + payload_len;
+
+    if (b->buffer_len + rec_len > b->memory_limit) {
+        if (spill_buffer(b) != 0) goto fail;
+        if (rec_len > b->memory_limit) { // oversized record: straight to its partition
+            FILE* f = b->spill[key[0]];
+            if (fwrite(key, 1, b->key_len, f) != b->key_len || fwrite(header, 1, header_len, f) != header_len ||
+                fwrite(payload, 1, payload_len, f) != payload_len) goto fail;
+            goto counted;
+        }
+    }
+    memcpy(b->buffer + b->buffer_len, key, b->key_len);
+    memcpy(b->buffer + b->buffer_len + b->key_len, header, header_len);
+    if (payload_len) memcpy(b->buffer + b->buffer_len + b->key_len + header_len, payload, payload_len);
+    b->buffer_len += rec_len;
+counted:
+    b->count++;
+    b->payload_bytes += header_len + payload_len;
+    return 0;
+fail:
+    b->error = 1;
+    return -1;
+}
+
+// Output state: entries and payloads are written through two buffers at their own file offsets.
+typedef struct {
+    int fd;
+    uint32_t key_len;
+    uint32_t fanout_bits;
+    uint64_t* fanout;
+    uint64_t entry_offset;
+    uint64_t payload_offset;
+    uint64_t payload_rel;
+    uint8_t* entry_buf;
+    size_t entry_len;
+    uint8_t* payload_buf;
+    size_t payload_len;
+} IndexWriter;
+
+static int flush_writer(IndexWriter* w) {
+    if (w->entry_len && write_all(w->fd, w->entry_buf, w->entry_len, w->entry_offset) != 0) return -1;
+    w->entry_offset += w->entry_len;
+    w->entry_len = 0;
+    if (w->payload_len && write_all(w->fd, w->payload_buf, w->payload_len, w->payload_offset) != 0) return -1;
+    w->payload_offset += w->payload_len;
+    w->payload_len = 0;
+    return 0;
+}
+
+static int emit_record(IndexWriter* w, const uint8_t* rec, size_t rec_len) {
+    size_t entry_size = w->key_len + HASH_INDEX_OFFSET_BYTES;
+    size_t payload_part = rec_len - w->key_len;
+    if (w->entry_len + entry_size > HASH_INDEX_WRITE_BUFFER || w->payload_len + payload_part > HASH_INDEX_WRITE_BUFFER) {
+        if (flush_writer(w) != 0) return -1;
+    }
+    if (w->payload_rel >> (8 * HASH_INDEX_OFFSET_BYTES)) return -1; // payload section beyond 1 TiB
+
+    uint8_t* e = w->entry_buf + w->entry_len;
+    memcpy(e, rec, w->key_len);
+    for (int i = 0; i < HASH_INDEX_OFFSET_BYTES; i++) e[w->key_len + i] = (uint8_t)(w->payload_rel >> (8 * i));
+    w->entry_len += entry_size;
+
+    if (payload_part > HASH_INDEX_WRITE_BUFFER) {
+        if (write_all(w->fd, rec + w->key_len, payload_part, w->payload_offset) != 0) return -1;
+        w->payload_offset += payload_part;
+    } else {
+        memcpy(w->payload_buf + w->payload_len, rec + w->key_len, payload_part);
+        w->payload_len += payload_part;
+    }
+    w->payload_rel += payload_part;
+
+    uint64_t prefix = w->fanout_bits ? load_be64(rec) >> (64 - w->fanout_bits) : 0;
+    w->fanout[prefix + 1]++;
+    return 0;
+}
+
+static _Thread_local uint32_t sort_key_len;
+
+typedef struct {
+    uint64_t prefix;
+    const uint8_t* rec;
+    size_t len;
+} SortItem;
+
+static int compare_items(const void* a, const void* b) {
+    const SortItem* x = (const SortItem*)a;
+    const SortItem* y = (const SortItem*)b;
+    if (x->prefix != y->prefix) return x->prefix < y->prefix ? -1 : 1;
+    return memcmp(x->rec + 8, y->rec + 8, sort_key_len - 8);
+}
+
+// Sorts the records of a memory-sized partition and emits them.
+static int sort_and_emit(IndexWriter* w, const uint8_t* data, size_t len) {
+    size_t n = 0;
+    for (size_t pos = 0; pos < len; n++) {
+        size_t rec = record_size(data + pos, len - pos, w->key_len);
+        if (!rec) return -1;
+        pos += rec;
+    }
+    if (n == 0) return 0;
+    SortItem* items = (SortItem*)malloc(n * sizeof(SortItem));
+    if (!items) return -1;
+    size_t pos = 0;
+    for (size_t i = 0; i < n; i++) {
+        items[i].rec = data + pos;
+        items[i].len = record_size(data + pos, len - pos, w->key_len);
+        items[i].prefix = load_be64(data + pos);
+        pos += items[i].len;
+    }
+    sort_key_len = w->key_len;
+    qsort(items, n, sizeof(SortItem), compare_items);
+    int rc = 0;
+    for (size_t i = 0; i < n && rc == 0; i++) rc = emit_record(w, items[i].rec, items[i].len);
+    free(items);
+    return rc;
+}
+
+// Reads one record from a partition file into buf (which must hold key_len + 10 bytes; larger payloads are realloc'ed).
+static int read_record(FILE* f, uint32_t key_len, uint8_t** buf, size_t* cap, size_t* rec_len) {
+    if (fread(*buf, 1, key_len, f) != key_len) return 0;
+    size_t n = 0;
+    uint64_t payload_len = 0;
+    for (;;) {
+        int c = fgetc(f);
+        if (c == EOF || n == 10) return -1;
+        (*buf)[key_len + n++] = (uint8_t)c;
+        if (!(c & 0x80)) break;
+    }
+    get_leb128(*buf + key_len, n, &payload_len);
+    size_t total = key_len + n + (size_t)payload_len;
+    if (total > *cap) {
+        uint8_t* p = (uint8_t*)realloc(*buf, total);
+        if (!p) return -1;
+        *buf = p;
+        *cap = total;
+    }
+    if (payload_len && fread(*buf + key_len + n, 1, (size_t)payload_len, f) != payload_len) return -1;
+    *rec_len = total;
+    return 1;
+}
+
+// External MSD radix sort: a partition that fits the budget is sorted in memory, a larger one is
+// split on key byte `depth` into 256 sub-partitions that are processed in order.
+static int process_partition(HashIndexBuilder* b, IndexWriter* w, FILE* f, uint32_t depth) {
+    if (fflush(f) != 0) return -1;
+    long size = ftell(f);
+    if (size < 0) return -1;
+    rewind(f);
+    if (size == 0) return 0;
+
+    if ((size_t)size <= b->memory_limit || depth >= b->key_len) {
+        uint8_t* data = (uint8_t*)malloc((size_t)size);
+        if (!data) return -1;
+        int rc = fread(data, 1, (size_t)size, f) == (size_t)size ? sort_and_emit(w, data, (size_t)size) : -1;
+        free(data);
+        return rc;
+    }
+
+    FILE* parts[256] = {0};
+    size_t cap = b->key_len + 10 + 256;
+    uint8_t* rec = (uint8_t*)malloc(cap);
+    int rc = rec ? 0 : -1;
+    for (int i = 0; i < 256 && rc == 0; i++) {
+        parts[i] = create_temp_file(b->path);
+        if (!parts[i]) rc = -1;
+    }
+    size_t rec_len;
+    int got;
+    while (rc == 0 && (got = read_record(f, b->key_len, &rec, &cap, &rec_len)) != 0) {
+        if (got < 0 || fwrite(rec, 1, rec_len, parts[rec[depth]]) != rec_len) rc = -1;
+    }
+    free(rec);
+    for (int i = 0; i < 256; i++) {
+        if (rc == 0) rc = process_partition(b, w, parts[i], depth + 1);
+        if (parts[i]) fclose(parts[i]);
+    }
+    return rc;
+}
+
+static uint32_t choose_fanout_bits(uint64_t count) {
+    uint32_t bits = 0;
+    while (bits < HASH_INDEX_MAX_FANOUT_BITS && (count >> (bits + 1)) >= 16) bits++;
+    return bits;
+}
+
+static void free_builder(HashIndexBuilder* b) {
+    for (int i = 0; i < 256; i++) {
+        if (b->spill[i]) fclose(b->spill[i]);
+    }
+    free(b->buffer);
+    free(b->path);
+    free(b);
+}
+
+void hash_index_builder_abort(HashIndexBuilder* b) {
+    if (b) free_builder(b);
+}
+
+int hash_index_builder_finish(HashIndexBuilder* b) {
+    if (!b) return -1;
+    if (b->error) {
+        free_builder(b);
+        return -1;
+    }
+
+    IndexWriter w;
+    memset(&w, 0, sizeof(w));
+    w.key_len = b->key_len;
+    w.fanout_bits = choose_fanout_bits(b->count);
+    uint64_t fanout_slots = ((uint64_t)1 << w.fanout_bits) + 1;
+    uint64_t entry_size = b->key_len + HASH_INDEX_OFFSET_BYTES;
+    uint64_t fanout_off = HASH_INDEX_HEADER_SIZE;
+    uint64_t entries_off = (fanout_off + fanout_slots * 8 + 63) & ~(uint64_t)63;
+    uint64_t payloads_off = (entries_off + b->count * entry_size + 63) & ~(uint64_t)63;
+    w.entry_offset = entries_off;
+    w.payload_offset = payloads_off;
+    w.fanout = (uint64_t*)calloc(fanout_slots, sizeof(uint64_t));
+    w.entry_buf = (uint8_t*)malloc(HASH_INDEX_WRITE_BUFFER);
+    w.payload_buf = (uint8_t*)malloc(HASH_INDEX_WRITE_BUFFER);
+    w.fd = open(b->path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    int rc = (w.fanout && w.entry_buf && w.payload_buf && w.fd >= 0) ? 0 : -1;
+    if (rc == 0) {
+        if (!b->spilled) {
+            rc = sort_and_emit(&w, b->buffer, b->buffer_len);
+        } else {
+            rc = spill_buffer(b);
+            for (int i = 0; i < 256 && rc == 0; i++) rc = process_partition(b, &w, b->spill[i], 1);
+        }
+    }
+    if (rc == 0) rc = flush_writer(&w);
+
+    if (rc == 0) {
+        for (uint64_t i = 1; i < fanout_slots; i++) w.fanout[i] += w.fanout[i - 1];
+        uint8_t* table = (uint8_t*)w.fanout; // host order is little-endian on x86-64
+        uint8_t header[HASH_INDEX_HEADER_SIZE] = {0};
+        memcpy(header, HASH_INDEX_MAGIC, 8);
+        memcpy(header + 8, &b->key_len, 4);
+        memcpy(header + 12, &w.fanout_bits, 4);
+        store_le64(header + 16, b->count);
+        store_le64(header + 24, fanout_off);
+        store_le64(header + 32, entries_off);
+        store_le64(header + 40, payloads_off);
+        store_le64(header + 48, b->payload_bytes);
+        if (write_all(w.fd, table, fanout_slots * 8, fanout_off) != 0 ||
+            ftruncate(w.fd, (off_t)(payloads_off + b->payload_bytes)) != 0 ||
+            fsync(w.fd) != 0 ||
+            write_all(w.fd, header, sizeof(header), 0) != 0 || // the magic lands last: a torn file never validates
+            fsync(w.fd) != 0) rc = -1;
+    }
+    if (w.fd >= 0) close(w.fd);
+    if (rc != 0) unlink(b->path);
+    free(w.fanout);
+    free(w.entry_buf);
+    free(w.payload_buf);
+    free_builder(b);
+    return rc;
+}
+
+// --- Reader ---
+
+int hash_index_open(HashIndex* index, const char* path) {
+    if (!index || !path) return -1;
+    memset(index, 0, sizeof(*index));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < HASH_INDEX_HEADER_SIZE) {
+        close(fd);
+        return -1;
+    }
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    const uint8_t* h = (const uint8_t*)map;
+    uint64_t size = (uint64_t)st.st_size;
+    uint32_t key_len, fanout_bits;
+    memcpy(&key_len, h + 8, 4);
+    memcpy(&fanout_bits, h + 12, 4);
+    uint64_t count = load_le64(h + 16), fanout_off = load_le64(h + 24);
+    uint64_t entries_off = load_le64(h + 32), payloads_off = load_le64(h + 40), payload_size = load_le64(h + 48);
+    uint64_t entry_size = key_len + HASH_INDEX_OFFSET_BYTES;
+    uint64_t fanout_slots = ((uint64_t)1 << (fanout_bits & 63)) + 1;
+    // Every section must lie inside the file (compared without overflow), since lookups index the
+    // entries straight from the fanout slots.
+    bool ok = memcmp(h, HASH_INDEX_MAGIC, 8) == 0 && key_len >= 8 && key_len <= HASH_INDEX_MAX_KEY_LEN &&
+              fanout_bits <= HASH_INDEX_MAX_FANOUT_BITS && entries_off <= size && payloads_off <= size &&
+              fanout_off <= entries_off && fanout_slots * 8 <= entries_off - fanout_off &&
+              entries_off <= payloads_off && count <= (payloads_off - entries_off) / entry_size &&
+              payload_size <= size - payloads_off;
+    // The fanout slots must be non-decreasing and end at count.
+    for (uint64_t i = 1; ok && i < fanout_slots; i++) ok = load_le64(h + fanout_off + (i - 1) * 8) <= load_le64(h + fanout_off + i * 8);
+    if (ok) ok = load_le64(h + fanout_off + (fanout_slots - 1) * 8) == count;
+    if (!ok) {
+        munmap(map, (size_t)st.st_size);
+        return -1;
+    }
+    index->map = h;
+    index->map_size = (size_t)st.st_size;
+    index->key_len = key_len;
+    index->fanout_bits = fanout_bits;
+    index->count = count;
+    index->fanout = h + fanout_off;
+    index->entries = h + entries_off;
+    index->payloads = h + payloads_off;
+    index->payload_size = payload_size;
+    madvise(map, (size_t)st.st_size, MADV_RANDOM);
+    return 0;
+}
+
+void hash_index_close(HashIndex* index) {
+    if (!index || !index->map) return;
+    munmap((void*)index->map, index->map_size);
+    memset(index, 0, sizeof(*index));
+}
+
+static inline const uint8_t* entry_at(const HashIndex* index, uint64_t i) {
+    return index->entries + i * (index->key_len + HASH_INDEX_OFFSET_BYTES);
+}
+
+// Bucket bounds [*lo, *hi) and the interpolated position of the key inside them.
+static inline uint64_t estimate(const HashIndex* index, const uint8_t* key, uint64_t* lo, uint64_t* hi) {
+    uint64_t k = load_be64(key);
+    uint32_t bits = index->fanout_bits;
+    uint64_t prefix = bits ? k >> (64 - bits) : 0;
+    *lo = load_le64(index->fanout + prefix * 8);
+    *hi = load_le64(index->fanout + prefix * 8 + 8);
+    if (*hi <= *lo) return *lo;
+    uint64_t within = bits ? k << bits : k; // position of the key inside its bucket, as a fraction of 2^64
+    return *lo + (uint64_t)(((unsigned __int128)within * (*hi - *lo)) >> 64);
+}
+
+// Galloping search outward from the estimate, then binary search; returns the entry index or UINT64_MAX.
+static uint64_t resolve(const HashIndex* index, const uint8_t* key, uint64_t lo, uint64_t hi, uint64_t est) {
+    if (lo >= hi) return UINT64_MAX;
+    uint32_t key_len = index->key_len;
+    uint64_t left = lo, right = hi; // entries < left are < key, entries >= right are >= key
+    uint64_t step = 4;
+    if (memcmp(entry_at(index, est), key, key_len) < 0) {
+        left = est + 1;
+        while (left + step < right) {
+            uint64_t probe = left + step;
+            if (memcmp(entry_at(index, probe), key, key_len) < 0) {
+                left = probe + 1;
+                step *= 2;
+            } else {
+                right = probe;
+                break;
+            }
+        }
+    } else {
+        right = est;
+        while (right > left + step) {
+            uint64_t probe = right - step;
+            if (memcmp(entry_at(index, probe), key, key_len) >= 0) {
+                right = probe;
+                step *= 2;
+            } else {
+                left = probe + 1;
+                break;
+            }
+        }
+    }
+    while (left < right) {
+        uint64_t mid = left + (right - left) / 2;
+        if (memcmp(entry_at(index, mid), key, key_len) < 0) left = mid + 1;
+        else right = mid;
+    }
+    if (left < hi && memcmp(entry_at(index, left), key, key_len) == 0) return left;
+    return UINT64_MAX;
+}
+
+static bool read_payload(const HashIndex* index, uint64_t entry, const uint8_t** payload, size_t* payload_len) {
+    const uint8_t* e = entry_at(index, entry) + index->key_len;
+    uint64_t off = 0, len;
+    for (int i = 0; i < HASH_INDEX_OFFSET_BYTES; i++) off |= (uint64_t)e[i] << (8 * i);
+    if (off >= index->payload_size) return false;
+    size_t n = get_leb128(index->payloads + off, (size_t)(index->payload_size - off), &len);
+    if (!n || len > index->payload_size - off - n) return false;
+    if (payload) *payload = index->payloads + off + n;
+    if (payload_len) *payload_len = (size_t)len;
+    return true;
+}
+
+bool hash_index_lookup(const HashIndex* index, const uint8_t* key, const uint8_t** payload, size_t* payload_len) {
+    if (payload) *payload = NULL;
+    if (payload_len) *payload_len = 0;
+    if (!index || !index->map || !key || index->count == 0) return false;
+    uint64_t lo, hi;
+    uint64_t est = estimate(index, key, &lo, &hi);
+    if (est >= hi) est = hi ? hi - 1 : 0;
+    uint64_t found = resolve(index, key, lo, hi, est);
+    return found != UINT64_MAX && read_payload(index, found, payload, payload_len);
+}
+
+uint64_t hash_index_find_all(const HashIndex* index, const uint8_t* key, uint64_t* first) {
+    if (first) *first = 0;
+    if (!index || !index->map || !key || index->count == 0) return 0;
+    uint64_t lo, hi;
+    uint64_t est = estimate(index, key, &lo, &hi);
+    if (est >= hi) est = hi ? hi - 1 : 0;
+    uint64_t found = resolve(index, key, lo, hi, est); // the first of the duplicates
+    if (found == UINT64_MAX) return 0;
+    uint64_t end = found + 1;
+    while (end < hi && memcmp(entry_at(index, end), key, index->key_len) == 0) end++;
+    if (first) *first = found;
+    return end - found;
+}
+
+bool hash_index_entry_payload(const HashIndex* index, uint64_t entry, const uint8_t** payload, size_t* payload_len) {
+    if (payload) *payload = NULL;
+    if (payload_len) *payload_len = 0;
+    if (!index || !index->map || entry >= index->count) return false;
+    return read_payload(index, entry, payload, payload_len);
+}
+
+uint8_t hash_index_lookup_8(const HashIndex* index, const uint8_t* const keys[8],
+                            const uint8_t* payloads[8], size_t payload_lens[8]) {
+    for (int lane = 0; lane < 8; lane++) {
+        if (payloads) payloads[lane] = NULL;
+        if (payload_lens) payload_lens[lane] = 0;
+    }
+    if (!index || !index->map || !keys || index->count == 0) return 0;
+
+    // Stage 1: prefetch the fanout slots; stage 2: interpolate and prefetch the entries;
+    // stage 3: resolve. The eight independent misses overlap instead of being paid one after another.
+    uint32_t bits = index->fanout_bits;
+    for (int lane = 0; lane < 8; lane++) {
+        uint64_t prefix = bits ? load_be64(keys[lane]) >> (64 - bits) : 0;
+        __builtin_prefetch(index->fanout + prefix * 8);
+    }
+    uint64_t lo[8], hi[8], est[8];
+    for (int lane = 0; lane < 8; lane++) {
+        est[lane] = estimate(index, keys[lane], &lo[lane], &hi[lane]);
+        if (est[lane] >= hi[lane]) est[lane] = hi[lane] ? hi[lane] - 1 : 0;
+        __builtin_prefetch(entry_at(index, est[lane]));
+    }
+    uint64_t found[8];
+    for (int lane = 0; lane < 8; lane++) {
+        found[lane] = resolve(index, keys[lane], lo[lane], hi[lane], est[lane]);
+        if (found[lane] != UINT64_MAX) __builtin_prefetch(entry_at(index, found[lane]) + index->key_len);
+    }
+    uint8_t mask = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        if (found[lane] == UINT64_MAX) continue;
+        if (read_payload(index, found[lane], payloads ? &payloads[lane] : NULL, payload_lens ? &payload_lens[lane] : NULL))
+            mask |= (uint8_t)(1u << lane);
+    }
+    return mask;
+}
+
+uint8_t hash_index_lookup_h160_8(const HashIndex* index, const uint8_t digests[8][20],
+                                 const uint8_t* payloads[8], size_t payload_lens[8]) {
+    if (!index || !digests || index->key_len != HASH_INDEX_KEY_LEN_HASH160) return 0;
+    const uint8_t* keys[8];
+    for (int lane = 0; lane < 8; lane++) keys[lane] = digests[lane];
+    return hash_index_lookup_8(index, keys, payloads, payload_lens);
+}
@@ -0,0 +1,138 @@
+/* hash_index_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef HASH_INDEX_AVX_H
+#define HASH_INDEX_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Sorted, memory-mapped index of fixed-length hash keys (20-byte HASH160 by default) to
+// variable-length payloads (e.g. a derivation path or index).
+//
+// File layout (little-endian):
+//   header   64 bytes: "HIDX0001", key_len, fanout_bits, count, section offsets
+//   fanout   (2^fanout_bits + 1) x uint64: first entry index of every key prefix
+//   entries  count x (key || 40-bit payload offset), sorted by key
+//   payloads LEB128 length || bytes, in entry order
+//
+// A lookup reads the fanout slot of the key's top bits (the table is small enough to stay resident),
+// interpolates the position inside the bucket from the next key bits (hash keys are uniform), and
+// finishes with a short local search, so it normally touches a single page of the entry section.
+
+#define HASH_INDEX_KEY_LEN_HASH160 20
+#define HASH_INDEX_MAX_KEY_LEN 64
+
+typedef struct {
+    const uint8_t* map;
+    size_t map_size;
+    uint32_t key_len;
+    uint32_t fanout_bits;
+    uint64_t count;
+    const uint8_t* fanout;   // (2^fanout_bits + 1) uint64 entry indices
+    const uint8_t* entries;
+    const uint8_t* payloads;
+    uint64_t payload_size;
+} HashIndex;
+
+typedef struct HashIndexBuilder HashIndexBuilder;
+
+/**
+* @brief Starts building an index file.
+* Records are buffered up to memory_limit bytes; beyond that they are radix-partitioned by key byte into
+* temporary files next to `path`, and oversized partitions are split again on the next byte.
+* @param key_len Key length in bytes (1..HASH_INDEX_MAX_KEY_LEN, at least 8).
+* @param memory_limit Buffer budget in bytes (a minimum of 1 MiB is enforced).
+* @return A builder, or NULL on invalid arguments or allocation failure.
+*/
+HashIndexBuilder* hash_index_builder_create(const char* path, uint32_t key_len, size_t memory_limit);
+
+/**
+* @brief Adds one (key, payload) record. Duplicate keys are kept; lookups return one of them.
+* @return 0 on success, -1 on an I/O error (the builder must still be finished or aborted).
+*/
+int hash_index_builder_add(HashIndexBuilder* builder, const uint8_t* key, const uint8_t* payload, size_t payload_len);
+
+/**
+* @brief Sorts the records, writes and fsyncs the index file, removes the temporary files and frees the builder.
+* @return 0 on success, -1 on error (the output file is removed).
+*/
+int hash_index_builder_finish(HashIndexBuilder* builder);
+
+/**
+* @brief Discards a builder and its temporary files without writing the index.
+*/
+void hash_index_builder_abort(HashIndexBuilder* builder);
+
+/**
+* @brief Maps an index file read-only and validates its header.
+* @return 0 on success, -1 on an I/O error or a malformed file.
+*/
+int hash_index_open(HashIndex* index, const char* path);
+
+/**
+* @brief Unmaps the index.
+*/
+void hash_index_close(HashIndex* index);
+
+/**
+* @brief Looks up one key (index->key_len bytes).
+* @param payload If not NULL, receives a pointer to the payload inside the mapping.
+* @param payload_len If not NULL, receives the payload length.
+* @return true if the key is present.
+*/
+bool hash_index_lookup(const HashIndex* index, const uint8_t* key, const uint8_t** payload, size_t* payload_len);
+
+/**
+* @brief Finds every entry of a key; duplicates are adjacent in the entry section.
+* @param first If not NULL, receives the index of the first matching entry.
+* @return The number of matching entries (0 if the key is absent).
+*/
+uint64_t hash_index_find_all(const HashIndex* index, const uint8_t* key, uint64_t* first);
+
+/**
+* @brief Reads the payload of entry `entry` (0 <= entry < count), e.g. one found by hash_index_find_all().
+* @return true if the entry exists and its payload is well-formed.
+*/
+bool hash_index_entry_payload(const HashIndex* index, uint64_t entry, const uint8_t** payload, size_t* payload_len);
+
+/**
+* @brief Looks up eight keys, issuing the prefetches of all eight probes before resolving any of them.
+* @param payloads, payload_lens Optional per-lane outputs (set to NULL/0 for misses).
+* @return Bit mask of the lanes whose key was found.
+*/
+uint8_t hash_index_lookup_8(const HashIndex* index, const uint8_t* const keys[8],
+                            const uint8_t* payloads[8], size_t payload_lens[8]);
+
+/**
+* @brief hash_index_lookup_8() for digests exactly as produced by ripemd160_multi_final().
+* The index must have 20-byte keys.
+*/
+uint8_t hash_index_lookup_h160_8(const HashIndex* index, const uint8_t digests[8][20],
+                                 const uint8_t* payloads[8], size_t payload_lens[8]);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // HASH_INDEX_AVX_H
@@ -0,0 +1,207 @@
+/* hash_index_test.c
+ * gcc -O3 -mavx2 -march=native hash_index_test.c hash_index_avx.c ripemd160_avx.c -o hash_index_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hash_index_avx.h"
+#include "ripemd160_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+// Keys straight out of the 8-lane RIPEMD-160: digests of "key <i>".
+static void make_keys(uint8_t (*keys)[20], size_t count, unsigned salt) {
+    for (size_t base = 0; base < count; base += 8) {
+        char text[8][32];
+        const uint8_t* msgs[8];
+        size_t lens[8];
+        uint8_t digests[8][20];
+        for (int lane = 0; lane < 8; lane++) {
+            lens[lane] = (size_t)snprintf(text[lane], sizeof(text[lane]), "key %u/%zu", salt, base + lane);
+            msgs[lane] = (const uint8_t*)text[lane];
+        }
+        ripemd160_multi_hash_lanes(msgs, lens, digests);
+        size_t n = count - base < 8 ? count - base : 8;
+        memcpy(keys[base], digests, n * 20);
+    }
+}
+
+static size_t make_payload(size_t i, char* out) {
+    return (size_t)sprintf(out, "m/84'/0'/0'/%zu/%zu", i & 1, i);
+}
+
+int main() {
+    printf("--- Correctness Test (Sorted mmap HASH160 Index) ---\n");
+    int failed_tests = 0;
+    const size_t COUNT = 300000;
+    uint8_t (*keys)[20] = (uint8_t (*)[20])malloc(COUNT * 20);
+    make_keys(keys, COUNT, 1);
+    // Skew: a third of the keys share the first byte, so that partition exceeds the memory budget
+    // and is split again on the second byte.
+    for (size_t i = 0; i < COUNT; i += 3) keys[i][0] = 0x42;
+
+    char path[] = "/tmp/hash_index_testXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "mkstemp failed.\n");
+        return 1;
+    }
+    close(fd);
+
+    HashIndexBuilder* builder = hash_index_builder_create(path, HASH_INDEX_KEY_LEN_HASH160, 1 << 20);
+    char payload[64];
+    int add_failures = 0;
+    for (size_t i = 0; i < COUNT; i++) {
+        size_t len = make_payload(i, payload);
+        if (hash_index_builder_add(builder, keys[i], (const uint8_t*)payload, len) != 0) add_failures++;
+    }
+    uint8_t big[100000];
+    memset(big, 0xab, sizeof(big));
+    uint8_t big_key[20];
+    memset(big_key, 0x99, sizeof(big_key));
+    hash_index_builder_add(builder, big_key, big, sizeof(big)); // larger than the write buffer
+    int rc = hash_index_builder_finish(builder);
+    failed_tests += report("Build with 1 MiB budget (spill + second-level split)", rc == 0 && add_failures == 0);
+
+    HashIndex index;
+    rc = hash_index_open(&index, path);
+    failed_tests += report("Open and validate header", rc == 0 && index.count == COUNT + 1);
+
+    // Sorted order.
+    int unsorted = 0;
+    for (uint64_t i = 1; i < index.count; i++) {
+        if (memcmp(index.entries + (i - 1) * 25, index.entries + i * 25, 20) > 0) unsorted++;
+    }
+    failed_tests += report("Entries are sorted", unsorted == 0);
+
+    // Every key found through the batched API with the right payload.
+    int lookup_failures = 0;
+    for (size_t base = 0; base + 8 <= COUNT; base += 8) {
+        const uint8_t* payloads[8];
+        size_t lens[8];
+        uint8_t mask = hash_index_lookup_h160_8(&index, (const uint8_t (*)[20])keys[base], payloads, lens);
+        if (mask != 0xff) {
+            lookup_failures++;
+            continue;
+        }
+        for (int lane = 0; lane < 8; lane++) {
+            size_t len = make_payload(base + lane, payload);
+            if (lens[lane] != len || memcmp(payloads[lane], payload, len) != 0) lookup_failures++;
+        }
+    }
+    failed_tests += report("All keys found via hash_index_lookup_h160_8", lookup_failures == 0);
+
+    const uint8_t* p;
+    size_t plen;
+    failed_tests += report("100 KB payload round-trips",
+                           hash_index_lookup(&index, big_key, &p, &plen) && plen == sizeof(big) && memcmp(p, big, plen) == 0);
+
+    // Keys that were never inserted.
+    uint8_t (*absent)[20] = (uint8_t (*)[20])malloc(8000 * 20);
+    make_keys(absent, 8000, 2);
+    int false_hits = 0;
+    for (size_t i = 0; i < 8000; i++) false_hits += hash_index_lookup(&index, absent[i], NULL, NULL);
+    failed_tests += report("Absent keys are not found", false_hits == 0);
+    hash_index_close(&index);
+
+    // Fanout slots out of order or past the entry count, and sections outside the file, are rejected.
+    {
+        uint8_t header[64];
+        FILE* f = fopen(path, "r+b");
+        size_t got = fread(header, 1, sizeof(header), f);
+        uint32_t fanout_bits;
+        uint64_t count, fanout_off;
+        memcpy(&fanout_bits, header + 12, 4);
+        memcpy(&count, header + 16, 8);
+        memcpy(&fanout_off, header + 24, 8);
+        const struct { uint64_t at, value; } patches[] = {
+            {fanout_off + 8, ~0ull},                                    // slot 1 above every later slot
+            {fanout_off + ((uint64_t)1 << fanout_bits) * 8, count + 1}, // last slot past count
+            {32, ~0ull},                                                // entries beyond the end of the file
+        };
+        int accepted = got != sizeof(header);
+        for (size_t i = 0; i < sizeof(patches) / sizeof(patches[0]); i++) {
+            uint64_t saved;
+            fseek(f, (long)patches[i].at, SEEK_SET);
+            if (fread(&saved, 8, 1, f) != 1) accepted++;
+            fseek(f, (long)patches[i].at, SEEK_SET);
+            fwrite(&patches[i].value, 8, 1, f);
+            fflush(f);
+            if (hash_index_open(&index, path) == 0) {
+                accepted++;
+                hash_index_close(&index);
+            }
+            fseek(f, (long)patches[i].at, SEEK_SET);
+            fwrite(&saved, 8, 1, f);
+            fflush(f);
+        }
+        fclose(f);
+        int reopened = hash_index_open(&index, path) == 0;
+        if (reopened) hash_index_close(&index);
+        failed_tests += report("Corrupt fanout and section offsets rejected", accepted == 0 && reopened);
+    }
+
+    // A torn or foreign file is rejected.
+    FILE* f = fopen(path, "r+b");
+    fwrite("XXXX", 1, 4, f);
+    fclose(f);
+    failed_tests += report("Corrupt header rejected", hash_index_open(&index, path) != 0);
+    unlink(path);
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (2M-key index, lookups) ---\n");
+    const size_t BENCH = 2000000;
+    uint8_t (*bench_keys)[20] = (uint8_t (*)[20])malloc(BENCH * 20);
+    make_keys(bench_keys, BENCH, 3);
+    builder = hash_index_builder_create(path, HASH_INDEX_KEY_LEN_HASH160, 64 << 20);
+    clock_t start = clock();
+    for (size_t i = 0; i < BENCH; i++) {
+        uint8_t idx[8];
+        memcpy(idx, &i, 8);
+        hash_index_builder_add(builder, bench_keys[i], idx, 4);
+    }
+    hash_index_builder_finish(builder);
+    clock_t end = clock();
+    printf("Build: %.4f seconds (%.2f Million records/sec)\n", (double)(end - start) / CLOCKS_PER_SEC,
+           BENCH / ((double)(end - start) / CLOCKS_PER_SEC) / 1e6);
+
+    hash_index_open(&index, path);
+    size_t hits = 0;
+    start = clock();
+    for (size_t i = 0; i < BENCH; i++) hits += hash_index_lookup(&index, bench_keys[(i * 7919) % BENCH], NULL, NULL);
+    end = clock();
+    double single_time = (double)(end - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (size_t i = 0; i + 8 <= BENCH; i += 8) {
+        const uint8_t* ks[8];
+        for (int lane = 0; lane < 8; lane++) ks[lane] = bench_keys[((i + lane) * 7919) % BENCH];
+        hits += (size_t)__builtin_popcount(hash_index_lookup_8(&index, ks, NULL, NULL));
+    }
+    end = clock();
+    double batch_time = (double)(end - start) / CLOCKS_PER_SEC;
+    hash_index_close(&index);
+    unlink(path);
+
+    printf("Hits: %zu of %zu\n", hits, 2 * BENCH);
+    printf("Single lookups: %.2f Million/sec\n", BENCH / single_time / 1e6);
+    printf("8-way lookups:  %.2f Million/sec\n", BENCH / batch_time / 1e6);
+
+    free(keys);
+    free(absent);
+    free(bench_keys);
+    return failed_tests == 0 ? 0 : 1;
+}
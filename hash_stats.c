@@ -0,0 +1,248 @@
+/* hash_stats.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "hash_stats.h"
+
+#ifdef HASH_STATS
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <x86intrin.h>
+
+static const char* const probe_names[HASH_STATS_PROBE_COUNT] = {
+    "sha256_transform",
+    "sha256_transpose",
+    "sha256_final",
+    "ripemd160_schedule",
+    "ripemd160_compress",
+    "ripemd160_final",
+    "main_keygen",
+    "main_hash_comp",
+    "main_hash_uncomp",
+    "main_verify",
+};
+
+typedef struct {
+    uint64_t calls;
+    uint64_t blocks;
+    uint64_t lanes;
+    uint64_t cycles;
+    uint64_t cache_misses;
+    uint64_t instructions;
+} ProbeCounters;
+
+typedef struct HashStatsThread {
+    ProbeCounters probes[HASH_STATS_PROBE_COUNT];
+    struct perf_event_mmap_page* pmc_pages[2]; // cache misses, instructions (NULL when unavailable)
+    int pmc_fds[2];
+    pid_t tid;
+    struct HashStatsThread* next;
+} HashStatsThread;
+
+static _Thread_local HashStatsThread* tls_stats = NULL;
+static HashStatsThread* all_threads = NULL;
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t global_once = PTHREAD_ONCE_INIT;
+static int signal_pipe[2] = {-1, -1};
+
+// --- Hardware counters (perf_event_open + rdpmc) ---
+
+static int open_pmc(uint64_t config, struct perf_event_mmap_page** page_out) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd < 0) return -1;
+    void* page = mmap(NULL, (size_t)sysconf(_SC_PAGESIZE), PROT_READ, MAP_SHARED, fd, 0);
+    if (page == MAP_FAILED) {
+        close(fd);
+        return -1;
+    }
+    struct perf_event_mmap_page* pc = (struct perf_event_mmap_page*)page;
+    if (!pc->cap_user_rdpmc) {
+        munmap(page, (size_t)sysconf(_SC_PAGESIZE));
+        close(fd);
+        return -1;
+    }
+    *page_out = pc;
+    return fd;
+}
+
+// Reads a counter from user space; the seqlock retries if the kernel rescheduled the event meanwhile.
+static inline uint64_t read_pmc(const struct perf_event_mmap_page* pc) {
+    if (!pc) return 0;
+    uint32_t seq;
+    uint64_t count;
+    do {
+        seq = pc->lock;
+        __asm__ __volatile__("" ::: "memory");
+        uint32_t idx = pc->index;
+        count = (uint64_t)pc->offset;
+        if (idx) {
+            uint32_t shift = 64 - pc->pmc_width;
+            int64_t pmc = (int64_t)__rdpmc((int)(idx - 1));
+            count += (uint64_t)((pmc << shift) >> shift);
+        }
+        __asm__ __volatile__("" ::: "memory");
+    } while (pc->lock != seq);
+    return count;
+}
+
+// --- Dumping ---
+
+static void write_probe_json(FILE* out, const ProbeCounters* c, bool with_pmc) {
+    uint64_t calls = __atomic_load_n(&c->calls, __ATOMIC_RELAXED);
+    uint64_t lanes = __atomic_load_n(&c->lanes, __ATOMIC_RELAXED);
+    fprintf(out, "{\"calls\": %llu, \"blocks\": %llu, \"lane_occupancy\": %.4f, \"cycles\": %llu",
+            (unsigned long long)calls,
+            (unsigned long long)__atomic_load_n(&c->blocks, __ATOMIC_RELAXED),
+            calls ? (double)lanes / (double)(calls * 8) : 0.0,
+            (unsigned long long)__atomic_load_n(&c->cycles, __ATOMIC_RELAXED));
+    if (with_pmc) {
+        fprintf(out, ", \"cache_misses\": %llu, \"instructions\": %llu",
+                (unsigned long long)__atomic_load_n(&c->cache_misses, __ATOMIC_RELAXED),
+                (unsigned long long)__atomic_load_n(&c->instructions, __ATOMIC_RELAXED));
+    }
+    fprintf(out, "}");
+}
+
+void hash_stats_dump_json(FILE* out) {
+    if (!out) return;
+    pthread_mutex_lock(&registry_lock);
+    fprintf(out, "{\"pid\": %d, \"threads\": [", (int)getpid());
+    for (HashStatsThread* t = all_threads; t; t = t->next) {
+        bool with_pmc = t->pmc_pages[0] || t->pmc_pages[1];
+        fprintf(out, "%s\n  {\"tid\": %d, \"perf_counters\": %s, \"probes\": {", t == all_threads ? "" : ",",
+                (int)t->tid, with_pmc ? "true" : "false");
+        bool first = true;
+        for (int p = 0; p < HASH_STATS_PROBE_COUNT; p++) {
+            if (__atomic_load_n(&t->probes[p].calls, __ATOMIC_RELAXED) == 0) continue;
+            fprintf(out, "%s\n    \"%s\": ", first ? "" : ",", probe_names[p]);
+            write_probe_json(out, &t->probes[p], with_pmc);
+            first = false;
+        }
+        fprintf(out, "\n  }}");
+    }
+    fprintf(out, "\n]}\n");
+    fflush(out);
+    pthread_mutex_unlock(&registry_lock);
+}
+
+static void dump_to_configured_target(void) {
+    const char* path = getenv("HASH_STATS_FILE");
+    FILE* out = path ? fopen(path, "w") : stderr;
+    if (!out) return;
+    hash_stats_dump_json(out);
+    if (out != stderr) fclose(out);
+}
+
+// SIGUSR1 only pokes a pipe; the dump itself runs on a helper thread where stdio and locks are safe.
+static void on_sigusr1(int sig) {
+    (void)sig;
+    char byte = 1;
+    ssize_t rc = write(signal_pipe[1], &byte, 1);
+    (void)rc;
+}
+
+static void* dump_thread_main(void* arg) {
+    (void)arg;
+    char byte;
+    while (read(signal_pipe[0], &byte, 1) > 0) dump_to_configured_target();
+    return NULL;
+}
+
+static void global_init(void) {
+    atexit(dump_to_configured_target);
+    if (pipe(signal_pipe) != 0) return;
+
+    // The helper thread must not take SIGUSR1 itself, or its blocking read would be interrupted.
+    sigset_t block, old;
+    sigemptyset(&block);
+    sigaddset(&block, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &block, &old);
+    pthread_t tid;
+    if (pthread_create(&tid, NULL, dump_thread_main, NULL) == 0) pthread_detach(tid);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_sigusr1;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGUSR1, &sa, NULL);
+}
+
+static HashStatsThread* thread_stats(void) {
+    if (tls_stats) return tls_stats;
+    pthread_once(&global_once, global_init);
+
+    HashStatsThread* t = (HashStatsThread*)calloc(1, sizeof(HashStatsThread));
+    if (!t) abort();
+    t->tid = (pid_t)syscall(SYS_gettid);
+    t->pmc_fds[0] = open_pmc(PERF_COUNT_HW_CACHE_MISSES, &t->pmc_pages[0]);
+    t->pmc_fds[1] = open_pmc(PERF_COUNT_HW_INSTRUCTIONS, &t->pmc_pages[1]);
+
+    // Thread records stay registered after the thread exits so its totals still appear in the dump.
+    pthread_mutex_lock(&registry_lock);
+    t->next = all_threads;
+    all_threads = t;
+    pthread_mutex_unlock(&registry_lock);
+    tls_stats = t;
+    return t;
+}
+
+// --- Probes ---
+
+void hash_stats_begin(HashStatsMark* mark) {
+    HashStatsThread* t = thread_stats();
+    mark->cache_misses = read_pmc(t->pmc_pages[0]);
+    mark->instructions = read_pmc(t->pmc_pages[1]);
+    mark->tsc = __rdtsc();
+}
+
+// Counters are only written by their owning thread; relaxed atomic stores keep concurrent dumps well-defined.
+#define STATS_ADD(field, value) __atomic_store_n(&(field), (field) + (value), __ATOMIC_RELAXED)
+
+void hash_stats_end(HashStatsProbe probe, const HashStatsMark* mark, uint64_t blocks, uint64_t lanes) {
+    uint64_t tsc = __rdtsc();
+    HashStatsThread* t = tls_stats;
+    if (!t || (unsigned)probe >= HASH_STATS_PROBE_COUNT) return;
+    ProbeCounters* c = &t->probes[probe];
+    STATS_ADD(c->calls, 1);
+    STATS_ADD(c->blocks, blocks);
+    STATS_ADD(c->lanes, lanes);
+    STATS_ADD(c->cycles, tsc - mark->tsc);
+    if (t->pmc_pages[0]) STATS_ADD(c->cache_misses, read_pmc(t->pmc_pages[0]) - mark->cache_misses);
+    if (t->pmc_pages[1]) STATS_ADD(c->instructions, read_pmc(t->pmc_pages[1]) - mark->instructions);
+}
+
+#endif // HASH_STATS
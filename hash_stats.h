@@ -0,0 +1,84 @@
+/* hash_stats.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+// Optional hot-path instrumentation.
+//
+// Build every translation unit with -DHASH_STATS and link hash_stats.c (plus -lpthread) to record,
+// per thread and per probe: call count, block count, active lanes, TSC cycles and, when
+// perf_event_open is permitted, cache misses and retired instructions (read in user space with rdpmc).
+// Stats are written as JSON at exit and whenever the process receives SIGUSR1; the destination is
+// $HASH_STATS_FILE (default: stderr).
+//
+// Without -DHASH_STATS every macro below expands to nothing and hash_stats.c compiles to an empty unit.
+
+#ifndef HASH_STATS_H
+#define HASH_STATS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    HASH_STATS_SHA256_TRANSFORM = 0, // sha256_transform_avx8 and the fixed-length round paths
+    HASH_STATS_SHA256_TRANSPOSE,     // transpose8x8_epi32
+    HASH_STATS_SHA256_FINAL,         // digest extraction (transpose + byte swap + store)
+    HASH_STATS_RIPEMD160_SCHEDULE,   // gather-based message transpose
+    HASH_STATS_RIPEMD160_COMPRESS,   // compress
+    HASH_STATS_RIPEMD160_FINAL,      // ripemd160_multi_final
+    HASH_STATS_MAIN_KEYGEN,          // main_full_avx.c: key generation and block preparation
+    HASH_STATS_MAIN_HASH_COMP,       // main_full_avx.c: compressed-key HASH160 stage
+    HASH_STATS_MAIN_HASH_UNCOMP,     // main_full_avx.c: uncompressed-key HASH160 stage
+    HASH_STATS_MAIN_VERIFY,          // main_full_avx.c: OpenSSL cross-check
+    HASH_STATS_PROBE_COUNT
+} HashStatsProbe;
+
+#ifdef HASH_STATS
+
+typedef struct {
+    uint64_t tsc;
+    uint64_t cache_misses;
+    uint64_t instructions;
+} HashStatsMark;
+
+void hash_stats_begin(HashStatsMark* mark);
+void hash_stats_end(HashStatsProbe probe, const HashStatsMark* mark, uint64_t blocks, uint64_t lanes);
+
+/**
+* @brief Writes the stats of every thread seen so far as one JSON document.
+*/
+void hash_stats_dump_json(FILE* out);
+
+#define HASH_STATS_BEGIN(probe) HashStatsMark hash_stats_mark_##probe; hash_stats_begin(&hash_stats_mark_##probe)
+#define HASH_STATS_END(probe, blocks, lanes) hash_stats_end((probe), &hash_stats_mark_##probe, (blocks), (lanes))
+
+#else
+
+#define HASH_STATS_BEGIN(probe) do { } while (0)
+// The counts are still evaluated (and then discarded by the optimizer), so variables kept only for them stay used.
+#define HASH_STATS_END(probe, blocks, lanes) do { (void)(blocks); (void)(lanes); } while (0)
+
+#endif // HASH_STATS
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // HASH_STATS_H
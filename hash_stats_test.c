@@ -0,0 +1,186 @@
+/* hash_stats_test.c
+ * gcc -O3 -mavx2 -march=native -DHASH_STATS hash_stats_test.c sha256_avx.c ripemd160_avx.c hash_stats.c -o hash_stats_test -lcrypto -lpthread
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdalign.h>
+#include <openssl/sha.h>
+#include <openssl/ripemd.h>
+
+#include "sha256_avx.h"
+#include "ripemd160_avx.h"
+#include "hash_stats.h"
+
+#ifndef HASH_STATS
+#error "Build with -DHASH_STATS: this test checks the instrumented hot paths."
+#endif
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+// Returns the "calls" count of a probe in the first thread of a dump that has it, or 0.
+static unsigned long long probe_calls(const char* json, const char* probe) {
+    char key[64];
+    snprintf(key, sizeof(key), "\"%s\": {\"calls\": ", probe);
+    const char* p = strstr(json, key);
+    return p ? strtoull(p + strlen(key), NULL, 10) : 0;
+}
+
+static char* dump_to_string(void) {
+    char* buf = NULL;
+    size_t len = 0;
+    FILE* f = open_memstream(&buf, &len);
+    hash_stats_dump_json(f);
+    fclose(f);
+    return buf;
+}
+
+static void* hash_in_thread(void* arg) {
+    (void)arg;
+    alignas(64) uint8_t blocks[8][64];
+    for (int lane = 0; lane < 8; lane++) prepare_test_data_block(blocks[lane], "abc", 3);
+    Sha256Avx8_C_Handle* h = sha256_avx8_create();
+    uint8_t out[8][32];
+    sha256_avx8_update_8_blocks(h, blocks);
+    sha256_avx8_get_final_hashes(h, out);
+    sha256_avx8_destroy(h);
+    return NULL;
+}
+
+int main() {
+    printf("--- Correctness Test (Instrumented Hot Paths, -DHASH_STATS) ---\n");
+    int failed_tests = 0;
+    setenv("HASH_STATS_FILE", "/dev/null", 0); // keep the exit dump out of the test output
+    srand(1);
+
+    uint8_t data[8][300];
+    for (int lane = 0; lane < 8; lane++)
+        for (int i = 0; i < 300; i++) data[lane][i] = (uint8_t)rand();
+    const uint8_t* ptrs[8];
+    for (int lane = 0; lane < 8; lane++) ptrs[lane] = data[lane];
+
+    // Independent lengths: lanes finish at different blocks, so the probes see partial occupancy.
+    {
+        int sha_bad = 0, rmd_bad = 0;
+        for (int round = 0; round < 300; round++) {
+            size_t lens[8];
+            for (int lane = 0; lane < 8; lane++) lens[lane] = (size_t)((round * 7 + lane * 37) % 301);
+            uint8_t sha[8][32], rmd[8][20], ref[32];
+            sha256_avx8_hash_lanes(NULL, 0, ptrs, lens, sha);
+            ripemd160_multi_hash_lanes(ptrs, lens, rmd);
+            for (int lane = 0; lane < 8; lane++) {
+                SHA256(data[lane], lens[lane], ref);
+                sha_bad += memcmp(sha[lane], ref, 32) != 0;
+                RIPEMD160(data[lane], lens[lane], ref);
+                rmd_bad += memcmp(rmd[lane], ref, 20) != 0;
+            }
+        }
+        failed_tests += report("SHA-256 lanes of 0..300 bytes match OpenSSL", sha_bad == 0);
+        failed_tests += report("RIPEMD-160 lanes of 0..300 bytes match OpenSSL", rmd_bad == 0);
+    }
+
+    // Fixed-length and streaming paths.
+    {
+        int bad = 0;
+        uint8_t out[8][32], ref[32];
+        sha256_avx8_hash_short(ptrs, 33, out);
+        for (int lane = 0; lane < 8; lane++) {
+            SHA256(data[lane], 33, ref);
+            bad += memcmp(out[lane], ref, 32) != 0;
+        }
+        sha256_avx8_double64(ptrs, out);
+        for (int lane = 0; lane < 8; lane++) {
+            SHA256(data[lane], 64, ref);
+            SHA256(ref, 32, ref);
+            bad += memcmp(out[lane], ref, 32) != 0;
+        }
+        // 200 bytes per lane, padded by hand to four blocks.
+        uint8_t padded[8][256];
+        const uint8_t* padded_ptrs[8];
+        for (int lane = 0; lane < 8; lane++) {
+            memcpy(padded[lane], data[lane], 200);
+            memset(padded[lane] + 200, 0, 56);
+            padded[lane][200] = 0x80;
+            padded[lane][254] = (200 * 8) >> 8;
+            padded[lane][255] = (200 * 8) & 0xff;
+            padded_ptrs[lane] = padded[lane];
+        }
+        Sha256Avx8_C_Handle* h = sha256_avx8_create();
+        sha256_avx8_update_n_blocks(h, padded_ptrs, 4);
+        sha256_avx8_get_final_hashes(h, out);
+        sha256_avx8_destroy(h);
+        for (int lane = 0; lane < 8; lane++) {
+            SHA256(data[lane], 200, ref);
+            bad += memcmp(out[lane], ref, 32) != 0;
+        }
+        failed_tests += report("Short, double-64 and 4-block streaming SHA-256", bad == 0);
+    }
+
+    // Iterated chains with independent counts (the lane-step accounting path).
+    {
+        const uint64_t counts[8] = {0, 1, 2, 3, 50, 99, 100, 7};
+        uint8_t out[8][32], rmd[8][20], ref[32];
+        int bad = 0;
+        sha256_avx8_iterate(ptrs, counts, out);
+        ripemd160_multi_iterate(ptrs, counts, rmd);
+        for (int lane = 0; lane < 8; lane++) {
+            memcpy(ref, data[lane], 32);
+            for (uint64_t i = 0; i < counts[lane]; i++) SHA256(ref, 32, ref);
+            bad += memcmp(out[lane], ref, 32) != 0;
+            memcpy(ref, data[lane], 20);
+            for (uint64_t i = 0; i < counts[lane]; i++) RIPEMD160(ref, 20, ref);
+            bad += memcmp(rmd[lane], ref, 20) != 0;
+        }
+        failed_tests += report("SHA-256^n and RIPEMD-160^n with independent counts", bad == 0);
+    }
+
+    // The dump lists the probes that fired, and a second thread gets its own record.
+    {
+        char* json = dump_to_string();
+        int ok = probe_calls(json, "sha256_transform") > 0 && probe_calls(json, "sha256_final") > 0 &&
+                 probe_calls(json, "ripemd160_compress") > 0 && probe_calls(json, "ripemd160_schedule") > 0 &&
+                 probe_calls(json, "main_keygen") == 0;
+        free(json);
+        failed_tests += report("Dump lists the probes that fired", ok);
+
+        pthread_t tid;
+        ok = pthread_create(&tid, NULL, hash_in_thread, NULL) == 0 && pthread_join(tid, NULL) == 0;
+        json = dump_to_string();
+        int threads = 0;
+        for (const char* p = json; (p = strstr(p, "\"tid\": ")); p++) threads++;
+        free(json);
+        failed_tests += report("Each thread is reported separately", ok && threads == 2);
+    }
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (Instrumented HASH160 of 33-byte keys) ---\n");
+    const long long NUM_ITERATIONS = 1000000;
+    uint8_t sha[8][32], rmd[8][20];
+    const uint8_t* sha_ptrs[8];
+    const size_t sha_lens[8] = {32, 32, 32, 32, 32, 32, 32, 32};
+    for (int lane = 0; lane < 8; lane++) sha_ptrs[lane] = sha[lane];
+    clock_t start = clock();
+    for (long long i = 0; i < NUM_ITERATIONS; i++) {
+        data[0][1] = (uint8_t)i;
+        sha256_avx8_hash_short(ptrs, 33, sha);
+        ripemd160_multi_hash_lanes(sha_ptrs, sha_lens, rmd);
+    }
+    double total_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("Total HASH160s: %lld\n", NUM_ITERATIONS * 8);
+    printf("Total time: %.4f seconds\n", total_time);
+    printf("Performance: %.2f Million HASH160s/sec (probe overhead included)\n", NUM_ITERATIONS * 8 / total_time / 1e6);
+
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+/* hash_verify.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "hash_verify.h"
+
+#ifdef HASH_VERIFY
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <openssl/sha.h>
+#include <openssl/ripemd.h>
+
+static const char* const kernel_names[HASH_VERIFY_KERNEL_COUNT] = {
+    "sha256",
+    "sha256d",
+    "ripemd160",
+    "hash160",
+};
+
+static const size_t digest_sizes[HASH_VERIFY_KERNEL_COUNT] = {32, 32, 20, 20};
+
+typedef struct {
+    HashVerifyKernel kernel;
+    uint32_t len;
+    uint8_t input[HASH_VERIFY_MAX_INPUT];
+    uint8_t digest[32];
+} VerifyJob;
+
+volatile int hash_verify_enabled = 0;
+_Thread_local int64_t hash_verify_countdown = 0;
+static _Thread_local uint64_t tls_rng = 0;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+static pthread_t worker;
+static bool running = false, stopping = false;
+static HashVerifyConfig config;
+static VerifyJob* queue = NULL;
+static size_t queue_head = 0, queue_count = 0;
+static HashVerifyCounters counters[HASH_VERIFY_KERNEL_COUNT];
+
+// Next countdown: uniform in [0, 2 * rate), so lanes are sampled at 1/rate without a fixed stride.
+static int64_t next_countdown(void) {
+    if (!tls_rng) tls_rng = (uint64_t)(uintptr_t)&tls_rng ^ 0x9E3779B97F4A7C15ull;
+    tls_rng ^= tls_rng << 13;
+    tls_rng ^= tls_rng >> 7;
+    tls_rng ^= tls_rng << 17;
+    return (int64_t)(tls_rng % (2ull * config.sample_rate));
+}
+
+static void reference(HashVerifyKernel kernel, const uint8_t* input, size_t len, uint8_t out[32]) {
+    uint8_t sha[32];
+    switch (kernel) {
+    case HASH_VERIFY_SHA256:
+        SHA256(input, len, out);
+        break;
+    case HASH_VERIFY_SHA256D:
+        SHA256(input, len, sha);
+        SHA256(sha, 32, out);
+        break;
+    case HASH_VERIFY_RIPEMD160:
+        RIPEMD160(input, len, out);
+        break;
+    default:
+        SHA256(input, len, sha);
+        RIPEMD160(sha, 32, out);
+        break;
+    }
+}
+
+static void print_hex(FILE* out, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) fprintf(out, "%02x", data[i]);
+}
+
+static void default_alert(HashVerifyKernel kernel, const uint8_t* input, size_t input_len,
+                          const uint8_t* got, const uint8_t* expected, void* user) {
+    (void)user;
+    size_t dlen = digest_sizes[kernel];
+    fprintf(stderr, "hash_verify: %s mismatch\n  input:    ", kernel_names[kernel]);
+    print_hex(stderr, input, input_len);
+    fprintf(stderr, "\n  got:      ");
+    print_hex(stderr, got, dlen);
+    fprintf(stderr, "\n  expected: ");
+    print_hex(stderr, expected, dlen);
+    fprintf(stderr, "\n");
+}
+
+static void* worker_main(void* arg) {
+    (void)arg;
+    VerifyJob job;
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (!queue_count && !stopping) pthread_cond_wait(&wake, &lock);
+        if (!queue_count) break; // stopping, and the queue is drained
+        job = queue[queue_head];
+        queue_head = (queue_head + 1) % HASH_VERIFY_QUEUE;
+        queue_count--;
+        pthread_mutex_unlock(&lock);
+
+        uint8_t expected[32];
+        reference(job.kernel, job.input, job.len, expected);
+        bool ok = memcmp(expected, job.digest, digest_sizes[job.kernel]) == 0;
+        if (!ok) {
+            config.alert(job.kernel, job.input, job.len, job.digest, expected, config.user);
+            if (config.policy == HASH_VERIFY_ABORT) {
+                fprintf(stderr, "hash_verify: aborting after a %s mismatch\n", kernel_names[job.kernel]);
+                abort();
+            }
+        }
+
+        pthread_mutex_lock(&lock);
+        counters[job.kernel].checked++;
+        if (!ok) counters[job.kernel].mismatches++;
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+void hash_verify_submit(HashVerifyKernel kernel, const uint8_t* const inputs[8], const size_t* lens, size_t len,
+                        const uint8_t* digests) {
+    int lane = (int)(hash_verify_countdown + 8); // the countdown crossed zero inside this batch
+    if (lane < 0) lane = 0;
+    hash_verify_countdown += next_countdown(); // the overshoot carries over, keeping the mean at 1/rate
+    if ((unsigned)kernel >= HASH_VERIFY_KERNEL_COUNT) return;
+    if (lens) len = lens[lane];
+
+    pthread_mutex_lock(&lock);
+    if (running && !stopping) {
+        counters[kernel].sampled++;
+        if (len > HASH_VERIFY_MAX_INPUT || queue_count == HASH_VERIFY_QUEUE) {
+            counters[kernel].dropped++;
+        } else {
+            VerifyJob* job = &queue[(queue_head + queue_count) % HASH_VERIFY_QUEUE];
+            job->kernel = kernel;
+            job->len = (uint32_t)len;
+            if (inputs[lane]) memcpy(job->input, inputs[lane], len);
+            else memset(job->input, 0, len);
+            memcpy(job->digest, digests + (size_t)lane * digest_sizes[kernel], digest_sizes[kernel]);
+            queue_count++;
+            pthread_cond_signal(&wake);
+        }
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+int hash_verify_start(const HashVerifyConfig* cfg) {
+    pthread_mutex_lock(&lock);
+    if (running) {
+        pthread_mutex_unlock(&lock);
+        return -1;
+    }
+    if (cfg) {
+        config = *cfg;
+    } else {
+        memset(&config, 0, sizeof(config));
+        const char* rate = getenv("HASH_VERIFY_RATE");
+        const char* policy = getenv("HASH_VERIFY_POLICY");
+        if (rate) config.sample_rate = (uint32_t)strtoul(rate, NULL, 10);
+        if (policy && strcmp(policy, "abort") == 0) config.policy = HASH_VERIFY_ABORT;
+    }
+    if (config.sample_rate == 0) config.sample_rate = HASH_VERIFY_DEFAULT_RATE;
+    if (!config.alert) config.alert = default_alert;
+
+    queue = (VerifyJob*)malloc(HASH_VERIFY_QUEUE * sizeof(VerifyJob));
+    if (!queue) {
+        pthread_mutex_unlock(&lock);
+        return -1;
+    }
+    queue_head = queue_count = 0;
+    memset(counters, 0, sizeof(counters));
+    stopping = false;
+    if (pthread_create(&worker, NULL, worker_main, NULL) != 0) {
+        free(queue);
+        queue = NULL;
+        pthread_mutex_unlock(&lock);
+        return -1;
+    }
+    running = true;
+    hash_verify_enabled = 1;
+    pthread_mutex_unlock(&lock);
+    return 0;
+}
+
+void hash_verify_stop(void) {
+    pthread_mutex_lock(&lock);
+    if (!running) {
+        pthread_mutex_unlock(&lock);
+        return;
+    }
+    hash_verify_enabled = 0;
+    stopping = true;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+    pthread_join(worker, NULL);
+
+    pthread_mutex_lock(&lock);
+    running = false;
+    free(queue);
+    queue = NULL;
+    pthread_mutex_unlock(&lock);
+}
+
+void hash_verify_get_counters(HashVerifyCounters out[HASH_VERIFY_KERNEL_COUNT]) {
+    pthread_mutex_lock(&lock);
+    memcpy(out, counters, sizeof(counters));
+    pthread_mutex_unlock(&lock);
+}
+
+#endif // HASH_VERIFY
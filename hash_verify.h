@@ -0,0 +1,119 @@
+/* hash_verify.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+// Optional online verification of the 8-lane kernels.
+//
+// Build every translation unit with -DHASH_VERIFY and link hash_verify.c (plus -lcrypto -lpthread).
+// The one-shot kernels then hand roughly one lane in every sample_rate to a background thread, which
+// recomputes it with OpenSSL and counts checks and mismatches per kernel. A mismatch is reported
+// through the alert callback (default: stderr), or aborts the process under HASH_VERIFY_ABORT.
+// The hot path only decrements a thread-local countdown; inputs are copied when a lane is sampled.
+//
+// Without -DHASH_VERIFY every macro below expands to nothing and hash_verify.c compiles to an empty unit.
+
+#ifndef HASH_VERIFY_H
+#define HASH_VERIFY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    HASH_VERIFY_SHA256 = 0, // sha256_avx8_hash_short, sha256_avx8_hash_lanes (without a prefix state)
+    HASH_VERIFY_SHA256D,    // sha256_avx8_double64
+    HASH_VERIFY_RIPEMD160,  // ripemd160_multi_hash_lanes
+    HASH_VERIFY_HASH160,    // main_full_avx.c: the chained SHA-256 -> RIPEMD-160 pipeline
+    HASH_VERIFY_KERNEL_COUNT
+} HashVerifyKernel;
+
+typedef enum {
+    HASH_VERIFY_ALERT = 0, // count the mismatch, report it and keep running
+    HASH_VERIFY_ABORT      // report the mismatch and abort()
+} HashVerifyPolicy;
+
+#define HASH_VERIFY_DEFAULT_RATE 4096
+#define HASH_VERIFY_MAX_INPUT 512 // longer sampled lanes are counted as dropped
+#define HASH_VERIFY_QUEUE 1024    // pending samples; when full, new samples are dropped
+
+typedef struct {
+    uint64_t sampled;    // lanes picked by the sampler
+    uint64_t checked;    // lanes recomputed by the background thread
+    uint64_t mismatches; // checked lanes whose digest differed from the reference
+    uint64_t dropped;    // sampled lanes not checked (queue full or input too long)
+} HashVerifyCounters;
+
+typedef void (*HashVerifyAlertFn)(HashVerifyKernel kernel, const uint8_t* input, size_t input_len,
+                                  const uint8_t* got, const uint8_t* expected, void* user);
+
+typedef struct {
+    uint32_t sample_rate;    // one lane in sample_rate on average; 0 means HASH_VERIFY_DEFAULT_RATE
+    HashVerifyPolicy policy;
+    HashVerifyAlertFn alert; // NULL prints the failing lane to stderr
+    void* user;
+} HashVerifyConfig;
+
+#ifdef HASH_VERIFY
+
+extern volatile int hash_verify_enabled;
+extern _Thread_local int64_t hash_verify_countdown;
+
+/**
+* @brief Starts the background checker. With a NULL config the rate and policy are taken from
+*        $HASH_VERIFY_RATE and $HASH_VERIFY_POLICY ("alert" or "abort"). Returns 0, or -1 on failure
+*        or if the checker is already running.
+*/
+int hash_verify_start(const HashVerifyConfig* config);
+
+/**
+* @brief Stops sampling, checks every queued sample and joins the background thread.
+*/
+void hash_verify_stop(void);
+
+/**
+* @brief Copies the counters of every kernel.
+*/
+void hash_verify_get_counters(HashVerifyCounters counters[HASH_VERIFY_KERNEL_COUNT]);
+
+/**
+* @brief Queues one lane of a batch for checking. lens may be NULL when every lane has length len;
+*        a NULL input pointer stands for len zero bytes. Called by the macros below.
+*/
+void hash_verify_submit(HashVerifyKernel kernel, const uint8_t* const inputs[8], const size_t* lens, size_t len,
+                        const uint8_t* digests);
+
+// The countdown drops by 8 per batch; the lane where it crosses zero is the one sampled.
+#define HASH_VERIFY_LANES(kernel, inputs, lens, digests) \
+    do { if (hash_verify_enabled && (hash_verify_countdown -= 8) < 0) hash_verify_submit((kernel), (inputs), (lens), 0, (const uint8_t*)(digests)); } while (0)
+#define HASH_VERIFY_LANES_FIXED(kernel, inputs, len, digests) \
+    do { if (hash_verify_enabled && (hash_verify_countdown -= 8) < 0) hash_verify_submit((kernel), (inputs), NULL, (len), (const uint8_t*)(digests)); } while (0)
+
+#else
+
+#define HASH_VERIFY_LANES(kernel, inputs, lens, digests) do { } while (0)
+#define HASH_VERIFY_LANES_FIXED(kernel, inputs, len, digests) do { } while (0)
+
+#endif // HASH_VERIFY
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // HASH_VERIFY_H
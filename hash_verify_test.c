@@ -0,0 +1,182 @@
+/* hash_verify_test.c
+ * gcc -O3 -mavx2 -march=native -DHASH_VERIFY hash_verify_test.c hash_verify.c sha256_avx.c ripemd160_avx.c -o hash_verify_test -lcrypto -lpthread
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <openssl/sha.h>
+
+#include "hash_verify.h"
+#include "sha256_avx.h"
+#include "ripemd160_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+static int alerts = 0;
+static HashVerifyKernel alert_kernel;
+static uint8_t alert_expected[32];
+
+static void record_alert(HashVerifyKernel kernel, const uint8_t* input, size_t input_len,
+                         const uint8_t* got, const uint8_t* expected, void* user) {
+    (void)input; (void)input_len; (void)got; (void)user;
+    alerts++;
+    alert_kernel = kernel;
+    memcpy(alert_expected, expected, 32);
+}
+
+static uint8_t data[8][300];
+static const uint8_t* ptrs[8];
+
+static void run_kernels(int batches) {
+    uint8_t out32[8][32], out20[8][20];
+    size_t lens[8];
+    for (int b = 0; b < batches; b++) {
+        for (int lane = 0; lane < 8; lane++) {
+            data[lane][b % 300] ^= (uint8_t)(b + lane);
+            lens[lane] = (size_t)(b * 7 + lane * 37) % 300;
+        }
+        sha256_avx8_hash_short(ptrs, 33, out32);
+        sha256_avx8_hash_lanes(NULL, 0, ptrs, lens, out32);
+        sha256_avx8_double64(ptrs, out32);
+        ripemd160_multi_hash_lanes(ptrs, lens, out20);
+    }
+}
+
+int main() {
+    printf("--- Correctness Test (Sampled Online Verification) ---\n");
+    int failed_tests = 0;
+    srand(1);
+    for (int lane = 0; lane < 8; lane++) {
+        for (int i = 0; i < 300; i++) data[lane][i] = (uint8_t)rand();
+        ptrs[lane] = data[lane];
+    }
+    HashVerifyCounters c[HASH_VERIFY_KERNEL_COUNT];
+
+    // Rate 1: every batch hands one lane to the checker; a correct kernel never mismatches.
+    HashVerifyConfig config = {1, HASH_VERIFY_ALERT, record_alert, NULL};
+    failed_tests += report("Checker starts, and refuses a second start", hash_verify_start(&config) == 0 && hash_verify_start(&config) == -1);
+    run_kernels(500);
+    hash_verify_stop();
+    hash_verify_get_counters(c);
+    int accounted = 1, mismatches = 0;
+    for (int k = 0; k < HASH_VERIFY_RIPEMD160 + 1; k++) {
+        uint64_t expect = k == HASH_VERIFY_SHA256 ? 1000 : 500; // hash_short and hash_lanes both count as SHA-256
+        if (c[k].sampled != expect || c[k].checked + c[k].dropped != c[k].sampled || c[k].checked == 0) accounted = 0;
+        mismatches += (int)c[k].mismatches;
+    }
+    failed_tests += report("Rate 1: one lane per batch sampled and accounted", accounted);
+    failed_tests += report("No mismatches on correct kernels (4 kernels)", mismatches == 0 && alerts == 0);
+
+    // Injected faults: a flipped bit in the sampled lane must be caught and reported per kernel.
+    uint8_t good[8][32], bad[8][32];
+    sha256_avx8_double64(ptrs, good);
+    failed_tests += report("Restart after stop", hash_verify_start(&config) == 0);
+    memcpy(bad, good, sizeof(bad));
+    bad[3][17] ^= 0x04;
+    hash_verify_countdown = -5; // the countdown crossed zero at lane 3
+    hash_verify_submit(HASH_VERIFY_SHA256D, ptrs, NULL, 64, (const uint8_t*)bad);
+    hash_verify_stop();
+    hash_verify_get_counters(c);
+    failed_tests += report("Corrupted SHA256d lane counted as a mismatch",
+                           c[HASH_VERIFY_SHA256D].mismatches == 1 && c[HASH_VERIFY_SHA256].mismatches == 0);
+    failed_tests += report("Alert callback gets the kernel and the reference digest",
+                           alerts == 1 && alert_kernel == HASH_VERIFY_SHA256D && memcmp(alert_expected, good[3], 32) == 0);
+
+    // Sampling rate: about one lane in 64.
+    config.sample_rate = 64;
+    hash_verify_start(&config);
+    for (int i = 0; i < 20000; i++) {
+        uint8_t out[8][32];
+        sha256_avx8_hash_short(ptrs, 33, out);
+    }
+    hash_verify_stop();
+    hash_verify_get_counters(c);
+    double expected = 20000.0 * 8 / 64;
+    failed_tests += report("Rate 64: sampled lanes within 10% of 1/64",
+                           c[HASH_VERIFY_SHA256].sampled > expected * 0.9 && c[HASH_VERIFY_SHA256].sampled < expected * 1.1);
+
+    // Stopped: the kernels run unsampled.
+    uint8_t out[8][32];
+    sha256_avx8_hash_short(ptrs, 33, out);
+    HashVerifyCounters after[HASH_VERIFY_KERNEL_COUNT];
+    hash_verify_get_counters(after);
+    failed_tests += report("No sampling after stop", memcmp(after, c, sizeof(c)) == 0);
+
+    // NULL lanes of hash_short stand for zero bytes, both in the kernel and in the checker.
+    {
+        const uint8_t* sparse[8] = {ptrs[0], NULL, ptrs[2], NULL, NULL, ptrs[5], NULL, ptrs[7]};
+        uint8_t zeros[33] = {0}, ref[32];
+        SHA256(zeros, sizeof(zeros), ref);
+        int alerts_before = alerts;
+        config.sample_rate = 1;
+        hash_verify_start(&config);
+        int ok = 1;
+        for (int i = 0; i < 64; i++) {
+            sha256_avx8_hash_short(sparse, 33, out);
+            for (int lane = 0; lane < 8; lane++) {
+                if (!sparse[lane]) ok &= memcmp(out[lane], ref, 32) == 0;
+            }
+        }
+        hash_verify_stop();
+        hash_verify_get_counters(after);
+        failed_tests += report("NULL lanes hash zero bytes, no false mismatches",
+                               ok && after[HASH_VERIFY_SHA256].mismatches == 0 && alerts == alerts_before);
+    }
+
+    // Abort policy, in a child process.
+    pid_t pid = fork();
+    if (pid == 0) {
+        int null_fd = open("/dev/null", O_WRONLY);
+        dup2(null_fd, STDERR_FILENO);
+        HashVerifyConfig abort_config = {1, HASH_VERIFY_ABORT, NULL, NULL};
+        hash_verify_start(&abort_config);
+        hash_verify_countdown = -5;
+        hash_verify_submit(HASH_VERIFY_SHA256D, ptrs, NULL, 64, (const uint8_t*)bad);
+        hash_verify_stop();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    failed_tests += report("Abort policy terminates the process with SIGABRT", WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (2M x 8 lanes, 33-byte SHA-256, rate %d) ---\n", HASH_VERIFY_DEFAULT_RATE);
+    const int BATCHES = 2000000;
+    clock_t start = clock();
+    for (int i = 0; i < BATCHES; i++) {
+        data[0][0] = (uint8_t)i;
+        sha256_avx8_hash_short(ptrs, 33, out);
+    }
+    double off = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    HashVerifyConfig bench_config = {HASH_VERIFY_DEFAULT_RATE, HASH_VERIFY_ALERT, NULL, NULL};
+    hash_verify_start(&bench_config);
+    start = clock();
+    for (int i = 0; i < BATCHES; i++) {
+        data[0][0] = (uint8_t)i;
+        sha256_avx8_hash_short(ptrs, 33, out);
+    }
+    hash_verify_stop(); // includes draining the queue, so the checker's work is in the measurement
+    double on = (double)(clock() - start) / CLOCKS_PER_SEC;
+    hash_verify_get_counters(c);
+
+    printf("Unsampled: %.4f seconds (%.1f Million hashes/sec)\n", off, BATCHES * 8.0 / off / 1e6);
+    printf("Sampled:   %.4f seconds (%.1f Million hashes/sec, %llu lanes checked, overhead %.2f%%)\n", on,
+           BATCHES * 8.0 / on / 1e6, (unsigned long long)c[HASH_VERIFY_SHA256].checked, (on / off - 1) * 100);
+    return failed_tests == 0 ? 0 : 1;
+}
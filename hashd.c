@@ -0,0 +1,87 @@
+/*
+* hashd.c
+*
+* Local hashing daemon (see hashd_avx.h). Requests from all clients on the Unix socket are packed into
+* 8-lane batches, which are hashed when full or when their oldest request reaches the deadline.
+* Statistics (p50/p99 latency, lane fill) are printed at exit and can be queried while it runs.
+*
+* Compilation instructions:
+* gcc -O3 -mavx2 -march=native hashd.c hashd_avx.c sha256_avx.c ripemd160_avx.c -o hashd
+*
+* Usage:
+* ./hashd -s /tmp/hashd.sock [-d deadline_us] [-c max_clients]   run the daemon (SIGINT/SIGTERM stop it)
+* ./hashd -s /tmp/hashd.sock -S                                  print the statistics of a running daemon
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include "hashd_avx.h"
+
+static HashdServer* g_server;
+
+static void on_signal(int sig) {
+    (void)sig;
+    hashd_server_stop(g_server);
+}
+
+static void print_stats(const HashdStats* st) {
+    double fill = st->batches ? 100.0 * (double)st->lanes_filled / (8.0 * (double)st->batches) : 0.0;
+    printf("requests: %llu  batches: %llu (%llu full, %llu by deadline)  lane fill: %.1f%%  clients: %llu (%u dropped)\n",
+           (unsigned long long)st->requests, (unsigned long long)st->batches, (unsigned long long)st->full_flushes,
+           (unsigned long long)st->deadline_flushes, fill, (unsigned long long)st->clients_accepted, st->clients_dropped);
+    printf("latency: p50 %u us  p99 %u us  max %u us\n", st->latency_p50_us, st->latency_p99_us, st->latency_max_us);
+}
+
+static void usage(const char* prog) {
+    fprintf(stderr, "Usage: %s -s socket [-d deadline_us] [-c max_clients] | -s socket -S\n", prog);
+}
+
+int main(int argc, char** argv) {
+    HashdConfig config = {NULL, 200, 0};
+    int query = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:d:c:S")) != -1) {
+        switch (opt) {
+        case 's': config.socket_path = optarg; break;
+        case 'd': config.deadline_us = (uint32_t)atol(optarg); break;
+        case 'c': config.max_clients = (uint32_t)atol(optarg); break;
+        case 'S': query = 1; break;
+        default: usage(argv[0]); return 1;
+        }
+    }
+    if (!config.socket_path) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (query) {
+        HashdStats st;
+        int fd = hashd_connect(config.socket_path);
+        if (fd < 0 || hashd_get_stats(fd, &st) != 0) {
+            fprintf(stderr, "Error: cannot query %s\n", config.socket_path);
+            return 1;
+        }
+        close(fd);
+        print_stats(&st);
+        return 0;
+    }
+
+    g_server = hashd_server_create(&config);
+    if (!g_server) {
+        fprintf(stderr, "Error: cannot listen on %s\n", config.socket_path);
+        return 1;
+    }
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    fprintf(stderr, "hashd: listening on %s (deadline %u us)\n", config.socket_path, config.deadline_us);
+    int rc = hashd_server_run(g_server);
+
+    HashdStats st;
+    hashd_server_stats(g_server, &st);
+    print_stats(&st);
+    hashd_server_destroy(g_server);
+    return rc == 0 ? 0 : 1;
+}
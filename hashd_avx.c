@@ -0,0 +1,527 @@
+/* hashd_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#define _GNU_SOURCE
+#include "hashd_avx.h"
+#include "sha256_avx.h"
+#include "ripemd160_avx.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+
+#define HASH_OPS 3                 // SHA256, SHA256D, HASH160: one batch queue each
+#define IN_CAP (64 * 1024)         // per-client receive buffer (whole frames are parsed out of it)
+#define OUT_MAX (1 << 20)          // unsent response bytes per client; past this it is not reading and is dropped
+#define CLIENT_WINDOW 4096         // requests hashd_hash_many keeps in flight: their responses stay far below OUT_MAX
+#define HIST_US 16384              // latency histogram: 1 us buckets, the last one collects the tail
+#define EV_LISTEN 0xFFFFFFFFu
+#define EV_TIMER  0xFFFFFFFEu
+#define EV_STOP   0xFFFFFFFDu
+
+typedef struct {
+    int fd;                 // -1 when the slot is free
+    uint32_t generation;    // bumped on close, so queued requests of a closed client are dropped
+    uint8_t* in;
+    size_t in_len;
+    uint8_t* out;           // response bytes a previous writev() could not send
+    size_t out_len, out_cap;
+} Client;
+
+typedef struct {
+    uint32_t client, generation, id;
+    uint16_t length;
+    uint64_t arrival_ns;
+    uint8_t data[HASHD_MAX_MESSAGE];
+} Pending;
+
+typedef struct {
+    Pending lane[8];
+    int count;
+} Queue;
+
+struct HashdServer {
+    int listen_fd, epoll_fd, timer_fd, stop_fd;
+    char* path;
+    uint32_t deadline_us;
+    uint32_t max_clients;
+    Client* clients;
+    Queue queues[HASH_OPS];
+    HashdStats stats;
+    uint64_t* hist;
+    uint64_t hist_total;
+};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void record_latency(HashdServer* s, uint64_t ns) {
+    uint64_t us = ns / 1000;
+    if (us > s->stats.latency_max_us) s->stats.latency_max_us = us > UINT32_MAX ? UINT32_MAX : (uint32_t)us;
+    s->hist[us < HIST_US ? us : HIST_US - 1]++;
+    s->hist_total++;
+}
+
+static uint32_t percentile(const HashdServer* s, uint64_t per_mille) {
+    if (s->hist_total == 0) return 0;
+    uint64_t rank = (s->hist_total * per_mille + 999) / 1000, seen = 0;
+    for (uint32_t us = 0; us < HIST_US; us++) {
+        seen += s->hist[us];
+        if (seen >= rank) return us;
+    }
+    return HIST_US - 1;
+}
+
+void hashd_server_stats(const HashdServer* server, HashdStats* stats) {
+    if (!server || !stats) return;
+    *stats = server->stats;
+    stats->latency_p50_us = percentile(server, 500);
+    stats->latency_p99_us = percentile(server, 990);
+}
+
+static void close_client(HashdServer* s, uint32_t index) {
+    Client* c = &s->clients[index];
+    if (c->fd < 0) return;
+    epoll_ctl(s->epoll_fd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    c->fd = -1;
+    c->generation++;
+    c->in_len = 0;
+    c->out_len = 0;
+}
+
+static int append_out(Client* c, const struct iovec* iov, int iovcnt, size_t skip) {
+    size_t need = c->out_len;
+    for (int i = 0; i < iovcnt; i++) need += iov[i].iov_len;
+    need -= skip;
+    if (need > OUT_MAX) return -1;
+    if (need > c->out_cap) {
+        size_t cap = c->out_cap ? c->out_cap : 4096;
+        while (cap < need) cap *= 2;
+        uint8_t* grown = (uint8_t*)realloc(c->out, cap);
+        if (!grown) return -1;
+        c->out = grown;
+        c->out_cap = cap;
+    }
+    for (int i = 0; i < iovcnt; i++) {
+        size_t len = iov[i].iov_len;
+        const uint8_t* base = (const uint8_t*)iov[i].iov_base;
+        if (skip >= len) {
+            skip -= len;
+            continue;
+        }
+        memcpy(c->out + c->out_len, base + skip, len - skip);
+        c->out_len += len - skip;
+        skip = 0;
+    }
+    return 0;
+}
+
+// Sends the frames directly when nothing is queued for this client; whatever the socket does not take is
+// buffered and sent on EPOLLOUT, so frames are never interleaved.
+static void send_frames(HashdServer* s, uint32_t index, const struct iovec* iov, int iovcnt) {
+    Client* c = &s->clients[index];
+    size_t sent = 0;
+    if (c->fd < 0) return;
+    if (c->out_len == 0) {
+        ssize_t n = writev(c->fd, iov, iovcnt);
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            close_client(s, index);
+            return;
+        }
+        sent = n > 0 ? (size_t)n : 0;
+        size_t total = 0;
+        for (int i = 0; i < iovcnt; i++) total += iov[i].iov_len;
+        if (sent == total) return;
+    }
+    if (append_out(c, iov, iovcnt, sent) != 0) {
+        close_client(s, index);
+        s->stats.clients_dropped++;
+        return;
+    }
+    struct epoll_event ev = {.events = EPOLLIN | EPOLLOUT, .data.u32 = index};
+    epoll_ctl(s->epoll_fd, EPOLL_CTL_MOD, c->fd, &ev);
+}
+
+static void send_response(HashdServer* s, uint32_t index, uint32_t id, uint8_t status, const void* payload, uint16_t len) {
+    HashdResponseHeader header = {id, status, 0, len};
+    struct iovec iov[2] = {{&header, sizeof(header)}, {(void*)payload, len}};
+    send_frames(s, index, iov, len ? 2 : 1);
+}
+
+static void flush_queue(HashdServer* s, int op_index, bool full) {
+    Queue* q = &s->queues[op_index];
+    if (q->count == 0) return;
+    const uint8_t* ptrs[8];
+    size_t lens[8];
+    uint8_t sha[8][32], digests[8][32];
+    for (int lane = 0; lane < 8; lane++) {
+        const Pending* p = &q->lane[lane < q->count ? lane : 0];
+        ptrs[lane] = p->data;
+        lens[lane] = p->length;
+    }
+    uint8_t op = (uint8_t)(op_index + HASHD_OP_SHA256);
+    uint16_t digest_len = op == HASHD_OP_HASH160 ? 20 : 32;
+    sha256_avx8_hash_lanes(NULL, 0, ptrs, lens, op == HASHD_OP_SHA256 ? digests : sha);
+    if (op != HASHD_OP_SHA256) {
+        for (int lane = 0; lane < 8; lane++) {
+            ptrs[lane] = sha[lane];
+            lens[lane] = 32;
+        }
+        if (op == HASHD_OP_SHA256D) {
+            sha256_avx8_hash_short(ptrs, 32, digests);
+        } else {
+            uint8_t h160[8][20];
+            ripemd160_multi_hash_lanes(ptrs, lens, h160);
+            for (int lane = 0; lane < 8; lane++) memcpy(digests[lane], h160[lane], 20);
+        }
+    }
+
+    // One writev per client, the digests referenced in place.
+    HashdResponseHeader headers[8];
+    bool done[8] = {false};
+    for (int lane = 0; lane < q->count; lane++) {
+        if (done[lane]) continue;
+        const Pending* p = &q->lane[lane];
+        struct iovec iov[16];
+        int iovcnt = 0;
+        for (int other = lane; other < q->count; other++) {
+            const Pending* o = &q->lane[other];
+            if (o->client != p->client || o->generation != p->generation) continue;
+            done[other] = true;
+            headers[other] = (HashdResponseHeader){o->id, HASHD_STATUS_OK, 0, digest_len};
+            iov[iovcnt++] = (struct iovec){&headers[other], sizeof(HashdResponseHeader)};
+            iov[iovcnt++] = (struct iovec){digests[other], digest_len};
+        }
+        if (s->clients[p->client].generation == p->generation && s->clients[p->client].fd >= 0) {
+            send_frames(s, p->client, iov, iovcnt);
+        }
+    }
+
+    uint64_t now = now_ns();
+    for (int lane = 0; lane < q->count; lane++) record_latency(s, now - q->lane[lane].arrival_ns);
+    s->stats.requests += (uint64_t)q->count;
+    s->stats.batches++;
+    s->stats.lanes_filled += (uint64_t)q->count;
+    if (full) s->stats.full_flushes++;
+    else s->stats.deadline_flushes++;
+    q->count = 0;
+}
+
+// Flushes queues whose oldest request is due and arms the timer for the earliest remaining one.
+static void check_deadlines(HashdServer* s) {
+    uint64_t now = now_ns(), next = 0;
+    for (int op = 0; op < HASH_OPS; op++) {
+        Queue* q = &s->queues[op];
+        if (q->count == 0) continue;
+        uint64_t due = q->lane[0].arrival_ns + (uint64_t)s->deadline_us * 1000;
+        if (due <= now) flush_queue(s, op, false);
+        else if (next == 0 || due < next) next = due;
+    }
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = (time_t)(next / 1000000000ull);
+    its.it_value.tv_nsec = (long)(next % 1000000000ull);
+    timerfd_settime(s->timer_fd, TFD_TIMER_ABSTIME, &its, NULL); // next == 0 disarms
+}
+
+// Parses whole frames out of the client's buffer; returns -1 when the client must be dropped.
+static int parse_frames(HashdServer* s, uint32_t index) {
+    Client* c = &s->clients[index];
+    size_t pos = 0;
+    uint64_t arrival = now_ns();
+    while (c->in_len - pos >= sizeof(HashdRequestHeader)) {
+        HashdRequestHeader h;
+        memcpy(&h, c->in + pos, sizeof(h));
+        if (h.length > HASHD_MAX_MESSAGE) {
+            send_response(s, index, h.id, HASHD_STATUS_TOO_LONG, NULL, 0);
+            return -1;
+        }
+        if (c->in_len - pos < sizeof(h) + h.length) break;
+        const uint8_t* msg = c->in + pos + sizeof(h);
+        pos += sizeof(h) + h.length;
+
+        if (h.op == HASHD_OP_STATS) {
+            HashdStats st;
+            hashd_server_stats(s, &st);
+            send_response(s, index, h.id, HASHD_STATUS_OK, &st, (uint16_t)sizeof(st));
+        } else if (h.op >= HASHD_OP_SHA256 && h.op <= HASHD_OP_HASH160) {
+            int op = h.op - HASHD_OP_SHA256;
+            Queue* q = &s->queues[op];
+            Pending* p = &q->lane[q->count++];
+            p->client = index;
+            p->generation = c->generation;
+            p->id = h.id;
+            p->length = h.length;
+            p->arrival_ns = arrival;
+            memcpy(p->data, msg, h.length);
+            if (q->count == 8) flush_queue(s, op, true);
+        } else {
+            send_response(s, index, h.id, HASHD_STATUS_BAD_OP, NULL, 0);
+        }
+        if (c->fd < 0) return -1; // a failed send closed it
+    }
+    memmove(c->in, c->in + pos, c->in_len - pos);
+    c->in_len -= pos;
+    return 0;
+}
+
+// One read per wakeup (level-triggered), so a busy client cannot starve the others.
+static void handle_readable(HashdServer* s, uint32_t index) {
+    Client* c = &s->clients[index];
+    ssize_t n = read(c->fd, c->in + c->in_len, IN_CAP - c->in_len);
+    if (n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) return;
+    if (n <= 0) {
+        close_client(s, index);
+        return;
+    }
+    c->in_len += (size_t)n;
+    if (parse_frames(s, index) != 0) close_client(s, index);
+}
+
+static void handle_writable(HashdServer* s, uint32_t index) {
+    Client* c = &s->clients[index];
+    if (c->fd < 0) return;
+    while (c->out_len) {
+        ssize_t n = write(c->fd, c->out, c->out_len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        if (n <= 0) {
+            close_client(s, index);
+            return;
+        }
+        memmove(c->out, c->out + n, c->out_len - (size_t)n);
+        c->out_len -= (size_t)n;
+    }
+    struct epoll_event ev = {.events = EPOLLIN, .data.u32 = index};
+    epoll_ctl(s->epoll_fd, EPOLL_CTL_MOD, c->fd, &ev);
+}
+
+static void accept_clients(HashdServer* s) {
+    for (;;) {
+        int fd = accept4(s->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        uint32_t index = 0;
+        while (index < s->max_clients && s->clients[index].fd >= 0) index++;
+        if (index == s->max_clients) {
+            close(fd);
+            continue;
+        }
+        Client* c = &s->clients[index];
+        if (!c->in && !(c->in = (uint8_t*)malloc(IN_CAP))) {
+            close(fd);
+            continue;
+        }
+        c->fd = fd;
+        struct epoll_event ev = {.events = EPOLLIN, .data.u32 = index};
+        epoll_ctl(s->epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+        s->stats.clients_accepted++;
+    }
+}
+
+HashdServer* hashd_server_create(const HashdConfig* config) {
+    if (!config || !config->socket_path) return NULL;
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(config->socket_path) >= sizeof(addr.sun_path)) return NULL;
+    strcpy(addr.sun_path, config->socket_path);
+
+    HashdServer* s = (HashdServer*)calloc(1, sizeof(HashdServer));
+    if (!s) return NULL;
+    s->listen_fd = s->epoll_fd = s->timer_fd = s->stop_fd = -1;
+    s->deadline_us = config->deadline_us;
+    s->max_clients = config->max_clients ? config->max_clients : 1024;
+    s->path = strdup(config->socket_path);
+    s->clients = (Client*)calloc(s->max_clients, sizeof(Client));
+    s->hist = (uint64_t*)calloc(HIST_US, sizeof(uint64_t));
+    if (!s->path || !s->clients || !s->hist) goto fail;
+    for (uint32_t i = 0; i < s->max_clients; i++) s->clients[i].fd = -1;
+
+    unlink(config->socket_path);
+    s->listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (s->listen_fd < 0 || bind(s->listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(s->listen_fd, 256) != 0) goto fail;
+    s->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    s->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    s->stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (s->epoll_fd < 0 || s->timer_fd < 0 || s->stop_fd < 0) goto fail;
+    struct epoll_event ev = {.events = EPOLLIN, .data.u32 = EV_LISTEN};
+    epoll_ctl(s->epoll_fd, EPOLL_CTL_ADD, s->listen_fd, &ev);
+    ev.data.u32 = EV_TIMER;
+    epoll_ctl(s->epoll_fd, EPOLL_CTL_ADD, s->timer_fd, &ev);
+    ev.data.u32 = EV_STOP;
+    epoll_ctl(s->epoll_fd, EPOLL_CTL_ADD, s->stop_fd, &ev);
+    return s;
+
+fail:
+    hashd_server_destroy(s);
+    return NULL;
+}
+
+int hashd_server_run(HashdServer* s) {
+    if (!s) return -1;
+    signal(SIGPIPE, SIG_IGN);
+    struct epoll_event events[64];
+    for (;;) {
+        int n = epoll_wait(s->epoll_fd, events, 64, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        for (int i = 0; i < n; i++) {
+            uint32_t tag = events[i].data.u32;
+            if (tag == EV_STOP) return 0;
+            if (tag == EV_LISTEN) {
+                accept_clients(s);
+            } else if (tag == EV_TIMER) {
+                uint64_t expirations;
+                if (read(s->timer_fd, &expirations, sizeof(expirations)) < 0) { /* spurious wakeup */ }
+            } else {
+                // An earlier event of this wakeup may have closed the client (a failed send during a flush).
+                if (s->clients[tag].fd < 0) continue;
+                if (events[i].events & EPOLLOUT) handle_writable(s, tag);
+                if (s->clients[tag].fd >= 0 && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) handle_readable(s, tag);
+            }
+        }
+        // Everything that arrived in this wakeup has been queued: flush what is due.
+        check_deadlines(s);
+    }
+}
+
+void hashd_server_stop(HashdServer* server) {
+    if (!server) return;
+    uint64_t one = 1;
+    if (write(server->stop_fd, &one, sizeof(one)) < 0) { /* already signalled */ }
+}
+
+void hashd_server_destroy(HashdServer* s) {
+    if (!s) return;
+    if (s->clients) {
+        for (uint32_t i = 0; i < s->max_clients; i++) {
+            if (s->clients[i].fd >= 0) close(s->clients[i].fd);
+            free(s->clients[i].in);
+            free(s->clients[i].out);
+        }
+    }
+    if (s->listen_fd >= 0) {
+        close(s->listen_fd);
+        unlink(s->path);
+    }
+    if (s->epoll_fd >= 0) close(s->epoll_fd);
+    if (s->timer_fd >= 0) close(s->timer_fd);
+    if (s->stop_fd >= 0) close(s->stop_fd);
+    free(s->clients);
+    free(s->hist);
+    free(s->path);
+    free(s);
+}
+
+// --- Client ---
+
+int hashd_connect(const char* socket_path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (!socket_path || strlen(socket_path) >= sizeof(addr.sun_path)) return -1;
+    strcpy(addr.sun_path, socket_path);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int write_all(int fd, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    while (len) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static int read_all(int fd, void* data, size_t len) {
+    uint8_t* p = (uint8_t*)data;
+    while (len) {
+        ssize_t n = read(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+int hashd_hash_many(int fd, uint8_t op, const uint8_t* const* messages, const size_t* lengths, size_t count,
+                    uint8_t (*digests)[32]) {
+    if (fd < 0 || op < HASHD_OP_SHA256 || op > HASHD_OP_HASH160 || (count && (!messages || !lengths || !digests))) return -1;
+    if (count > UINT32_MAX) return -1;
+    for (size_t i = 0; i < count; i++) {
+        if (lengths[i] > HASHD_MAX_MESSAGE) return -1;
+    }
+    _Static_assert(CLIENT_WINDOW * (sizeof(HashdResponseHeader) + 32) < OUT_MAX / 4, "CLIENT_WINDOW is too large");
+    uint8_t frame[sizeof(HashdRequestHeader) + HASHD_MAX_MESSAGE];
+    size_t sent = 0;
+    int rc = 0;
+    for (size_t received = 0; received < count; received++) {
+        // Keep at most CLIENT_WINDOW requests unanswered, so the daemon never holds more unsent
+        // responses for this client than it allows a reader that keeps up.
+        for (; sent < count && sent - received < CLIENT_WINDOW; sent++) {
+            HashdRequestHeader h = {(uint32_t)sent, op, 0, (uint16_t)lengths[sent]};
+            memcpy(frame, &h, sizeof(h));
+            if (lengths[sent]) memcpy(frame + sizeof(h), messages[sent], lengths[sent]);
+            if (write_all(fd, frame, sizeof(h) + lengths[sent]) != 0) return -1;
+        }
+        HashdResponseHeader r;
+        uint8_t payload[32];
+        if (read_all(fd, &r, sizeof(r)) != 0 || r.length > sizeof(payload) || read_all(fd, payload, r.length) != 0) return -1;
+        if (r.status != HASHD_STATUS_OK || r.id >= count) {
+            rc = -1;
+            continue;
+        }
+        memcpy(digests[r.id], payload, r.length);
+    }
+    return rc;
+}
+
+int hashd_get_stats(int fd, HashdStats* stats) {
+    if (fd < 0 || !stats) return -1;
+    HashdRequestHeader h = {0, HASHD_OP_STATS, 0, 0};
+    HashdResponseHeader r;
+    if (write_all(fd, &h, sizeof(h)) != 0 || read_all(fd, &r, sizeof(r)) != 0) return -1;
+    if (r.status != HASHD_STATUS_OK || r.length != sizeof(HashdStats)) return -1;
+    return read_all(fd, stats, sizeof(HashdStats));
+}
@@ -0,0 +1,140 @@
+/* hashd_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef HASHD_AVX_H
+#define HASHD_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Local hashing daemon: many client processes send small hash requests over a Unix stream socket and
+// the daemon packs them, across clients, into 8-lane batches. A batch of one operation is hashed as
+// soon as it has 8 requests, or when its oldest request reaches the configured deadline (timerfd, so
+// the deadline has microsecond resolution). Responses of a batch are gathered with writev() straight
+// from the batch's digest array, one call per client.
+//
+// Wire format (host byte order, the peers share a host):
+//   request:  HashdRequestHeader, then `length` message bytes
+//   response: HashdResponseHeader, then `digest_len` digest bytes
+// A client may pipeline any number of requests; responses carry the request id and may arrive in any order.
+
+#define HASHD_OP_SHA256   1 // SHA-256
+#define HASHD_OP_SHA256D  2 // SHA256(SHA256(m))
+#define HASHD_OP_HASH160  3 // RIPEMD160(SHA256(m))
+#define HASHD_OP_STATS    4 // no message; the response payload is a HashdStats
+
+#define HASHD_STATUS_OK        0
+#define HASHD_STATUS_BAD_OP    1
+#define HASHD_STATUS_TOO_LONG  2
+
+#define HASHD_MAX_MESSAGE 1024
+
+typedef struct {
+    uint32_t id;        // echoed in the response
+    uint8_t op;         // HASHD_OP_*
+    uint8_t reserved;
+    uint16_t length;    // message bytes that follow (at most HASHD_MAX_MESSAGE)
+} HashdRequestHeader;
+
+typedef struct {
+    uint32_t id;
+    uint8_t status;     // HASHD_STATUS_*
+    uint8_t reserved;
+    uint16_t length;    // payload bytes that follow (digest, or sizeof(HashdStats))
+} HashdResponseHeader;
+
+typedef struct {
+    uint64_t requests;         // hash requests answered
+    uint64_t batches;          // 8-lane batches hashed
+    uint64_t lanes_filled;     // requests carried by those batches (fill = lanes_filled / (8 * batches))
+    uint64_t full_flushes;     // batches flushed because they were full
+    uint64_t deadline_flushes; // batches flushed by the deadline
+    uint64_t clients_accepted;
+    uint32_t latency_p50_us;   // receive-to-reply latency percentiles, 1 us resolution
+    uint32_t latency_p99_us;
+    uint32_t latency_max_us;
+    uint32_t clients_dropped;  // clients closed because their unsent responses passed 1 MiB
+} HashdStats;
+
+typedef struct {
+    const char* socket_path;   // created by the server (an existing socket file is replaced)
+    uint32_t deadline_us;      // flush a partial batch once its oldest request is this old (0: flush immediately)
+    uint32_t max_clients;      // 0: 1024
+} HashdConfig;
+
+typedef struct HashdServer HashdServer;
+
+/**
+* @brief Binds and listens on the configured socket.
+* @return The server, or NULL if the socket cannot be created.
+*/
+HashdServer* hashd_server_create(const HashdConfig* config);
+
+/**
+* @brief Runs the event loop in the calling thread until hashd_server_stop() is called.
+* @return 0 after a stop, -1 on a fatal error.
+*/
+int hashd_server_run(HashdServer* server);
+
+/**
+* @brief Makes hashd_server_run() return after the current iteration. Safe from signal handlers and other threads.
+*/
+void hashd_server_stop(HashdServer* server);
+
+/**
+* @brief Current statistics (call from the thread running the server, or after it has returned).
+*/
+void hashd_server_stats(const HashdServer* server, HashdStats* stats);
+
+/**
+* @brief Closes all connections, removes the socket file and frees the server.
+*/
+void hashd_server_destroy(HashdServer* server);
+
+// --- Client ---
+
+/**
+* @brief Connects to a daemon.
+* @return A socket descriptor, or -1.
+*/
+int hashd_connect(const char* socket_path);
+
+/**
+* @brief Sends `count` requests of one operation (pipelined) and waits for all responses.
+* At most a few thousand requests are in flight at a time; larger counts are sent as responses arrive.
+* @param digests Output, one 32-byte slot per message (HASH160 uses the first 20 bytes).
+* @return 0 on success, -1 on a connection error or a non-OK status.
+*/
+int hashd_hash_many(int fd, uint8_t op, const uint8_t* const* messages, const size_t* lengths, size_t count,
+                    uint8_t (*digests)[32]);
+
+/**
+* @brief Fetches the daemon statistics.
+* @return 0 on success, -1 on error.
+*/
+int hashd_get_stats(int fd, HashdStats* stats);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // HASHD_AVX_H
@@ -0,0 +1,238 @@
+/* hashd_test.c
+ * gcc -O3 -mavx2 -march=native hashd_test.c hashd_avx.c sha256_avx.c ripemd160_avx.c -o hashd_test -lcrypto -lpthread
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <openssl/sha.h>
+#include <openssl/ripemd.h>
+
+#include "hashd_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+static void* run_server(void* arg) {
+    hashd_server_run((HashdServer*)arg);
+    return NULL;
+}
+
+static HashdServer* start_server(const char* path, uint32_t deadline_us, pthread_t* thread) {
+    HashdConfig config = {path, deadline_us, 0};
+    HashdServer* server = hashd_server_create(&config);
+    if (server) pthread_create(thread, NULL, run_server, server);
+    return server;
+}
+
+static void stop_server(HashdServer* server, pthread_t thread) {
+    hashd_server_stop(server);
+    pthread_join(thread, NULL);
+    hashd_server_destroy(server);
+}
+
+static void reference(uint8_t op, const uint8_t* msg, size_t len, uint8_t out[32]) {
+    uint8_t sha[32];
+    SHA256(msg, len, sha);
+    if (op == HASHD_OP_SHA256) memcpy(out, sha, 32);
+    else if (op == HASHD_OP_SHA256D) SHA256(sha, 32, out);
+    else RIPEMD160(sha, 32, out);
+}
+
+static double elapsed_us(const struct timespec* a, const struct timespec* b) {
+    return (double)(b->tv_sec - a->tv_sec) * 1e6 + (double)(b->tv_nsec - a->tv_nsec) / 1e3;
+}
+
+// Client process: `rounds` synchronous requests of `per_round` messages; exits 0 when all digests match.
+static int client_process(const char* path, int rounds, int per_round, unsigned seed) {
+    int fd = hashd_connect(path);
+    if (fd < 0) return 1;
+    srand(seed);
+    uint8_t msgs[8][200], digests[8][32], ref[32];
+    const uint8_t* ptrs[8];
+    size_t lens[8];
+    for (int r = 0; r < rounds; r++) {
+        uint8_t op = (uint8_t)(HASHD_OP_SHA256 + r % 3);
+        for (int i = 0; i < per_round; i++) {
+            lens[i] = (size_t)(rand() % 200);
+            for (size_t j = 0; j < lens[i]; j++) msgs[i][j] = (uint8_t)rand();
+            ptrs[i] = msgs[i];
+        }
+        if (hashd_hash_many(fd, op, ptrs, lens, (size_t)per_round, digests) != 0) return 1;
+        for (int i = 0; i < per_round; i++) {
+            reference(op, msgs[i], lens[i], ref);
+            if (memcmp(digests[i], ref, op == HASHD_OP_HASH160 ? 20 : 32) != 0) return 1;
+        }
+    }
+    close(fd);
+    return 0;
+}
+
+static int run_clients(const char* path, int clients, int rounds, int per_round) {
+    int bad = 0;
+    for (int c = 0; c < clients; c++) {
+        if (fork() == 0) _exit(client_process(path, rounds, per_round, (unsigned)c + 1));
+    }
+    for (int c = 0; c < clients; c++) {
+        int status;
+        wait(&status);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) bad++;
+    }
+    return bad;
+}
+
+int main() {
+    printf("--- Correctness Test (Hashing Daemon, Unix Socket Micro-batching) ---\n");
+    int failed_tests = 0;
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/hashd_test_%d.sock", (int)getpid());
+    pthread_t thread;
+
+    // Pipelined requests of every operation and lengths 0..1024 from one client.
+    HashdServer* server = start_server(path, 200, &thread);
+    int fd = server ? hashd_connect(path) : -1;
+    const size_t N = 1025;
+    uint8_t* data = (uint8_t*)malloc(N);
+    const uint8_t** ptrs = (const uint8_t**)malloc(N * sizeof(uint8_t*));
+    size_t* lens = (size_t*)malloc(N * sizeof(size_t));
+    uint8_t (*digests)[32] = (uint8_t (*)[32])malloc(N * 32);
+    for (size_t i = 0; i < N; i++) {
+        data[i] = (uint8_t)(i * 7);
+        ptrs[i] = data;
+        lens[i] = i;
+    }
+    int mismatches = 0;
+    for (uint8_t op = HASHD_OP_SHA256; op <= HASHD_OP_HASH160; op++) {
+        if (hashd_hash_many(fd, op, ptrs, lens, N, digests) != 0) {
+            mismatches++;
+            continue;
+        }
+        for (size_t i = 0; i < N; i++) {
+            uint8_t ref[32];
+            reference(op, data, i, ref);
+            if (memcmp(digests[i], ref, op == HASHD_OP_HASH160 ? 20 : 32) != 0) mismatches++;
+        }
+    }
+    failed_tests += report("SHA256/SHA256D/HASH160, lengths 0..1024, pipelined", fd >= 0 && mismatches == 0);
+
+    HashdStats st;
+    int stats_ok = hashd_get_stats(fd, &st) == 0 && st.requests == 3 * N && st.lanes_filled == st.requests &&
+                   st.full_flushes + st.deadline_flushes == st.batches && st.full_flushes * 8 >= st.requests * 9 / 10;
+    failed_tests += report("Stats query counts requests and full batches", stats_ok);
+
+    HashdRequestHeader bad = {77, 9, 0, 0};
+    HashdResponseHeader reply = {0, 0, 0, 0};
+    int bad_ok = write(fd, &bad, sizeof(bad)) == (ssize_t)sizeof(bad) && read(fd, &reply, sizeof(reply)) == (ssize_t)sizeof(reply);
+    failed_tests += report("Unknown operation answered with BAD_OP", bad_ok && reply.id == 77 && reply.status == HASHD_STATUS_BAD_OP);
+    close(fd);
+
+    // Concurrent client processes with one request in flight each are packed into shared batches.
+    int client_failures = run_clients(path, 8, 200, 1);
+    fd = hashd_connect(path);
+    HashdStats before = st;
+    hashd_get_stats(fd, &st);
+    close(fd);
+    double fill = (double)(st.lanes_filled - before.lanes_filled) / (double)(st.batches - before.batches);
+    failed_tests += report("8 client processes: digests correct", client_failures == 0);
+    failed_tests += report("Requests from different clients share batches", fill > 1.5);
+    printf("  (average lanes per batch across clients: %.2f)\n", fill);
+
+    // A client that sends requests but never reads its responses is dropped once they pass 1 MiB.
+    {
+        int hog = hashd_connect(path);
+        HashdRequestHeader req = {0, HASHD_OP_SHA256, 0, 0};
+        uint32_t sent = 0;
+        while (hog >= 0 && sent < 200000) {
+            req.id = sent;
+            if (send(hog, &req, sizeof(req), MSG_NOSIGNAL) != (ssize_t)sizeof(req)) break;
+            sent++;
+        }
+        if (hog >= 0) close(hog);
+        fd = hashd_connect(path);
+        int ok = hashd_get_stats(fd, &st) == 0;
+        close(fd);
+        failed_tests += report("Client that never reads is dropped, server keeps serving",
+                               ok && sent < 200000 && st.clients_dropped == 1);
+    }
+
+    // A batch whose responses would pass that cap if all were sent up front still completes.
+    {
+        const size_t BIG = 100000;
+        const uint8_t** big_ptrs = (const uint8_t**)malloc(BIG * sizeof(uint8_t*));
+        size_t* big_lens = (size_t*)malloc(BIG * sizeof(size_t));
+        uint8_t (*big_digests)[32] = (uint8_t (*)[32])malloc(BIG * 32);
+        for (size_t i = 0; i < BIG; i++) {
+            big_ptrs[i] = data + (i % 1000);
+            big_lens[i] = 16;
+        }
+        fd = hashd_connect(path);
+        int ok = hashd_hash_many(fd, HASHD_OP_SHA256, big_ptrs, big_lens, BIG, big_digests) == 0;
+        for (size_t i = 0; ok && i < BIG; i++) {
+            uint8_t ref[32];
+            reference(HASHD_OP_SHA256, big_ptrs[i], 16, ref);
+            ok = memcmp(big_digests[i], ref, 32) == 0;
+        }
+        ok = ok && hashd_get_stats(fd, &st) == 0 && st.clients_dropped == 1;
+        close(fd);
+        free(big_ptrs);
+        free(big_lens);
+        free(big_digests);
+        failed_tests += report("100000 pipelined requests complete without a drop", ok);
+    }
+    stop_server(server, thread);
+
+    // Deadline: a lone request waits for the deadline; a full batch does not.
+    server = start_server(path, 5000, &thread);
+    fd = hashd_connect(path);
+    struct timespec t0, t1, t2;
+    const uint8_t* one[8] = {data, data, data, data, data, data, data, data};
+    size_t one_len[8] = {32, 32, 32, 32, 32, 32, 32, 32};
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    hashd_hash_many(fd, HASHD_OP_SHA256, one, one_len, 1, digests);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    hashd_hash_many(fd, HASHD_OP_SHA256, one, one_len, 8, digests);
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    double lone = elapsed_us(&t0, &t1), full = elapsed_us(&t1, &t2);
+    failed_tests += report("Partial batch flushed at the 5 ms deadline", lone >= 5000 && lone < 50000);
+    failed_tests += report("Full batch flushed without waiting", full < 5000);
+    hashd_get_stats(fd, &st);
+    failed_tests += report("Deadline and full flushes reported separately", st.deadline_flushes == 1 && st.full_flushes == 1);
+    close(fd);
+    stop_server(server, thread);
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (8 client processes x 5000 x 8-message requests, 100 us deadline) ---\n");
+    server = start_server(path, 100, &thread);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int bench_failures = run_clients(path, 8, 5000, 8);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    fd = hashd_connect(path);
+    hashd_get_stats(fd, &st);
+    close(fd);
+    stop_server(server, thread);
+    double secs = elapsed_us(&t0, &t1) / 1e6;
+    printf("Requests: %llu in %.3f seconds (%.0f Thousand hashes/sec, %d client failures)\n",
+           (unsigned long long)st.requests, secs, (double)st.requests / secs / 1e3, bench_failures);
+    printf("Lane fill: %.1f%% (%llu batches, %llu by deadline)\n", 100.0 * (double)st.lanes_filled / (8.0 * (double)st.batches),
+           (unsigned long long)st.batches, (unsigned long long)st.deadline_flushes);
+    printf("Latency: p50 %u us, p99 %u us, max %u us\n", st.latency_p50_us, st.latency_p99_us, st.latency_max_us);
+
+    free(data);
+    free(ptrs);
+    free(lens);
+    free(digests);
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+/* hex_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "hex_avx.h"
+#include <immintrin.h>
+
+static const char hex_digits[16] = {'0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f'};
+
+static inline int hex_value(unsigned char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// 32 characters -> 32 nibble values; returns a mask with a bit set for every invalid character.
+static inline uint32_t nibbles_avx2(__m256i chars, __m256i* nibbles) {
+    const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    // Unsigned range checks: x <= k  <=>  min(x, k) == x.
+    const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+    *nibbles = _mm256_blendv_epi8(_mm256_add_epi8(letter, _mm256_set1_epi8(10)), digit, is_digit);
+    return ~(uint32_t)_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter));
+}
+
+size_t hex_decode_avx2(const char* hex, size_t hex_len, uint8_t* out) {
+    if (hex_len & 1) return HEX_DECODE_ERROR;
+    size_t i = 0;
+    for (; i + 32 <= hex_len; i += 32) {
+        __m256i nib;
+        if (nibbles_avx2(_mm256_loadu_si256((const __m256i*)(hex + i)), &nib)) return HEX_DECODE_ERROR;
+        // (hi, lo) byte pairs -> hi * 16 + lo in 16-bit lanes, then narrowed to bytes.
+        __m256i words = _mm256_maddubs_epi16(nib, _mm256_set1_epi16(0x0110));
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(words, words), 0x08);
+        _mm_storeu_si128((__m128i*)(out + i / 2), _mm256_castsi256_si128(packed));
+    }
+    for (; i < hex_len; i += 2) {
+        int hi = hex_value((unsigned char)hex[i]), lo = hex_value((unsigned char)hex[i + 1]);
+        if (hi < 0 || lo < 0) return HEX_DECODE_ERROR;
+        out[i / 2] = (uint8_t)(hi << 4 | lo);
+    }
+    return hex_len / 2;
+}
+
+void hex_encode_avx2(const uint8_t* data, size_t len, char* out) {
+    const __m256i lut = _mm256_setr_epi8('0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f',
+                                         '0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f');
+    const __m256i low4 = _mm256_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), low4));
+        __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(bytes, low4));
+        // unpack works within 128-bit halves: a = bytes 0-7 | 16-23, b = bytes 8-15 | 24-31.
+        __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256((__m256i*)(out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i*)(out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    if (i + 16 <= len) {
+        const __m128i lut128 = _mm256_castsi256_si128(lut);
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i hi = _mm_shuffle_epi8(lut128, _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm256_castsi256_si128(low4)));
+        __m128i lo = _mm_shuffle_epi8(lut128, _mm_and_si128(bytes, _mm256_castsi256_si128(low4)));
+        _mm_storeu_si128((__m128i*)(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i*)(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+        i += 16;
+    }
+    for (; i < len; i++) {
+        out[2 * i] = hex_digits[data[i] >> 4];
+        out[2 * i + 1] = hex_digits[data[i] & 15];
+    }
+}
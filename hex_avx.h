@@ -0,0 +1,56 @@
+/* hex_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef HEX_AVX_H
+#define HEX_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Compile-time check to ensure AVX2 is enabled
+#if !defined(__AVX2__)
+#error "This implementation requires AVX2 support. Please compile with -mavx2."
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HEX_DECODE_ERROR ((size_t)-1)
+
+/**
+* @brief Decodes hex text (either case) into bytes, 32 characters per AVX2 step.
+* @param hex Input characters (no terminator needed).
+* @param hex_len Number of characters; must be even.
+* @param out Output buffer of hex_len / 2 bytes.
+* @return Number of bytes written, or HEX_DECODE_ERROR for an odd length or a non-hex character
+* (the contents of `out` are then unspecified).
+*/
+size_t hex_decode_avx2(const char* hex, size_t hex_len, uint8_t* out);
+
+/**
+* @brief Encodes bytes as lowercase hex, 32 input bytes per AVX2 step.
+* @param out Output buffer of 2 * len characters (no terminator is written).
+*/
+void hex_encode_avx2(const uint8_t* data, size_t len, char* out);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // HEX_AVX_H
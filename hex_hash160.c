@@ -0,0 +1,238 @@
+/*
+* hex_hash160.c
+*
+* Streams newline-separated hex public keys (33-byte compressed or 65-byte uncompressed, detected per
+* line) from files or stdin and writes one hex HASH160 per line. Input is read in large chunks and
+* decoded with AVX2, keys are hashed 8 lanes at a time and the digests are hex-encoded with AVX2, so
+* stdio is out of the hot path.
+*
+* Compilation instructions:
+* gcc -O3 -mavx2 -march=native hex_hash160.c hex_avx.c sha256_avx.c ripemd160_avx.c result_ring.c -o hex_hash160
+*
+* Usage:
+* ./hex_hash160 [-k] [-r NAME] [file ...]     (no file or "-" reads stdin)
+*   -k       print "<pubkey> <hash160>" instead of only the HASH160
+*   -r NAME  instead of printing, hand (HASH160, 0-based line index) records to consumer processes through the
+*            shared-memory ring NAME (see result_ring.h); waits for the first consumer to attach
+* Lines that are not a valid key, empty and over-long ones included, print "invalid" (a record with
+* digest_len 0 under -r) so output lines stay aligned with input lines.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "hex_avx.h"
+#include "sha256_avx.h"
+#include "ripemd160_avx.h"
+#include "result_ring.h"
+
+#define READ_CHUNK (4 << 20)
+#define BATCH_KEYS 4096
+#define MAX_LINE 256
+#define OUT_LINE_MAX (MAX_LINE + 1 + 40 + 1)
+
+typedef struct {
+    uint8_t keys[BATCH_KEYS][65];
+    uint8_t lens[BATCH_KEYS];        // 33, 65, or 0 for an invalid line
+    const char* text[BATCH_KEYS];    // the line, for -k
+    uint16_t text_len[BATCH_KEYS];
+    uint8_t sha[BATCH_KEYS][32];
+    uint8_t hash160[BATCH_KEYS][20];
+    uint32_t compressed[BATCH_KEYS];
+    uint32_t uncompressed[BATCH_KEYS];
+    size_t count;
+    char* out;                       // BATCH_KEYS * OUT_LINE_MAX bytes
+    int print_keys;
+    ResultRing* ring;                // -r: records go here instead of stdout
+    unsigned long long lines, invalid;
+} Batch;
+
+static int write_all(int fd, const char* data, size_t len) {
+    while (len) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        data += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+// SHA-256 of one length class in groups of 8; a partial group repeats its first key.
+static void sha_group(Batch* b, const uint32_t* idx, size_t n, size_t key_len) {
+    for (size_t base = 0; base < n; base += 8) {
+        const uint8_t* ptrs[8];
+        size_t lens[8];
+        uint8_t digests[8][32];
+        size_t cnt = n - base < 8 ? n - base : 8;
+        for (size_t lane = 0; lane < 8; lane++) {
+            ptrs[lane] = b->keys[idx[base + (lane < cnt ? lane : 0)]];
+            lens[lane] = key_len;
+        }
+        if (key_len < 56) sha256_avx8_hash_short(ptrs, key_len, digests);
+        else sha256_avx8_hash_lanes(NULL, 0, ptrs, lens, digests);
+        for (size_t lane = 0; lane < cnt; lane++) memcpy(b->sha[idx[base + lane]], digests[lane], 32);
+    }
+}
+
+static int flush_batch(Batch* b) {
+    size_t nc = 0, nu = 0;
+    for (size_t i = 0; i < b->count; i++) {
+        if (b->lens[i] == 33) b->compressed[nc++] = (uint32_t)i;
+        else if (b->lens[i] == 65) b->uncompressed[nu++] = (uint32_t)i;
+        else memset(b->sha[i], 0, 32);
+    }
+    sha_group(b, b->compressed, nc, 33);
+    sha_group(b, b->uncompressed, nu, 65);
+
+    for (size_t base = 0; base < b->count; base += 8) {
+        const uint8_t* ptrs[8];
+        size_t lens[8];
+        uint8_t digests[8][20];
+        size_t cnt = b->count - base < 8 ? b->count - base : 8;
+        for (size_t lane = 0; lane < 8; lane++) {
+            ptrs[lane] = b->sha[base + (lane < cnt ? lane : 0)];
+            lens[lane] = 32;
+        }
+        ripemd160_multi_hash_lanes(ptrs, lens, digests);
+        memcpy(b->hash160[base], digests, cnt * 20);
+    }
+
+    if (b->ring) {
+        uint64_t first_line = b->lines - b->count;
+        for (size_t i = 0; i < b->count; i++) result_ring_push(b->ring, b->hash160[i], b->lens[i] ? 20 : 0, first_line + i);
+        b->count = 0;
+        return 0;
+    }
+
+    char* p = b->out;
+    for (size_t i = 0; i < b->count; i++) {
+        if (b->print_keys) {
+            memcpy(p, b->text[i], b->text_len[i]);
+            p += b->text_len[i];
+            *p++ = ' ';
+        }
+        if (b->lens[i]) {
+            hex_encode_avx2(b->hash160[i], 20, p);
+            p += 40;
+        } else {
+            memcpy(p, "invalid", 7);
+            p += 7;
+        }
+        *p++ = '\n';
+    }
+    b->count = 0;
+    return write_all(STDOUT_FILENO, b->out, (size_t)(p - b->out));
+}
+
+static void add_line(Batch* b, const char* line, size_t len) {
+    while (len && (line[len - 1] == '\r' || line[len - 1] == ' ' || line[len - 1] == '\t')) len--;
+    if (len > MAX_LINE) len = MAX_LINE; // only echoed with -k; such a line is invalid anyway
+    size_t i = b->count++;
+    b->text[i] = line;
+    b->text_len[i] = (uint16_t)len;
+    b->lens[i] = 0;
+    b->lines++;
+    if ((len == 66 || len == 130) && hex_decode_avx2(line, len, b->keys[i]) == len / 2) {
+        uint8_t prefix = b->keys[i][0];
+        if ((len == 66 && (prefix == 0x02 || prefix == 0x03)) || (len == 130 && prefix == 0x04)) b->lens[i] = (uint8_t)(len / 2);
+    }
+    if (!b->lens[i]) b->invalid++;
+}
+
+// Reads a descriptor in large chunks; complete lines are batched, a partial last line is carried over.
+// A line longer than the whole buffer is reported as invalid and the rest of it is skipped.
+static int process_fd(Batch* b, int fd, char* buf) {
+    size_t have = 0;
+    int skipping = 0;
+    for (;;) {
+        ssize_t n = read(fd, buf + have, READ_CHUNK - have);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return -1;
+        size_t end = have + (size_t)n;
+        size_t start = 0;
+        if (skipping) {
+            const char* nl = (const char*)memchr(buf, '\n', end);
+            if (!nl) {
+                if (n == 0) return flush_batch(b);
+                have = 0;
+                continue;
+            }
+            start = (size_t)(nl - buf) + 1;
+            skipping = 0;
+        }
+        for (;;) {
+            const char* nl = (const char*)memchr(buf + start, '\n', end - start);
+            if (!nl) break;
+            size_t len = (size_t)(nl - (buf + start));
+            add_line(b, buf + start, len);
+            start += len + 1;
+            if (b->count == BATCH_KEYS && flush_batch(b) != 0) return -1;
+        }
+        if (n == 0) {
+            if (end > start) add_line(b, buf + start, end - start);
+            return flush_batch(b);
+        }
+        // Lines still in the batch point into buf: flush before moving the tail.
+        if (b->count && flush_batch(b) != 0) return -1;
+        have = end - start;
+        if (have == READ_CHUNK) {
+            add_line(b, buf, have);
+            if (flush_batch(b) != 0) return -1;
+            skipping = 1;
+            have = 0;
+        }
+        memmove(buf, buf + start, have);
+    }
+}
+
+int main(int argc, char** argv) {
+    Batch* b = (Batch*)calloc(1, sizeof(Batch));
+    char* buf = (char*)malloc(READ_CHUNK);
+    if (!b || !buf || !(b->out = (char*)malloc((size_t)BATCH_KEYS * OUT_LINE_MAX))) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return 1;
+    }
+    int argi = 1;
+    for (; argi < argc; argi++) {
+        if (strcmp(argv[argi], "-k") == 0) {
+            b->print_keys = 1;
+        } else if (strcmp(argv[argi], "-r") == 0 && argi + 1 < argc) {
+            b->ring = result_ring_create(argv[++argi], 1 << 16, 0);
+            if (!b->ring) {
+                fprintf(stderr, "Error: cannot create ring %s: %s\n", argv[argi], strerror(errno));
+                return 1;
+            }
+            result_ring_wait_consumers(b->ring, 1, -1);
+        } else {
+            break;
+        }
+    }
+
+    int rc = 0;
+    if (argi >= argc) {
+        rc = process_fd(b, STDIN_FILENO, buf);
+    } else {
+        for (; argi < argc && rc == 0; argi++) {
+            int fd = strcmp(argv[argi], "-") == 0 ? STDIN_FILENO : open(argv[argi], O_RDONLY);
+            if (fd < 0) {
+                fprintf(stderr, "Error: cannot open %s\n", argv[argi]);
+                rc = 1;
+                break;
+            }
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+            rc = process_fd(b, fd, buf);
+            if (fd != STDIN_FILENO) close(fd);
+        }
+    }
+    if (rc != 0) fprintf(stderr, "Error: I/O failure\n");
+    if (b->invalid) fprintf(stderr, "%llu of %llu lines were not valid public keys\n", b->invalid, b->lines);
+    result_ring_close(b->ring);
+    free(b->out);
+    free(b);
+    free(buf);
+    return rc == 0 ? 0 : 1;
+}
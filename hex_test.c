@@ -0,0 +1,93 @@
+/* hex_test.c
+ * gcc -O3 -mavx2 -march=native hex_test.c hex_avx.c -o hex_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hex_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+static void encode_ref(const uint8_t* data, size_t len, char* out) {
+    for (size_t i = 0; i < len; i++) sprintf(out + 2 * i, "%02x", data[i]);
+}
+
+int main() {
+    printf("--- Correctness Test (AVX2 Hex Encode/Decode) ---\n");
+    int failed_tests = 0;
+    srand(1);
+    uint8_t data[300], back[300];
+    char hex[601], ref[601];
+
+    int encode_bad = 0, decode_bad = 0, upper_bad = 0;
+    for (size_t len = 0; len <= 300; len++) {
+        for (size_t i = 0; i < len; i++) data[i] = (uint8_t)rand();
+        hex_encode_avx2(data, len, hex);
+        encode_ref(data, len, ref);
+        if (memcmp(hex, ref, 2 * len) != 0) encode_bad++;
+        if (hex_decode_avx2(hex, 2 * len, back) != len || memcmp(back, data, len) != 0) decode_bad++;
+        for (size_t i = 0; i < 2 * len; i++) {
+            if (hex[i] >= 'a') hex[i] = (char)(hex[i] - 'a' + 'A');
+        }
+        if (hex_decode_avx2(hex, 2 * len, back) != len || memcmp(back, data, len) != 0) upper_bad++;
+    }
+    failed_tests += report("Encode matches %02x for lengths 0..300", encode_bad == 0);
+    failed_tests += report("Decode round-trips lowercase", decode_bad == 0);
+    failed_tests += report("Decode accepts uppercase", upper_bad == 0);
+
+    // Every non-hex byte value, in every position of a 130-character key (SIMD and scalar tail).
+    int missed = 0;
+    for (int c = 0; c < 256; c++) {
+        int is_hex = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        if (is_hex) continue;
+        for (size_t pos = 0; pos < 130; pos++) {
+            memset(hex, 'a', 130);
+            hex[pos] = (char)c;
+            if (hex_decode_avx2(hex, 130, back) != HEX_DECODE_ERROR) missed++;
+        }
+    }
+    failed_tests += report("Every invalid character rejected at every position", missed == 0);
+    failed_tests += report("Odd length rejected", hex_decode_avx2("abc", 3, back) == HEX_DECODE_ERROR);
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (1M x 33-byte keys) ---\n");
+    const size_t N = 1000000, LEN = 33;
+    uint8_t* raw = (uint8_t*)malloc(N * LEN);
+    char* text = (char*)malloc(N * LEN * 2);
+    for (size_t i = 0; i < N * LEN; i++) raw[i] = (uint8_t)rand();
+
+    clock_t start = clock();
+    for (size_t i = 0; i < N; i++) hex_encode_avx2(raw + i * LEN, LEN, text + i * LEN * 2);
+    double enc = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    size_t ok = 0;
+    for (size_t i = 0; i < N; i++) ok += hex_decode_avx2(text + i * LEN * 2, LEN * 2, raw + i * LEN) == LEN;
+    double dec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    char line[80];
+    for (size_t i = 0; i < N; i++) {
+        for (size_t j = 0; j < LEN; j++) sprintf(line + 2 * j, "%02x", raw[i * LEN + j]);
+    }
+    double printf_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Encode: %.4f seconds (%.1f Million keys/sec, %.0f MB/s of hex)\n", enc, N / enc / 1e6, N * LEN * 2 / enc / 1e6);
+    printf("Decode: %.4f seconds (%.1f Million keys/sec, %zu valid)\n", dec, N / dec / 1e6, ok);
+    printf("sprintf(\"%%02x\") per byte: %.4f seconds (%.1fx slower than AVX2 encode)\n", printf_time, printf_time / enc);
+    free(raw);
+    free(text);
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -6,6 +6,12 @@
 *
 * Compilation instructions:
 * gcc -O3 -mavx2 -march=native main_full_avx.c sha256_avx.c ripemd160_avx.c -o main_full_test -lsecp256k1 -lcrypto
+*
+* Instrumented build (per-stage/per-kernel JSON stats at exit or on SIGUSR1, see hash_stats.h):
+* gcc -O3 -mavx2 -march=native -DHASH_STATS main_full_avx.c sha256_avx.c ripemd160_avx.c hash_stats.c -o main_full_test -lsecp256k1 -lcrypto -lpthread
+*
+* Sampled online verification (one lane in $HASH_VERIFY_RATE re-checked in the background, see hash_verify.h):
+* gcc -O3 -mavx2 -march=native -DHASH_VERIFY main_full_avx.c sha256_avx.c ripemd160_avx.c hash_verify.c -o main_full_test -lsecp256k1 -lcrypto -lpthread
 */
 
 #include <stdio.h>
@@ -17,6 +23,8 @@
 
 #include "sha256_avx.h"
 #include "ripemd160_avx.h"
+#include "hash_stats.h"
+#include "hash_verify.h"
 
 #include <secp256k1.h>
 #include <openssl/sha.h>
@@ -96,6 +104,12 @@ int main(int argc, char **argv) {
     RIPEMD160_MULTI_CTX ripemd_ctx;
 
     assert(secp_ctx != NULL && sha_hasher != NULL);
+#ifdef HASH_VERIFY
+    if (hash_verify_start(NULL) != 0) {
+        fprintf(stderr, "Failed to start the verification thread.\n");
+        return 1;
+    }
+#endif
 
     unsigned char privkey[32] = {0};
     privkey[31] = 1;
@@ -112,6 +126,18 @@ int main(int argc, char **argv) {
     alignas(32) uint8_t ripemd_results_comp[BATCH_SIZE][20];
     alignas(32) uint8_t ripemd_results_uncomp[BATCH_SIZE][20];
 
+    // Serialized keys of the final batch for the printout; under HASH_VERIFY, of every batch for the sampler
+    unsigned char batch_comp_keys[BATCH_SIZE][33];
+    unsigned char batch_uncomp_keys[BATCH_SIZE][65];
+#ifdef HASH_VERIFY
+    const uint8_t* comp_key_ptrs[BATCH_SIZE];
+    const uint8_t* uncomp_key_ptrs[BATCH_SIZE];
+    for (int i = 0; i < BATCH_SIZE; i++) {
+        comp_key_ptrs[i] = batch_comp_keys[i];
+        uncomp_key_ptrs[i] = batch_uncomp_keys[i];
+    }
+#endif
+
     printf("Starting %lld HASH160 calculations using PURE AVX2 pipeline...\n", total_pubkeys);
     printf("  - Both key types handled by multi-block AVX2-SHA256 -> AVX2-RIPEMD160.\n");
     printf("Processing in batches of %d. Results for the last 5 public keys will be printed.\n\n", BATCH_SIZE);
@@ -121,12 +147,9 @@ int main(int argc, char **argv) {
     for (long long batch_idx = 0; batch_idx < NUM_BATCHES; batch_idx++) {
         
         unsigned char last_batch_privkeys[BATCH_SIZE][32];
-        unsigned char last_batch_comp_keys[BATCH_SIZE][33];
-        unsigned char last_batch_uncomp_keys[BATCH_SIZE][65];
-        size_t last_batch_comp_len[BATCH_SIZE];
-        size_t last_batch_uncomp_len[BATCH_SIZE];
 
         // 1. Generate a batch of public keys and prepare data blocks
+        HASH_STATS_BEGIN(HASH_STATS_MAIN_KEYGEN);
         for (int i = 0; i < BATCH_SIZE; i++) {
             bool is_last_batch = (batch_idx == NUM_BATCHES - 1);
             if (is_last_batch) {
@@ -148,16 +171,21 @@ int main(int argc, char **argv) {
             // Prepare dual-block data for uncompressed public keys
             prepare_multi_block_sha256_data(uncomp_pubkey_blocks_1[i], uncomp_pubkey_blocks_2[i], uncomp_buf, uncomp_len);
 
-            if (is_last_batch) {
-                 memcpy(last_batch_comp_keys[i], comp_buf, comp_len);
-                 last_batch_comp_len[i] = comp_len;
-                 memcpy(last_batch_uncomp_keys[i], uncomp_buf, uncomp_len);
-                 last_batch_uncomp_len[i] = uncomp_len;
+#ifdef HASH_VERIFY
+            bool keep_keys = true; // any batch can be sampled
+#else
+            bool keep_keys = is_last_batch; // only the final printout needs them
+#endif
+            if (keep_keys) {
+                memcpy(batch_comp_keys[i], comp_buf, comp_len);
+                memcpy(batch_uncomp_keys[i], uncomp_buf, uncomp_len);
             }
             increment_privkey(privkey);
         }
+        HASH_STATS_END(HASH_STATS_MAIN_KEYGEN, BATCH_SIZE, BATCH_SIZE);
 
         // --- 2. Handle compressed format public keys (single-block AVX link) ---
+        HASH_STATS_BEGIN(HASH_STATS_MAIN_HASH_COMP);
         sha256_avx8_init(sha_hasher);
         sha256_avx8_update_8_blocks(sha_hasher, comp_pubkey_blocks);
         sha256_avx8_get_final_hashes(sha_hasher, sha256_results);
@@ -168,8 +196,11 @@ int main(int argc, char **argv) {
             ripemd_ctx.buffer_len[i] = 32;
         }
         ripemd160_multi_final(&ripemd_ctx, ripemd_results_comp);
+        HASH_STATS_END(HASH_STATS_MAIN_HASH_COMP, BATCH_SIZE, BATCH_SIZE);
+        HASH_VERIFY_LANES_FIXED(HASH_VERIFY_HASH160, comp_key_ptrs, 33, ripemd_results_comp);
 
         // --- 3. Handle uncompressed public keys (dual-block AVX links) ---
+        HASH_STATS_BEGIN(HASH_STATS_MAIN_HASH_UNCOMP);
         sha256_avx8_init(sha_hasher);
         sha256_avx8_update_8_blocks(sha_hasher, uncomp_pubkey_blocks_1); // Processing the first block
         sha256_avx8_update_8_blocks(sha_hasher, uncomp_pubkey_blocks_2); // Processing the second block
@@ -181,9 +212,12 @@ int main(int argc, char **argv) {
             ripemd_ctx.buffer_len[i] = 32;
         }
         ripemd160_multi_final(&ripemd_ctx, ripemd_results_uncomp);
+        HASH_STATS_END(HASH_STATS_MAIN_HASH_UNCOMP, 2 * BATCH_SIZE, BATCH_SIZE);
+        HASH_VERIFY_LANES_FIXED(HASH_VERIFY_HASH160, uncomp_key_ptrs, 65, ripemd_results_uncomp);
         
         // --- 4. Verify the results of the last batch ---
         if (batch_idx == NUM_BATCHES - 1) {
+            HASH_STATS_BEGIN(HASH_STATS_MAIN_VERIFY);
             printf("\n--- Results from the final batch (Verification) ---\n");
             for (int i = BATCH_SIZE - 5; i < BATCH_SIZE; ++i) {
                  long long current_pubkey_index = (batch_idx * BATCH_SIZE) + i + 1;
@@ -191,8 +225,8 @@ int main(int argc, char **argv) {
                 print_hex("  Private Key:             ", last_batch_privkeys[i], 32);
                 
                 unsigned char ref_comp_hash[20], ref_uncomp_hash[20];
-                calculate_single_hash160_openssl(last_batch_comp_keys[i], last_batch_comp_len[i], ref_comp_hash);
-                calculate_single_hash160_openssl(last_batch_uncomp_keys[i], last_batch_uncomp_len[i], ref_uncomp_hash);
+                calculate_single_hash160_openssl(batch_comp_keys[i], 33, ref_comp_hash);
+                calculate_single_hash160_openssl(batch_uncomp_keys[i], 65, ref_uncomp_hash);
                 
                 print_hex("  HASH160 (Comp, Pure AVX):", ripemd_results_comp[i], 20);
                 print_hex("  HASH160 (Comp, OpenSSL): ", ref_comp_hash, 20);
@@ -205,6 +239,7 @@ int main(int argc, char **argv) {
                 else printf("  (!!! Uncomp Verification FAILED !!!)\n");
                 printf("\n");
             }
+            HASH_STATS_END(HASH_STATS_MAIN_VERIFY, 5, 5);
         }
     }
 
@@ -224,5 +259,15 @@ int main(int argc, char **argv) {
     printf("Performance:                 %.2f HASH160s/sec\n", hashes_per_sec);
     printf("Performance:                 %.2f Million HASH160s/sec\n", hashes_per_sec / 1e6);
 
+#ifdef HASH_VERIFY
+    hash_verify_stop();
+    HashVerifyCounters counters[HASH_VERIFY_KERNEL_COUNT];
+    hash_verify_get_counters(counters);
+    const HashVerifyCounters* c = &counters[HASH_VERIFY_HASH160];
+    printf("Sampled verification (HASH160): %llu checked, %llu mismatches, %llu dropped\n",
+           (unsigned long long)c->checked, (unsigned long long)c->mismatches, (unsigned long long)c->dropped);
+    if (c->mismatches) return 1;
+#endif
+
     return 0;
 }
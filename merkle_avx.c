@@ -0,0 +1,249 @@
+/* merkle_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "merkle_avx.h"
+#include "sha256_avx.h"
+#include "sha256_avx_soa.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdalign.h>
+
+// Hashes parents of one level 8 at a time. `parents` lists the parent indices to compute (ascending),
+// or is NULL for all parents 0..n-1. `out` may alias `in`: parent p only overwrites node p, which
+// every later batch has already read past, and each batch loads its inputs before storing.
+static void hash_parents(const uint8_t (*in)[32], size_t in_count, const size_t* parents, size_t n,
+                         uint8_t (*out)[32], bool* mutated) {
+    alignas(64) uint8_t staged[8][64];
+    alignas(32) uint8_t digests[8][32];
+
+    for (size_t base = 0; base < n; base += 8) {
+        size_t cnt = n - base < 8 ? n - base : 8;
+        const uint8_t* ptrs[8];
+        size_t targets[8];
+        for (size_t lane = 0; lane < 8; lane++) {
+            size_t i = base + (lane < cnt ? lane : 0); // spare lanes repeat the first pair
+            size_t p = parents ? parents[i] : i;
+            size_t left = 2 * p;
+            targets[lane] = p;
+            if (left + 1 < in_count) {
+                ptrs[lane] = in[left]; // siblings are adjacent: hash the 64 bytes in place
+                if (mutated && lane < cnt && memcmp(in[left], in[left + 1], 32) == 0) *mutated = true;
+            } else {
+                memcpy(staged[lane], in[left], 32); // odd node: pair it with itself
+                memcpy(staged[lane] + 32, in[left], 32);
+                ptrs[lane] = staged[lane];
+            }
+        }
+        sha256_avx8_double64(ptrs, digests);
+        for (size_t lane = 0; lane < cnt; lane++) memcpy(out[targets[lane]], digests[lane], 32);
+    }
+}
+
+void merkle_root_avx8(uint8_t (*hashes)[32], size_t count, uint8_t root[32], bool* mutated) {
+    if (mutated) *mutated = false;
+    if (!hashes || count == 0) {
+        if (root) memset(root, 0, 32);
+        return;
+    }
+    while (count > 1) {
+        size_t parents = (count + 1) / 2;
+        hash_parents((const uint8_t (*)[32])hashes, count, NULL, parents, hashes, mutated);
+        count = parents;
+    }
+    if (root) memcpy(root, hashes[0], 32);
+}
+
+int merkle_tree_build(MerkleTree* tree, const uint8_t (*leaves)[32], size_t count) {
+    if (!tree || !leaves || count == 0) return -1;
+    memset(tree, 0, sizeof(*tree));
+
+    size_t levels = 1, total = count;
+    for (size_t size = count; size > 1; size = (size + 1) / 2) {
+        levels++;
+        total += (size + 1) / 2;
+    }
+    tree->level_offset = (size_t*)malloc(levels * sizeof(size_t));
+    tree->level_size = (size_t*)malloc(levels * sizeof(size_t));
+    tree->nodes = (uint8_t (*)[32])malloc(total * 32);
+    if (!tree->level_offset || !tree->level_size || !tree->nodes) {
+        merkle_tree_free(tree);
+        return -1;
+    }
+    tree->leaf_count = count;
+    tree->level_count = levels;
+
+    size_t offset = 0, size = count;
+    for (size_t l = 0; l < levels; l++) {
+        tree->level_offset[l] = offset;
+        tree->level_size[l] = size;
+        offset += size;
+        size = (size + 1) / 2;
+    }
+
+    memcpy(tree->nodes, leaves, count * 32);
+    for (size_t l = 1; l < levels; l++) {
+        hash_parents((const uint8_t (*)[32])(tree->nodes + tree->level_offset[l - 1]), tree->level_size[l - 1],
+                     NULL, tree->level_size[l], tree->nodes + tree->level_offset[l], NULL);
+    }
+    return 0;
+}
+
+static int compare_size(const void* a, const void* b) {
+    size_t x = *(const size_t*)a, y = *(const size_t*)b;
+    return (x > y) - (x < y);
+}
+
+int merkle_tree_update(MerkleTree* tree, const size_t* indices, const uint8_t (*new_leaves)[32], size_t n) {
+    if (!tree || !tree->nodes || (n && (!indices || !new_leaves))) return -1;
+    if (n == 0) return 0;
+
+    size_t* dirty = (size_t*)malloc(n * sizeof(size_t));
+    if (!dirty) return -1;
+    for (size_t i = 0; i < n; i++) {
+        if (indices[i] >= tree->leaf_count) {
+            free(dirty);
+            return -1;
+        }
+        memcpy(tree->nodes[indices[i]], new_leaves[i], 32);
+        dirty[i] = indices[i];
+    }
+
+    // Walk up: the dirty set of each level is the deduplicated parents of the level below.
+    qsort(dirty, n, sizeof(size_t), compare_size);
+    size_t dirty_count = n;
+    for (size_t l = 1; l < tree->level_count; l++) {
+        size_t unique = 0;
+        for (size_t i = 0; i < dirty_count; i++) {
+            size_t parent = dirty[i] / 2;
+            if (unique == 0 || dirty[unique - 1] != parent) dirty[unique++] = parent;
+        }
+        dirty_count = unique;
+        hash_parents((const uint8_t (*)[32])(tree->nodes + tree->level_offset[l - 1]), tree->level_size[l - 1],
+                     dirty, dirty_count, tree->nodes + tree->level_offset[l], NULL);
+    }
+    free(dirty);
+    return 0;
+}
+
+void merkle_tree_root(const MerkleTree* tree, uint8_t root[32]) {
+    if (!tree || !tree->nodes || !root) return;
+    memcpy(root, tree->nodes[tree->level_offset[tree->level_count - 1]], 32);
+}
+
+void merkle_tree_free(MerkleTree* tree) {
+    if (!tree) return;
+    free(tree->level_offset);
+    free(tree->level_size);
+    free(tree->nodes);
+    memset(tree, 0, sizeof(*tree));
+}
+
+// --- Inclusion proofs ---
+
+#define MERKLE_MAX_DEPTH 32
+
+uint8_t merkle_verify_proofs_8(const MerkleProof proofs[8]) {
+    if (!proofs) return 0;
+    static const uint8_t zero[32] = {0};
+    const uint8_t* leaves[8];
+    const uint8_t* roots[8];
+    uint32_t depth[8];
+    uint8_t usable = 0;
+    uint32_t max_depth = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        const MerkleProof* p = &proofs[lane];
+        bool ok = p->leaf && p->root && p->depth <= MERKLE_MAX_DEPTH && (p->depth == 0 || p->branch) &&
+                  (p->depth == MERKLE_MAX_DEPTH || (p->index >> p->depth) == 0);
+        leaves[lane] = ok ? p->leaf : zero;
+        roots[lane] = ok ? p->root : zero;
+        depth[lane] = ok ? p->depth : 0;
+        if (ok) usable |= (uint8_t)(1u << lane);
+        if (depth[lane] > max_depth) max_depth = depth[lane];
+    }
+
+    // The running hash is kept as SoA big-endian words, exactly the form of a SHA-256 state.
+    __m256i cur[8], sib[8], state[8], w[16];
+    sha256_avx8_soa_load_digests(cur, leaves);
+    const __m256i depths = _mm256_loadu_si256((const __m256i*)depth);
+    const __m256i indices = _mm256_setr_epi32((int)proofs[0].index, (int)proofs[1].index, (int)proofs[2].index,
+                                              (int)proofs[3].index, (int)proofs[4].index, (int)proofs[5].index,
+                                              (int)proofs[6].index, (int)proofs[7].index);
+
+    for (uint32_t level = 0; level < max_depth; level++) {
+        const uint8_t* siblings[8];
+        for (int lane = 0; lane < 8; lane++) siblings[lane] = level < depth[lane] ? proofs[lane].branch[level] : zero;
+        sha256_avx8_soa_load_digests(sib, siblings);
+
+        // Right children (index bit set) take the sibling on the left.
+        __m256i right = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_srli_epi32(indices, (int)level), _mm256_set1_epi32(1)),
+                                           _mm256_set1_epi32(1));
+        for (int i = 0; i < 8; i++) {
+            w[i] = _mm256_blendv_epi8(cur[i], sib[i], right);
+            w[i + 8] = _mm256_blendv_epi8(sib[i], cur[i], right);
+        }
+        sha256_avx8_soa_init(state);
+        sha256_avx8_soa_transform(state, w);
+        sha256_avx8_soa_finish_64(state);
+        sha256_avx8_soa_digest_block(w, state);
+        sha256_avx8_soa_init(state);
+        sha256_avx8_soa_transform(state, w);
+
+        // Lanes past their depth keep their final hash.
+        __m256i active = _mm256_cmpgt_epi32(depths, _mm256_set1_epi32((int)level));
+        for (int i = 0; i < 8; i++) cur[i] = _mm256_blendv_epi8(cur[i], state[i], active);
+    }
+
+    __m256i expected[8];
+    sha256_avx8_soa_load_digests(expected, roots);
+    __m256i equal = _mm256_set1_epi32(-1);
+    for (int i = 0; i < 8; i++) equal = _mm256_and_si256(equal, _mm256_cmpeq_epi32(cur[i], expected[i]));
+    return (uint8_t)_mm256_movemask_ps(_mm256_castsi256_ps(equal)) & usable;
+}
+
+size_t merkle_verify_proofs(const MerkleProof* proofs, size_t count, uint8_t* valid_masks) {
+    if (!proofs || count == 0) return 0;
+    if (valid_masks) memset(valid_masks, 0, (count + 7) / 8);
+
+    // Counting sort by depth, so each group of 8 runs for about the same number of levels.
+    size_t* order = (size_t*)malloc(count * sizeof(size_t));
+    size_t bucket[MERKLE_MAX_DEPTH + 2] = {0};
+    if (order) {
+        for (size_t i = 0; i < count; i++) bucket[(proofs[i].depth <= MERKLE_MAX_DEPTH ? proofs[i].depth : MERKLE_MAX_DEPTH) + 1]++;
+        for (int d = 1; d <= MERKLE_MAX_DEPTH + 1; d++) bucket[d] += bucket[d - 1];
+        for (size_t i = 0; i < count; i++) order[bucket[proofs[i].depth <= MERKLE_MAX_DEPTH ? proofs[i].depth : MERKLE_MAX_DEPTH]++] = i;
+    }
+
+    size_t passed = 0;
+    for (size_t base = 0; base < count; base += 8) {
+        size_t cnt = count - base < 8 ? count - base : 8;
+        MerkleProof group[8];
+        size_t ids[8];
+        for (size_t lane = 0; lane < 8; lane++) {
+            ids[lane] = lane < cnt ? (order ? order[base + lane] : base + lane) : 0;
+            if (lane < cnt) group[lane] = proofs[ids[lane]];
+            else memset(&group[lane], 0, sizeof(group[lane])); // empty lanes fail without any hashing
+        }
+        uint8_t mask = merkle_verify_proofs_8(group);
+        for (size_t lane = 0; lane < cnt; lane++) {
+            if (!(mask & (1u << lane))) continue;
+            passed++;
+            if (valid_masks) valid_masks[ids[lane] / 8] |= (uint8_t)(1u << (ids[lane] % 8));
+        }
+    }
+    free(order);
+    return passed;
+}
@@ -0,0 +1,105 @@
+/* merkle_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef MERKLE_AVX_H
+#define MERKLE_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bitcoin Merkle trees: every parent is SHA256(SHA256(left || right)), and a level with an odd
+// number of nodes pairs its last node with itself. Hashes are in internal (little-endian txid) byte order.
+
+/**
+* @brief Computes the Merkle root of `count` leaf hashes, level by level, overwriting `hashes` in place.
+* Each level is hashed 8 parents at a time with sha256_avx8_double64().
+* @param hashes Leaf hashes; used as the working buffer and clobbered.
+* @param count Number of leaves. A count of 0 yields an all-zero root.
+* @param root Output root hash.
+* @param mutated If not NULL, set to true when some level hashes two identical siblings (CVE-2012-2459 pattern).
+*/
+void merkle_root_avx8(uint8_t (*hashes)[32], size_t count, uint8_t root[32], bool* mutated);
+
+// A fully materialized tree that supports recomputing only the paths of changed leaves.
+typedef struct {
+    size_t leaf_count;
+    size_t level_count;     // number of levels, leaves included (1 for a single leaf)
+    size_t* level_offset;   // index of the first node of each level in `nodes`
+    size_t* level_size;     // node count of each level
+    uint8_t (*nodes)[32];   // all levels, leaves first, root last
+} MerkleTree;
+
+/**
+* @brief Builds a tree over `count` leaves.
+* @return 0 on success, -1 on invalid arguments or allocation failure.
+*/
+int merkle_tree_build(MerkleTree* tree, const uint8_t (*leaves)[32], size_t count);
+
+/**
+* @brief Replaces `n` leaves and recomputes only the ancestors of those leaves, 8 parents at a time per level.
+* @param indices Leaf indices to replace (any order, duplicates allowed; the last value wins).
+* @param new_leaves Replacement hashes, one per index.
+* @return 0 on success, -1 on invalid arguments or allocation failure.
+*/
+int merkle_tree_update(MerkleTree* tree, const size_t* indices, const uint8_t (*new_leaves)[32], size_t n);
+
+/**
+* @brief Copies the current root.
+*/
+void merkle_tree_root(const MerkleTree* tree, uint8_t root[32]);
+
+/**
+* @brief Releases the tree's memory.
+*/
+void merkle_tree_free(MerkleTree* tree);
+
+// An inclusion proof: the leaf, its siblings from the leaf level up, and the leaf's position.
+typedef struct {
+    const uint8_t* leaf;          // 32-byte leaf hash (txid, internal byte order)
+    const uint8_t (*branch)[32];  // `depth` sibling hashes, leaf level first
+    uint32_t depth;               // number of levels (0..32); 0 means the leaf is the root
+    uint32_t index;               // leaf position: bit i set means the node is a right child at level i
+    const uint8_t* root;          // expected Merkle root
+} MerkleProof;
+
+/**
+* @brief Verifies 8 inclusion proofs at once, one tree level per step for all lanes.
+* The running hashes stay in SoA registers; each lane's left/right order is chosen with a blend on its
+* index bit, and lanes whose proof is shorter stop updating once their depth is reached.
+* @param proofs Eight proofs. A lane with a NULL leaf or root, or an index with bits at or above depth, fails.
+* @return Pass mask, bit i set when proof i hashes to its root.
+*/
+uint8_t merkle_verify_proofs_8(const MerkleProof proofs[8]);
+
+/**
+* @brief Verifies any number of proofs, 8 at a time (after grouping proofs of similar depth).
+* @param valid_masks Output of (count + 7) / 8 masks, bit i of byte k for proof 8k + i. May be NULL.
+* @return Number of proofs that passed.
+*/
+size_t merkle_verify_proofs(const MerkleProof* proofs, size_t count, uint8_t* valid_masks);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // MERKLE_AVX_H
@@ -0,0 +1,250 @@
+/* merkle_test.c
+ * gcc -O3 -mavx2 -march=native merkle_test.c merkle_avx.c sha256_avx.c -o merkle_test -lcrypto
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <openssl/sha.h>
+
+#include "merkle_avx.h"
+
+// Scalar reference: the same odd-node rule, one SHA256d per parent.
+static void reference_root(const uint8_t (*leaves)[32], size_t count, uint8_t root[32]) {
+    uint8_t (*level)[32] = (uint8_t (*)[32])malloc(count * 32);
+    memcpy(level, leaves, count * 32);
+    while (count > 1) {
+        size_t parents = (count + 1) / 2;
+        for (size_t p = 0; p < parents; p++) {
+            uint8_t pair[64], once[32];
+            memcpy(pair, level[2 * p], 32);
+            memcpy(pair + 32, level[2 * p + 1 < count ? 2 * p + 1 : 2 * p], 32);
+            SHA256(pair, 64, once);
+            SHA256(once, 32, level[p]);
+        }
+        count = parents;
+    }
+    memcpy(root, level[0], 32);
+    free(level);
+}
+
+// Display order (as printed by block explorers) is the byte-reverse of the internal order.
+static void from_display_hex(const char* hex, uint8_t out[32]) {
+    for (int i = 0; i < 32; i++) sscanf(hex + 2 * (31 - i), "%2hhx", &out[i]);
+}
+
+static void fill_random(uint8_t (*leaves)[32], size_t count, unsigned seed) {
+    srand(seed);
+    for (size_t i = 0; i < count; i++)
+        for (int j = 0; j < 32; j++) leaves[i][j] = (uint8_t)rand();
+}
+
+// Branch for leaf `index` from the tree levels (an odd last node is paired with itself).
+static uint32_t tree_branch(const MerkleTree* tree, size_t index, uint8_t (*branch)[32]) {
+    uint32_t depth = 0;
+    for (size_t level = 0; level + 1 < tree->level_count; level++, index >>= 1) {
+        size_t sibling = index ^ 1;
+        if (sibling >= tree->level_size[level]) sibling = index;
+        memcpy(branch[depth++], tree->nodes[tree->level_offset[level] + sibling], 32);
+    }
+    return depth;
+}
+
+// Scalar reference verifier.
+static int reference_verify(const MerkleProof* p) {
+    uint8_t cur[32], pair[64], once[32];
+    memcpy(cur, p->leaf, 32);
+    for (uint32_t level = 0; level < p->depth; level++) {
+        int right = (p->index >> level) & 1;
+        memcpy(pair + (right ? 32 : 0), cur, 32);
+        memcpy(pair + (right ? 0 : 32), p->branch[level], 32);
+        SHA256(pair, 64, once);
+        SHA256(once, 32, cur);
+    }
+    return memcmp(cur, p->root, 32) == 0;
+}
+
+static int report(const char* name, int ok) {
+    printf("  %-52s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+int main() {
+    printf("--- Correctness Test (Merkle Root, 8-way SHA256d) ---\n");
+    int failed_tests = 0;
+
+    // Block 100000: four transactions.
+    const char* txids[4] = {
+        "8c14f0db3df150123e6f3dbbf30f8b955a8249b62ac1d1ff16284aefa3d06d87",
+        "fff2525b8931402dd09222c50775608f75787bd2b87e56995a7bdd30f79702c4",
+        "6359f0868171b1d194cbee1af2f16ea598ae8fad666d9b012c8ed2b79a236ec4",
+        "e9a66845e05d5abc0ad04ec80f774a7e585c6e8db975962d069a522137b80c1d",
+    };
+    uint8_t block_leaves[4][32], expected[32], root[32];
+    for (int i = 0; i < 4; i++) from_display_hex(txids[i], block_leaves[i]);
+    from_display_hex("f3e94742aca4b5ef85488dc37c06c3282295ffec960994b2c0d5ac2a25a95766", expected);
+    bool mutated = true;
+    merkle_root_avx8(block_leaves, 4, root, &mutated);
+    failed_tests += report("Block 100000 root", memcmp(root, expected, 32) == 0 && !mutated);
+
+    // Every size from 1 to 300 against the scalar reference.
+    const size_t MAX_LEAVES = 300;
+    uint8_t (*leaves)[32] = (uint8_t (*)[32])malloc(MAX_LEAVES * 32);
+    uint8_t (*work)[32] = (uint8_t (*)[32])malloc(MAX_LEAVES * 32);
+    fill_random(leaves, MAX_LEAVES, 1);
+    int size_failures = 0;
+    for (size_t count = 1; count <= MAX_LEAVES; count++) {
+        uint8_t ref[32];
+        reference_root((const uint8_t (*)[32])leaves, count, ref);
+        memcpy(work, leaves, count * 32);
+        merkle_root_avx8(work, count, root, &mutated);
+        if (memcmp(root, ref, 32) != 0 || mutated) size_failures++;
+    }
+    failed_tests += report("Roots for 1..300 leaves match reference", size_failures == 0);
+
+    // Duplicating the last pair of an even level leaves the root unchanged but must be flagged.
+    memcpy(work, leaves, 6 * 32);
+    memcpy(work[6], leaves[4], 32);
+    memcpy(work[7], leaves[5], 32);
+    uint8_t ref6[32];
+    reference_root((const uint8_t (*)[32])leaves, 6, ref6);
+    merkle_root_avx8(work, 8, root, &mutated);
+    failed_tests += report("Duplicated subtree flagged as mutated (CVE-2012-2459)", memcmp(root, ref6, 32) == 0 && mutated);
+
+    // Incremental updates on a persistent tree.
+    MerkleTree tree;
+    int update_failures = 0;
+    for (size_t count = 1; count <= MAX_LEAVES; count += 37) {
+        fill_random(leaves, count, (unsigned)count);
+        if (merkle_tree_build(&tree, (const uint8_t (*)[32])leaves, count) != 0) {
+            update_failures++;
+            continue;
+        }
+        for (int round = 0; round < 4; round++) {
+            size_t indices[20];
+            uint8_t fresh[20][32];
+            size_t n = (size_t)(rand() % 20) + 1;
+            for (size_t i = 0; i < n; i++) {
+                indices[i] = (size_t)rand() % count;
+                for (int j = 0; j < 32; j++) fresh[i][j] = (uint8_t)rand();
+                memcpy(leaves[indices[i]], fresh[i], 32); // later duplicates win, as in the tree
+            }
+            merkle_tree_update(&tree, indices, (const uint8_t (*)[32])fresh, n);
+            uint8_t ref[32];
+            reference_root((const uint8_t (*)[32])leaves, count, ref);
+            merkle_tree_root(&tree, root);
+            if (memcmp(root, ref, 32) != 0) update_failures++;
+        }
+        merkle_tree_free(&tree);
+    }
+    failed_tests += report("Incremental updates match full recomputation", update_failures == 0);
+
+    // Inclusion proofs: trees of mixed sizes verified together, plus tampered proofs.
+    const size_t PROOFS = 1000;
+    MerkleProof* proofs = (MerkleProof*)calloc(PROOFS, sizeof(MerkleProof));
+    uint8_t (*proof_leaves)[32] = (uint8_t (*)[32])malloc(PROOFS * 32);
+    uint8_t (*proof_roots)[32] = (uint8_t (*)[32])malloc(PROOFS * 32);
+    uint8_t (*branches)[32][32] = (uint8_t (*)[32][32])malloc(PROOFS * sizeof(*branches));
+    uint8_t proof_masks[(1000 + 7) / 8];
+    int proof_failures = 0;
+    size_t expected_pass = 0;
+    for (size_t i = 0; i < PROOFS; i++) {
+        size_t count = (size_t)(rand() % 300) + 1;
+        fill_random(leaves, count, (unsigned)(i + 1000));
+        merkle_tree_build(&tree, (const uint8_t (*)[32])leaves, count);
+        size_t index = (size_t)rand() % count;
+        memcpy(proof_leaves[i], leaves[index], 32);
+        merkle_tree_root(&tree, proof_roots[i]);
+        proofs[i].leaf = proof_leaves[i];
+        proofs[i].branch = (const uint8_t (*)[32])branches[i];
+        proofs[i].depth = tree_branch(&tree, index, branches[i]);
+        proofs[i].index = (uint32_t)index;
+        proofs[i].root = proof_roots[i];
+        merkle_tree_free(&tree);
+        switch (i % 5) {
+        case 1: if (proofs[i].depth) branches[i][rand() % proofs[i].depth][rand() % 32] ^= 1; break;
+        case 2: proof_roots[i][31] ^= 0x80; break;
+        case 3: if (proofs[i].depth) proofs[i].index ^= 1u << (rand() % proofs[i].depth); break;
+        default: break;
+        }
+        expected_pass += (size_t)reference_verify(&proofs[i]);
+    }
+    size_t passed = merkle_verify_proofs(proofs, PROOFS, proof_masks);
+    for (size_t i = 0; i < PROOFS; i++) {
+        if (((proof_masks[i / 8] >> (i % 8)) & 1) != reference_verify(&proofs[i])) proof_failures++;
+    }
+    failed_tests += report("Batched proofs (mixed depths) match reference", proof_failures == 0 && passed == expected_pass);
+    failed_tests += report("Tampered branch, root and index rejected", expected_pass < PROOFS && expected_pass >= PROOFS * 2 / 5);
+
+    MerkleProof bad[8];
+    for (int lane = 0; lane < 8; lane++) bad[lane] = proofs[0];
+    bad[1].leaf = NULL;
+    bad[2].root = NULL;
+    bad[3].index = 1u << bad[3].depth;
+    bad[4].depth = 33;
+    failed_tests += report("Malformed lanes fail, valid lanes pass", merkle_verify_proofs_8(bad) == 0xE1);
+
+    memset(root, 0xff, 32);
+    merkle_root_avx8(work, 0, root, NULL);
+    uint8_t zero[32] = {0};
+    failed_tests += report("Empty leaf set yields zero root", memcmp(root, zero, 32) == 0);
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+    free(work);
+    free(leaves);
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (Merkle Root of 4096 leaves) ---\n");
+    const size_t BENCH_LEAVES = 4096;
+    const int NUM_ITERATIONS = 2000;
+    uint8_t (*bench)[32] = (uint8_t (*)[32])malloc(BENCH_LEAVES * 32);
+    uint8_t (*bench_work)[32] = (uint8_t (*)[32])malloc(BENCH_LEAVES * 32);
+    if (!bench || !bench_work) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return 1;
+    }
+    fill_random(bench, BENCH_LEAVES, 7);
+
+    clock_t start = clock();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        memcpy(bench_work, bench, BENCH_LEAVES * 32);
+        bench_work[0][0] = (uint8_t)i;
+        merkle_root_avx8(bench_work, BENCH_LEAVES, root, NULL);
+    }
+    clock_t end = clock();
+
+    double total_time = (double)(end - start) / CLOCKS_PER_SEC;
+    double nodes = (double)(BENCH_LEAVES - 1) * NUM_ITERATIONS;
+    printf("Total trees: %d (%.0f SHA256d nodes)\n", NUM_ITERATIONS, nodes);
+    printf("Total time: %.4f seconds\n", total_time);
+    printf("Performance: %.2f Million SHA256d nodes/sec\n", nodes / total_time / 1e6);
+
+
+    printf("--- Performance Benchmark (Merkle proof verification) ---\n");
+    const int PROOF_ROUNDS = 200;
+    start = clock();
+    size_t batch_passed = 0;
+    for (int r = 0; r < PROOF_ROUNDS; r++) batch_passed += merkle_verify_proofs(proofs, PROOFS, proof_masks);
+    double batch_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    size_t scalar_passed = 0;
+    for (int r = 0; r < PROOF_ROUNDS; r++)
+        for (size_t i = 0; i < PROOFS; i++) scalar_passed += (size_t)reference_verify(&proofs[i]);
+    double scalar_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double total_proofs = (double)PROOFS * PROOF_ROUNDS;
+    printf("8-lane batch: %.4f seconds (%.2f Million proofs/sec, %zu passed)\n", batch_time, total_proofs / batch_time / 1e6, batch_passed);
+    printf("One by one (OpenSSL): %.4f seconds (%.2f Million proofs/sec, %zu passed)\n", scalar_time, total_proofs / scalar_time / 1e6, scalar_passed);
+
+    free(proofs);
+    free(proof_leaves);
+    free(proof_roots);
+    free(branches);
+    free(bench);
+    free(bench_work);
+    return failed_tests == 0 ? 0 : 1;
+}
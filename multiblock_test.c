@@ -0,0 +1,165 @@
+/* multiblock_test.c
+ * gcc -O3 -mavx2 -march=native multiblock_test.c sha256_avx.c ripemd160_avx.c -o multiblock_test -lcrypto
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdalign.h>
+#include <openssl/sha.h>
+#include <openssl/ripemd.h>
+
+#include "sha256_avx.h"
+#include "ripemd160_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+// Final SHA-256 block of a message made of nblocks full blocks.
+static void sha256_pad_block(uint8_t block[64], size_t nblocks) {
+    memset(block, 0, 64);
+    block[0] = 0x80;
+    uint64_t bits = (uint64_t)nblocks * 512;
+    for (int i = 0; i < 8; i++) block[63 - i] = (uint8_t)(bits >> (8 * i));
+}
+
+int main() {
+    printf("--- Correctness Test (Multi-block SHA-256 / RIPEMD-160 Updates) ---\n");
+    int failed_tests = 0;
+    const size_t MAX_BLOCKS = 40;
+    uint8_t* data = (uint8_t*)malloc(8 * MAX_BLOCKS * 64 + 8);
+    srand(1);
+    for (size_t i = 0; i < 8 * MAX_BLOCKS * 64 + 8; i++) data[i] = (uint8_t)rand();
+
+    // Lanes at odd offsets: the loads must not assume alignment.
+    const uint8_t* lanes[8];
+    for (int lane = 0; lane < 8; lane++) lanes[lane] = data + (size_t)lane * MAX_BLOCKS * 64 + (size_t)lane;
+
+    Sha256Avx8_C_Handle* hasher = sha256_avx8_create();
+    int sha_bad = 0, split_bad = 0, rmd_bad = 0;
+    alignas(64) uint8_t pad[8][64];
+    alignas(32) uint8_t hashes[8][32];
+    uint8_t ref[32], digests[8][20];
+    for (size_t n = 0; n <= MAX_BLOCKS; n++) {
+        for (int lane = 0; lane < 8; lane++) sha256_pad_block(pad[lane], n);
+        sha256_avx8_init(hasher);
+        sha256_avx8_update_n_blocks(hasher, lanes, n);
+        sha256_avx8_update_8_blocks(hasher, (const uint8_t (*)[64])pad);
+        sha256_avx8_get_final_hashes(hasher, hashes);
+        for (int lane = 0; lane < 8; lane++) {
+            SHA256(lanes[lane], n * 64, ref);
+            if (memcmp(hashes[lane], ref, 32) != 0) sha_bad++;
+        }
+
+        // The same message in two calls continues from the stored state.
+        sha256_avx8_init(hasher);
+        const uint8_t* second[8];
+        for (int lane = 0; lane < 8; lane++) second[lane] = lanes[lane] + (n / 3) * 64;
+        sha256_avx8_update_n_blocks(hasher, lanes, n / 3);
+        sha256_avx8_update_n_blocks(hasher, second, n - n / 3);
+        sha256_avx8_update_8_blocks(hasher, (const uint8_t (*)[64])pad);
+        sha256_avx8_get_final_hashes(hasher, hashes);
+        for (int lane = 0; lane < 8; lane++) {
+            SHA256(lanes[lane], n * 64, ref);
+            if (memcmp(hashes[lane], ref, 32) != 0) split_bad++;
+        }
+
+        RIPEMD160_MULTI_CTX ctx;
+        ripemd160_multi_init(&ctx);
+        ripemd160_multi_update_n_blocks(&ctx, lanes, n);
+        ripemd160_multi_final(&ctx, digests);
+        for (int lane = 0; lane < 8; lane++) {
+            RIPEMD160(lanes[lane], n * 64, ref);
+            if (memcmp(digests[lane], ref, 20) != 0) rmd_bad++;
+        }
+    }
+    failed_tests += report("SHA-256 update_n_blocks, 0..40 blocks, unaligned", sha_bad == 0);
+    failed_tests += report("SHA-256 update_n_blocks split across two calls", split_bad == 0);
+    failed_tests += report("RIPEMD-160 update_n_blocks, 0..40 blocks, unaligned", rmd_bad == 0);
+
+    // The one-shot lane APIs hash their common full-block prefix in place.
+    size_t lens[8] = {0, 63, 64, 65, 700, 1000, 2048, 2559};
+    int lanes_bad = 0;
+    sha256_avx8_hash_lanes(NULL, 0, lanes, lens, hashes);
+    for (int lane = 0; lane < 8; lane++) {
+        SHA256(lanes[lane], lens[lane], ref);
+        if (memcmp(hashes[lane], ref, 32) != 0) lanes_bad++;
+    }
+    for (int lane = 0; lane < 8; lane++) lens[lane] = 1000 + (size_t)lane * 150;
+    sha256_avx8_hash_lanes(NULL, 0, lanes, lens, hashes);
+    ripemd160_multi_hash_lanes(lanes, lens, digests);
+    for (int lane = 0; lane < 8; lane++) {
+        SHA256(lanes[lane], lens[lane], ref);
+        if (memcmp(hashes[lane], ref, 32) != 0) lanes_bad++;
+        RIPEMD160(lanes[lane], lens[lane], ref);
+        if (memcmp(digests[lane], ref, 20) != 0) lanes_bad++;
+    }
+    failed_tests += report("hash_lanes (SHA-256 and RIPEMD-160) match OpenSSL", lanes_bad == 0);
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (8 lanes x 1 MiB, 20 rounds) ---\n");
+    const size_t LANE_BYTES = 1 << 20, ROUNDS = 20, NB = LANE_BYTES / 64;
+    uint8_t* big = (uint8_t*)malloc(8 * LANE_BYTES);
+    if (!big) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return 1;
+    }
+    for (size_t i = 0; i < 8 * LANE_BYTES; i++) big[i] = (uint8_t)i;
+    for (int lane = 0; lane < 8; lane++) lanes[lane] = big + (size_t)lane * LANE_BYTES;
+    double mb = 8.0 * LANE_BYTES * ROUNDS / 1e6;
+
+    clock_t start = clock();
+    for (size_t r = 0; r < ROUNDS; r++) {
+        sha256_avx8_init(hasher);
+        for (size_t b = 0; b < NB; b++) {
+            for (int lane = 0; lane < 8; lane++) memcpy(pad[lane], lanes[lane] + b * 64, 64);
+            sha256_avx8_update_8_blocks(hasher, (const uint8_t (*)[64])pad);
+        }
+    }
+    double staged = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (size_t r = 0; r < ROUNDS; r++) {
+        sha256_avx8_init(hasher);
+        sha256_avx8_update_n_blocks(hasher, lanes, NB);
+    }
+    double direct = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    RIPEMD160_MULTI_CTX ctx;
+    alignas(64) uint8_t rblocks[8][64];
+    start = clock();
+    for (size_t r = 0; r < ROUNDS; r++) {
+        ripemd160_multi_init(&ctx);
+        for (size_t b = 0; b < NB; b++) {
+            for (int lane = 0; lane < 8; lane++) memcpy(rblocks[lane], lanes[lane] + b * 64, 64);
+            ripemd160_multi_update_full_blocks(&ctx, (const uint8_t (*)[64])rblocks);
+        }
+    }
+    double rmd_staged = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (size_t r = 0; r < ROUNDS; r++) {
+        ripemd160_multi_init(&ctx);
+        ripemd160_multi_update_n_blocks(&ctx, lanes, NB);
+    }
+    double rmd_direct = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("SHA-256 staged update_8_blocks: %.4f seconds (%.0f MB/s)\n", staged, mb / staged);
+    printf("SHA-256 update_n_blocks:        %.4f seconds (%.0f MB/s, %.2fx)\n", direct, mb / direct, staged / direct);
+    printf("RIPEMD-160 staged full blocks:  %.4f seconds (%.0f MB/s)\n", rmd_staged, mb / rmd_staged);
+    printf("RIPEMD-160 update_n_blocks:     %.4f seconds (%.0f MB/s, %.2fx)\n", rmd_direct, mb / rmd_direct, rmd_staged / rmd_direct);
+
+    sha256_avx8_destroy(hasher);
+    free(big);
+    free(data);
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+/* nested_segwit_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "nested_segwit_avx.h"
+#include "sha256_avx_soa.h"
+#include "ripemd160_avx_soa.h"
+#include <string.h>
+#include <immintrin.h>
+
+// Big-endian word from the last byte of each lane's key followed by the 0x80 padding byte.
+static inline __m256i tail_word(const uint8_t* const pubkeys[8], size_t offset) {
+    return _mm256_setr_epi32((int)((uint32_t)pubkeys[0][offset] << 24 | 0x800000), (int)((uint32_t)pubkeys[1][offset] << 24 | 0x800000),
+                             (int)((uint32_t)pubkeys[2][offset] << 24 | 0x800000), (int)((uint32_t)pubkeys[3][offset] << 24 | 0x800000),
+                             (int)((uint32_t)pubkeys[4][offset] << 24 | 0x800000), (int)((uint32_t)pubkeys[5][offset] << 24 | 0x800000),
+                             (int)((uint32_t)pubkeys[6][offset] << 24 | 0x800000), (int)((uint32_t)pubkeys[7][offset] << 24 | 0x800000));
+}
+
+// SHA-256 of the keys; the first 32 (and 64) bytes are loaded straight into schedule words.
+static void sha256_pubkeys(__m256i state[8], const uint8_t* const pubkeys[8], size_t pubkey_len) {
+    __m256i w[16];
+    sha256_avx8_soa_init(state);
+    sha256_avx8_soa_load_digests(w, pubkeys);
+    size_t tail = 32;
+    if (pubkey_len == 65) {
+        const uint8_t* second[8];
+        for (int lane = 0; lane < 8; lane++) second[lane] = pubkeys[lane] + 32;
+        sha256_avx8_soa_load_digests(w + 8, second);
+        sha256_avx8_soa_transform(state, w);
+        tail = 64;
+        w[0] = tail_word(pubkeys, tail);
+        for (int i = 1; i < 8; i++) w[i] = _mm256_setzero_si256();
+    } else {
+        w[8] = tail_word(pubkeys, tail);
+    }
+    // Only one of w[0] / w[8] carries data in the last block; the rest is zero up to the bit length.
+    for (int i = (pubkey_len == 65 ? 8 : 9); i < 15; i++) w[i] = _mm256_setzero_si256();
+    w[15] = _mm256_set1_epi32((int)(pubkey_len * 8));
+    sha256_avx8_soa_transform(state, w);
+}
+
+int hash160_p2sh_p2wpkh_avx8(const uint8_t* const pubkeys[8], size_t pubkey_len,
+                             uint8_t hash160_out[8][20], uint8_t p2sh_out[8][20]) {
+    if (!pubkeys || (pubkey_len != 33 && pubkey_len != 65)) return -1;
+    __m256i sha[8], key_hash[5], w[16];
+    sha256_pubkeys(sha, pubkeys, pubkey_len);
+    ripemd160_avx8_soa_hash_digest(key_hash, sha);
+    if (hash160_out) ripemd160_avx8_soa_store(key_hash, hash160_out);
+    if (!p2sh_out) return 0;
+
+    // Redeem script 0x00 0x14 || key hash (22 bytes): every big-endian word straddles two digest words.
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m256i be[5];
+    for (int i = 0; i < 5; i++) be[i] = _mm256_shuffle_epi8(key_hash[i], bswap);
+    w[0] = _mm256_or_si256(_mm256_set1_epi32(0x00140000), _mm256_srli_epi32(be[0], 16));
+    for (int i = 1; i < 5; i++) w[i] = _mm256_or_si256(_mm256_slli_epi32(be[i - 1], 16), _mm256_srli_epi32(be[i], 16));
+    w[5] = _mm256_or_si256(_mm256_slli_epi32(be[4], 16), _mm256_set1_epi32(0x8000));
+    for (int i = 6; i < 15; i++) w[i] = _mm256_setzero_si256();
+    w[15] = _mm256_set1_epi32(22 * 8);
+
+    __m256i script_hash[5];
+    sha256_avx8_soa_init(sha);
+    sha256_avx8_soa_transform(sha, w);
+    ripemd160_avx8_soa_hash_digest(script_hash, sha);
+    ripemd160_avx8_soa_store(script_hash, p2sh_out);
+    return 0;
+}
+
+int hash160_p2sh_p2wpkh_batch(const uint8_t* pubkeys, size_t pubkey_len, size_t count,
+                              uint8_t (*hash160_out)[20], uint8_t (*p2sh_out)[20]) {
+    if (pubkey_len != 33 && pubkey_len != 65) return -1;
+    if (count && !pubkeys) return -1;
+    for (size_t base = 0; base < count; base += 8) {
+        size_t cnt = count - base < 8 ? count - base : 8;
+        const uint8_t* ptrs[8];
+        for (size_t lane = 0; lane < 8; lane++) ptrs[lane] = pubkeys + (base + (lane < cnt ? lane : 0)) * pubkey_len;
+        if (cnt == 8) {
+            hash160_p2sh_p2wpkh_avx8(ptrs, pubkey_len, hash160_out ? hash160_out + base : NULL, p2sh_out ? p2sh_out + base : NULL);
+            continue;
+        }
+        uint8_t h[8][20], p[8][20];
+        hash160_p2sh_p2wpkh_avx8(ptrs, pubkey_len, h, p);
+        if (hash160_out) memcpy(hash160_out[base], h, cnt * 20);
+        if (p2sh_out) memcpy(p2sh_out[base], p, cnt * 20);
+    }
+    return 0;
+}
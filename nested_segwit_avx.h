@@ -0,0 +1,58 @@
+/* nested_segwit_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef NESTED_SEGWIT_AVX_H
+#define NESTED_SEGWIT_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Compile-time check to ensure AVX2 is enabled
+#if !defined(__AVX2__)
+#error "This implementation requires AVX2 support. Please compile with -mavx2."
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+* @brief HASH160 and P2SH-P2WPKH script hash of 8 public keys in one pass.
+* The key hash (the P2PKH and P2WPKH payload) is also the redeem script payload, so it stays in SoA
+* registers: it is prefixed with OP_0 PUSH20 (0x00 0x14) by shifting words, hashed as a constant-padded
+* 22-byte SHA-256 block and then as a 32-byte RIPEMD-160 block, with no byte buffers in between.
+* @param pubkeys 8 public keys of pubkey_len bytes (33 compressed or 65 uncompressed).
+* @param hash160_out HASH160(pubkey), the P2PKH and P2WPKH payload. May be NULL.
+* @param p2sh_out HASH160(0x00 0x14 || HASH160(pubkey)), the P2SH-P2WPKH payload. May be NULL.
+* @return 0 on success, -1 for an unsupported key length.
+*/
+int hash160_p2sh_p2wpkh_avx8(const uint8_t* const pubkeys[8], size_t pubkey_len,
+                             uint8_t hash160_out[8][20], uint8_t p2sh_out[8][20]);
+
+/**
+* @brief Same as hash160_p2sh_p2wpkh_avx8() for `count` contiguous keys (any count; the tail group is padded).
+* @return 0 on success, -1 for an unsupported key length.
+*/
+int hash160_p2sh_p2wpkh_batch(const uint8_t* pubkeys, size_t pubkey_len, size_t count,
+                              uint8_t (*hash160_out)[20], uint8_t (*p2sh_out)[20]);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // NESTED_SEGWIT_AVX_H
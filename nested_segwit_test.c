@@ -0,0 +1,128 @@
+/* nested_segwit_test.c
+ * gcc -O3 -mavx2 -march=native nested_segwit_test.c nested_segwit_avx.c sha256_avx.c ripemd160_avx.c -o nested_segwit_test -lcrypto
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <openssl/sha.h>
+#include <openssl/ripemd.h>
+
+#include "nested_segwit_avx.h"
+#include "sha256_avx.h"
+#include "ripemd160_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-52s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+static void hash160_ref(const uint8_t* data, size_t len, uint8_t out[20]) {
+    uint8_t sha[32];
+    SHA256(data, len, sha);
+    RIPEMD160(sha, 32, out);
+}
+
+static void p2sh_ref(const uint8_t* pubkey, size_t len, uint8_t out[20]) {
+    uint8_t script[22] = {0x00, 0x14};
+    hash160_ref(pubkey, len, script + 2);
+    hash160_ref(script, 22, out);
+}
+
+static void from_hex(const char* hex, uint8_t* out, size_t len) {
+    for (size_t i = 0; i < len; i++) sscanf(hex + 2 * i, "%2hhx", &out[i]);
+}
+
+int main() {
+    printf("--- Correctness Test (Fused HASH160 + P2SH-P2WPKH) ---\n");
+    int failed_tests = 0;
+
+    // Public key of private key 1 (address 3JvL6Ymt8MVWiCNHC7oWU6nLeHNJKLZGLN).
+    uint8_t g[33], h[8][20], p[8][20], expected_h[20], expected_p[20];
+    from_hex("0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", g, 33);
+    from_hex("751e76e8199196d454941c45d1b3a323f1433bd6", expected_h, 20);
+    from_hex("bcfeb728b584253d5f3f70bcb780e9ef218a68f4", expected_p, 20);
+    const uint8_t* ptrs[8] = {g, g, g, g, g, g, g, g};
+    int rc = hash160_p2sh_p2wpkh_avx8(ptrs, 33, h, p);
+    failed_tests += report("Generator key: HASH160 and P2SH-P2WPKH", rc == 0 && memcmp(h[7], expected_h, 20) == 0 &&
+                                                                     memcmp(p[7], expected_p, 20) == 0);
+
+    const size_t N = 1003;
+    srand(1);
+    int mismatches[2] = {0, 0};
+    for (int k = 0; k < 2; k++) {
+        size_t len = k ? 65 : 33;
+        uint8_t* keys = (uint8_t*)malloc(N * len);
+        uint8_t (*hashes)[20] = (uint8_t (*)[20])malloc(N * 20);
+        uint8_t (*scripts)[20] = (uint8_t (*)[20])malloc(N * 20);
+        for (size_t i = 0; i < N * len; i++) keys[i] = (uint8_t)rand();
+        hash160_p2sh_p2wpkh_batch(keys, len, N, hashes, scripts);
+        for (size_t i = 0; i < N; i++) {
+            uint8_t ref_h[20], ref_p[20];
+            hash160_ref(keys + i * len, len, ref_h);
+            p2sh_ref(keys + i * len, len, ref_p);
+            if (memcmp(hashes[i], ref_h, 20) != 0 || memcmp(scripts[i], ref_p, 20) != 0) mismatches[k]++;
+        }
+        free(keys);
+        free(hashes);
+        free(scripts);
+    }
+    failed_tests += report("1003 compressed keys match OpenSSL", mismatches[0] == 0);
+    failed_tests += report("1003 uncompressed keys match OpenSSL", mismatches[1] == 0);
+    failed_tests += report("Unsupported key length rejected", hash160_p2sh_p2wpkh_avx8(ptrs, 32, h, p) == -1);
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (1M compressed keys, HASH160 + P2SH-P2WPKH) ---\n");
+    const size_t BENCH = 1000000;
+    uint8_t* keys = (uint8_t*)malloc(BENCH * 33);
+    uint8_t (*hashes)[20] = (uint8_t (*)[20])malloc(BENCH * 20);
+    uint8_t (*scripts)[20] = (uint8_t (*)[20])malloc(BENCH * 20);
+    if (!keys || !hashes || !scripts) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return 1;
+    }
+    for (size_t i = 0; i < BENCH * 33; i++) keys[i] = (uint8_t)rand();
+
+    clock_t start = clock();
+    hash160_p2sh_p2wpkh_batch(keys, 33, BENCH, hashes, scripts);
+    double fused = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // The unfused pipeline: two byte-level HASH160 passes with the redeem script built in memory.
+    start = clock();
+    for (size_t base = 0; base < BENCH; base += 8) {
+        const uint8_t* lane_ptrs[8];
+        size_t lens[8];
+        uint8_t sha[8][32], script[8][22], out[8][20];
+        for (int lane = 0; lane < 8; lane++) {
+            lane_ptrs[lane] = keys + (base + (size_t)lane) * 33;
+            lens[lane] = 32;
+        }
+        sha256_avx8_hash_short(lane_ptrs, 33, sha);
+        for (int lane = 0; lane < 8; lane++) lane_ptrs[lane] = sha[lane];
+        ripemd160_multi_hash_lanes(lane_ptrs, lens, out);
+        for (int lane = 0; lane < 8; lane++) {
+            script[lane][0] = 0x00;
+            script[lane][1] = 0x14;
+            memcpy(script[lane] + 2, out[lane], 20);
+            lane_ptrs[lane] = script[lane];
+        }
+        sha256_avx8_hash_short(lane_ptrs, 22, sha);
+        for (int lane = 0; lane < 8; lane++) lane_ptrs[lane] = sha[lane];
+        ripemd160_multi_hash_lanes(lane_ptrs, lens, scripts + base);
+    }
+    double chained = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Fused kernel: %.4f seconds (%.2f Million keys/sec)\n", fused, BENCH / fused / 1e6);
+    printf("Chained HASH160 calls: %.4f seconds (%.2f Million keys/sec, %.2fx)\n", chained, BENCH / chained / 1e6, chained / fused);
+    free(keys);
+    free(hashes);
+    free(scripts);
+    return failed_tests == 0 ? 0 : 1;
+}
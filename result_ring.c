@@ -0,0 +1,404 @@
+/* result_ring.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#define _GNU_SOURCE
+#include "result_ring.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#define RING_MAGIC 0x31474E4952534552ull // "RESRING1"
+#define HEADER_SIZE 4096
+#define DEAD_CHECK_MS 100                // a producer blocked this long checks for dead consumers
+
+enum { SLOT_FREE = 0, SLOT_ACTIVE = 1, SLOT_CLAIMED = 2 };
+
+typedef struct {
+    alignas(64) _Atomic uint32_t state;
+    _Atomic int32_t pid;
+    _Atomic uint64_t read_seq; // records released by this consumer
+} ConsumerSlot;
+
+typedef struct {
+    uint64_t magic;
+    uint64_t capacity;
+    uint64_t record_size;
+    alignas(64) _Atomic uint64_t write_seq; // records committed
+    _Atomic uint32_t commit_futex;          // bumped on every commit and on close
+    _Atomic uint32_t sleepers;              // consumers inside FUTEX_WAIT on commit_futex
+    _Atomic uint32_t closed;
+    alignas(64) _Atomic uint32_t space_futex; // bumped on release/detach while the producer waits
+    _Atomic uint32_t producer_waiting;
+    _Atomic uint32_t attach_futex;            // bumped on attach
+    ConsumerSlot consumers[RESULT_RING_MAX_CONSUMERS];
+} RingHeader;
+
+_Static_assert(sizeof(RingHeader) <= HEADER_SIZE, "ring header must fit its page");
+_Static_assert(sizeof(ResultRecord) == 48, "records are 48 bytes");
+
+struct ResultRing {
+    RingHeader* hdr;
+    ResultRecord* records;
+    size_t map_size;
+    int fd;
+    char* name;
+    uint64_t mask;
+    uint64_t staged;     // next sequence number to write
+    uint64_t committed;
+    uint64_t limit;      // staged may not reach this without re-checking the consumers
+    size_t commit_batch;
+};
+
+struct ResultRingReader {
+    RingHeader* hdr;
+    const ResultRecord* records;
+    size_t map_size;
+    ConsumerSlot* slot;
+    uint64_t read_seq;
+    uint64_t mask;
+};
+
+// --- futex ---
+
+static int futex_wait(_Atomic uint32_t* addr, uint32_t expected, int timeout_ms) {
+    struct timespec ts, *tp = NULL;
+    if (timeout_ms >= 0) {
+        ts.tv_sec = timeout_ms / 1000;
+        ts.tv_nsec = (long)(timeout_ms % 1000) * 1000000L;
+        tp = &ts;
+    }
+    // Not FUTEX_PRIVATE_FLAG: the word is shared between processes.
+    return (int)syscall(SYS_futex, (uint32_t*)addr, FUTEX_WAIT, expected, tp, NULL, 0);
+}
+
+static void futex_wake(_Atomic uint32_t* addr) {
+    syscall(SYS_futex, (uint32_t*)addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+static int64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Milliseconds left until deadline (-1: none), clamped to cap when cap >= 0.
+static int remaining_ms(int64_t deadline, int cap) {
+    if (deadline < 0) return cap;
+    int64_t left = deadline - now_ms();
+    if (left < 0) left = 0;
+    return cap >= 0 && left > cap ? cap : (int)left;
+}
+
+// --- Producer ---
+
+// True once the consumer's process has exited; a zombie (exited, not yet reaped) counts as gone.
+static int process_gone(pid_t pid) {
+    if (pid <= 0) return 0;
+    if (kill(pid, 0) != 0) return errno == ESRCH;
+    char path[64], buf[512];
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int)pid);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0) return 0;
+    buf[n] = 0;
+    const char* p = strrchr(buf, ')'); // the state follows the parenthesized command name
+    return p && p[1] == ' ' && p[2] == 'Z';
+}
+
+// Lowest read sequence of the attached consumers, at most `fallback`. The producer passes its committed
+// position: a consumer attaching later starts there or after it, so the limit derived from it also
+// protects that consumer. With check_dead, consumers whose process has exited are dropped first.
+static uint64_t min_read_seq(RingHeader* hdr, uint64_t fallback, unsigned* active, int check_dead) {
+    uint64_t min = fallback;
+    unsigned n = 0;
+    for (int i = 0; i < RESULT_RING_MAX_CONSUMERS; i++) {
+        ConsumerSlot* c = &hdr->consumers[i];
+        if (atomic_load(&c->state) != SLOT_ACTIVE) continue;
+        if (check_dead && process_gone((pid_t)atomic_load(&c->pid))) {
+            uint32_t expected = SLOT_ACTIVE;
+            atomic_compare_exchange_strong(&c->state, &expected, SLOT_FREE);
+            continue;
+        }
+        uint64_t r = atomic_load(&c->read_seq);
+        if (r < min) min = r;
+        n++;
+    }
+    if (active) *active = n;
+    return min;
+}
+
+static int map_segment(int fd, size_t size, void** base) {
+    void* p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) return -1;
+    *base = p;
+    return 0;
+}
+
+ResultRing* result_ring_create(const char* shm_name, size_t capacity, size_t commit_batch) {
+    if (capacity < 2 * RESULT_RING_MIN_COMMIT) capacity = 2 * RESULT_RING_MIN_COMMIT;
+    uint64_t cap = 1;
+    while (cap < capacity) cap <<= 1;
+    if (commit_batch == 0) commit_batch = RESULT_RING_DEFAULT_COMMIT;
+    if (commit_batch < RESULT_RING_MIN_COMMIT) commit_batch = RESULT_RING_MIN_COMMIT;
+    if (commit_batch > cap / 2) commit_batch = (size_t)(cap / 2);
+
+    ResultRing* ring = (ResultRing*)calloc(1, sizeof(ResultRing));
+    if (!ring) return NULL;
+    ring->fd = -1;
+    if (shm_name) {
+        ring->name = strdup(shm_name);
+        ring->fd = ring->name ? shm_open(shm_name, O_CREAT | O_EXCL | O_RDWR, 0600) : -1;
+    } else {
+        ring->fd = memfd_create("result_ring", 0); // inherited across fork and exec
+    }
+    ring->map_size = HEADER_SIZE + (size_t)cap * sizeof(ResultRecord);
+    void* base = NULL;
+    if (ring->fd < 0 || ftruncate(ring->fd, (off_t)ring->map_size) != 0 || map_segment(ring->fd, ring->map_size, &base) != 0) {
+        int err = errno;
+        if (ring->fd >= 0) close(ring->fd);
+        if (ring->fd >= 0 && ring->name) shm_unlink(ring->name); // ours: O_EXCL created it
+        free(ring->name);
+        free(ring);
+        errno = err;
+        return NULL;
+    }
+    ring->hdr = (RingHeader*)base;
+    ring->records = (ResultRecord*)((uint8_t*)base + HEADER_SIZE);
+    ring->mask = cap - 1;
+    ring->commit_batch = commit_batch;
+    ring->hdr->capacity = cap;
+    ring->hdr->record_size = sizeof(ResultRecord);
+    atomic_store(&ring->hdr->write_seq, 0);
+    atomic_store_explicit((_Atomic uint64_t*)&ring->hdr->magic, RING_MAGIC, memory_order_release);
+    return ring;
+}
+
+int result_ring_fd(const ResultRing* ring) { return ring->fd; }
+
+int result_ring_wait_consumers(ResultRing* ring, unsigned n, int timeout_ms) {
+    int64_t deadline = timeout_ms < 0 ? -1 : now_ms() + timeout_ms;
+    for (;;) {
+        uint32_t v = atomic_load(&ring->hdr->attach_futex);
+        unsigned active;
+        min_read_seq(ring->hdr, 0, &active, 1);
+        if (active >= n) return 0;
+        if (deadline >= 0 && now_ms() >= deadline) return -1;
+        futex_wait(&ring->hdr->attach_futex, v, remaining_ms(deadline, DEAD_CHECK_MS));
+    }
+}
+
+void result_ring_commit(ResultRing* ring) {
+    if (ring->staged == ring->committed) return;
+    RingHeader* hdr = ring->hdr;
+    atomic_store(&hdr->write_seq, ring->staged); // releases the record writes
+    ring->committed = ring->staged;
+    atomic_fetch_add(&hdr->commit_futex, 1);
+    if (atomic_load(&hdr->sleepers)) futex_wake(&hdr->commit_futex);
+}
+
+// Makes room for the next record: re-reads the consumers' positions, and while the slowest one is a
+// whole ring behind, commits what is staged and sleeps until a consumer releases records. Consumer
+// pids are only checked after a wait timed out, so a healthy handoff makes no extra syscalls.
+static void wait_for_space(ResultRing* ring) {
+    RingHeader* hdr = ring->hdr;
+    uint64_t cap = ring->mask + 1;
+    int check_dead = 0;
+    for (;;) {
+        uint64_t min = min_read_seq(hdr, ring->committed, NULL, check_dead);
+        if (ring->staged - min < cap) {
+            ring->limit = min + cap;
+            return;
+        }
+        result_ring_commit(ring);
+        uint32_t v = atomic_load(&hdr->space_futex);
+        atomic_store(&hdr->producer_waiting, 1);
+        min = min_read_seq(hdr, ring->committed, NULL, 0);
+        check_dead = 0;
+        if (ring->staged - min >= cap && futex_wait(&hdr->space_futex, v, DEAD_CHECK_MS) != 0 && errno == ETIMEDOUT) {
+            check_dead = 1;
+        }
+        atomic_store(&hdr->producer_waiting, 0);
+    }
+}
+
+static inline ResultRecord* next_slot(ResultRing* ring) {
+    if (ring->staged >= ring->limit) wait_for_space(ring);
+    return &ring->records[ring->staged & ring->mask];
+}
+
+static inline void staged_one(ResultRing* ring) {
+    ring->staged++;
+    if (ring->staged - ring->committed >= ring->commit_batch) result_ring_commit(ring);
+}
+
+int result_ring_push(ResultRing* ring, const uint8_t* digest, size_t digest_len, uint64_t tag) {
+    if (digest_len > 32) return -1;
+    ResultRecord* r = next_slot(ring);
+    r->tag = tag;
+    memcpy(r->digest, digest, digest_len);
+    r->digest_len = (uint8_t)digest_len;
+    staged_one(ring);
+    return 0;
+}
+
+int result_ring_push_lanes(ResultRing* ring, const uint8_t* digests, size_t digest_len, size_t count,
+                           const uint64_t* tags, uint64_t first_tag) {
+    if (digest_len > 32) return -1;
+    for (size_t i = 0; i < count; i++) {
+        ResultRecord* r = next_slot(ring);
+        r->tag = tags ? tags[i] : first_tag + i;
+        memcpy(r->digest, digests + i * digest_len, digest_len);
+        r->digest_len = (uint8_t)digest_len;
+        staged_one(ring);
+    }
+    return 0;
+}
+
+void result_ring_close(ResultRing* ring) {
+    if (!ring) return;
+    result_ring_commit(ring);
+    atomic_store(&ring->hdr->closed, 1);
+    atomic_fetch_add(&ring->hdr->commit_futex, 1);
+    futex_wake(&ring->hdr->commit_futex);
+    munmap(ring->hdr, ring->map_size);
+    close(ring->fd);
+    if (ring->name) shm_unlink(ring->name);
+    free(ring->name);
+    free(ring);
+}
+
+// --- Consumer ---
+
+ResultRingReader* result_ring_attach_fd(int fd) {
+    struct stat st;
+    void* base = NULL;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < HEADER_SIZE || map_segment(fd, (size_t)st.st_size, &base) != 0) return NULL;
+    RingHeader* hdr = (RingHeader*)base;
+    // The magic is published last with release: only after seeing it are capacity and record_size valid.
+    int ready = atomic_load_explicit((_Atomic uint64_t*)&hdr->magic, memory_order_acquire) == RING_MAGIC;
+    uint64_t cap = ready ? hdr->capacity : 0;
+    if (!ready || hdr->record_size != sizeof(ResultRecord) || cap == 0 || (cap & (cap - 1)) ||
+        (size_t)st.st_size < HEADER_SIZE + cap * sizeof(ResultRecord)) {
+        munmap(base, (size_t)st.st_size);
+        errno = EINVAL;
+        return NULL;
+    }
+    ResultRingReader* reader = (ResultRingReader*)calloc(1, sizeof(ResultRingReader));
+    if (!reader) {
+        munmap(base, (size_t)st.st_size);
+        return NULL;
+    }
+    reader->hdr = hdr;
+    reader->records = (const ResultRecord*)((uint8_t*)base + HEADER_SIZE);
+    reader->map_size = (size_t)st.st_size;
+    reader->mask = cap - 1;
+    for (int i = 0; i < RESULT_RING_MAX_CONSUMERS && !reader->slot; i++) {
+        uint32_t expected = SLOT_FREE;
+        if (atomic_compare_exchange_strong(&hdr->consumers[i].state, &expected, SLOT_CLAIMED)) reader->slot = &hdr->consumers[i];
+    }
+    if (!reader->slot) {
+        munmap(base, reader->map_size);
+        free(reader);
+        errno = EBUSY;
+        return NULL;
+    }
+    // Publish a position, become visible to the producer, then start from what is committed by now:
+    // the producer cannot have overwritten anything at or after that point while it ignored this slot.
+    atomic_store(&reader->slot->pid, (int32_t)getpid());
+    atomic_store(&reader->slot->read_seq, atomic_load(&hdr->write_seq));
+    atomic_store(&reader->slot->state, SLOT_ACTIVE);
+    reader->read_seq = atomic_load(&hdr->write_seq);
+    atomic_store(&reader->slot->read_seq, reader->read_seq);
+    atomic_fetch_add(&hdr->attach_futex, 1);
+    futex_wake(&hdr->attach_futex);
+    return reader;
+}
+
+ResultRingReader* result_ring_attach(const char* shm_name) {
+    int fd = shm_open(shm_name, O_RDWR, 0);
+    if (fd < 0) return NULL;
+    ResultRingReader* reader = result_ring_attach_fd(fd);
+    close(fd); // the mapping keeps the segment
+    return reader;
+}
+
+int result_ring_acquire(ResultRingReader* reader, const ResultRecord** records, size_t* count, size_t max,
+                        int timeout_ms) {
+    RingHeader* hdr = reader->hdr;
+    int64_t deadline = timeout_ms < 0 ? -1 : now_ms() + timeout_ms;
+    for (;;) {
+        uint64_t w = atomic_load(&hdr->write_seq);
+        if (w > reader->read_seq) {
+            uint64_t n = w - reader->read_seq;
+            uint64_t to_end = reader->mask + 1 - (reader->read_seq & reader->mask);
+            if (n > to_end) n = to_end;
+            if (max && n > max) n = max;
+            *records = &reader->records[reader->read_seq & reader->mask];
+            *count = (size_t)n;
+            return 1;
+        }
+        if (atomic_load(&hdr->closed)) {
+            if (atomic_load(&hdr->write_seq) > reader->read_seq) continue;
+            return -1;
+        }
+        if (deadline >= 0 && now_ms() >= deadline) return 0;
+        // Announce the sleep before the last check, so a commit in between either is seen here or wakes us.
+        uint32_t v = atomic_load(&hdr->commit_futex);
+        atomic_fetch_add(&hdr->sleepers, 1);
+        if (atomic_load(&hdr->write_seq) == reader->read_seq && !atomic_load(&hdr->closed)) {
+            futex_wait(&hdr->commit_futex, v, remaining_ms(deadline, -1));
+        }
+        atomic_fetch_sub(&hdr->sleepers, 1);
+    }
+}
+
+void result_ring_release(ResultRingReader* reader, size_t count) {
+    RingHeader* hdr = reader->hdr;
+    reader->read_seq += count;
+    atomic_store(&reader->slot->read_seq, reader->read_seq);
+    if (atomic_load(&hdr->producer_waiting)) {
+        atomic_fetch_add(&hdr->space_futex, 1);
+        futex_wake(&hdr->space_futex);
+    }
+}
+
+void result_ring_detach(ResultRingReader* reader) {
+    if (!reader) return;
+    RingHeader* hdr = reader->hdr;
+    atomic_store(&reader->slot->state, SLOT_FREE);
+    if (atomic_load(&hdr->producer_waiting)) {
+        atomic_fetch_add(&hdr->space_futex, 1);
+        futex_wake(&hdr->space_futex);
+    }
+    munmap(hdr, reader->map_size);
+    free(reader);
+}
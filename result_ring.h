@@ -0,0 +1,125 @@
+/* result_ring.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+// Shared-memory ring that hands fixed-size result records (a digest plus a caller tag) from one
+// producer process to up to RESULT_RING_MAX_CONSUMERS consumer processes, without pipes.
+//
+// The ring lives in a memfd (inherited or passed as a descriptor) or a named POSIX shm segment.
+// The producer writes records straight into their slots and publishes them in batches: one release
+// store of the write sequence per commit, and a futex wake only when a consumer is actually asleep.
+// Every attached consumer sees every record, reading it in place, and releases it by advancing its
+// own read sequence; the producer blocks (futex) while the slowest consumer is a full ring behind.
+// A consumer that dies without detaching is dropped once the producer notices its pid is gone.
+
+#ifndef RESULT_RING_H
+#define RESULT_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RESULT_RING_MAX_CONSUMERS 16
+#define RESULT_RING_MIN_COMMIT 8      // records staged before an automatic commit, at least
+#define RESULT_RING_DEFAULT_COMMIT 64
+
+typedef struct {
+    uint64_t tag;           // caller-defined, e.g. a key index
+    uint8_t digest[32];     // HASH160 uses the first 20 bytes
+    uint8_t digest_len;
+    uint8_t reserved[7];
+} ResultRecord;             // 48 bytes
+
+typedef struct ResultRing ResultRing;             // producer side
+typedef struct ResultRingReader ResultRingReader; // consumer side
+
+/**
+* @brief Creates a ring of `capacity` records (rounded up to a power of two).
+* @param shm_name Name for shm_open ("/name"), or NULL for an anonymous memfd (see result_ring_fd). An
+*        existing segment of that name is never replaced: creation fails with EEXIST, and a segment left
+*        behind by a crashed producer has to be removed with shm_unlink first.
+* @param commit_batch Records staged before an automatic commit (0 for RESULT_RING_DEFAULT_COMMIT;
+*        raised to RESULT_RING_MIN_COMMIT, capped at half the capacity).
+* @return The ring, or NULL on error (errno is set).
+*/
+ResultRing* result_ring_create(const char* shm_name, size_t capacity, size_t commit_batch);
+
+/** @brief Descriptor of the segment, for passing to a consumer (fork, exec, SCM_RIGHTS). */
+int result_ring_fd(const ResultRing* ring);
+
+/**
+* @brief Waits until at least n consumers are attached. Records committed earlier are not seen by
+* consumers attaching later.
+* @param timeout_ms -1 waits forever.
+* @return 0 when n consumers are attached, -1 on timeout.
+*/
+int result_ring_wait_consumers(ResultRing* ring, unsigned n, int timeout_ms);
+
+/**
+* @brief Stages one record; blocks while the ring is full. Commits automatically every commit_batch records.
+* @return 0 on success, -1 if the digest is longer than 32 bytes.
+*/
+int result_ring_push(ResultRing* ring, const uint8_t* digest, size_t digest_len, uint64_t tag);
+
+/**
+* @brief Stages count records whose digests are contiguous (e.g. the uint8_t[8][20] output of a HASH160
+* batch), with tags[i] for record i (NULL: first_tag + i).
+* @return 0 on success, -1 if digest_len is longer than 32 bytes.
+*/
+int result_ring_push_lanes(ResultRing* ring, const uint8_t* digests, size_t digest_len, size_t count,
+                           const uint64_t* tags, uint64_t first_tag);
+
+/** @brief Publishes the staged records and wakes sleeping consumers. */
+void result_ring_commit(ResultRing* ring);
+
+/**
+* @brief Commits, marks the stream finished (consumers drain and then see the end) and unmaps the ring.
+* A named segment is unlinked; attached consumers keep their mappings.
+*/
+void result_ring_close(ResultRing* ring);
+
+/** @brief Attaches to a named ring; the reader starts at the next committed record. NULL on error. */
+ResultRingReader* result_ring_attach(const char* shm_name);
+
+/** @brief Attaches through a descriptor from result_ring_fd (the descriptor is not closed). */
+ResultRingReader* result_ring_attach_fd(int fd);
+
+/**
+* @brief Waits for committed records and returns the next run of them, in place in the shared ring.
+* The records stay valid until result_ring_release.
+* @param records Receives a pointer to the first record; a run never wraps around the end of the ring.
+* @param count Receives the number of records in the run (at most max, if max > 0).
+* @param timeout_ms -1 waits forever, 0 polls.
+* @return 1 with records, 0 on timeout, -1 when the producer closed the ring and everything was read.
+*/
+int result_ring_acquire(ResultRingReader* reader, const ResultRecord** records, size_t* count, size_t max,
+                        int timeout_ms);
+
+/** @brief Releases the first count records of the last acquired run, freeing their slots for the producer. */
+void result_ring_release(ResultRingReader* reader, size_t count);
+
+/** @brief Detaches the consumer and unmaps the ring. */
+void result_ring_detach(ResultRingReader* reader);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // RESULT_RING_H
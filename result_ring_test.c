@@ -0,0 +1,234 @@
+/* result_ring_test.c
+ * gcc -O3 -mavx2 -march=native result_ring_test.c result_ring.c -o result_ring_test
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/wait.h>
+
+#include "result_ring.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    fflush(stdout); // before the next fork
+    return ok ? 0 : 1;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Digest of record i: 20 bytes derived from the tag, so a consumer can check every record on its own.
+static void digest_of(uint64_t tag, uint8_t out[20]) {
+    uint64_t x = tag * 0x9E3779B97F4A7C15ull + 0x632BE59BD9B4E019ull;
+    for (int i = 0; i < 20; i++) {
+        x ^= x >> 29;
+        x *= 0xBF58476D1CE4E5B9ull;
+        out[i] = (uint8_t)(x >> 56);
+    }
+}
+
+static void produce(ResultRing* ring, uint64_t count) {
+    uint8_t digests[8][20];
+    for (uint64_t base = 0; base < count; base += 8) {
+        size_t n = count - base < 8 ? (size_t)(count - base) : 8;
+        for (size_t lane = 0; lane < n; lane++) digest_of(base + lane, digests[lane]);
+        result_ring_push_lanes(ring, digests[0], 20, n, NULL, base);
+    }
+}
+
+// Consumer process body: reads until the producer closes; exit status 0 if every record arrived in order.
+// stop_after > 0 makes it exit abruptly (no detach) after that many records.
+static int consume(ResultRingReader* reader, uint64_t expect, uint64_t stop_after) {
+    if (!reader) return 2;
+    uint64_t next = 0;
+    int bad = 0;
+    const ResultRecord* recs;
+    size_t n;
+    int rc;
+    while ((rc = result_ring_acquire(reader, &recs, &n, 0, -1)) == 1) {
+        for (size_t i = 0; i < n; i++) {
+            uint8_t want[20];
+            digest_of(next, want);
+            if (recs[i].tag != next || recs[i].digest_len != 20 || memcmp(recs[i].digest, want, 20) != 0) bad++;
+            next++;
+        }
+        result_ring_release(reader, n);
+        if (stop_after && next >= stop_after) _exit(0);
+    }
+    result_ring_detach(reader);
+    return bad == 0 && next == expect ? 0 : 1;
+}
+
+static int child_status(pid_t pid) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 99;
+}
+
+int main() {
+    printf("--- Correctness Test (Shared-memory Result Ring) ---\n");
+    fflush(stdout);
+    int failed_tests = 0;
+
+    // memfd inherited across fork, one consumer, a ring much smaller than the stream.
+    {
+        const uint64_t COUNT = 1000003;
+        ResultRing* ring = result_ring_create(NULL, 4096, 0);
+        pid_t pid = fork();
+        if (pid == 0) _exit(consume(result_ring_attach_fd(result_ring_fd(ring)), COUNT, 0));
+        int ok = result_ring_wait_consumers(ring, 1, 5000) == 0;
+        produce(ring, COUNT);
+        result_ring_close(ring);
+        failed_tests += report("memfd ring: 1M records to a forked consumer, in order", ok && child_status(pid) == 0);
+    }
+
+    // Named segment, two consumers, 16-record ring: constant backpressure and wraparound.
+    {
+        const uint64_t COUNT = 200000;
+        char name[64];
+        snprintf(name, sizeof(name), "/result_ring_test_%d", (int)getpid());
+        ResultRing* ring = result_ring_create(name, 16, 8);
+        pid_t pids[2];
+        for (int c = 0; c < 2; c++) {
+            pids[c] = fork();
+            if (pids[c] == 0) _exit(consume(result_ring_attach(name), COUNT, 0));
+        }
+        int ok = result_ring_wait_consumers(ring, 2, 5000) == 0;
+        produce(ring, COUNT);
+        result_ring_close(ring);
+        int s0 = child_status(pids[0]), s1 = child_status(pids[1]);
+        failed_tests += report("Named ring: two consumers each see every record", ok && s0 == 0 && s1 == 0);
+    }
+
+    // An existing segment of the same name is never replaced.
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "/result_ring_test_excl_%d", (int)getpid());
+        ResultRing* ring = result_ring_create(name, 16, 8);
+        errno = 0;
+        ResultRing* again = result_ring_create(name, 16, 8);
+        int eexist = again == NULL && errno == EEXIST;
+        ResultRingReader* reader = result_ring_attach(name);
+        failed_tests += report("Named ring: second create fails with EEXIST", ring && eexist && reader);
+        result_ring_detach(reader);
+        result_ring_close(again);
+        result_ring_close(ring);
+    }
+
+    // A consumer that dies without detaching must not block the producer forever.
+    {
+        const uint64_t COUNT = 100000;
+        ResultRing* ring = result_ring_create(NULL, 64, 8);
+        pid_t quitter = fork();
+        if (quitter == 0) _exit(consume(result_ring_attach_fd(result_ring_fd(ring)), COUNT, 1000));
+        pid_t steady = fork();
+        if (steady == 0) _exit(consume(result_ring_attach_fd(result_ring_fd(ring)), COUNT, 0));
+        int ok = result_ring_wait_consumers(ring, 2, 5000) == 0;
+        alarm(60); // a hang fails the test instead of stalling it
+        produce(ring, COUNT);
+        result_ring_close(ring);
+        alarm(0);
+        int sq = child_status(quitter), ss = child_status(steady);
+        failed_tests += report("Dead consumer is dropped, the live one completes", ok && sq == 0 && ss == 0);
+    }
+
+    // Timeouts, partial runs and end of stream within one process.
+    {
+        ResultRing* ring = result_ring_create(NULL, 32, 8);
+        ResultRingReader* reader = result_ring_attach_fd(result_ring_fd(ring));
+        const ResultRecord* recs;
+        size_t n = 0;
+        int poll_empty = result_ring_acquire(reader, &recs, &n, 0, 0) == 0;
+        double t0 = now_sec();
+        int timed_out = result_ring_acquire(reader, &recs, &n, 0, 50) == 0 && now_sec() - t0 >= 0.04;
+        uint8_t d[20];
+        digest_of(0, d);
+        for (int i = 0; i < 5; i++) result_ring_push(ring, d, 20, (uint64_t)i);
+        int staged_hidden = result_ring_acquire(reader, &recs, &n, 0, 0) == 0; // below the commit batch
+        result_ring_commit(ring);
+        int got = result_ring_acquire(reader, &recs, &n, 3, 0) == 1 && n == 3 && recs[0].tag == 0;
+        result_ring_release(reader, 3);
+        got = got && result_ring_acquire(reader, &recs, &n, 0, 0) == 1 && n == 2 && recs[0].tag == 3;
+        result_ring_release(reader, 2);
+        int too_long = result_ring_push(ring, d, 33, 0) == -1;
+        result_ring_close(ring);
+        int ended = result_ring_acquire(reader, &recs, &n, 0, -1) == -1;
+        result_ring_detach(reader);
+        failed_tests += report("Poll/timeout, batched commit, partial release, end", poll_empty && timed_out && staged_hidden && got && too_long && ended);
+    }
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    const uint64_t COUNT = 8000000;
+    printf("--- Performance Benchmark (%llu HASH160 records to another process) ---\n", (unsigned long long)COUNT);
+    fflush(stdout);
+    ResultRing* ring = result_ring_create(NULL, 1 << 16, 256);
+    pid_t pid = fork();
+    if (pid == 0) _exit(consume(result_ring_attach_fd(result_ring_fd(ring)), COUNT, 0));
+    result_ring_wait_consumers(ring, 1, 5000);
+    double t0 = now_sec();
+    produce(ring, COUNT);
+    result_ring_close(ring);
+    int ring_ok = child_status(pid) == 0;
+    double ring_time = now_sec() - t0;
+
+    // The same records through a pipe, one write per batch of 8 (the handoff being replaced).
+    int fds[2];
+    if (pipe(fds) != 0) return 1;
+    pid = fork();
+    if (pid == 0) {
+        close(fds[1]);
+        ResultRecord batch[8];
+        uint64_t next = 0;
+        int bad = 0;
+        size_t have = 0;
+        ssize_t r;
+        while ((r = read(fds[0], (uint8_t*)batch + have, sizeof(batch) - have)) > 0) {
+            have += (size_t)r;
+            if (have < sizeof(batch)) continue;
+            for (int i = 0; i < 8; i++) {
+                uint8_t want[20];
+                digest_of(next, want);
+                if (batch[i].tag != next++ || memcmp(batch[i].digest, want, 20) != 0) bad++;
+            }
+            have = 0;
+        }
+        _exit(bad == 0 && next == COUNT ? 0 : 1);
+    }
+    close(fds[0]);
+    t0 = now_sec();
+    uint8_t digests[8][20];
+    for (uint64_t base = 0; base < COUNT; base += 8) {
+        ResultRecord batch[8];
+        memset(batch, 0, sizeof(batch));
+        for (int lane = 0; lane < 8; lane++) {
+            digest_of(base + (uint64_t)lane, digests[lane]);
+            batch[lane].tag = base + (uint64_t)lane;
+            memcpy(batch[lane].digest, digests[lane], 20);
+            batch[lane].digest_len = 20;
+        }
+        if (write(fds[1], batch, sizeof(batch)) != (ssize_t)sizeof(batch)) break;
+    }
+    close(fds[1]);
+    int pipe_ok = child_status(pid) == 0;
+    double pipe_time = now_sec() - t0;
+
+    printf("Pipe, one write per 8 records: %.1f M records/sec%s\n", COUNT / pipe_time / 1e6, pipe_ok ? "" : " (FAILED)");
+    printf("Shared-memory ring:            %.1f M records/sec (%.2fx)%s\n", COUNT / ring_time / 1e6, pipe_time / ring_time,
+           ring_ok ? "" : " (FAILED)");
+    return failed_tests == 0 ? 0 : 1;
+}
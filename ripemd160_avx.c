@@ -15,6 +15,9 @@
    Author: 8891689 (https://github.com/8891689)
 */
 #include "ripemd160_avx.h" 
+#include "ripemd160_avx_soa.h"
+#include "hash_stats.h"
+#include "hash_verify.h"
 #include <string.h>
 #include <stdbool.h>
 #include <stddef.h> 
@@ -102,6 +105,7 @@ static void initialize_avx_constants() {
 
 //  schedule function
 static void schedule(__m256i X[16], const uint8_t blocks[LANE_COUNT][BLOCK_SIZE]) {
+    HASH_STATS_BEGIN(HASH_STATS_RIPEMD160_SCHEDULE);
     const int* base_addr = (const int*)blocks; 
     const int block_size_dwords = BLOCK_SIZE / sizeof(int); // 64 / 4 = 16
 
@@ -118,10 +122,12 @@ static void schedule(__m256i X[16], const uint8_t blocks[LANE_COUNT][BLOCK_SIZE]
         );
         X[word_idx] = _mm256_i32gather_epi32(base_addr, vindex, 4);
     }
+    HASH_STATS_END(HASH_STATS_RIPEMD160_SCHEDULE, 0, LANE_COUNT);
 }
 
 static void compress(__m256i state[5], const __m256i X[16]) {
     initialize_avx_constants(); 
+    HASH_STATS_BEGIN(HASH_STATS_RIPEMD160_COMPRESS);
 
     __m256i H0 = state[0];
     __m256i H1 = state[1];
@@ -175,6 +181,51 @@ static void compress(__m256i state[5], const __m256i X[16]) {
     state[2] = _mm256_add_epi32(_mm256_add_epi32(H3, E), A1);
     state[3] = _mm256_add_epi32(_mm256_add_epi32(H4, A), B1);
     state[4] = _mm256_add_epi32(_mm256_add_epi32(H0, B), C1);
+    HASH_STATS_END(HASH_STATS_RIPEMD160_COMPRESS, LANE_COUNT, LANE_COUNT);
+}
+
+// Loads one block from each of 8 unaligned lane pointers: RIPEMD-160 words are little-endian, so only a transpose is needed.
+static inline void load_words_ptrs(__m256i X[16], const uint8_t* const ptrs[LANE_COUNT]) {
+    for (int half = 0; half < 2; ++half) {
+        __m256i* rows = X + half * 8;
+        __m256i t[8];
+        for (int lane = 0; lane < LANE_COUNT; ++lane) rows[lane] = _mm256_loadu_si256((const __m256i*)(ptrs[lane] + half * 32));
+        t[0] = _mm256_unpacklo_epi32(rows[0], rows[1]); t[1] = _mm256_unpackhi_epi32(rows[0], rows[1]);
+        t[2] = _mm256_unpacklo_epi32(rows[2], rows[3]); t[3] = _mm256_unpackhi_epi32(rows[2], rows[3]);
+        t[4] = _mm256_unpacklo_epi32(rows[4], rows[5]); t[5] = _mm256_unpackhi_epi32(rows[4], rows[5]);
+        t[6] = _mm256_unpacklo_epi32(rows[6], rows[7]); t[7] = _mm256_unpackhi_epi32(rows[6], rows[7]);
+        rows[0] = _mm256_unpacklo_epi64(t[0], t[2]); rows[1] = _mm256_unpackhi_epi64(t[0], t[2]);
+        rows[2] = _mm256_unpacklo_epi64(t[1], t[3]); rows[3] = _mm256_unpackhi_epi64(t[1], t[3]);
+        rows[4] = _mm256_unpacklo_epi64(t[4], t[6]); rows[5] = _mm256_unpackhi_epi64(t[4], t[6]);
+        rows[6] = _mm256_unpacklo_epi64(t[5], t[7]); rows[7] = _mm256_unpackhi_epi64(t[5], t[7]);
+        t[0] = _mm256_permute2x128_si256(rows[0], rows[4], 0x20); t[1] = _mm256_permute2x128_si256(rows[1], rows[5], 0x20);
+        t[2] = _mm256_permute2x128_si256(rows[2], rows[6], 0x20); t[3] = _mm256_permute2x128_si256(rows[3], rows[7], 0x20);
+        t[4] = _mm256_permute2x128_si256(rows[0], rows[4], 0x31); t[5] = _mm256_permute2x128_si256(rows[1], rows[5], 0x31);
+        t[6] = _mm256_permute2x128_si256(rows[2], rows[6], 0x31); t[7] = _mm256_permute2x128_si256(rows[3], rows[7], 0x31);
+        memcpy(rows, t, sizeof(t));
+    }
+}
+
+// nblocks consecutive blocks per lane straight from the callers' buffers, with the state kept in locals
+// across blocks and the next block of each lane prefetched.
+static void process_blocks_ptrs(__m256i state_io[5], const uint8_t* const lane_ptrs[LANE_COUNT], size_t nblocks) {
+    __m256i state[5];
+    memcpy(state, state_io, sizeof(state));
+    const uint8_t* ptrs[LANE_COUNT];
+    memcpy(ptrs, lane_ptrs, sizeof(ptrs));
+    CUSTOM_ALIGNAS(64) __m256i X[16];
+    for (size_t b = 0; b < nblocks; ++b) {
+        if (b + 1 < nblocks) {
+            for (int lane = 0; lane < LANE_COUNT; ++lane) {
+                _mm_prefetch((const char*)(ptrs[lane] + BLOCK_SIZE), _MM_HINT_T0);
+                _mm_prefetch((const char*)(ptrs[lane] + 2 * BLOCK_SIZE - 1), _MM_HINT_T0);
+            }
+        }
+        load_words_ptrs(X, ptrs);
+        compress(state, X);
+        for (int lane = 0; lane < LANE_COUNT; ++lane) ptrs[lane] += BLOCK_SIZE;
+    }
+    memcpy(state_io, state, sizeof(state));
 }
 
 static void process_full_blocks(__m256i state[5], uint64_t total_bits[LANE_COUNT], const uint8_t blocks_to_process[LANE_COUNT][BLOCK_SIZE]) {
@@ -214,7 +265,14 @@ void ripemd160_multi_update_full_blocks(RIPEMD160_MULTI_CTX* ctx, const uint8_t
     process_full_blocks(ctx->state, ctx->total_bits, data_blocks);
 }
 
+void ripemd160_multi_update_n_blocks(RIPEMD160_MULTI_CTX* ctx, const uint8_t* const lane_ptrs[LANE_COUNT], size_t nblocks) {
+    if (!ctx || !lane_ptrs) return;
+    process_blocks_ptrs(ctx->state, lane_ptrs, nblocks);
+    for (int lane = 0; lane < LANE_COUNT; ++lane) ctx->total_bits[lane] += (uint64_t)nblocks * BLOCK_SIZE * 8;
+}
+
 void ripemd160_multi_final(RIPEMD160_MULTI_CTX* ctx, uint8_t digests[LANE_COUNT][DIGEST_SIZE]) {
+    HASH_STATS_BEGIN(HASH_STATS_RIPEMD160_FINAL);
     uint8_t final_padding_block[LANE_COUNT][BLOCK_SIZE];
     uint8_t second_padding_block[LANE_COUNT][BLOCK_SIZE];
     bool needs_second_block_for_padding[LANE_COUNT] = {false}; 
@@ -264,5 +322,130 @@ void ripemd160_multi_final(RIPEMD160_MULTI_CTX* ctx, uint8_t digests[LANE_COUNT]
             digests[lane][word_idx*4 + 3] = (val >> 24) & 0xFF;
         }
     }
+    HASH_STATS_END(HASH_STATS_RIPEMD160_FINAL, 0, LANE_COUNT);
 }
 
+
+void ripemd160_multi_hash_lanes(const uint8_t* const messages[LANE_COUNT], const size_t lengths[LANE_COUNT], uint8_t digests[LANE_COUNT][DIGEST_SIZE]) {
+    if (!messages || !lengths || !digests) return;
+    initialize_avx_constants();
+    __m256i state[5] = {INIT_A, INIT_B, INIT_C, INIT_D, INIT_E};
+
+    size_t lane_blocks[LANE_COUNT];
+    size_t max_blocks = 0;
+    for (int lane = 0; lane < LANE_COUNT; ++lane) {
+        lane_blocks[lane] = (lengths[lane] + 9 + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        if (lane_blocks[lane] > max_blocks) max_blocks = lane_blocks[lane];
+    }
+
+    // Blocks that are full in every lane are hashed in place, without staging copies.
+    size_t direct_blocks = SIZE_MAX;
+    for (int lane = 0; lane < LANE_COUNT; ++lane) {
+        if (lengths[lane] / BLOCK_SIZE < direct_blocks) direct_blocks = lengths[lane] / BLOCK_SIZE;
+    }
+    process_blocks_ptrs(state, messages, direct_blocks);
+
+    CUSTOM_ALIGNAS(64) uint8_t blocks[LANE_COUNT][BLOCK_SIZE];
+    CUSTOM_ALIGNAS(32) uint32_t state_lanes_buffer[5][LANE_COUNT];
+    for (size_t b = direct_blocks; b < max_blocks; ++b) {
+        bool finishing[LANE_COUNT] = {false};
+        bool any_finishing = false;
+        for (int lane = 0; lane < LANE_COUNT; ++lane) {
+            size_t len = lengths[lane];
+            size_t offset = b * BLOCK_SIZE;
+            if (b >= lane_blocks[lane]) continue; // finished lane: the stale block is hashed and ignored
+            if (offset + BLOCK_SIZE <= len) {
+                memcpy(blocks[lane], messages[lane] + offset, BLOCK_SIZE);
+                continue;
+            }
+            memset(blocks[lane], 0, BLOCK_SIZE);
+            size_t remaining = offset < len ? len - offset : 0;
+            if (remaining) memcpy(blocks[lane], messages[lane] + offset, remaining);
+            if (offset <= len) blocks[lane][remaining] = 0x80;
+            if (b == lane_blocks[lane] - 1) {
+                append_length_to_padding(blocks[lane], (uint64_t)len * 8);
+                finishing[lane] = true;
+                any_finishing = true;
+            }
+        }
+        process_full_blocks(state, NULL, (const uint8_t (*)[BLOCK_SIZE])blocks);
+
+        if (!any_finishing) continue;
+        for (int i = 0; i < 5; ++i) {
+            _mm256_store_si256((__m256i*)state_lanes_buffer[i], state[i]);
+        }
+        for (int lane = 0; lane < LANE_COUNT; ++lane) {
+            if (!finishing[lane]) continue;
+            for (int word_idx = 0; word_idx < 5; ++word_idx) {
+                uint32_t val = state_lanes_buffer[word_idx][lane];
+                memcpy(digests[lane] + word_idx * 4, &val, 4); // RIPEMD-160 digests are little-endian words
+            }
+        }
+    }
+    HASH_VERIFY_LANES(HASH_VERIFY_RIPEMD160, messages, lengths, digests);
+}
+
+void ripemd160_multi_iterate(const uint8_t* const seeds[LANE_COUNT], const uint64_t counts[LANE_COUNT], uint8_t digests[LANE_COUNT][DIGEST_SIZE]) {
+    if (!seeds || !counts || !digests) return;
+    initialize_avx_constants();
+    CUSTOM_ALIGNAS(32) uint32_t words[5][LANE_COUNT];
+    for (int lane = 0; lane < LANE_COUNT; ++lane) {
+        for (int i = 0; i < 5; ++i) memcpy(&words[i][lane], seeds[lane] + i * 4, 4);
+    }
+    __m256i digest[5];
+    for (int i = 0; i < 5; ++i) digest[i] = _mm256_load_si256((const __m256i*)words[i]);
+
+    // A 20-byte message is words 0-4 of the block; the padding words never change.
+    CUSTOM_ALIGNAS(64) __m256i X[16];
+    X[5] = _mm256_set1_epi32(0x80);
+    for (int i = 6; i < 16; ++i) X[i] = _mm256_setzero_si256();
+    X[14] = _mm256_set1_epi32(DIGEST_SIZE * 8);
+
+    uint64_t done = 0;
+    for (;;) {
+        uint8_t active = 0;
+        uint64_t run = UINT64_MAX;
+        for (int lane = 0; lane < LANE_COUNT; ++lane) {
+            if (counts[lane] <= done) continue;
+            active |= (uint8_t)(1u << lane);
+            if (counts[lane] - done < run) run = counts[lane] - done;
+        }
+        if (!active) break;
+        const __m256i sel = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        const __m256i keep = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(active), sel), sel);
+        for (uint64_t step = 0; step < run; ++step) {
+            __m256i state[5] = {INIT_A, INIT_B, INIT_C, INIT_D, INIT_E};
+            for (int i = 0; i < 5; ++i) X[i] = digest[i];
+            compress(state, X);
+            for (int i = 0; i < 5; ++i) digest[i] = active == 0xFF ? state[i] : _mm256_blendv_epi8(digest[i], state[i], keep);
+        }
+        done += run;
+    }
+    ripemd160_avx8_soa_store(digest, digests);
+}
+
+// --- SoA interface (ripemd160_avx_soa.h) ---
+void ripemd160_avx8_soa_hash_digest(__m256i out[5], const __m256i sha256_state[8]) {
+    initialize_avx_constants();
+    // The SHA-256 words are big-endian and RIPEMD-160 reads little-endian ones: byte-swap, then pad in place.
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    CUSTOM_ALIGNAS(64) __m256i X[16];
+    for (int i = 0; i < 8; i++) X[i] = _mm256_shuffle_epi8(sha256_state[i], bswap);
+    X[8] = _mm256_set1_epi32(0x80);
+    for (int i = 9; i < 16; i++) X[i] = _mm256_setzero_si256();
+    X[14] = _mm256_set1_epi32(32 * 8);
+    out[0] = INIT_A; out[1] = INIT_B; out[2] = INIT_C; out[3] = INIT_D; out[4] = INIT_E;
+    compress(out, X);
+}
+
+void ripemd160_avx8_soa_store(const __m256i state[5], uint8_t digests[8][20]) {
+    CUSTOM_ALIGNAS(32) uint32_t state_lanes_buffer[5][LANE_COUNT];
+    for (int i = 0; i < 5; ++i) _mm256_store_si256((__m256i*)state_lanes_buffer[i], state[i]);
+    for (int lane = 0; lane < LANE_COUNT; ++lane) {
+        for (int word_idx = 0; word_idx < 5; ++word_idx) {
+            uint32_t val = state_lanes_buffer[word_idx][lane];
+            memcpy(digests[lane] + word_idx * 4, &val, 4);
+        }
+    }
+}
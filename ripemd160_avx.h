@@ -50,8 +50,19 @@ typedef struct CUSTOM_ALIGNAS(64) RIPEMD160_MULTI_CTX_TAG {
 
 void ripemd160_multi_init(RIPEMD160_MULTI_CTX* ctx);
 void ripemd160_multi_update_full_blocks(RIPEMD160_MULTI_CTX* ctx, const uint8_t data_blocks[LANE_COUNT][BLOCK_SIZE]);
+// Processes nblocks consecutive 64-byte blocks per lane loaded directly from the callers' (unaligned) buffers,
+// keeping the state in registers across blocks and prefetching each lane's next block. Call with no partial data buffered.
+void ripemd160_multi_update_n_blocks(RIPEMD160_MULTI_CTX* ctx, const uint8_t* const lane_ptrs[LANE_COUNT], size_t nblocks);
 void ripemd160_multi_final(RIPEMD160_MULTI_CTX* ctx, uint8_t digests[LANE_COUNT][DIGEST_SIZE]);
 
+// One-shot RIPEMD-160 of 8 messages with independent lengths; each lane's digest is taken at the block where it finishes.
+// Returns without writing when messages, lengths or digests is NULL.
+void ripemd160_multi_hash_lanes(const uint8_t* const messages[LANE_COUNT], const size_t lengths[LANE_COUNT], uint8_t digests[LANE_COUNT][DIGEST_SIZE]);
+
+// Iterated RIPEMD-160 of 8 20-byte seeds: lane i is replaced by its own digest counts[i] times (0 copies the seed).
+// Each step compresses the previous digest as one constant-padded block without leaving registers; finished lanes are blended out.
+void ripemd160_multi_iterate(const uint8_t* const seeds[LANE_COUNT], const uint64_t counts[LANE_COUNT], uint8_t digests[LANE_COUNT][DIGEST_SIZE]);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
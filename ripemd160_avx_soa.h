@@ -0,0 +1,42 @@
+/* ripemd160_avx_soa.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+// Low-level SoA interface to the 8-lane RIPEMD-160 kernel, the counterpart of sha256_avx_soa.h.
+// A RIPEMD-160 state is 5 vectors of little-endian words (word i of all 8 lanes in state[i]).
+
+#ifndef RIPEMD160_AVX_SOA_H
+#define RIPEMD160_AVX_SOA_H
+
+#include <immintrin.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// RIPEMD-160 of a 32-byte message given as a SHA-256 state in SoA form (the second half of HASH160).
+void ripemd160_avx8_soa_hash_digest(__m256i out[5], const __m256i sha256_state[8]);
+
+// Transposes the state and writes 8 digests.
+void ripemd160_avx8_soa_store(const __m256i state[5], uint8_t digests[8][20]);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // RIPEMD160_AVX_SOA_H
@@ -0,0 +1,282 @@
+/* scripthash_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#include "scripthash_avx.h"
+#include "hash_index_avx.h"
+#include "sha256_avx.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MAGIC_LEN 8
+#define FIXED_BUCKETS 4
+#define MIXED_BUCKET FIXED_BUCKETS
+
+// Script lengths with a fixed-length bucket: P2PKH, P2SH, P2WPKH, P2WSH/P2TR.
+static const size_t fixed_lengths[FIXED_BUCKETS] = {25, 23, 22, 34};
+
+// Up to 8 scripts waiting for one kernel call; fixed_len is 0 for the mixed-length bucket.
+typedef struct {
+    size_t fixed_len;
+    size_t n;
+    const uint8_t* scripts[8];
+    size_t lens[8];
+    uint64_t ids[8];
+} Bucket;
+
+// Receives the scripthash of the script that was queued with `id`.
+typedef int (*ScripthashSink)(void* ctx, uint64_t id, const uint8_t scripthash[32]);
+
+typedef struct {
+    Bucket buckets[FIXED_BUCKETS + 1];
+    ScripthashSink sink;
+    void* ctx;
+    uint64_t fixed_hashes;
+} Hasher;
+
+static inline uint32_t load_le32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint64_t load_le64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static void hasher_init(Hasher* h, ScripthashSink sink, void* ctx) {
+    memset(h, 0, sizeof(*h));
+    for (int i = 0; i < FIXED_BUCKETS; i++) h->buckets[i].fixed_len = fixed_lengths[i];
+    h->sink = sink;
+    h->ctx = ctx;
+}
+
+static int flush_bucket(Hasher* h, Bucket* b) {
+    if (!b->n) return 0;
+    for (size_t lane = b->n; lane < 8; lane++) { // idle lanes rehash lane 0
+        b->scripts[lane] = b->scripts[0];
+        b->lens[lane] = b->lens[0];
+    }
+    uint8_t digests[8][32];
+    if (b->fixed_len) {
+        sha256_avx8_hash_short(b->scripts, b->fixed_len, digests);
+        h->fixed_hashes += b->n;
+    } else {
+        sha256_avx8_hash_lanes(NULL, 0, b->scripts, b->lens, digests);
+    }
+    int rc = 0;
+    for (size_t lane = 0; lane < b->n; lane++) {
+        uint8_t scripthash[32];
+        for (int i = 0; i < 32; i++) scripthash[i] = digests[lane][31 - i];
+        if (h->sink(h->ctx, b->ids[lane], scripthash) != 0) rc = -1;
+    }
+    b->n = 0;
+    return rc;
+}
+
+static int hasher_add(Hasher* h, const uint8_t* script, size_t len, uint64_t id) {
+    Bucket* b = &h->buckets[MIXED_BUCKET];
+    for (int i = 0; i < FIXED_BUCKETS; i++) {
+        if (len == fixed_lengths[i]) {
+            b = &h->buckets[i];
+            break;
+        }
+    }
+    b->scripts[b->n] = script;
+    b->lens[b->n] = len;
+    b->ids[b->n] = id;
+    return ++b->n == 8 ? flush_bucket(h, b) : 0;
+}
+
+static int hasher_finish(Hasher* h) {
+    int rc = 0;
+    for (int i = 0; i <= MIXED_BUCKET; i++) {
+        if (flush_bucket(h, &h->buckets[i]) != 0) rc = -1;
+    }
+    return rc;
+}
+
+size_t utxo_serialize_record(const UtxoRecord* rec, uint8_t* out) {
+    if (!rec) return 0;
+    size_t len = rec->script_len;
+    size_t prefix = len < 0xfd ? 1 : len <= 0xffff ? 3 : len <= 0xffffffffu ? 5 : 9;
+    size_t total = SCRIPTHASH_PAYLOAD_LEN + prefix + len;
+    if (!out) return total;
+    memcpy(out, rec->txid, 32);
+    memcpy(out + 32, &rec->vout, 4);
+    memcpy(out + 36, &rec->height, 4);
+    memcpy(out + 40, &rec->value, 8);
+    uint8_t* p = out + SCRIPTHASH_PAYLOAD_LEN;
+    uint64_t n = len;
+    if (prefix == 1) {
+        *p++ = (uint8_t)n;
+    } else {
+        *p++ = prefix == 3 ? 0xfd : prefix == 5 ? 0xfe : 0xff;
+        memcpy(p, &n, prefix - 1);
+        p += prefix - 1;
+    }
+    if (len) memcpy(p, rec->script, len);
+    return total;
+}
+
+size_t utxo_parse_record(const uint8_t* data, size_t avail, UtxoRecord* rec) {
+    if (!data || !rec || avail < SCRIPTHASH_PAYLOAD_LEN + 1) return 0;
+    scripthash_decode_payload(data, rec);
+    const uint8_t* p = data + SCRIPTHASH_PAYLOAD_LEN;
+    size_t left = avail - SCRIPTHASH_PAYLOAD_LEN;
+    uint64_t len = *p;
+    size_t prefix = len < 0xfd ? 1 : len == 0xfd ? 3 : len == 0xfe ? 5 : 9;
+    if (left < prefix) return 0;
+    if (prefix > 1) {
+        len = 0;
+        memcpy(&len, p + 1, prefix - 1);
+    }
+    if (len > UTXO_MAX_SCRIPT_LEN || len > left - prefix) return 0;
+    rec->script = p + prefix;
+    rec->script_len = (size_t)len;
+    return SCRIPTHASH_PAYLOAD_LEN + prefix + (size_t)len;
+}
+
+ScriptType script_classify(const uint8_t* s, size_t len) {
+    if (!s) return SCRIPT_TYPE_OTHER;
+    if (len == 25 && s[0] == 0x76 && s[1] == 0xa9 && s[2] == 0x14 && s[23] == 0x88 && s[24] == 0xac) return SCRIPT_TYPE_P2PKH;
+    if (len == 23 && s[0] == 0xa9 && s[1] == 0x14 && s[22] == 0x87) return SCRIPT_TYPE_P2SH;
+    if (len == 22 && s[0] == 0x00 && s[1] == 0x14) return SCRIPT_TYPE_P2WPKH;
+    if (len == 34 && s[0] == 0x00 && s[1] == 0x20) return SCRIPT_TYPE_P2WSH;
+    if (len == 34 && s[0] == 0x51 && s[1] == 0x20) return SCRIPT_TYPE_P2TR;
+    return SCRIPT_TYPE_OTHER;
+}
+
+void scripthash_decode_payload(const uint8_t* payload, UtxoRecord* rec) {
+    if (!payload || !rec) return;
+    memcpy(rec->txid, payload, 32);
+    rec->vout = load_le32(payload + 32);
+    rec->height = load_le32(payload + 36);
+    rec->value = load_le64(payload + 40);
+    rec->script = NULL;
+    rec->script_len = 0;
+}
+
+static int sink_to_array(void* ctx, uint64_t id, const uint8_t scripthash[32]) {
+    memcpy(((uint8_t (*)[32])ctx)[id], scripthash, 32);
+    return 0;
+}
+
+int electrum_scripthash_batch(const uint8_t* const* scripts, const size_t* lens, size_t count, uint8_t (*out)[32]) {
+    if (count && (!scripts || !lens || !out)) return -1;
+    Hasher h;
+    hasher_init(&h, sink_to_array, out);
+    for (size_t i = 0; i < count; i++) hasher_add(&h, scripts[i], lens[i], i);
+    return hasher_finish(&h);
+}
+
+// --- Index builder ---
+
+typedef struct {
+    const uint8_t* map;
+    HashIndexBuilder* index;
+} BuildSink;
+
+// The record at offset `id` starts with the payload fields, so they are stored as they are.
+static int sink_to_index(void* ctx, uint64_t id, const uint8_t scripthash[32]) {
+    BuildSink* s = (BuildSink*)ctx;
+    return hash_index_builder_add(s->index, scripthash, s->map + id, SCRIPTHASH_PAYLOAD_LEN);
+}
+
+static int scan_dump(const uint8_t* map, size_t size, HashIndexBuilder* index, HashIndexBuilder* address_index,
+                     ScripthashStats* stats) {
+    if (size < MAGIC_LEN || memcmp(map, UTXO_DUMP_MAGIC, MAGIC_LEN) != 0) return -1;
+    BuildSink sink = {map, index};
+    Hasher h;
+    hasher_init(&h, sink_to_index, &sink);
+    int rc = 0;
+    size_t pos = MAGIC_LEN;
+    while (pos < size && rc == 0) {
+        UtxoRecord rec;
+        size_t n = utxo_parse_record(map + pos, size - pos, &rec);
+        if (!n) {
+            rc = -1;
+            break;
+        }
+        ScriptType type = script_classify(rec.script, rec.script_len);
+        stats->outputs++;
+        stats->by_type[type]++;
+        if (address_index && (type == SCRIPT_TYPE_P2PKH || type == SCRIPT_TYPE_P2SH)) {
+            uint8_t payload[SCRIPTHASH_ADDRESS_PAYLOAD_LEN];
+            payload[0] = (uint8_t)type;
+            memcpy(payload + 1, map + pos, SCRIPTHASH_PAYLOAD_LEN);
+            const uint8_t* hash160 = rec.script + (type == SCRIPT_TYPE_P2PKH ? 3 : 2);
+            if (hash_index_builder_add(address_index, hash160, payload, sizeof(payload)) != 0) rc = -1;
+            stats->address_entries++;
+        }
+        if (hasher_add(&h, rec.script, rec.script_len, pos) != 0) rc = -1;
+        pos += n;
+    }
+    if (hasher_finish(&h) != 0) rc = -1;
+    stats->fixed_length_hashes = h.fixed_hashes;
+    return rc;
+}
+
+int scripthash_index_build(const char* dump_path, const char* index_path, const char* address_index_path,
+                           size_t memory_limit, ScripthashStats* stats) {
+    if (!dump_path || !index_path) return -1;
+    ScripthashStats local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+
+    int fd = open(dump_path, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < MAGIC_LEN) {
+        close(fd);
+        return -1;
+    }
+    size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+    madvise(map, size, MADV_SEQUENTIAL);
+
+    HashIndexBuilder* index = hash_index_builder_create(index_path, SCRIPTHASH_KEY_LEN, memory_limit);
+    HashIndexBuilder* address_index = address_index_path
+        ? hash_index_builder_create(address_index_path, HASH_INDEX_KEY_LEN_HASH160, memory_limit) : NULL;
+    int rc = -1;
+    if (index && (address_index || !address_index_path)) rc = scan_dump((const uint8_t*)map, size, index, address_index, stats);
+    munmap(map, size);
+
+    if (rc != 0) {
+        hash_index_builder_abort(index);
+        hash_index_builder_abort(address_index);
+        return -1;
+    }
+    if (hash_index_builder_finish(index) != 0) {
+        hash_index_builder_abort(address_index);
+        return -1;
+    }
+    if (address_index && hash_index_builder_finish(address_index) != 0) {
+        unlink(index_path);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+/* scripthash_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef SCRIPTHASH_AVX_H
+#define SCRIPTHASH_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Compile-time check to ensure AVX2 is enabled
+#if !defined(__AVX2__)
+#error "This implementation requires AVX2 support. Please compile with -mavx2."
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Electrum-protocol scripthash index (SHA256(scriptPubKey), byte-reversed) built from a UTXO snapshot.
+//
+// UTXO dump (little-endian): the magic "UTXD0001", then one record per unspent output until EOF:
+//   txid[32] (internal byte order) || vout u32 || height u32 || value u64 || compact-size length || script
+//
+// Scripts are bucketed by length. The standard lengths go through the constant-padded fixed-length
+// kernel (sha256_avx8_hash_short): 25 (P2PKH), 23 (P2SH), 22 (P2WPKH) and 34 (P2WSH, P2TR). Every
+// other length shares a mixed-length bucket (sha256_avx8_hash_lanes). The results are written to
+// hash_index files (hash_index_avx.h), so lookups are mmap-based and all outputs of a scripthash sit
+// next to each other (hash_index_find_all).
+
+#define UTXO_DUMP_MAGIC "UTXD0001"
+#define UTXO_MAX_SCRIPT_LEN 1000000
+#define SCRIPTHASH_KEY_LEN 32
+#define SCRIPTHASH_PAYLOAD_LEN 48      // txid || vout || height || value
+#define SCRIPTHASH_ADDRESS_PAYLOAD_LEN 49  // script type || the above
+
+typedef enum {
+    SCRIPT_TYPE_P2PKH = 0,
+    SCRIPT_TYPE_P2SH,
+    SCRIPT_TYPE_P2WPKH,
+    SCRIPT_TYPE_P2WSH,
+    SCRIPT_TYPE_P2TR,
+    SCRIPT_TYPE_OTHER,
+    SCRIPT_TYPE_COUNT
+} ScriptType;
+
+typedef struct {
+    uint8_t txid[32];
+    uint32_t vout;
+    uint32_t height;
+    uint64_t value;
+    const uint8_t* script;   // inside the caller's buffer (NULL in a decoded payload)
+    size_t script_len;
+} UtxoRecord;
+
+typedef struct {
+    uint64_t outputs;
+    uint64_t by_type[SCRIPT_TYPE_COUNT];
+    uint64_t fixed_length_hashes;   // scripts hashed by the fixed-length kernel
+    uint64_t address_entries;       // entries written to the HASH160 index
+} ScripthashStats;
+
+/**
+* @brief Serializes one dump record; with out == NULL only returns its size.
+*/
+size_t utxo_serialize_record(const UtxoRecord* rec, uint8_t* out);
+
+/**
+* @brief Parses one dump record in place (rec->script points into data).
+* @return The number of bytes consumed, or 0 if the data is truncated or malformed.
+*/
+size_t utxo_parse_record(const uint8_t* data, size_t avail, UtxoRecord* rec);
+
+/**
+* @brief Classifies a scriptPubKey by its standard template.
+*/
+ScriptType script_classify(const uint8_t* script, size_t len);
+
+/**
+* @brief Electrum scripthashes (SHA-256 of the script, byte-reversed) of any number of scripts.
+* Scripts are grouped by length, 8 at a time, as in the index builder.
+* @return 0 on success, -1 on invalid arguments or allocation failure.
+*/
+int electrum_scripthash_batch(const uint8_t* const* scripts, const size_t* lens, size_t count, uint8_t (*out)[32]);
+
+/**
+* @brief Builds the scripthash index of a UTXO dump: key = scripthash, payload = SCRIPTHASH_PAYLOAD_LEN bytes.
+* @param address_index_path If not NULL, also writes a HASH160 index of the P2PKH and P2SH outputs, keyed by
+*        the 20-byte hash in the script, payload = SCRIPTHASH_ADDRESS_PAYLOAD_LEN bytes.
+* @param memory_limit Sort buffer budget of each index builder (see hash_index_builder_create).
+* @param stats If not NULL, receives the counters (reset first).
+* @return 0 on success, -1 on an I/O error or a malformed dump (no index file is left behind).
+*/
+int scripthash_index_build(const char* dump_path, const char* index_path, const char* address_index_path,
+                           size_t memory_limit, ScripthashStats* stats);
+
+/**
+* @brief Decodes an index payload (SCRIPTHASH_PAYLOAD_LEN bytes) into txid, vout, height and value.
+*/
+void scripthash_decode_payload(const uint8_t* payload, UtxoRecord* rec);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // SCRIPTHASH_AVX_H
@@ -0,0 +1,319 @@
+/* scripthash_test.c
+ * gcc -O3 -mavx2 -march=native scripthash_test.c scripthash_avx.c hash_index_avx.c sha256_avx.c -o scripthash_test -lcrypto
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <openssl/sha.h>
+
+#include "scripthash_avx.h"
+#include "hash_index_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+static size_t from_hex(const char* hex, uint8_t* out) {
+    size_t n = strlen(hex) / 2;
+    for (size_t i = 0; i < n; i++) sscanf(hex + 2 * i, "%2hhx", &out[i]);
+    return n;
+}
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ull;
+
+static uint64_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static void random_bytes(uint8_t* p, size_t n) {
+    for (size_t i = 0; i < n; i++) p[i] = (uint8_t)next_random();
+}
+
+static void reference_scripthash(const uint8_t* script, size_t len, uint8_t out[32]) {
+    uint8_t h[32];
+    SHA256(script, len, h);
+    for (int i = 0; i < 32; i++) out[i] = h[31 - i];
+}
+
+// A scriptPubKey with a mainnet-like mix of templates; returns its length (at most 400 bytes).
+static size_t random_script(uint8_t* s) {
+    unsigned r = (unsigned)(next_random() % 100);
+    if (r < 40) { s[0] = 0x00; s[1] = 0x14; random_bytes(s + 2, 20); return 22; }
+    if (r < 60) { s[0] = 0x76; s[1] = 0xa9; s[2] = 0x14; random_bytes(s + 3, 20); s[23] = 0x88; s[24] = 0xac; return 25; }
+    if (r < 72) { s[0] = 0xa9; s[1] = 0x14; random_bytes(s + 2, 20); s[22] = 0x87; return 23; }
+    if (r < 84) { s[0] = 0x51; s[1] = 0x20; random_bytes(s + 2, 32); return 34; }
+    if (r < 92) { s[0] = 0x00; s[1] = 0x20; random_bytes(s + 2, 32); return 34; }
+    size_t len = (size_t)(next_random() % 401); // bare multisig, OP_RETURN, non-standard, empty
+    random_bytes(s, len);
+    return len;
+}
+
+typedef struct {
+    uint8_t* data;
+    size_t len;
+    size_t count;
+    size_t* offsets; // record offsets in data
+} Dump;
+
+// count records, a tenth of them reusing the script of an earlier record (address reuse).
+static void make_dump(Dump* d, size_t count) {
+    d->data = (uint8_t*)malloc(8 + count * 460);
+    d->offsets = (size_t*)malloc(count * sizeof(size_t));
+    d->count = count;
+    memcpy(d->data, UTXO_DUMP_MAGIC, 8);
+    d->len = 8;
+    uint8_t script[400];
+    for (size_t i = 0; i < count; i++) {
+        UtxoRecord rec;
+        random_bytes(rec.txid, 32);
+        rec.vout = (uint32_t)(next_random() % 5);
+        rec.height = (uint32_t)(next_random() % 900000);
+        rec.value = next_random() % 2100000000000000ull;
+        if (i > 0 && next_random() % 10 == 0) {
+            size_t j = (size_t)(next_random() % i);
+            UtxoRecord prev;
+            utxo_parse_record(d->data + d->offsets[j], d->len - d->offsets[j], &prev);
+            memcpy(script, prev.script, prev.script_len);
+            rec.script_len = prev.script_len;
+        } else {
+            rec.script_len = random_script(script);
+        }
+        rec.script = script;
+        d->offsets[i] = d->len;
+        d->len += utxo_serialize_record(&rec, d->data + d->len);
+    }
+}
+
+static void free_dump(Dump* d) {
+    free(d->data);
+    free(d->offsets);
+}
+
+static int compare_keys(const void* a, const void* b) {
+    return memcmp(a, b, 32);
+}
+
+// Occurrences of key in a sorted key array (short random scripts, e.g. empty ones, repeat by chance).
+static size_t count_key(const uint8_t (*sorted)[32], size_t count, const uint8_t key[32]) {
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (memcmp(sorted[mid], key, 32) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    size_t n = 0;
+    while (lo + n < count && memcmp(sorted[lo + n], key, 32) == 0) n++;
+    return n;
+}
+
+static int write_file(const char* path, const uint8_t* data, size_t len) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return -1;
+    size_t n = fwrite(data, 1, len, f);
+    fclose(f);
+    return n == len ? 0 : -1;
+}
+
+int main(void) {
+    int failed_tests = 0;
+    printf("--- Correctness Test (Electrum Scripthash Index) ---\n");
+
+    // --- Electrum protocol documentation: P2PKH of 1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa ---
+    {
+        uint8_t script[25], expected[32], out[1][32];
+        from_hex("76a91462e907b15cbf27d5425399ebf6f0fb50ebb88f1888ac", script);
+        from_hex("8b01df4e368ea28f8dc0423bcf7a4923e3a12d307c875e47a0cfbf90b5c39161", expected);
+        const uint8_t* scripts[1] = {script};
+        size_t lens[1] = {25};
+        int ok = electrum_scripthash_batch(scripts, lens, 1, out) == 0;
+        failed_tests += report("Electrum documentation scripthash", ok && memcmp(out[0], expected, 32) == 0);
+    }
+
+    // --- Batch of mixed lengths against OpenSSL ---
+    {
+        const size_t N = 5000;
+        uint8_t (*scripts)[400] = (uint8_t (*)[400])malloc(N * 400);
+        const uint8_t** ptrs = (const uint8_t**)malloc(N * sizeof(uint8_t*));
+        size_t* lens = (size_t*)malloc(N * sizeof(size_t));
+        uint8_t (*out)[32] = (uint8_t (*)[32])malloc(N * 32);
+        for (size_t i = 0; i < N; i++) {
+            lens[i] = random_script(scripts[i]);
+            ptrs[i] = scripts[i];
+        }
+        int ok = electrum_scripthash_batch(ptrs, lens, N, out) == 0;
+        for (size_t i = 0; i < N && ok; i++) {
+            uint8_t ref[32];
+            reference_scripthash(scripts[i], lens[i], ref);
+            ok = memcmp(out[i], ref, 32) == 0;
+        }
+        failed_tests += report("Bucketed batch hashing matches OpenSSL", ok);
+        free(scripts);
+        free(ptrs);
+        free(lens);
+        free(out);
+    }
+
+    // --- Record format ---
+    {
+        uint8_t script[70000], buf[70100];
+        random_bytes(script, sizeof(script));
+        int ok = 1;
+        size_t sizes[4] = {0, 252, 253, 70000}; // one-, three- and five-byte length prefixes
+        for (int i = 0; i < 4; i++) {
+            UtxoRecord rec = {{0}, 7, 800000, 5000000000ull, script, sizes[i]}, back;
+            size_t n = utxo_serialize_record(&rec, buf);
+            ok &= n == utxo_serialize_record(&rec, NULL);
+            ok &= utxo_parse_record(buf, n, &back) == n && back.vout == 7 && back.height == 800000;
+            ok &= back.value == 5000000000ull && back.script_len == sizes[i] && back.script == buf + n - sizes[i];
+            ok &= utxo_parse_record(buf, n - 1, &back) == 0;
+        }
+        failed_tests += report("Record serialize/parse round-trip, truncation", ok);
+    }
+
+    // --- Index build from a dump (1 MiB budget: the builders spill to partitions) ---
+    char dump_path[] = "/tmp/scripthash_dumpXXXXXX";
+    int fd = mkstemp(dump_path);
+    if (fd < 0) {
+        fprintf(stderr, "mkstemp failed.\n");
+        return 1;
+    }
+    close(fd);
+    char index_path[256], address_path[256];
+    snprintf(index_path, sizeof(index_path), "%s.shidx", dump_path);
+    snprintf(address_path, sizeof(address_path), "%s.hidx", dump_path);
+
+    const size_t COUNT = 200000;
+    Dump d;
+    make_dump(&d, COUNT);
+    write_file(dump_path, d.data, d.len);
+    ScripthashStats stats;
+    int rc = scripthash_index_build(dump_path, index_path, address_path, 1 << 20, &stats);
+    uint64_t expected_types[SCRIPT_TYPE_COUNT] = {0};
+    uint8_t (*sorted_keys)[32] = (uint8_t (*)[32])malloc(COUNT * 32);
+    for (size_t i = 0; i < COUNT; i++) {
+        UtxoRecord rec;
+        utxo_parse_record(d.data + d.offsets[i], d.len - d.offsets[i], &rec);
+        expected_types[script_classify(rec.script, rec.script_len)]++;
+        reference_scripthash(rec.script, rec.script_len, sorted_keys[i]);
+    }
+    qsort(sorted_keys, COUNT, 32, compare_keys);
+    int stats_ok = rc == 0 && stats.outputs == COUNT;
+    for (int t = 0; t < SCRIPT_TYPE_COUNT; t++) stats_ok &= stats.by_type[t] == expected_types[t];
+    stats_ok &= stats.address_entries == expected_types[SCRIPT_TYPE_P2PKH] + expected_types[SCRIPT_TYPE_P2SH];
+    failed_tests += report("Build (200k outputs) and per-template counts", stats_ok);
+
+    HashIndex index, address_index;
+    int open_ok = hash_index_open(&index, index_path) == 0 && hash_index_open(&address_index, address_path) == 0;
+    failed_tests += report("Both indexes open", open_ok && index.count == COUNT && address_index.count == stats.address_entries);
+
+    int sh_failures = 0, addr_failures = 0;
+    for (size_t i = 0; i < COUNT && open_ok; i++) {
+        UtxoRecord rec;
+        const uint8_t* raw = d.data + d.offsets[i];
+        utxo_parse_record(raw, d.len - d.offsets[i], &rec);
+        uint8_t key[32];
+        reference_scripthash(rec.script, rec.script_len, key);
+        uint64_t first;
+        uint64_t n = hash_index_find_all(&index, key, &first);
+        int found = 0;
+        for (uint64_t e = first; e < first + n; e++) {
+            const uint8_t* payload;
+            size_t len;
+            if (hash_index_entry_payload(&index, e, &payload, &len) && len == SCRIPTHASH_PAYLOAD_LEN &&
+                memcmp(payload, raw, SCRIPTHASH_PAYLOAD_LEN) == 0) found = 1;
+        }
+        if (!found || n != count_key((const uint8_t (*)[32])sorted_keys, COUNT, key)) sh_failures++;
+
+        ScriptType type = script_classify(rec.script, rec.script_len);
+        if (type == SCRIPT_TYPE_P2PKH || type == SCRIPT_TYPE_P2SH) {
+            const uint8_t* h160 = rec.script + (type == SCRIPT_TYPE_P2PKH ? 3 : 2);
+            n = hash_index_find_all(&address_index, h160, &first);
+            found = 0;
+            for (uint64_t e = first; e < first + n; e++) {
+                const uint8_t* payload;
+                size_t len;
+                if (hash_index_entry_payload(&address_index, e, &payload, &len) && len == SCRIPTHASH_ADDRESS_PAYLOAD_LEN &&
+                    payload[0] == type && memcmp(payload + 1, raw, SCRIPTHASH_PAYLOAD_LEN) == 0) found = 1;
+            }
+            if (!found) addr_failures++;
+        }
+    }
+    failed_tests += report("Every outpoint under its scripthash (reused scripts)", open_ok && sh_failures == 0);
+    failed_tests += report("P2PKH/P2SH outpoints under their HASH160", open_ok && addr_failures == 0);
+
+    uint8_t absent[32];
+    random_bytes(absent, 32);
+    uint64_t first;
+    failed_tests += report("Absent scripthash has no entries", open_ok && hash_index_find_all(&index, absent, &first) == 0);
+    if (open_ok) {
+        hash_index_close(&index);
+        hash_index_close(&address_index);
+    }
+    unlink(index_path);
+    unlink(address_path);
+
+    // --- Malformed dumps leave no index behind ---
+    {
+        write_file(dump_path, d.data, d.len - 3);
+        int ok = scripthash_index_build(dump_path, index_path, NULL, 1 << 20, NULL) == -1;
+        ok &= access(index_path, F_OK) != 0;
+        memcpy(d.data, "UTXD9999", 8);
+        write_file(dump_path, d.data, d.len);
+        ok &= scripthash_index_build(dump_path, index_path, NULL, 1 << 20, NULL) == -1;
+        ok &= access(index_path, F_OK) != 0;
+        failed_tests += report("Truncated record and bad magic are rejected", ok);
+    }
+    free_dump(&d);
+    free(sorted_keys);
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    const size_t BENCH = 2000000;
+    printf("--- Performance Benchmark (%zu-output dump) ---\n", BENCH);
+    make_dump(&d, BENCH);
+    write_file(dump_path, d.data, d.len);
+    const uint8_t** ptrs = (const uint8_t**)malloc(BENCH * sizeof(uint8_t*));
+    size_t* lens = (size_t*)malloc(BENCH * sizeof(size_t));
+    uint8_t (*out)[32] = (uint8_t (*)[32])malloc(BENCH * 32);
+    for (size_t i = 0; i < BENCH; i++) {
+        UtxoRecord rec;
+        utxo_parse_record(d.data + d.offsets[i], d.len - d.offsets[i], &rec);
+        ptrs[i] = rec.script;
+        lens[i] = rec.script_len;
+    }
+
+    clock_t start = clock();
+    electrum_scripthash_batch(ptrs, lens, BENCH, out);
+    double t_batch = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (size_t i = 0; i < BENCH; i++) reference_scripthash(ptrs[i], lens[i], out[i]);
+    double t_scalar = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    scripthash_index_build(dump_path, index_path, address_path, 256 << 20, &stats);
+    double t_build = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Scripthashes, bucketed 8-lane: %.2f Million/sec (%.1f%% fixed-length)\n", BENCH / t_batch / 1e6,
+           100.0 * stats.fixed_length_hashes / stats.outputs);
+    printf("Scripthashes, OpenSSL per script: %.2f Million/sec (%.2fx)\n", BENCH / t_scalar / 1e6, t_scalar / t_batch);
+    printf("Full build (both indexes): %.4f seconds (%.2f Million outputs/sec)\n", t_build, BENCH / t_build / 1e6);
+    unlink(index_path);
+    unlink(address_path);
+    unlink(dump_path);
+    free_dump(&d);
+    free(ptrs);
+    free(lens);
+    free(out);
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,465 @@
+/* sha256_autotune.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "sha256_autotune.h"
+#include "sha256_avx.h"
+#include "sha256_ni.h"
+
+#include <cpuid.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define AUTOTUNE_BUDGET_NS 100000000ull  // total measurement budget: 100 ms
+#define MIN_MESSAGES_PER_THREAD 1024
+#define MAX_THREADS 256
+
+static const uint32_t sort_windows[] = {8, 64, 512};
+#define SORT_WINDOW_COUNT (sizeof(sort_windows) / sizeof(sort_windows[0]))
+
+static const char* const kernel_names[SHA256_KERNEL_COUNT] = {"avx2", "avx2-fixed", "sha-ni", "sha-ni-x2"};
+
+const char* sha256_kernel_name(Sha256Kernel kernel) {
+    return (unsigned)kernel < SHA256_KERNEL_COUNT ? kernel_names[kernel] : "unknown";
+}
+
+static Sha256LengthClass length_class(size_t len) {
+    if (len < 56) return SHA256_LEN_SHORT;
+    if (len < 120) return SHA256_LEN_TWO_BLOCK;
+    if (len < 1024) return SHA256_LEN_MEDIUM;
+    return SHA256_LEN_LONG;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// --- CPU key ---
+
+void sha256_autotune_cpu_key(char key[96]) {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    char vendor[13] = {0};
+    __get_cpuid(0, &eax, &ebx, &ecx, &edx);
+    memcpy(vendor, &ebx, 4);
+    memcpy(vendor + 4, &edx, 4);
+    memcpy(vendor + 8, &ecx, 4);
+
+    __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+    unsigned family = (eax >> 8) & 0xf, model = (eax >> 4) & 0xf, stepping = eax & 0xf;
+    if (family == 0xf) family += (eax >> 20) & 0xff;
+    if (family == 0x6 || family >= 0xf) model |= ((eax >> 16) & 0xf) << 4;
+
+    unsigned int ebx7 = 0;
+    if (__get_cpuid_count(7, 0, &eax, &ebx7, &ecx, &edx) == 0) ebx7 = 0;
+
+    // The brand string separates parts that share a family/model (e.g. SKUs with different cache sizes).
+    uint32_t brand_hash = 2166136261u;
+    unsigned int max_ext = __get_cpuid_max(0x80000000, NULL);
+    if (max_ext >= 0x80000004) {
+        for (unsigned int leaf = 0x80000002; leaf <= 0x80000004; leaf++) {
+            unsigned int regs[4];
+            __get_cpuid(leaf, &regs[0], &regs[1], &regs[2], &regs[3]);
+            const uint8_t* bytes = (const uint8_t*)regs;
+            for (int i = 0; i < 16; i++) brand_hash = (brand_hash ^ bytes[i]) * 16777619u;
+        }
+    }
+    snprintf(key, 96, "%s-f%x-m%x-s%x-%s%s%s-b%08x-n%ld", vendor[0] ? vendor : "unknown", family, model, stepping,
+             (ebx7 >> 5) & 1 ? "avx2" : "", (ebx7 >> 29) & 1 ? "+sha" : "", (ebx7 >> 16) & 1 ? "+avx512f" : "",
+             brand_hash, sysconf(_SC_NPROCESSORS_ONLN));
+}
+
+// --- Dispatch ---
+
+typedef struct {
+    uint32_t len;
+    uint32_t index;
+} SortKey;
+
+static int compare_sort_keys(const void* a, const void* b) {
+    const SortKey* x = (const SortKey*)a;
+    const SortKey* y = (const SortKey*)b;
+    if (x->len != y->len) return x->len < y->len ? -1 : 1;
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+// AVX2 kernels: each window is sorted by length so that groups of 8 have similar block counts
+// (and, for the fixed kernel, often the exact same length).
+static void hash_avx2(const uint32_t* idx, size_t n, uint32_t window, bool fixed,
+                      const uint8_t* const messages[], const size_t lengths[], uint8_t (*out)[32]) {
+    SortKey keys[512];
+    if (window > 512) window = 512;
+    for (size_t base = 0; base < n; base += window) {
+        size_t w = n - base < window ? n - base : window;
+        for (size_t i = 0; i < w; i++) {
+            keys[i].len = lengths[idx[base + i]] > UINT32_MAX ? UINT32_MAX : (uint32_t)lengths[idx[base + i]];
+            keys[i].index = idx[base + i];
+        }
+        if (window > 8) qsort(keys, w, sizeof(SortKey), compare_sort_keys);
+
+        for (size_t g = 0; g < w; g += 8) {
+            size_t cnt = w - g < 8 ? w - g : 8;
+            const uint8_t* ptrs[8];
+            size_t lens[8];
+            uint8_t digests[8][32];
+            bool same = true;
+            for (size_t lane = 0; lane < 8; lane++) {
+                uint32_t m = keys[g + (lane < cnt ? lane : 0)].index;
+                ptrs[lane] = messages[m];
+                lens[lane] = lengths[m];
+                if (lens[lane] != lens[0]) same = false;
+            }
+            if (fixed && same && lens[0] < 56) sha256_avx8_hash_short(ptrs, lens[0], digests);
+            else sha256_avx8_hash_lanes(NULL, 0, ptrs, lens, digests);
+            for (size_t lane = 0; lane < cnt; lane++) memcpy(out[keys[g + lane].index], digests[lane], 32);
+        }
+    }
+}
+
+static void hash_with_kernel(Sha256Kernel kernel, uint32_t window, const uint32_t* idx, size_t n,
+                             const uint8_t* const messages[], const size_t lengths[], uint8_t (*out)[32]) {
+    switch (kernel) {
+    case SHA256_KERNEL_SHANI:
+        for (size_t i = 0; i < n; i++) sha256_ni_hash(messages[idx[i]], lengths[idx[i]], out[idx[i]]);
+        break;
+    case SHA256_KERNEL_SHANI_X2: {
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            uint32_t a = idx[i], b = idx[i + 1];
+            sha256_ni_hash_x2(messages[a], lengths[a], messages[b], lengths[b], out[a], out[b]);
+        }
+        if (i < n) sha256_ni_hash(messages[idx[i]], lengths[idx[i]], out[idx[i]]);
+        break;
+    }
+    case SHA256_KERNEL_AVX2_FIXED:
+        hash_avx2(idx, n, window, true, messages, lengths, out);
+        break;
+    default:
+        hash_avx2(idx, n, window, false, messages, lengths, out);
+        break;
+    }
+}
+
+// Single-threaded: classify, then hash every class with its kernel. Indices are relative to the range.
+static void hash_range(const Sha256TuneProfile* profile, const uint8_t* const messages[], const size_t lengths[],
+                       size_t count, uint8_t (*out)[32]) {
+    uint32_t* idx = (uint32_t*)malloc(count * sizeof(uint32_t));
+    if (!idx) {
+        // Out of memory: hash in order, 8 at a time, without classification.
+        uint32_t group[8];
+        for (size_t base = 0; base < count; base += 8) {
+            size_t n = count - base < 8 ? count - base : 8;
+            for (size_t i = 0; i < n; i++) group[i] = (uint32_t)(base + i);
+            hash_avx2(group, n, 8, false, messages, lengths, out);
+        }
+        return;
+    }
+    size_t class_count[SHA256_LEN_CLASS_COUNT] = {0}, class_start[SHA256_LEN_CLASS_COUNT];
+    for (size_t i = 0; i < count; i++) class_count[length_class(lengths[i])]++;
+    size_t pos = 0;
+    for (int c = 0; c < SHA256_LEN_CLASS_COUNT; c++) {
+        class_start[c] = pos;
+        pos += class_count[c];
+    }
+    size_t fill[SHA256_LEN_CLASS_COUNT];
+    memcpy(fill, class_start, sizeof(fill));
+    for (size_t i = 0; i < count; i++) idx[fill[length_class(lengths[i])]++] = (uint32_t)i;
+    for (int c = 0; c < SHA256_LEN_CLASS_COUNT; c++) {
+        if (class_count[c]) hash_with_kernel((Sha256Kernel)profile->kernel[c], profile->sort_window[c],
+                                             idx + class_start[c], class_count[c], messages, lengths, out);
+    }
+    free(idx);
+}
+
+typedef struct {
+    const Sha256TuneProfile* profile;
+    const uint8_t* const* messages;
+    const size_t* lengths;
+    size_t count;
+    uint8_t (*out)[32];
+} RangeJob;
+
+static void* range_worker(void* arg) {
+    RangeJob* job = (RangeJob*)arg;
+    hash_range(job->profile, job->messages, job->lengths, job->count, job->out);
+    return NULL;
+}
+
+void sha256_tuned_hash_batch(const Sha256TuneProfile* profile, const uint8_t* const messages[], const size_t lengths[],
+                             size_t count, uint8_t (*hashes_out)[32]) {
+    if (!profile || !messages || !lengths || !hashes_out || count == 0) return;
+    size_t threads = profile->threads ? profile->threads : 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (threads > count / MIN_MESSAGES_PER_THREAD) threads = count / MIN_MESSAGES_PER_THREAD;
+    if (threads <= 1) {
+        hash_range(profile, messages, lengths, count, hashes_out);
+        return;
+    }
+
+    pthread_t tids[MAX_THREADS];
+    bool started[MAX_THREADS];
+    RangeJob jobs[MAX_THREADS];
+    size_t per = (count + threads - 1) / threads;
+    for (size_t t = 0; t < threads; t++) {
+        size_t begin = t * per;
+        jobs[t].profile = profile;
+        jobs[t].messages = messages + begin;
+        jobs[t].lengths = lengths + begin;
+        jobs[t].count = begin >= count ? 0 : (count - begin < per ? count - begin : per);
+        jobs[t].out = hashes_out + begin;
+        // The caller's thread takes the first range; a failed spawn is run inline.
+        started[t] = t > 0 && jobs[t].count > 0 && pthread_create(&tids[t], NULL, range_worker, &jobs[t]) == 0;
+        if (t > 0 && !started[t] && jobs[t].count > 0) range_worker(&jobs[t]);
+    }
+    range_worker(&jobs[0]);
+    for (size_t t = 1; t < threads; t++) {
+        if (started[t]) pthread_join(tids[t], NULL);
+    }
+}
+
+// --- Measurement ---
+
+typedef struct {
+    const uint8_t** messages;
+    size_t* lengths;
+    uint32_t* idx;
+    uint8_t (*out)[32];
+    size_t count;
+    uint64_t bytes;
+} Workload;
+
+static const size_t class_min_len[SHA256_LEN_CLASS_COUNT] = {0, 56, 120, 1024};
+static const size_t class_max_len[SHA256_LEN_CLASS_COUNT] = {55, 119, 1023, 4096};
+static const size_t class_messages[SHA256_LEN_CLASS_COUNT] = {1024, 512, 128, 32};
+
+static int make_workload(Workload* w, const uint8_t* pool, size_t pool_size, Sha256LengthClass c, size_t count, uint32_t* seed) {
+    w->count = count;
+    w->messages = (const uint8_t**)malloc(count * sizeof(uint8_t*));
+    w->lengths = (size_t*)malloc(count * sizeof(size_t));
+    w->idx = (uint32_t*)malloc(count * sizeof(uint32_t));
+    w->out = (uint8_t (*)[32])malloc(count * 32);
+    if (!w->messages || !w->lengths || !w->idx || !w->out) return -1;
+    w->bytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        *seed = *seed * 1103515245u + 12345u;
+        // Short messages cluster on a few typical sizes (keys, digests); the others are uniform in the class.
+        size_t span = class_max_len[c] - class_min_len[c] + 1;
+        size_t len = class_min_len[c] + (*seed >> 8) % span;
+        if (c == SHA256_LEN_SHORT && (*seed & 3) != 0) len = (*seed & 4) ? 33 : 32;
+        w->lengths[i] = len;
+        w->messages[i] = pool + ((*seed >> 4) % (pool_size - len));
+        w->idx[i] = (uint32_t)i;
+        w->bytes += len;
+    }
+    return 0;
+}
+
+static void free_workload(Workload* w) {
+    free(w->messages);
+    free(w->lengths);
+    free(w->idx);
+    free(w->out);
+}
+
+// Runs one candidate for about slice_ns and returns its throughput in MB/s.
+static double measure(const Workload* w, Sha256Kernel kernel, uint32_t window, uint64_t slice_ns) {
+    uint64_t start = now_ns(), elapsed = 0, bytes = 0;
+    int reps = 0;
+    do {
+        hash_with_kernel(kernel, window, w->idx, w->count, w->messages, w->lengths, w->out);
+        bytes += w->bytes;
+        elapsed = now_ns() - start;
+    } while (++reps < 2 || elapsed < slice_ns);
+    return elapsed ? (double)bytes * 1000.0 / (double)elapsed : 0.0;
+}
+
+static void run_measurements(Sha256TuneProfile* profile) {
+    bool has_ni = sha256_ni_available();
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpu < 1) ncpu = 1;
+    uint32_t thread_candidates[3] = {1, (uint32_t)(ncpu / 2), (uint32_t)ncpu};
+
+    size_t candidates = 0;
+    for (int c = 0; c < SHA256_LEN_CLASS_COUNT; c++) {
+        candidates += SORT_WINDOW_COUNT * (c == SHA256_LEN_SHORT ? 2 : 1) + (has_ni ? 2 : 0);
+    }
+    candidates += 2; // thread-count candidates beyond 1
+    uint64_t slice = AUTOTUNE_BUDGET_NS * 3 / 4 / candidates; // leave room for setup and overshoot
+
+    size_t pool_size = 1 << 16;
+    uint8_t* pool = (uint8_t*)malloc(pool_size);
+    uint32_t seed = 0x5eed;
+    for (size_t i = 0; pool && i < pool_size; i++) {
+        seed = seed * 1103515245u + 12345u;
+        pool[i] = (uint8_t)(seed >> 16);
+    }
+
+    for (int c = 0; c < SHA256_LEN_CLASS_COUNT; c++) {
+        profile->kernel[c] = SHA256_KERNEL_AVX2_LANES;
+        profile->sort_window[c] = 64;
+        profile->mbps[c] = 0;
+        Workload w;
+        if (!pool || make_workload(&w, pool, pool_size, (Sha256LengthClass)c, class_messages[c], &seed) != 0) {
+            if (pool) free_workload(&w);
+            continue;
+        }
+        for (int k = 0; k < SHA256_KERNEL_COUNT; k++) {
+            if (k == SHA256_KERNEL_AVX2_FIXED && c != SHA256_LEN_SHORT) continue;
+            if ((k == SHA256_KERNEL_SHANI || k == SHA256_KERNEL_SHANI_X2) && !has_ni) continue;
+            bool windowed = k == SHA256_KERNEL_AVX2_LANES || k == SHA256_KERNEL_AVX2_FIXED;
+            for (size_t wi = 0; wi < (windowed ? SORT_WINDOW_COUNT : 1); wi++) {
+                double mbps = measure(&w, (Sha256Kernel)k, sort_windows[wi], slice);
+                if (mbps > profile->mbps[c]) {
+                    profile->mbps[c] = mbps;
+                    profile->kernel[c] = (uint8_t)k;
+                    profile->sort_window[c] = windowed ? sort_windows[wi] : 0;
+                }
+            }
+        }
+        free_workload(&w);
+    }
+
+    // Thread count: the tuned dispatcher on a short-message batch large enough for every candidate.
+    profile->threads = 1;
+    size_t big = (size_t)ncpu * MIN_MESSAGES_PER_THREAD * 2;
+    if (ncpu > 1 && pool) {
+        Workload w;
+        uint32_t best_threads = 1;
+        double best = 0;
+        if (make_workload(&w, pool, pool_size, SHA256_LEN_SHORT, big, &seed) == 0) {
+            for (int t = 0; t < 3; t++) {
+                if (thread_candidates[t] < 1 || (t > 0 && thread_candidates[t] == thread_candidates[t - 1])) continue;
+                profile->threads = thread_candidates[t];
+                uint64_t start = now_ns(), elapsed, bytes = 0;
+                do {
+                    sha256_tuned_hash_batch(profile, w.messages, w.lengths, w.count, w.out);
+                    bytes += w.bytes;
+                    elapsed = now_ns() - start;
+                } while (elapsed < slice);
+                double mbps = (double)bytes * 1000.0 / (double)elapsed;
+                if (mbps > best) {
+                    best = mbps;
+                    best_threads = thread_candidates[t];
+                }
+            }
+        }
+        profile->threads = best_threads;
+        free_workload(&w);
+    }
+    free(pool);
+}
+
+// --- Cache file: one line per CPU key ---
+//   <cpu_key> <threads> <kernel>/<window> x4
+
+static void default_cache_path(char* path, size_t size) {
+    const char* env = getenv("SHA256_TUNE_CACHE");
+    if (env && *env) {
+        snprintf(path, size, "%s", env);
+        return;
+    }
+    const char* home = getenv("HOME");
+    snprintf(path, size, "%s/.cache/sha256_avx_tune", home && *home ? home : "/tmp");
+}
+
+static int kernel_from_name(const char* name) {
+    for (int k = 0; k < SHA256_KERNEL_COUNT; k++) {
+        if (strcmp(name, kernel_names[k]) == 0) return k;
+    }
+    return -1;
+}
+
+static bool parse_cache_line(const char* line, const char* key, Sha256TuneProfile* profile) {
+    char line_key[96], kernels[SHA256_LEN_CLASS_COUNT][16];
+    unsigned threads, windows[SHA256_LEN_CLASS_COUNT];
+    if (sscanf(line, "%95s %u %15[^/]/%u %15[^/]/%u %15[^/]/%u %15[^/]/%u", line_key, &threads,
+               kernels[0], &windows[0], kernels[1], &windows[1], kernels[2], &windows[2], kernels[3], &windows[3]) != 10)
+        return false;
+    if (strcmp(line_key, key) != 0 || threads < 1 || threads > MAX_THREADS) return false;
+    for (int c = 0; c < SHA256_LEN_CLASS_COUNT; c++) {
+        int k = kernel_from_name(kernels[c]);
+        if (k < 0 || windows[c] > 512) return false;
+        if ((k == SHA256_KERNEL_SHANI || k == SHA256_KERNEL_SHANI_X2) && !sha256_ni_available()) return false;
+        profile->kernel[c] = (uint8_t)k;
+        profile->sort_window[c] = windows[c];
+    }
+    profile->threads = threads;
+    return true;
+}
+
+static bool load_cache(const char* path, Sha256TuneProfile* profile) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char line[256];
+    bool found = false;
+    while (!found && fgets(line, sizeof(line), f)) found = parse_cache_line(line, profile->cpu_key, profile);
+    fclose(f);
+    return found;
+}
+
+static void store_cache(const char* path, const Sha256TuneProfile* profile) {
+    // Keep the entries of other CPUs, replace ours, and swap the file in atomically.
+    char tmp_path[4200];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.%ld.tmp", path, (long)getpid());
+    char dir[4096];
+    snprintf(dir, sizeof(dir), "%s", path);
+    char* slash = strrchr(dir, '/');
+    if (slash && slash != dir) {
+        *slash = '\0';
+        mkdir(dir, 0755);
+    }
+    FILE* out = fopen(tmp_path, "w");
+    if (!out) return;
+    FILE* in = fopen(path, "r");
+    if (in) {
+        char line[256], line_key[96];
+        while (fgets(line, sizeof(line), in)) {
+            if (sscanf(line, "%95s", line_key) == 1 && strcmp(line_key, profile->cpu_key) != 0) fputs(line, out);
+        }
+        fclose(in);
+    }
+    fprintf(out, "%s %u", profile->cpu_key, profile->threads);
+    for (int c = 0; c < SHA256_LEN_CLASS_COUNT; c++) {
+        fprintf(out, " %s/%u", kernel_names[profile->kernel[c]], profile->sort_window[c]);
+    }
+    fputc('\n', out);
+    if (fclose(out) != 0 || rename(tmp_path, path) != 0) unlink(tmp_path);
+}
+
+int sha256_autotune(Sha256TuneProfile* profile, const char* cache_path, unsigned flags) {
+    if (!profile) return -1;
+    memset(profile, 0, sizeof(*profile));
+    sha256_autotune_cpu_key(profile->cpu_key);
+
+    char path[4096];
+    if (cache_path) snprintf(path, sizeof(path), "%s", cache_path);
+    else default_cache_path(path, sizeof(path));
+
+    bool use_cache = !(flags & SHA256_AUTOTUNE_NO_CACHE);
+    if (use_cache && !(flags & SHA256_AUTOTUNE_FORCE) && load_cache(path, profile)) {
+        profile->from_cache = true;
+        return 0;
+    }
+    run_measurements(profile);
+    if (use_cache) store_cache(path, profile);
+    return 0;
+}
@@ -0,0 +1,93 @@
+/* sha256_autotune.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef SHA256_AUTOTUNE_H
+#define SHA256_AUTOTUNE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Startup autotuner for batched SHA-256: microbenchmarks the kernels available on this CPU for each
+// message-length class (about 100 ms in total), picks the fastest kernel and batch shape per class and
+// the worker thread count, and caches the decision in a small text file keyed by CPUID.
+
+typedef enum {
+    SHA256_KERNEL_AVX2_LANES = 0, // sha256_avx8_hash_lanes on groups of 8
+    SHA256_KERNEL_AVX2_FIXED,     // sha256_avx8_hash_short when a group of 8 shares one length < 56
+    SHA256_KERNEL_SHANI,          // sha256_ni_hash, one message at a time
+    SHA256_KERNEL_SHANI_X2,       // sha256_ni_hash_x2, two interleaved messages
+    SHA256_KERNEL_COUNT
+} Sha256Kernel;
+
+typedef enum {
+    SHA256_LEN_SHORT = 0, // < 56 bytes: one block
+    SHA256_LEN_TWO_BLOCK, // 56..119 bytes
+    SHA256_LEN_MEDIUM,    // 120..1023 bytes
+    SHA256_LEN_LONG,      // >= 1024 bytes
+    SHA256_LEN_CLASS_COUNT
+} Sha256LengthClass;
+
+typedef struct {
+    char cpu_key[96];                             // CPUID vendor/family/model/stepping/features/brand
+    uint8_t kernel[SHA256_LEN_CLASS_COUNT];       // Sha256Kernel per class
+    uint32_t sort_window[SHA256_LEN_CLASS_COUNT]; // AVX2 kernels: messages sorted by length in windows of this size
+    uint32_t threads;                             // worker threads for large batches
+    double mbps[SHA256_LEN_CLASS_COUNT];          // measured single-thread throughput of the winner (0 if cached)
+    bool from_cache;
+} Sha256TuneProfile;
+
+#define SHA256_AUTOTUNE_FORCE    1u // measure even if the cache has an entry for this CPU
+#define SHA256_AUTOTUNE_NO_CACHE 2u // neither read nor write the cache file
+
+/**
+* @brief Fills `profile` from the cache or by measuring.
+* @param cache_path Cache file, or NULL for $SHA256_TUNE_CACHE, else $HOME/.cache/sha256_avx_tune.
+* Entries for other CPUs in the same file are preserved (the file may be shared between hosts).
+* @param flags SHA256_AUTOTUNE_* flags.
+* @return 0 on success (a failure to write the cache is not an error), -1 on invalid arguments.
+*/
+int sha256_autotune(Sha256TuneProfile* profile, const char* cache_path, unsigned flags);
+
+/**
+* @brief Writes the CPUID key of this machine (the cache key).
+*/
+void sha256_autotune_cpu_key(char key[96]);
+
+/**
+* @brief Hashes `count` messages with the kernels selected in `profile`.
+* Messages are classified by length, each class is hashed with its kernel, and batches of at least
+* 1024 messages per thread are split across profile->threads worker threads.
+*/
+void sha256_tuned_hash_batch(const Sha256TuneProfile* profile, const uint8_t* const messages[], const size_t lengths[],
+                             size_t count, uint8_t (*hashes_out)[32]);
+
+/**
+* @brief Returns a short name for a kernel ("avx2", "avx2-fixed", "sha-ni", "sha-ni-x2").
+*/
+const char* sha256_kernel_name(Sha256Kernel kernel);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // SHA256_AUTOTUNE_H
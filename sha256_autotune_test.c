@@ -0,0 +1,169 @@
+/* sha256_autotune_test.c
+ * gcc -O3 -mavx2 -march=native sha256_autotune_test.c sha256_autotune.c sha256_ni.c sha256_avx.c -o sha256_autotune_test -lcrypto -lpthread
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <openssl/sha.h>
+
+#include "sha256_autotune.h"
+#include "sha256_ni.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+// Mixed batch: mostly 32/33-byte keys, plus two-block, medium and long messages.
+static size_t make_batch(const uint8_t* pool, size_t pool_size, size_t count, const uint8_t** msgs, size_t* lens) {
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t len;
+        switch (rand() % 8) {
+        case 0: len = (size_t)(rand() % 56); break;
+        case 1: len = 56 + (size_t)(rand() % 64); break;
+        case 2: len = 120 + (size_t)(rand() % 904); break;
+        case 3: len = 1024 + (size_t)(rand() % 3000); break;
+        case 4: case 5: len = 33; break;
+        default: len = 32; break;
+        }
+        lens[i] = len;
+        msgs[i] = pool + (size_t)rand() % (pool_size - len);
+        bytes += len;
+    }
+    return bytes;
+}
+
+static int check_batch(const Sha256TuneProfile* profile, const uint8_t* const* msgs, const size_t* lens, size_t count) {
+    uint8_t (*out)[32] = (uint8_t (*)[32])malloc(count * 32);
+    sha256_tuned_hash_batch(profile, msgs, lens, count, out);
+    int bad = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint8_t ref[32];
+        SHA256(msgs[i], lens[i], ref);
+        if (memcmp(ref, out[i], 32) != 0) bad++;
+    }
+    free(out);
+    return bad;
+}
+
+int main() {
+    printf("--- Correctness Test (SHA-256 Autotuner) ---\n");
+    int failed_tests = 0;
+    srand(7);
+    const size_t POOL = 1 << 20;
+    uint8_t* pool = (uint8_t*)malloc(POOL);
+    for (size_t i = 0; i < POOL; i++) pool[i] = (uint8_t)rand();
+
+    char cache[] = "/tmp/sha256_tune_testXXXXXX";
+    int fd = mkstemp(cache);
+    if (fd < 0) {
+        fprintf(stderr, "mkstemp failed.\n");
+        return 1;
+    }
+    // Another host's entry must survive our write.
+    const char* foreign = "OtherVendor-f6-m55-s4-avx2-b00000000-n2 1 avx2/64 avx2/64 avx2/8 avx2/8\n";
+    if (write(fd, foreign, strlen(foreign)) != (ssize_t)strlen(foreign)) return 1;
+    close(fd);
+
+    Sha256TuneProfile profile;
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int rc = sha256_autotune(&profile, cache, 0);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double tune_ms = (t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    failed_tests += report("First run measures", rc == 0 && !profile.from_cache);
+    failed_tests += report("Measurement stays within ~100 ms budget", tune_ms < 400.0);
+
+    static const char* class_names[SHA256_LEN_CLASS_COUNT] = {"<56", "56..119", "120..1023", ">=1024"};
+    printf("  CPU key: %s (SHA-NI %s)\n", profile.cpu_key, sha256_ni_available() ? "yes" : "no");
+    for (int c = 0; c < SHA256_LEN_CLASS_COUNT; c++) {
+        printf("    %-10s %-10s window %-4u %8.1f MB/s\n", class_names[c], sha256_kernel_name((Sha256Kernel)profile.kernel[c]),
+               profile.sort_window[c], profile.mbps[c]);
+    }
+    printf("    threads    %u (tuning took %.1f ms)\n", profile.threads, tune_ms);
+
+    Sha256TuneProfile cached;
+    rc = sha256_autotune(&cached, cache, 0);
+    failed_tests += report("Second run served from cache", rc == 0 && cached.from_cache &&
+                           memcmp(cached.kernel, profile.kernel, sizeof(profile.kernel)) == 0 &&
+                           memcmp(cached.sort_window, profile.sort_window, sizeof(profile.sort_window)) == 0 &&
+                           cached.threads == profile.threads);
+
+    Sha256TuneProfile forced;
+    rc = sha256_autotune(&forced, cache, SHA256_AUTOTUNE_FORCE);
+    failed_tests += report("FORCE re-measures", rc == 0 && !forced.from_cache);
+
+    FILE* f = fopen(cache, "r");
+    char line[256];
+    int lines = 0, foreign_kept = 0;
+    while (f && fgets(line, sizeof(line), f)) {
+        lines++;
+        if (strcmp(line, foreign) == 0) foreign_kept = 1;
+    }
+    if (f) fclose(f);
+    failed_tests += report("Other CPUs' cache entries preserved", lines == 2 && foreign_kept);
+
+    // Every kernel against OpenSSL, whatever the tuner picked.
+    const size_t COUNT = 20000;
+    const uint8_t** msgs = (const uint8_t**)malloc(COUNT * sizeof(uint8_t*));
+    size_t* lens = (size_t*)malloc(COUNT * sizeof(size_t));
+    make_batch(pool, POOL, COUNT, msgs, lens);
+    int bad = check_batch(&profile, msgs, lens, COUNT);
+    failed_tests += report("Tuned profile matches OpenSSL (mixed lengths, threaded)", bad == 0);
+
+    for (int k = 0; k < SHA256_KERNEL_COUNT; k++) {
+        if ((k == SHA256_KERNEL_SHANI || k == SHA256_KERNEL_SHANI_X2) && !sha256_ni_available()) continue;
+        Sha256TuneProfile fixed = profile;
+        for (int c = 0; c < SHA256_LEN_CLASS_COUNT; c++) {
+            fixed.kernel[c] = (uint8_t)k;
+            fixed.sort_window[c] = 64;
+        }
+        fixed.threads = 1;
+        char name[64];
+        snprintf(name, sizeof(name), "Kernel %s matches OpenSSL", sha256_kernel_name((Sha256Kernel)k));
+        failed_tests += report(name, check_batch(&fixed, msgs, lens, 4099) == 0);
+    }
+    unlink(cache);
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (mixed batch, tuned vs. AVX2 only) ---\n");
+    const size_t BENCH = 200000;
+    const uint8_t** bmsgs = (const uint8_t**)malloc(BENCH * sizeof(uint8_t*));
+    size_t* blens = (size_t*)malloc(BENCH * sizeof(size_t));
+    uint8_t (*out)[32] = (uint8_t (*)[32])malloc(BENCH * 32);
+    size_t bytes = make_batch(pool, POOL, BENCH, bmsgs, blens);
+
+    Sha256TuneProfile baseline = profile;
+    for (int c = 0; c < SHA256_LEN_CLASS_COUNT; c++) {
+        baseline.kernel[c] = SHA256_KERNEL_AVX2_LANES;
+        baseline.sort_window[c] = 8;
+    }
+    const Sha256TuneProfile* runs[2] = {&baseline, &profile};
+    const char* run_names[2] = {"AVX2, unsorted", "Tuned"};
+    for (int r = 0; r < 2; r++) {
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int iter = 0; iter < 5; iter++) sha256_tuned_hash_batch(runs[r], bmsgs, blens, BENCH, out);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+        printf("%-16s %.4f seconds (%.2f Million hashes/sec, %.1f MB/s)\n", run_names[r], secs,
+               5 * BENCH / secs / 1e6, 5 * bytes / secs / 1e6);
+    }
+
+    free(pool);
+    free(msgs);
+    free(lens);
+    free(bmsgs);
+    free(blens);
+    free(out);
+    return failed_tests == 0 ? 0 : 1;
+}
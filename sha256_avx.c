@@ -16,6 +16,9 @@
    Author: 8891689 (https://github.com/8891689)
 */
 #include "sha256_avx.h" 
+#include "sha256_avx_soa.h"
+#include "hash_stats.h"
+#include "hash_verify.h"
 #include <immintrin.h>  
 #include <stdint.h>
 #include <string.h>    
@@ -32,6 +35,8 @@ static inline void explicit_bzero(void *s, size_t n) { volatile unsigned char *p
 // --- Internal structure definition ---
 typedef struct { alignas(64) __m256i state[8]; } SHA256_CTX_AVX8;
 struct Sha256Avx8_C_Handle { SHA256_CTX_AVX8 ctx; };
+_Static_assert(sizeof(struct Sha256Avx8_C_Handle) <= SHA256_AVX8_HANDLE_SIZE, "SHA256_AVX8_HANDLE_SIZE is too small");
+_Static_assert(_Alignof(struct Sha256Avx8_C_Handle) <= SHA256_AVX8_HANDLE_ALIGN, "SHA256_AVX8_HANDLE_ALIGN is too small");
 
 // --- Alternative implementations of compiler built-in functions ---
 #ifndef __builtin_bswap32
@@ -61,6 +66,18 @@ static const uint32_t k_const[64] __attribute__((aligned(64))) = {
     0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
 };
 
+// Fully expanded schedule of the padding block that follows a 64-byte message (0x80, zeros, bit length 512).
+static const uint32_t pad64_schedule[64] __attribute__((aligned(64))) = {
+    0x80000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,
+    0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000200,
+    0x80000000,0x01400000,0x00205000,0x00005088,0x22000800,0x22550014,0x05089742,0xa0000020,
+    0x5a880000,0x005c9400,0x0016d49d,0xfa801f00,0xd33225d0,0x11675959,0xf6e6bfda,0xb30c1549,
+    0x08b2b050,0x9d7c4c27,0x0ce2a393,0x88e6e1ea,0xa52b4335,0x67a16f49,0xd732016f,0x4eeb2e91,
+    0x5dbf55e5,0x8eee2335,0xe2bc5ec2,0xa83f4394,0x45ad78f7,0x36f3d0cd,0xd99c05e8,0xb0511dc7,
+    0x69bc7ac4,0xbd11375b,0xe3ba71e5,0x3b209ff2,0x18feee17,0xe25ad9e7,0x13375046,0x0515089d,
+    0x4f0d0f04,0x2627484e,0x310128d2,0xc668b434,0x420841cc,0x62d311b8,0xe59ba771,0x85a7a484
+};
+
 #define BSWAP_MASK _mm256_set_epi32(0x0c0d0e0f, 0x08090a0b, 0x04050607, 0x00010203, 0x0c0d0e0f, 0x08090a0b, 0x04050607, 0x00010203)
 #define CH(x, y, z)  _mm256_xor_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z))
 #define MAJ(x, y, z) _mm256_xor_si256(_mm256_and_si256(x, y), _mm256_xor_si256(_mm256_and_si256(x, z), _mm256_and_si256(y, z)))
@@ -71,6 +88,7 @@ static const uint32_t k_const[64] __attribute__((aligned(64))) = {
 #define sigma1(x) (_mm256_xor_si256(ROR(x, 17), _mm256_xor_si256(ROR(x, 19), _mm256_srli_epi32(x, 10))))
 
 static inline void transpose8x8_epi32(__m256i *rows) {
+    HASH_STATS_BEGIN(HASH_STATS_SHA256_TRANSPOSE);
     __m256i temp[8];
     temp[0] = _mm256_unpacklo_epi32(rows[0], rows[1]); temp[1] = _mm256_unpackhi_epi32(rows[0], rows[1]);
     temp[2] = _mm256_unpacklo_epi32(rows[2], rows[3]); temp[3] = _mm256_unpackhi_epi32(rows[2], rows[3]);
@@ -85,6 +103,7 @@ static inline void transpose8x8_epi32(__m256i *rows) {
     temp[4] = _mm256_permute2x128_si256(rows[0], rows[4], 0x31); temp[5] = _mm256_permute2x128_si256(rows[1], rows[5], 0x31);
     temp[6] = _mm256_permute2x128_si256(rows[2], rows[6], 0x31); temp[7] = _mm256_permute2x128_si256(rows[3], rows[7], 0x31);
     memcpy(rows, temp, sizeof(temp));
+    HASH_STATS_END(HASH_STATS_SHA256_TRANSPOSE, 0, 8);
 }
 
 static void internal_init_ctx(SHA256_CTX_AVX8 *ctx) {
@@ -94,38 +113,20 @@ static void internal_init_ctx(SHA256_CTX_AVX8 *ctx) {
     ctx->state[6] = _mm256_set1_epi32(SHA256_H6); ctx->state[7] = _mm256_set1_epi32(SHA256_H7);
 }
 
-// Core expansion logic
-void sha256_transform_avx8(SHA256_CTX_AVX8 *ctx, const uint8_t input_data_8blocks[8][64]) {
-    alignas(64) __m256i W[64];
-    const __m256i bswap_mask = BSWAP_MASK;
-    
-    // --- Message block preprocessing ---
-    __m256i block_data[8];
-    for (int i = 0; i < 8; i++) {
-        // [Optimization] Use aligned loading
-        block_data[i] = _mm256_load_si256((const __m256i*)input_data_8blocks[i]);
-        block_data[i] = _mm256_shuffle_epi8(block_data[i], bswap_mask);
-    }
-    transpose8x8_epi32(block_data);
-    for (int i = 0; i < 8; i++) W[i] = block_data[i];
-    
-    for (int i = 0; i < 8; i++) {
-        block_data[i] = _mm256_load_si256((const __m256i*)(input_data_8blocks[i] + 32));
-        block_data[i] = _mm256_shuffle_epi8(block_data[i], bswap_mask);
-    }
-    transpose8x8_epi32(block_data);
-    for (int i = 0; i < 8; i++) W[i + 8] = block_data[i];
-
-    // --- Message Extension ---
+// --- Message Extension ---: W[0..15] in SoA form -> W[16..63]
+static inline __attribute__((always_inline)) void sha256_expand_avx8(__m256i W[64]) {
     for (int i = 16; i < 64; ++i) {
         __m256i s1 = sigma1(W[i-2]);
         __m256i s0 = sigma0(W[i-15]);
         W[i] = _mm256_add_epi32(s1, _mm256_add_epi32(W[i-7], _mm256_add_epi32(W[i-16], s0)));
     }
+}
 
+// The 64 rounds over an already expanded schedule.
+static inline __attribute__((always_inline)) void sha256_compress_avx8(__m256i state[8], const __m256i W[64]) {
     // --- Main Loop ---
-    __m256i a = ctx->state[0], b = ctx->state[1], c = ctx->state[2], d = ctx->state[3];
-    __m256i e = ctx->state[4], f = ctx->state[5], g = ctx->state[6], h = ctx->state[7];
+    __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+    __m256i e = state[4], f = state[5], g = state[6], h = state[7];
     
     // Preload k and W for the first 4 rounds
     __m256i k0 = _mm256_set1_epi32(k_const[0]);
@@ -164,10 +165,127 @@ void sha256_transform_avx8(SHA256_CTX_AVX8 *ctx, const uint8_t input_data_8block
     }
 
     // --- Update final status ---
-    ctx->state[0] = _mm256_add_epi32(ctx->state[0], a); ctx->state[1] = _mm256_add_epi32(ctx->state[1], b);
-    ctx->state[2] = _mm256_add_epi32(ctx->state[2], c); ctx->state[3] = _mm256_add_epi32(ctx->state[3], d);
-    ctx->state[4] = _mm256_add_epi32(ctx->state[4], e); ctx->state[5] = _mm256_add_epi32(ctx->state[5], f);
-    ctx->state[6] = _mm256_add_epi32(ctx->state[6], g); ctx->state[7] = _mm256_add_epi32(ctx->state[7], h);
+    state[0] = _mm256_add_epi32(state[0], a); state[1] = _mm256_add_epi32(state[1], b);
+    state[2] = _mm256_add_epi32(state[2], c); state[3] = _mm256_add_epi32(state[3], d);
+    state[4] = _mm256_add_epi32(state[4], e); state[5] = _mm256_add_epi32(state[5], f);
+    state[6] = _mm256_add_epi32(state[6], g); state[7] = _mm256_add_epi32(state[7], h);
+}
+
+// Rounds first..last-1 on the working registers a..h, without the final addition, so that a compression
+// can be split after rounds whose message words are the same in every lane.
+static inline void sha256_round_range_avx8(__m256i v[8], const __m256i W[64], int first, int last) {
+    __m256i a = v[0], b = v[1], c = v[2], d = v[3];
+    __m256i e = v[4], f = v[5], g = v[6], h = v[7];
+    for (int i = first; i < last; i++) {
+        __m256i t1 = _mm256_add_epi32(h, _mm256_add_epi32(SIGMA1(e), _mm256_add_epi32(CH(e, f, g), _mm256_add_epi32(_mm256_set1_epi32(k_const[i]), W[i]))));
+        __m256i t2 = _mm256_add_epi32(SIGMA0(a), MAJ(a, b, c));
+        h = g; g = f; f = e; e = _mm256_add_epi32(d, t1); d = c; c = b; b = a; a = _mm256_add_epi32(t1, t2);
+    }
+    v[0] = a; v[1] = b; v[2] = c; v[3] = d;
+    v[4] = e; v[5] = f; v[6] = g; v[7] = h;
+}
+
+// Message expansion plus the 64 rounds; W[0..15] must already hold the schedule words in SoA form.
+static inline __attribute__((always_inline)) void sha256_rounds_avx8(__m256i state[8], __m256i W[64]) {
+    sha256_expand_avx8(W);
+    sha256_compress_avx8(state, W);
+}
+
+// Loads 32 bytes from each of the 8 aligned blocks at the given offset and transposes them into 8 SoA words.
+static inline void sha256_load_words_avx8(__m256i out[8], const uint8_t input_data_8blocks[8][64], size_t offset) {
+    const __m256i bswap_mask = BSWAP_MASK;
+    for (int i = 0; i < 8; i++) {
+        // [Optimization] Use aligned loading
+        out[i] = _mm256_load_si256((const __m256i*)(input_data_8blocks[i] + offset));
+        out[i] = _mm256_shuffle_epi8(out[i], bswap_mask);
+    }
+    transpose8x8_epi32(out);
+}
+
+// Loads, expands and compresses one block per lane; active_lanes only feeds the optional stats.
+static inline void sha256_transform_lanes(SHA256_CTX_AVX8 *ctx, const uint8_t input_data_8blocks[8][64], int active_lanes) {
+    HASH_STATS_BEGIN(HASH_STATS_SHA256_TRANSFORM);
+    alignas(64) __m256i W[64];
+    
+    // --- Message block preprocessing ---
+    sha256_load_words_avx8(W, input_data_8blocks, 0);
+    sha256_load_words_avx8(W + 8, input_data_8blocks, 32);
+
+    sha256_rounds_avx8(ctx->state, W);
+    HASH_STATS_END(HASH_STATS_SHA256_TRANSFORM, (uint64_t)active_lanes, (uint64_t)active_lanes);
+}
+
+// Same as sha256_load_words_avx8, but from 8 independent, unaligned block pointers.
+static inline void sha256_load_words_ptrs_avx8(__m256i out[8], const uint8_t* const blocks[8], size_t offset) {
+    const __m256i bswap_mask = BSWAP_MASK;
+    for (int i = 0; i < 8; i++) {
+        out[i] = _mm256_loadu_si256((const __m256i*)(blocks[i] + offset));
+        out[i] = _mm256_shuffle_epi8(out[i], bswap_mask);
+    }
+    transpose8x8_epi32(out);
+}
+
+// Second compression of a 64-byte message: the padding block's schedule is a precomputed constant.
+static inline void sha256_finish_64_avx8(__m256i state[8]) {
+    alignas(64) __m256i W[64];
+    for (int i = 0; i < 64; i++) W[i] = _mm256_set1_epi32((int)pad64_schedule[i]);
+    sha256_compress_avx8(state, W);
+}
+
+// Schedule words of a 32-byte message held in SoA form: the digest words are the message words as-is.
+static inline void sha256_digest_block_avx8(__m256i W[16], const __m256i digest[8]) {
+    for (int i = 0; i < 8; i++) W[i] = digest[i];
+    W[8] = _mm256_set1_epi32((int)0x80000000);
+    for (int i = 9; i < 15; i++) W[i] = _mm256_setzero_si256();
+    W[15] = _mm256_set1_epi32(256);
+}
+
+// Compresses nblocks consecutive blocks of every lane straight from the callers' buffers. The chaining
+// state lives in locals for the whole loop and the next block of each lane is prefetched.
+static void sha256_blocks_ptrs_avx8(__m256i state_io[8], const uint8_t* const lane_ptrs[8], size_t nblocks) {
+    __m256i state[8];
+    memcpy(state, state_io, sizeof(state));
+    const uint8_t* ptrs[8];
+    memcpy(ptrs, lane_ptrs, sizeof(ptrs));
+    alignas(64) __m256i W[64];
+    for (size_t b = 0; b < nblocks; b++) {
+        HASH_STATS_BEGIN(HASH_STATS_SHA256_TRANSFORM);
+        if (b + 1 < nblocks) {
+            for (int lane = 0; lane < 8; lane++) {
+                _mm_prefetch((const char*)(ptrs[lane] + 64), _MM_HINT_T0);
+                _mm_prefetch((const char*)(ptrs[lane] + 127), _MM_HINT_T0); // unaligned blocks span two lines
+            }
+        }
+        sha256_load_words_ptrs_avx8(W, ptrs, 0);
+        sha256_load_words_ptrs_avx8(W + 8, ptrs, 32);
+        sha256_rounds_avx8(state, W);
+        for (int lane = 0; lane < 8; lane++) ptrs[lane] += 64;
+        HASH_STATS_END(HASH_STATS_SHA256_TRANSFORM, 8, 8);
+    }
+    memcpy(state_io, state, sizeof(state));
+}
+
+// Core expansion logic
+void sha256_transform_avx8(SHA256_CTX_AVX8 *ctx, const uint8_t input_data_8blocks[8][64]) {
+    sha256_transform_lanes(ctx, input_data_8blocks, 8);
+}
+
+// Writes the SoA state out as 8 big-endian digests.
+static void sha256_store_digests_avx8(const __m256i state[8], uint8_t hashes_out[8][32]) {
+    HASH_STATS_BEGIN(HASH_STATS_SHA256_FINAL);
+    const __m256i bswap_final_mask = _mm256_setr_epi8(
+        3, 2, 1, 0,   7, 6, 5, 4,   11, 10, 9, 8,   15, 14, 13, 12,
+        3, 2, 1, 0,   7, 6, 5, 4,   11, 10, 9, 8,   15, 14, 13, 12
+    );
+    alignas(64) __m256i transposed_state[8];
+    memcpy(transposed_state, state, sizeof(transposed_state));
+    transpose8x8_epi32(transposed_state);
+    for (int i = 0; i < 8; ++i) {
+        __m256i final_hash_vec = transposed_state[i];
+        final_hash_vec = _mm256_shuffle_epi8(final_hash_vec, bswap_final_mask);
+        _mm256_storeu_si256((__m256i*)hashes_out[i], final_hash_vec);
+    }
+    HASH_STATS_END(HASH_STATS_SHA256_FINAL, 0, 8);
 }
 
 // --- Implementation of public interface functions ---
@@ -183,6 +301,12 @@ void sha256_avx8_destroy(Sha256Avx8_C_Handle* handle) {
         free(handle);
     }
 }
+Sha256Avx8_C_Handle* sha256_avx8_init_at(void* storage) {
+    if (!storage || ((uintptr_t)storage % SHA256_AVX8_HANDLE_ALIGN) != 0) return NULL;
+    Sha256Avx8_C_Handle* handle = (Sha256Avx8_C_Handle*)storage;
+    internal_init_ctx(&handle->ctx);
+    return handle;
+}
 void sha256_avx8_init(Sha256Avx8_C_Handle* handle) {
     if (!handle) return;
     internal_init_ctx(&handle->ctx);
@@ -193,20 +317,304 @@ void sha256_avx8_update_8_blocks(Sha256Avx8_C_Handle* handle, const uint8_t inpu
 }
 
 
+void sha256_avx8_update_n_blocks(Sha256Avx8_C_Handle* handle, const uint8_t* const lane_ptrs[8], size_t nblocks) {
+    if (!handle || !lane_ptrs) return;
+    sha256_blocks_ptrs_avx8(handle->ctx.state, lane_ptrs, nblocks);
+}
+
 void sha256_avx8_get_final_hashes(Sha256Avx8_C_Handle* handle, uint8_t hashes_out[8][32]) {
     if (!handle || !hashes_out) return;
-    const __m256i bswap_final_mask = _mm256_setr_epi8(
-        3, 2, 1, 0,   7, 6, 5, 4,   11, 10, 9, 8,   15, 14, 13, 12,
-        3, 2, 1, 0,   7, 6, 5, 4,   11, 10, 9, 8,   15, 14, 13, 12
-    );
-    alignas(64) __m256i transposed_state[8];
-    memcpy(transposed_state, handle->ctx.state, sizeof(transposed_state));
-    transpose8x8_epi32(transposed_state);
-    for (int i = 0; i < 8; ++i) {
-        __m256i final_hash_vec = transposed_state[i];
-        final_hash_vec = _mm256_shuffle_epi8(final_hash_vec, bswap_final_mask);
-        _mm256_storeu_si256((__m256i*)hashes_out[i], final_hash_vec);
+    sha256_store_digests_avx8(handle->ctx.state, hashes_out);
+}
+
+void sha256_avx8_hash_short(const uint8_t* const messages[8], size_t message_len_bytes, uint8_t hashes_out[8][32]) {
+    if (!messages || !hashes_out) return;
+    if (message_len_bytes >= 56) {
+        fprintf(stderr, "Error: sha256_avx8_hash_short only supports messages shorter than 56 bytes. Got %zu.\n", message_len_bytes);
+        exit(EXIT_FAILURE);
+    }
+    // The padding and length bytes are identical in every lane, so only the message bytes are copied in.
+    alignas(64) uint8_t blocks[8][64];
+    // The template is copied before any message goes in, so a NULL lane keeps its zero message bytes.
+    prepare_test_data_block(blocks[0], NULL, message_len_bytes);
+    for (int i = 1; i < 8; i++) memcpy(blocks[i], blocks[0], 64);
+    for (int i = 0; i < 8; i++) {
+        if (messages[i]) memcpy(blocks[i], messages[i], message_len_bytes);
+    }
+
+    HASH_STATS_BEGIN(HASH_STATS_SHA256_TRANSFORM);
+    alignas(64) __m256i W[64];
+    sha256_load_words_avx8(W, blocks, 0);
+    if (message_len_bytes < 32) {
+        // The second half of every block is pure padding: broadcast it instead of loading and transposing.
+        for (int i = 8; i < 16; i++) {
+            uint32_t w;
+            memcpy(&w, blocks[0] + i * 4, 4);
+            W[i] = _mm256_set1_epi32((int)__builtin_bswap32(w));
+        }
+    } else {
+        sha256_load_words_avx8(W + 8, blocks, 32);
+    }
+
+    SHA256_CTX_AVX8 ctx;
+    internal_init_ctx(&ctx);
+    sha256_rounds_avx8(ctx.state, W);
+    HASH_STATS_END(HASH_STATS_SHA256_TRANSFORM, 8, 8);
+    sha256_store_digests_avx8(ctx.state, hashes_out);
+    HASH_VERIFY_LANES_FIXED(HASH_VERIFY_SHA256, messages, message_len_bytes, hashes_out);
+}
+
+void sha256_avx8_compress_states(uint32_t states[8][8], const uint8_t blocks[8][64]) {
+    if (!states || !blocks) return;
+    alignas(64) uint8_t aligned_blocks[8][64];
+    memcpy(aligned_blocks, blocks, sizeof(aligned_blocks));
+
+    SHA256_CTX_AVX8 ctx;
+    for (int i = 0; i < 8; i++) ctx.state[i] = _mm256_loadu_si256((const __m256i*)states[i]);
+    transpose8x8_epi32(ctx.state);
+    sha256_transform_avx8(&ctx, (const uint8_t (*)[64])aligned_blocks);
+    transpose8x8_epi32(ctx.state);
+    for (int i = 0; i < 8; i++) _mm256_storeu_si256((__m256i*)states[i], ctx.state[i]);
+}
+
+void sha256_avx8_hash_lanes(const uint32_t init_state[8], uint64_t prefix_len_bytes,
+                            const uint8_t* const messages[8], const size_t lengths[8], uint8_t hashes_out[8][32]) {
+    if (!messages || !lengths || !hashes_out) return;
+
+    SHA256_CTX_AVX8 ctx;
+    if (init_state) {
+        for (int i = 0; i < 8; i++) ctx.state[i] = _mm256_set1_epi32((int)init_state[i]);
+    } else {
+        internal_init_ctx(&ctx);
+    }
+
+    size_t lane_blocks[8];
+    size_t max_blocks = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        lane_blocks[lane] = (lengths[lane] + 9 + 63) / 64;
+        if (lane_blocks[lane] > max_blocks) max_blocks = lane_blocks[lane];
+    }
+
+    // Blocks that are full in every lane are hashed in place, without staging copies.
+    size_t direct_blocks = SIZE_MAX;
+    for (int lane = 0; lane < 8; lane++) {
+        if (lengths[lane] / 64 < direct_blocks) direct_blocks = lengths[lane] / 64;
+    }
+    sha256_blocks_ptrs_avx8(ctx.state, messages, direct_blocks);
+
+    alignas(64) uint8_t blocks[8][64];
+    alignas(32) uint8_t digests[8][32];
+    for (size_t b = direct_blocks; b < max_blocks; b++) {
+        uint8_t finishing = 0;
+        int active_lanes = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            size_t len = lengths[lane];
+            size_t offset = b * 64;
+            if (b >= lane_blocks[lane]) continue; // finished lane: the stale block is hashed and ignored
+            active_lanes++;
+            if (offset + 64 <= len) {
+                memcpy(blocks[lane], messages[lane] + offset, 64);
+                continue;
+            }
+            // Tail block(s): remaining bytes, 0x80, zeros, and the big-endian bit length in the last block.
+            memset(blocks[lane], 0, 64);
+            size_t remaining = offset < len ? len - offset : 0;
+            if (remaining) memcpy(blocks[lane], messages[lane] + offset, remaining);
+            if (offset <= len) blocks[lane][remaining] = 0x80;
+            if (b == lane_blocks[lane] - 1) {
+                uint64_t bit_length = __builtin_bswap64((prefix_len_bytes + len) * 8);
+                memcpy(blocks[lane] + 56, &bit_length, 8);
+                finishing |= (uint8_t)(1u << lane);
+            }
+        }
+        sha256_transform_lanes(&ctx, (const uint8_t (*)[64])blocks, active_lanes);
+
+        if (finishing) {
+            sha256_store_digests_avx8(ctx.state, digests);
+            for (int lane = 0; lane < 8; lane++) {
+                if (finishing & (1u << lane)) memcpy(hashes_out[lane], digests[lane], 32);
+            }
+        }
+    }
+    if (!init_state && !prefix_len_bytes) HASH_VERIFY_LANES(HASH_VERIFY_SHA256, messages, lengths, hashes_out);
+}
+
+void sha256_avx8_double64(const uint8_t* const inputs[8], uint8_t hashes_out[8][32]) {
+    if (!inputs || !hashes_out) return;
+    HASH_STATS_BEGIN(HASH_STATS_SHA256_TRANSFORM);
+    alignas(64) __m256i W[64];
+    __m256i state[8];
+
+    // First SHA-256: the 64-byte message block, then the constant padding block.
+    sha256_load_words_ptrs_avx8(W, inputs, 0);
+    sha256_load_words_ptrs_avx8(W + 8, inputs, 32);
+    sha256_avx8_soa_init(state);
+    sha256_rounds_avx8(state, W);
+    sha256_finish_64_avx8(state);
+
+    // Second SHA-256 straight from the SoA state, without storing the intermediate digests.
+    __m256i digest[8];
+    memcpy(digest, state, sizeof(digest));
+    sha256_digest_block_avx8(W, digest);
+    sha256_avx8_soa_init(state);
+    sha256_rounds_avx8(state, W);
+    HASH_STATS_END(HASH_STATS_SHA256_TRANSFORM, 24, 8);
+
+    sha256_store_digests_avx8(state, hashes_out);
+    HASH_VERIFY_LANES_FIXED(HASH_VERIFY_SHA256D, inputs, 64, hashes_out);
+}
+
+void sha256_avx8_iterate(const uint8_t* const seeds[8], const uint64_t counts[8], uint8_t hashes_out[8][32]) {
+    if (!seeds || !counts || !hashes_out) return;
+    __m256i digest[8];
+    sha256_load_words_ptrs_avx8(digest, seeds, 0);
+
+    HASH_STATS_BEGIN(HASH_STATS_SHA256_TRANSFORM);
+    uint64_t done = 0, lane_steps = 0;
+    for (;;) {
+        // Run until the next lane reaches its count; finished lanes keep their digest through a blend.
+        uint8_t active = 0;
+        uint64_t run = UINT64_MAX;
+        for (int lane = 0; lane < 8; lane++) {
+            if (counts[lane] <= done) continue;
+            active |= (uint8_t)(1u << lane);
+            if (counts[lane] - done < run) run = counts[lane] - done;
+        }
+        if (!active) break;
+        const __m256i sel = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        const __m256i keep = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(active), sel), sel);
+        for (uint64_t step = 0; step < run; step++) {
+            alignas(64) __m256i W[64];
+            __m256i state[8];
+            sha256_digest_block_avx8(W, digest);
+            sha256_avx8_soa_init(state);
+            sha256_rounds_avx8(state, W);
+            if (active == 0xFF) {
+                for (int i = 0; i < 8; i++) digest[i] = state[i];
+            } else {
+                for (int i = 0; i < 8; i++) digest[i] = _mm256_blendv_epi8(digest[i], state[i], keep);
+            }
+        }
+        done += run;
+        lane_steps += run * (uint64_t)__builtin_popcount(active);
+    }
+    HASH_STATS_END(HASH_STATS_SHA256_TRANSFORM, lane_steps, 8);
+
+    sha256_store_digests_avx8(digest, hashes_out);
+}
+
+// --- Single-message path (scalar) ---
+#define SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sha256_compress_scalar(uint32_t state[8], const uint8_t block[64]) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        uint32_t v;
+        memcpy(&v, block + i * 4, 4);
+        w[i] = __builtin_bswap32(v);
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = SHA256_ROTR(w[i - 15], 7) ^ SHA256_ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = SHA256_ROTR(w[i - 2], 17) ^ SHA256_ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = h + (SHA256_ROTR(e, 6) ^ SHA256_ROTR(e, 11) ^ SHA256_ROTR(e, 25)) + ((e & f) ^ (~e & g)) +
+                      k_const[i] + w[i];
+        uint32_t t2 = (SHA256_ROTR(a, 2) ^ SHA256_ROTR(a, 13) ^ SHA256_ROTR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
     }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+void sha256_compress_single(uint32_t state[8], const uint8_t* blocks, size_t nblocks) {
+    if (!state || (!blocks && nblocks)) return;
+    for (size_t b = 0; b < nblocks; b++) sha256_compress_scalar(state, blocks + b * 64);
+}
+
+void sha256_hash_single(const uint8_t* message, size_t length, uint8_t hash_out[32]) {
+    if ((!message && length) || !hash_out) return;
+    uint32_t state[8] = {SHA256_H0, SHA256_H1, SHA256_H2, SHA256_H3, SHA256_H4, SHA256_H5, SHA256_H6, SHA256_H7};
+    size_t full = length / 64;
+    for (size_t b = 0; b < full; b++) sha256_compress_scalar(state, message + b * 64);
+
+    // Tail: remaining bytes, 0x80, zeros, and the big-endian bit length (one or two blocks).
+    uint8_t tail[128] = {0};
+    size_t remaining = length - full * 64;
+    if (remaining) memcpy(tail, message + full * 64, remaining);
+    tail[remaining] = 0x80;
+    size_t tail_len = remaining < 56 ? 64 : 128;
+    uint64_t bit_length = __builtin_bswap64((uint64_t)length * 8);
+    memcpy(tail + tail_len - 8, &bit_length, 8);
+    sha256_compress_scalar(state, tail);
+    if (tail_len == 128) sha256_compress_scalar(state, tail + 64);
+
+    for (int i = 0; i < 8; i++) {
+        uint32_t v = __builtin_bswap32(state[i]);
+        memcpy(hash_out + i * 4, &v, 4);
+    }
+}
+
+// --- SoA interface (sha256_avx_soa.h) ---
+void sha256_avx8_soa_init(__m256i state[8]) {
+    state[0] = _mm256_set1_epi32(SHA256_H0); state[1] = _mm256_set1_epi32(SHA256_H1);
+    state[2] = _mm256_set1_epi32(SHA256_H2); state[3] = _mm256_set1_epi32(SHA256_H3);
+    state[4] = _mm256_set1_epi32(SHA256_H4); state[5] = _mm256_set1_epi32(SHA256_H5);
+    state[6] = _mm256_set1_epi32(SHA256_H6); state[7] = _mm256_set1_epi32(SHA256_H7);
+}
+
+void sha256_avx8_soa_load(__m256i w[16], const uint8_t* const blocks[8]) {
+    sha256_load_words_ptrs_avx8(w, blocks, 0);
+    sha256_load_words_ptrs_avx8(w + 8, blocks, 32);
+}
+
+void sha256_avx8_soa_load_digests(__m256i words[8], const uint8_t* const digests[8]) {
+    sha256_load_words_ptrs_avx8(words, digests, 0);
+}
+
+void sha256_avx8_soa_transform(__m256i state[8], const __m256i w[16]) {
+    HASH_STATS_BEGIN(HASH_STATS_SHA256_TRANSFORM);
+    alignas(64) __m256i W[64];
+    memcpy(W, w, 16 * sizeof(__m256i));
+    sha256_rounds_avx8(state, W);
+    HASH_STATS_END(HASH_STATS_SHA256_TRANSFORM, 8, 8);
+}
+
+void sha256_avx8_soa_rounds_head(__m256i working[8], const __m256i state[8], const __m256i w[16], int rounds) {
+    alignas(64) __m256i W[64];
+    memcpy(W, w, 16 * sizeof(__m256i));
+    memmove(working, state, 8 * sizeof(__m256i));
+    sha256_round_range_avx8(working, W, 0, rounds < 16 ? rounds : 16);
+}
+
+void sha256_avx8_soa_transform_from(__m256i state[8], const __m256i working[8], const __m256i w[16], int first_round) {
+    HASH_STATS_BEGIN(HASH_STATS_SHA256_TRANSFORM);
+    alignas(64) __m256i W[64];
+    __m256i v[8];
+    memcpy(W, w, 16 * sizeof(__m256i));
+    memcpy(v, working, sizeof(v));
+    sha256_expand_avx8(W);
+    sha256_round_range_avx8(v, W, first_round, 64);
+    for (int i = 0; i < 8; i++) state[i] = _mm256_add_epi32(state[i], v[i]);
+    HASH_STATS_END(HASH_STATS_SHA256_TRANSFORM, 8, 8);
+}
+
+void sha256_avx8_soa_finish_64(__m256i state[8]) {
+    HASH_STATS_BEGIN(HASH_STATS_SHA256_TRANSFORM);
+    sha256_finish_64_avx8(state);
+    HASH_STATS_END(HASH_STATS_SHA256_TRANSFORM, 8, 8);
+}
+
+void sha256_avx8_soa_digest_block(__m256i w[16], const __m256i digest[8]) {
+    sha256_digest_block_avx8(w, digest);
+}
+
+void sha256_avx8_soa_store(const __m256i state[8], uint8_t hashes_out[8][32]) {
+    sha256_store_digests_avx8(state, hashes_out);
 }
 
 void prepare_test_data_block(uint8_t block[64], const char* message, size_t message_len_bytes) {
@@ -36,6 +36,10 @@ extern "C" {
 struct Sha256Avx8_C_Handle; 
 typedef struct Sha256Avx8_C_Handle Sha256Avx8_C_Handle;
 
+// Storage requirements for placing a handle in caller-owned memory (see sha256_avx8_init_at).
+#define SHA256_AVX8_HANDLE_SIZE 256
+#define SHA256_AVX8_HANDLE_ALIGN 64
+
 // --- Public interface function ---
 
 /**
@@ -50,6 +54,14 @@ Sha256Avx8_C_Handle* sha256_avx8_create();
 */
 void sha256_avx8_destroy(Sha256Avx8_C_Handle* handle);
 
+/**
+* @brief Initializes a handle inside caller-owned storage, without any heap allocation.
+* @param storage At least SHA256_AVX8_HANDLE_SIZE bytes, aligned to SHA256_AVX8_HANDLE_ALIGN.
+* @return The handle (pointing into storage), or NULL if storage is NULL or misaligned.
+* The handle must not be passed to sha256_avx8_destroy(); the owner simply releases the storage.
+*/
+Sha256Avx8_C_Handle* sha256_avx8_init_at(void* storage);
+
 /**
 * @brief Reinitializes the hash state, allowing the handle to be reused for new computations.
 * @param handle A valid handle. If NULL, no action is performed.
@@ -64,6 +76,15 @@ void sha256_avx8_init(Sha256Avx8_C_Handle* handle);
 */
 void sha256_avx8_update_8_blocks(Sha256Avx8_C_Handle* handle, const uint8_t input_blocks[8][64]);
 
+/**
+* @brief Processes nblocks consecutive 64-byte blocks per lane, loading them directly from the callers' buffers.
+* The chaining state stays in registers across blocks and the next block of each lane is prefetched.
+* @param handle A valid handle.
+* @param lane_ptrs Eight pointers to at least nblocks * 64 bytes each (no alignment requirement).
+* @param nblocks Number of blocks per lane. If handle or lane_ptrs is NULL, no action is performed.
+*/
+void sha256_avx8_update_n_blocks(Sha256Avx8_C_Handle* handle, const uint8_t* const lane_ptrs[8], size_t nblocks);
+
 /**
 * @brief Extracts the 8 final hash digests from the internal state.
 * @param handle A valid handle.
@@ -72,6 +93,74 @@ void sha256_avx8_update_8_blocks(Sha256Avx8_C_Handle* handle, const uint8_t inpu
 */
 void sha256_avx8_get_final_hashes(Sha256Avx8_C_Handle* handle, uint8_t hashes_out[8][32]);
 
+/**
+* @brief One-shot SHA-256 of eight equal-length short messages (constant-padded fast path).
+* The padding and length words are shared by all lanes, and when the message is shorter
+* than 32 bytes the second half of the block is broadcast instead of being transposed.
+* @param messages Eight message pointers (no alignment requirement). A NULL lane hashes zero bytes of that length.
+* @param message_len_bytes Common message length (bytes). The length must be less than 56.
+* @param hashes_out An output array to store the 8 32-byte hash results.
+*/
+void sha256_avx8_hash_short(const uint8_t* const messages[8], size_t message_len_bytes, uint8_t hashes_out[8][32]);
+
+/**
+* @brief One-shot SHA-256 of eight messages of independent lengths, optionally resuming from a midstate.
+* Lanes that need fewer blocks finish early; their digests are captured at the block they complete.
+* @param init_state Chaining state shared by all lanes, or NULL to start from the SHA-256 IV.
+* @param prefix_len_bytes Bytes already compressed into init_state (a multiple of 64, 0 when init_state is NULL).
+* @param messages Eight message pointers (no alignment requirement).
+* @param lengths Eight message lengths (bytes).
+* @param hashes_out An output array to store the 8 32-byte hash results.
+*/
+void sha256_avx8_hash_lanes(const uint32_t init_state[8], uint64_t prefix_len_bytes,
+                            const uint8_t* const messages[8], const size_t lengths[8], uint8_t hashes_out[8][32]);
+
+/**
+* @brief Applies one compression to each of eight independent chaining states.
+* @param states Eight chaining states (host-order words), updated in place.
+* @param blocks Eight 64-byte message blocks (no alignment requirement).
+*/
+void sha256_avx8_compress_states(uint32_t states[8][8], const uint8_t blocks[8][64]);
+
+/**
+* @brief Double SHA-256 of eight 64-byte messages, SHA256(SHA256(x)), as used for Merkle tree nodes.
+* The padding block of the first hash uses a precomputed schedule and the second hash is fed
+* from the vector state directly, so only the inputs are transposed.
+* @param inputs Eight pointers to 64-byte messages (no alignment requirement).
+* @param hashes_out An output array to store the 8 32-byte hash results.
+*/
+void sha256_avx8_double64(const uint8_t* const inputs[8], uint8_t hashes_out[8][32]);
+
+/**
+* @brief Iterated SHA-256 of eight 32-byte seeds: lane i is replaced by its own digest counts[i] times.
+* Each step is one compression of the previous digest as a constant-padded block, with the digest
+* kept in registers between steps. Lanes that reach their count early are frozen by a blend, so the
+* batch costs max(counts) compressions.
+* @param seeds Eight pointers to 32-byte seeds (no alignment requirement).
+* @param counts Iteration count per lane; 0 copies the seed.
+* @param hashes_out An output array to store the 8 32-byte results.
+*/
+void sha256_avx8_iterate(const uint8_t* const seeds[8], const uint64_t counts[8], uint8_t hashes_out[8][32]);
+
+// --- Single-message path ---
+
+/**
+* @brief Scalar SHA-256 of one message, for callers that hash one or two messages at a time
+* (checksums, DRBG state updates) and would otherwise occupy all eight lanes for one result.
+* @param message Message bytes (may be NULL when length is 0).
+* @param length Message length (bytes).
+* @param hash_out The 32-byte hash result (may overlap the message).
+*/
+void sha256_hash_single(const uint8_t* message, size_t length, uint8_t hash_out[32]);
+
+/**
+* @brief Scalar compression of consecutive 64-byte blocks into one chaining state (no padding),
+* e.g. to compute a midstate shared by many messages.
+* @param state Chaining state (host-order words), updated in place.
+* @param blocks nblocks * 64 message bytes (no alignment requirement).
+*/
+void sha256_compress_single(uint32_t state[8], const uint8_t* blocks, size_t nblocks);
+
 
 // --- Test helper functions ---
 
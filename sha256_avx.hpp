@@ -0,0 +1,211 @@
+/* sha256_avx.hpp */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+// Header-only C++20 layer over the C API.
+//
+//   avx_hash::Sha256Avx8                      RAII streaming hasher, state lives inside the object (no heap).
+//   avx_hash::Hasher<Algo, Lanes, FixedLen>   one-shot batch hasher; Algo is Sha256, Ripemd160 or Hash160.
+//
+// FixedLen != 0 selects the constant-padded paths at compile time:
+//   SHA-256 < 56 bytes -> sha256_avx8_hash_short, < 120 bytes -> two staged blocks, longer -> per-lane engine.
+// Lanes must be a multiple of 8; each group of 8 is one kernel batch.
+
+#ifndef SHA256_AVX_HPP
+#define SHA256_AVX_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "sha256_avx.h"
+#include "ripemd160_avx.h"
+
+namespace avx_hash {
+
+template <std::size_t N>
+using Digest = std::array<std::uint8_t, N>;
+
+using Block64 = std::array<std::uint8_t, 64>;
+
+struct Sha256    { static constexpr std::size_t digest_size = 32; };
+struct Ripemd160 { static constexpr std::size_t digest_size = 20; };
+struct Hash160   { static constexpr std::size_t digest_size = 20; }; // RIPEMD160(SHA256(x))
+
+// --- Streaming SHA-256 state for 8 lanes, stored in place ---
+class Sha256Avx8 {
+public:
+    Sha256Avx8() noexcept { sha256_avx8_init_at(storage_); }
+    Sha256Avx8(const Sha256Avx8&) noexcept = default;
+    Sha256Avx8& operator=(const Sha256Avx8&) noexcept = default;
+    ~Sha256Avx8() {
+        volatile unsigned char* p = storage_;
+        for (std::size_t i = 0; i < sizeof(storage_); ++i) p[i] = 0;
+    }
+
+    void reset() noexcept { sha256_avx8_init(handle()); }
+
+    // Blocks must be 64-byte aligned, as required by sha256_avx8_update_8_blocks.
+    void update(std::span<const Block64, 8> blocks) noexcept {
+        sha256_avx8_update_8_blocks(handle(), reinterpret_cast<const std::uint8_t (*)[64]>(blocks.data()));
+    }
+
+    void digests(std::span<Digest<32>, 8> out) noexcept {
+        sha256_avx8_get_final_hashes(handle(), reinterpret_cast<std::uint8_t (*)[32]>(out.data()));
+    }
+
+    Sha256Avx8_C_Handle* handle() noexcept { return reinterpret_cast<Sha256Avx8_C_Handle*>(storage_); }
+
+private:
+    alignas(SHA256_AVX8_HANDLE_ALIGN) unsigned char storage_[SHA256_AVX8_HANDLE_SIZE];
+};
+
+namespace detail {
+
+// Big-endian bit length of a FixedLen-byte message in the last 8 bytes of the final block.
+template <std::size_t FixedLen>
+inline void put_bit_length(std::uint8_t* block) noexcept {
+    constexpr std::uint64_t bits = static_cast<std::uint64_t>(FixedLen) * 8;
+    for (int i = 0; i < 8; ++i) block[63 - i] = static_cast<std::uint8_t>(bits >> (i * 8));
+}
+
+// Big-endian SHA-256 padding of a FixedLen-byte message, placed after `len` bytes of the final block.
+template <std::size_t FixedLen>
+inline void pad_final_block(std::uint8_t* block, std::size_t len) noexcept {
+    std::memset(block + len, 0, 64 - len);
+    block[len] = 0x80;
+    put_bit_length<FixedLen>(block);
+}
+
+template <std::size_t FixedLen>
+inline void sha256_8(const std::uint8_t* const msgs[8], const std::size_t lens[8], std::uint8_t out[8][32]) {
+    if constexpr (FixedLen == 0) {
+        sha256_avx8_hash_lanes(nullptr, 0, msgs, lens, out);
+    } else if constexpr (FixedLen < 56) {
+        sha256_avx8_hash_short(msgs, FixedLen, out);
+    } else if constexpr (FixedLen < 120) {
+        // Two blocks: the split point and the padding offsets are compile-time constants.
+        alignas(64) std::uint8_t first[8][64];
+        alignas(64) std::uint8_t second[8][64];
+        for (int lane = 0; lane < 8; ++lane) {
+            if constexpr (FixedLen < 64) {
+                // 56..63: the 0x80 still fits after the message, the length spills into a block of its own.
+                std::memcpy(first[lane], msgs[lane], FixedLen);
+                std::memset(first[lane] + FixedLen, 0, 64 - FixedLen);
+                first[lane][FixedLen] = 0x80;
+                std::memset(second[lane], 0, 56);
+                put_bit_length<FixedLen>(second[lane]);
+            } else {
+                std::memcpy(first[lane], msgs[lane], 64);
+                std::memcpy(second[lane], msgs[lane] + 64, FixedLen - 64);
+                pad_final_block<FixedLen>(second[lane], FixedLen - 64);
+            }
+        }
+        Sha256Avx8 state;
+        sha256_avx8_update_8_blocks(state.handle(), first);
+        sha256_avx8_update_8_blocks(state.handle(), second);
+        sha256_avx8_get_final_hashes(state.handle(), out);
+    } else {
+        sha256_avx8_hash_lanes(nullptr, 0, msgs, lens, out);
+    }
+}
+
+template <std::size_t FixedLen>
+inline void ripemd160_8(const std::uint8_t* const msgs[8], const std::size_t lens[8], std::uint8_t out[8][20]) {
+    if constexpr (FixedLen != 0 && FixedLen < 56) {
+        // Single constant-padded block: the message goes straight into the context buffers.
+        RIPEMD160_MULTI_CTX ctx;
+        ripemd160_multi_init(&ctx);
+        for (int lane = 0; lane < 8; ++lane) {
+            std::memcpy(ctx.buffer[lane], msgs[lane], FixedLen);
+            ctx.buffer_len[lane] = FixedLen;
+        }
+        ripemd160_multi_final(&ctx, out);
+    } else {
+        ripemd160_multi_hash_lanes(msgs, lens, out);
+    }
+}
+
+template <class Algo, std::size_t FixedLen>
+inline void hash_8(const std::uint8_t* const msgs[8], const std::size_t lens[8],
+                   std::uint8_t out[8][Algo::digest_size]) {
+    if constexpr (std::is_same_v<Algo, Sha256>) {
+        sha256_8<FixedLen>(msgs, lens, out);
+    } else if constexpr (std::is_same_v<Algo, Ripemd160>) {
+        ripemd160_8<FixedLen>(msgs, lens, out);
+    } else {
+        static_assert(std::is_same_v<Algo, Hash160>, "Algo must be Sha256, Ripemd160 or Hash160");
+        std::uint8_t sha_out[8][32];
+        const std::uint8_t* sha_ptrs[8];
+        const std::size_t sha_lens[8] = {32, 32, 32, 32, 32, 32, 32, 32};
+        sha256_8<FixedLen>(msgs, lens, sha_out);
+        for (int lane = 0; lane < 8; ++lane) sha_ptrs[lane] = sha_out[lane];
+        ripemd160_8<32>(sha_ptrs, sha_lens, out);
+    }
+}
+
+} // namespace detail
+
+// --- One-shot batch hasher ---
+template <class Algo, std::size_t Lanes = 8, std::size_t FixedLen = 0>
+class Hasher {
+    static_assert(Lanes > 0 && Lanes % 8 == 0, "Lanes must be a multiple of 8");
+
+public:
+    static constexpr std::size_t digest_size = Algo::digest_size;
+    static constexpr std::size_t lanes = Lanes;
+    static constexpr std::size_t fixed_length = FixedLen;
+    using digest_type = Digest<digest_size>;
+    using message_type = std::conditional_t<FixedLen == 0, std::span<const std::uint8_t>,
+                                            std::array<std::uint8_t, FixedLen>>;
+
+    // Hashes exactly Lanes messages.
+    void operator()(std::span<const message_type, Lanes> in, std::span<digest_type, Lanes> out) const {
+        for (std::size_t base = 0; base < Lanes; base += 8) hash_group(in.data() + base, 8, out.data() + base);
+    }
+
+    // Hashes any number of messages; the last group is padded with repeats of its first message.
+    void hash_batch(std::span<const message_type> in, std::span<digest_type> out) const {
+        if (out.size() < in.size()) throw std::length_error("avx_hash::Hasher: output span is too small");
+        for (std::size_t base = 0; base < in.size(); base += 8) {
+            std::size_t n = in.size() - base < 8 ? in.size() - base : 8;
+            hash_group(in.data() + base, n, out.data() + base);
+        }
+    }
+
+private:
+    static void hash_group(const message_type* in, std::size_t n, digest_type* out) {
+        const std::uint8_t* ptrs[8];
+        std::size_t lens[8];
+        for (std::size_t lane = 0; lane < 8; ++lane) {
+            const message_type& m = in[lane < n ? lane : 0];
+            ptrs[lane] = m.data();
+            lens[lane] = m.size();
+        }
+        std::uint8_t result[8][digest_size];
+        detail::hash_8<Algo, FixedLen>(ptrs, lens, result);
+        for (std::size_t lane = 0; lane < n; ++lane) std::memcpy(out[lane].data(), result[lane], digest_size);
+    }
+};
+
+} // namespace avx_hash
+
+#endif // SHA256_AVX_HPP
@@ -0,0 +1,143 @@
+// sha256_avx_hpp_test.cpp
+// gcc -O3 -mavx2 -march=native -c sha256_avx.c ripemd160_avx.c && g++ -std=c++20 -O3 -mavx2 -march=native sha256_avx_hpp_test.cpp sha256_avx.o ripemd160_avx.o -o sha256_avx_hpp_test
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sha256_avx.hpp"
+
+using namespace avx_hash;
+
+template <std::size_t N>
+static std::string to_hex(const Digest<N>& d) {
+    std::string s;
+    char buf[3];
+    for (auto b : d) {
+        std::snprintf(buf, sizeof(buf), "%02x", b);
+        s += buf;
+    }
+    return s;
+}
+
+static int check(const char* name, const std::string& got, const char* expected) {
+    bool ok = got == expected;
+    std::printf("  %-42s %s %s\n", name, got.c_str(), ok ? "OK" : "FAIL");
+    if (!ok) std::printf("  %-42s %s (expected)\n", "", expected);
+    return ok ? 0 : 1;
+}
+
+static std::array<std::uint8_t, 33> hex33(const char* hex) {
+    std::array<std::uint8_t, 33> out{};
+    for (std::size_t i = 0; i < out.size(); ++i) std::sscanf(hex + 2 * i, "%2hhx", &out[i]);
+    return out;
+}
+
+// Fixed-length SHA-256 around the padding boundaries, lane by lane against the variable-length path.
+template <std::size_t N>
+static int check_fixed_sha256() {
+    std::array<std::array<std::uint8_t, N>, 8> fixed;
+    std::array<std::span<const std::uint8_t>, 8> spans;
+    for (std::size_t lane = 0; lane < 8; ++lane) {
+        for (std::size_t i = 0; i < N; ++i) fixed[lane][i] = static_cast<std::uint8_t>(lane * 31 + i);
+        spans[lane] = {fixed[lane].data(), N};
+    }
+    std::array<Digest<32>, 8> got, want;
+    Hasher<Sha256, 8, N>()(fixed, got);
+    Hasher<Sha256>()(spans, want);
+    std::size_t lane = 0;
+    while (lane < 7 && got[lane] == want[lane]) ++lane;
+    std::string name = "Sha256<FixedLen=" + std::to_string(N) + "> lane " + std::to_string(lane);
+    return check(name.c_str(), to_hex(got[lane]), to_hex(want[lane]).c_str());
+}
+
+template <std::size_t... N>
+static int check_fixed_sha256_lengths(std::index_sequence<N...>) {
+    return (check_fixed_sha256<N + 55>() + ...);
+}
+
+int main() {
+    std::printf("--- Correctness Test (C++ Header-Only Wrapper) ---\n");
+    int failed = 0;
+
+    // Generic SHA-256 with messages of different lengths in one batch.
+    const std::string texts[8] = {"", "abc", "a", "hello world", "1234567890", "SHA256 AVX2 Test",
+                                  std::string(100, 'x'), "https://github.com/8891689"};
+    std::array<std::span<const std::uint8_t>, 8> msgs;
+    for (int i = 0; i < 8; ++i) msgs[i] = {reinterpret_cast<const std::uint8_t*>(texts[i].data()), texts[i].size()};
+    std::array<Digest<32>, 8> sha_out;
+    Hasher<Sha256> sha;
+    sha(msgs, sha_out);
+    failed += check("Sha256(\"\")", to_hex(sha_out[0]), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    failed += check("Sha256(\"abc\")", to_hex(sha_out[1]), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    failed += check("Sha256(\"https://github.com/8891689\")", to_hex(sha_out[7]), "73f9f4d7581f581a8be499fd002160182f4953ab0a736494540161395fb94e81");
+
+    // Generic RIPEMD-160, including a lane that needs two blocks.
+    std::array<Digest<20>, 8> rmd_out;
+    Hasher<Ripemd160> rmd;
+    rmd(msgs, rmd_out);
+    failed += check("Ripemd160(\"\")", to_hex(rmd_out[0]), "9c1185a5c5e9fc54612808977ee8f548b2258d31");
+    failed += check("Ripemd160(\"abc\")", to_hex(rmd_out[1]), "8eb208f7e05d987a9b044a8e98c6b087f15a0bfc");
+
+    // Fixed-length HASH160 of the generator point, compressed (33 bytes) and uncompressed (65 bytes).
+    std::array<std::array<std::uint8_t, 33>, 8> comp;
+    comp.fill(hex33("0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"));
+    std::array<Digest<20>, 8> h160;
+    Hasher<Hash160, 8, 33> h160_comp;
+    h160_comp(comp, h160);
+    failed += check("Hash160<FixedLen=33>(G)", to_hex(h160[7]), "751e76e8199196d454941c45d1b3a323f1433bd6");
+
+    std::array<std::array<std::uint8_t, 65>, 8> uncomp;
+    const char* g_uncomp = "0479be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+                           "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8";
+    for (auto& k : uncomp)
+        for (std::size_t i = 0; i < k.size(); ++i) std::sscanf(g_uncomp + 2 * i, "%2hhx", &k[i]);
+    Hasher<Hash160, 8, 65> h160_uncomp;
+    h160_uncomp(uncomp, h160);
+    failed += check("Hash160<FixedLen=65>(G)", to_hex(h160[0]), "91b24bf9f5288532960ac687abb035127b1d28a5");
+
+    // Every fixed length whose padding straddles a block boundary.
+    failed += check_fixed_sha256_lengths(std::make_index_sequence<10>());
+    failed += check_fixed_sha256<119>();
+    failed += check_fixed_sha256<120>();
+
+    // Batch with a partial last group and Lanes = 16.
+    std::vector<std::array<std::uint8_t, 33>> keys(13, comp[0]);
+    std::vector<Digest<20>> key_out(keys.size());
+    Hasher<Hash160, 16, 33>().hash_batch(keys, key_out);
+    failed += check("Hash160<Lanes=16,FixedLen=33> batch[12]", to_hex(key_out[12]), "751e76e8199196d454941c45d1b3a323f1433bd6");
+
+    // Streaming state object (no heap allocation, copyable value type).
+    alignas(64) std::array<Block64, 8> blocks;
+    for (auto& b : blocks) prepare_test_data_block(b.data(), "abc", 3);
+    Sha256Avx8 stream;
+    Sha256Avx8 copy = stream;
+    copy.update(blocks);
+    copy.digests(sha_out);
+    failed += check("Sha256Avx8 stream(\"abc\")", to_hex(sha_out[3]), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+    std::printf("--- Summary ---\n");
+    if (failed == 0) {
+        std::printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        std::printf("\x1b[31m%d checks failed.\x1b[0m\n\n", failed);
+    }
+
+    // --- Performance Testing ---
+    std::printf("--- Performance Benchmark (Hash160<Sha256-fixed 33 -> Ripemd160-fixed 32>) ---\n");
+    const long long NUM_ITERATIONS = 1000000;
+    std::clock_t start = std::clock();
+    for (long long i = 0; i < NUM_ITERATIONS; ++i) {
+        comp[0][1] = static_cast<std::uint8_t>(i);
+        h160_comp(comp, h160);
+    }
+    std::clock_t end = std::clock();
+    double total_time = static_cast<double>(end - start) / CLOCKS_PER_SEC;
+    std::printf("Total HASH160s: %lld\n", NUM_ITERATIONS * 8);
+    std::printf("Total time: %.4f seconds\n", total_time);
+    std::printf("Performance: %.2f Million HASH160s/sec\n", NUM_ITERATIONS * 8 / total_time / 1e6);
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+/* sha256_avx_soa.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+// Low-level SoA interface to the 8-lane SHA-256 kernel, for modules that chain hashes in registers.
+// A state is 8 vectors (word i of all 8 lanes in state[i]); a block schedule is 16 vectors of
+// big-endian message words, laid out the same way.
+
+#ifndef SHA256_AVX_SOA_H
+#define SHA256_AVX_SOA_H
+
+#include <immintrin.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Sets all 8 lanes to the SHA-256 IV.
+void sha256_avx8_soa_init(__m256i state[8]);
+
+// Loads one 64-byte block per lane (unaligned pointers), byte-swaps and transposes it into schedule words.
+void sha256_avx8_soa_load(__m256i w[16], const uint8_t* const blocks[8]);
+
+// Loads one 32-byte digest per lane (unaligned pointers) as 8 big-endian words, the SoA form of a state.
+void sha256_avx8_soa_load_digests(__m256i words[8], const uint8_t* const digests[8]);
+
+// One compression of the 16 schedule words into the state.
+void sha256_avx8_soa_transform(__m256i state[8], const __m256i w[16]);
+
+// Runs the first `rounds` rounds (at most 16) of a compression of w from state and leaves the working
+// registers a..h in `working`, without the final addition. When the leading message words are the same
+// in every lane, this part can be computed once and reused for many blocks (see below).
+void sha256_avx8_soa_rounds_head(__m256i working[8], const __m256i state[8], const __m256i w[16], int rounds);
+
+// Finishes such a compression: rounds first_round..63 of w starting from `working`, added into state.
+void sha256_avx8_soa_transform_from(__m256i state[8], const __m256i working[8], const __m256i w[16], int first_round);
+
+// Compresses the constant padding block that terminates a 64-byte message.
+void sha256_avx8_soa_finish_64(__m256i state[8]);
+
+// Builds the padded single block of a 32-byte message whose words are a digest in SoA form.
+void sha256_avx8_soa_digest_block(__m256i w[16], const __m256i digest[8]);
+
+// Transposes the state and writes 8 big-endian digests.
+void sha256_avx8_soa_store(const __m256i state[8], uint8_t hashes_out[8][32]);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // SHA256_AVX_SOA_H
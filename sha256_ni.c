@@ -0,0 +1,163 @@
+/* sha256_ni.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "sha256_ni.h"
+#include <immintrin.h>
+#include <cpuid.h>
+#include <string.h>
+
+#define SHA_NI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+
+static const uint32_t k_const[64] __attribute__((aligned(64))) = {
+    0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
+    0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,
+    0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,
+    0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967,
+    0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85,
+    0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,0xd192e819,0xd6990624,0xf40e3585,0x106aa070,
+    0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3,
+    0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
+};
+
+static const uint32_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+bool sha256_ni_available(void) {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+    return (ebx >> 29) & 1;
+}
+
+// State in the ABEF/CDGH register form used by sha256rnds2.
+typedef struct {
+    __m128i abef;
+    __m128i cdgh;
+} NiState;
+
+SHA_NI_TARGET static inline NiState ni_state_load(const uint32_t state[8]) {
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xB1); // CDAB
+    __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1B); // EFGH
+    NiState s;
+    s.abef = _mm_alignr_epi8(tmp, efgh, 8);    // ABEF
+    s.cdgh = _mm_blend_epi16(efgh, tmp, 0xF0); // CDGH
+    return s;
+}
+
+SHA_NI_TARGET static inline void ni_state_store(NiState s, uint8_t out[32]) {
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i tmp = _mm_shuffle_epi32(s.abef, 0x1B);       // FEBA
+    __m128i dchg = _mm_shuffle_epi32(s.cdgh, 0xB1);      // DCHG
+    __m128i abcd = _mm_blend_epi16(tmp, dchg, 0xF0);     // DCBA
+    __m128i efgh = _mm_alignr_epi8(dchg, tmp, 8);        // HGFE
+    _mm_storeu_si128((__m128i*)out, _mm_shuffle_epi8(abcd, bswap));
+    _mm_storeu_si128((__m128i*)(out + 16), _mm_shuffle_epi8(efgh, bswap));
+}
+
+// One group of four rounds (quad q of 16) plus the message schedule work that overlaps it.
+#define NI_QUAD(s, m, q) do {                                                                             \
+    __m128i msg_ = _mm_add_epi32(m[(q) & 3], _mm_load_si128((const __m128i*)&k_const[4 * (q)]));          \
+    s.cdgh = _mm_sha256rnds2_epu32(s.cdgh, s.abef, msg_);                                                 \
+    if ((q) >= 3 && (q) <= 14) {                                                                          \
+        __m128i tmp_ = _mm_alignr_epi8(m[(q) & 3], m[((q) - 1) & 3], 4);                                  \
+        m[((q) + 1) & 3] = _mm_sha256msg2_epu32(_mm_add_epi32(m[((q) + 1) & 3], tmp_), m[(q) & 3]);      \
+    }                                                                                                     \
+    s.abef = _mm_sha256rnds2_epu32(s.abef, s.cdgh, _mm_shuffle_epi32(msg_, 0x0E));                       \
+    if ((q) >= 1 && (q) <= 12) m[((q) - 1) & 3] = _mm_sha256msg1_epu32(m[((q) - 1) & 3], m[(q) & 3]);   \
+} while (0)
+
+SHA_NI_TARGET static inline void ni_load_block(__m128i m[4], const uint8_t* block) {
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    for (int i = 0; i < 4; i++) m[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(block + 16 * i)), bswap);
+}
+
+SHA_NI_TARGET static void ni_compress(NiState* state, const uint8_t* block) {
+    NiState s = *state;
+    __m128i m[4];
+    ni_load_block(m, block);
+    NI_QUAD(s, m, 0);  NI_QUAD(s, m, 1);  NI_QUAD(s, m, 2);  NI_QUAD(s, m, 3);
+    NI_QUAD(s, m, 4);  NI_QUAD(s, m, 5);  NI_QUAD(s, m, 6);  NI_QUAD(s, m, 7);
+    NI_QUAD(s, m, 8);  NI_QUAD(s, m, 9);  NI_QUAD(s, m, 10); NI_QUAD(s, m, 11);
+    NI_QUAD(s, m, 12); NI_QUAD(s, m, 13); NI_QUAD(s, m, 14); NI_QUAD(s, m, 15);
+    state->abef = _mm_add_epi32(state->abef, s.abef);
+    state->cdgh = _mm_add_epi32(state->cdgh, s.cdgh);
+}
+
+SHA_NI_TARGET static void ni_compress_x2(NiState* state_a, const uint8_t* block_a, NiState* state_b, const uint8_t* block_b) {
+    NiState a = *state_a, b = *state_b;
+    __m128i ma[4], mb[4];
+    ni_load_block(ma, block_a);
+    ni_load_block(mb, block_b);
+#define NI_QUAD_X2(q) NI_QUAD(a, ma, q); NI_QUAD(b, mb, q)
+    NI_QUAD_X2(0);  NI_QUAD_X2(1);  NI_QUAD_X2(2);  NI_QUAD_X2(3);
+    NI_QUAD_X2(4);  NI_QUAD_X2(5);  NI_QUAD_X2(6);  NI_QUAD_X2(7);
+    NI_QUAD_X2(8);  NI_QUAD_X2(9);  NI_QUAD_X2(10); NI_QUAD_X2(11);
+    NI_QUAD_X2(12); NI_QUAD_X2(13); NI_QUAD_X2(14); NI_QUAD_X2(15);
+#undef NI_QUAD_X2
+    state_a->abef = _mm_add_epi32(state_a->abef, a.abef);
+    state_a->cdgh = _mm_add_epi32(state_a->cdgh, a.cdgh);
+    state_b->abef = _mm_add_epi32(state_b->abef, b.abef);
+    state_b->cdgh = _mm_add_epi32(state_b->cdgh, b.cdgh);
+}
+
+// Message cursor: full blocks come from the message, the last one or two are padded into `tail`.
+typedef struct {
+    const uint8_t* message;
+    size_t full_blocks;
+    size_t total_blocks;
+    uint8_t tail[128];
+} NiMessage;
+
+static void ni_message_init(NiMessage* m, const uint8_t* message, size_t length) {
+    m->message = message;
+    m->full_blocks = length / 64;
+    size_t rem = length % 64;
+    size_t tail_blocks = rem < 56 ? 1 : 2;
+    m->total_blocks = m->full_blocks + tail_blocks;
+    memset(m->tail, 0, sizeof(m->tail));
+    if (rem) memcpy(m->tail, message + m->full_blocks * 64, rem);
+    m->tail[rem] = 0x80;
+    uint64_t bit_length = __builtin_bswap64((uint64_t)length * 8);
+    memcpy(m->tail + tail_blocks * 64 - 8, &bit_length, 8);
+}
+
+static inline const uint8_t* ni_message_block(const NiMessage* m, size_t i) {
+    return i < m->full_blocks ? m->message + i * 64 : m->tail + (i - m->full_blocks) * 64;
+}
+
+SHA_NI_TARGET void sha256_ni_hash(const uint8_t* message, size_t length, uint8_t hash_out[32]) {
+    NiMessage m;
+    ni_message_init(&m, message, length);
+    NiState s = ni_state_load(sha256_iv);
+    for (size_t i = 0; i < m.total_blocks; i++) ni_compress(&s, ni_message_block(&m, i));
+    ni_state_store(s, hash_out);
+}
+
+SHA_NI_TARGET void sha256_ni_hash_x2(const uint8_t* message_a, size_t length_a, const uint8_t* message_b, size_t length_b,
+                                     uint8_t hash_a[32], uint8_t hash_b[32]) {
+    NiMessage ma, mb;
+    ni_message_init(&ma, message_a, length_a);
+    ni_message_init(&mb, message_b, length_b);
+    NiState sa = ni_state_load(sha256_iv), sb = sa;
+    size_t common = ma.total_blocks < mb.total_blocks ? ma.total_blocks : mb.total_blocks;
+    size_t i = 0;
+    for (; i < common; i++) ni_compress_x2(&sa, ni_message_block(&ma, i), &sb, ni_message_block(&mb, i));
+    for (size_t j = i; j < ma.total_blocks; j++) ni_compress(&sa, ni_message_block(&ma, j));
+    for (size_t j = i; j < mb.total_blocks; j++) ni_compress(&sb, ni_message_block(&mb, j));
+    ni_state_store(sa, hash_a);
+    ni_state_store(sb, hash_b);
+}
@@ -0,0 +1,54 @@
+/* sha256_ni.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef SHA256_NI_H
+#define SHA256_NI_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Single-stream SHA-256 on the x86 SHA extensions (SHA-NI). The kernels are compiled with a target
+// attribute, so this file builds without -msha; callers must check sha256_ni_available() first.
+
+/**
+* @brief Returns true when the CPU supports the SHA extensions (CPUID.7.0:EBX[29]).
+*/
+bool sha256_ni_available(void);
+
+/**
+* @brief One-shot SHA-256 of one message.
+*/
+void sha256_ni_hash(const uint8_t* message, size_t length, uint8_t hash_out[32]);
+
+/**
+* @brief One-shot SHA-256 of two messages, with the rounds of both streams interleaved to hide the
+* latency of the sha256rnds2 dependency chain.
+*/
+void sha256_ni_hash_x2(const uint8_t* message_a, size_t length_a, const uint8_t* message_b, size_t length_b,
+                       uint8_t hash_a[32], uint8_t hash_b[32]);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // SHA256_NI_H
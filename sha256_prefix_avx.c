@@ -0,0 +1,150 @@
+/* sha256_prefix_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "sha256_prefix_avx.h"
+#include "sha256_avx.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdalign.h>
+
+// Lanes whose tail || suffix fits here are assembled on the stack; longer ones go to the heap.
+#define PREFIX_STACK_LANE_BYTES 256
+
+static const uint32_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+// Midstates after compressing SHA256(tag) || SHA256(tag); order follows Sha256Tag.
+static const Sha256Prefix builtin_tags[SHA256_TAG_COUNT] = {
+    { {0x9cecba11, 0x23925381, 0x11679112, 0xd1627e0f, 0x97c87550, 0x003cc765, 0x90f61164, 0x33e9b66a}, 64, {0}, 0 }, // BIP0340/challenge
+    { {0x24dd3219, 0x4eba7e70, 0xca0fabb9, 0x0fa3166d, 0x3afbe4b1, 0x4c44df97, 0x4aac2739, 0x249e850a}, 64, {0}, 0 }, // BIP0340/aux
+    { {0x46615b35, 0xf4bfbff7, 0x9f8dc671, 0x83627ab3, 0x60217180, 0x57358661, 0x21a29e54, 0x68b07b4c}, 64, {0}, 0 }, // BIP0340/nonce
+    { {0x9ce0e4e6, 0x7c116c39, 0x38b3caf2, 0xc30f5089, 0xd3f3936c, 0x47636e60, 0x7db33eea, 0xddc6f0c9}, 64, {0}, 0 }, // TapLeaf
+    { {0x23a865a9, 0xb8a40da7, 0x977c1e04, 0xc49e246f, 0xb5be1376, 0x9d24c9b7, 0xb583b5d4, 0xa8d226d2}, 64, {0}, 0 }, // TapBranch
+    { {0xd129a2f3, 0x701c655d, 0x6583b6c3, 0xb9419727, 0x95f4e232, 0x94fd54f4, 0xa2ae8d85, 0x47ca590b}, 64, {0}, 0 }, // TapTweak
+    { {0xf504a425, 0xd7f8783b, 0x1363868a, 0xe3e55658, 0x6eee945d, 0xbc7888dd, 0x02a6e2c3, 0x1873fe9f}, 64, {0}, 0 }, // TapSighash
+};
+
+void sha256_prefix_init(Sha256Prefix* prefix) {
+    if (!prefix) return;
+    memset(prefix, 0, sizeof(*prefix));
+    memcpy(prefix->state, sha256_iv, sizeof(sha256_iv));
+}
+
+void sha256_prefix_append(Sha256Prefix* prefix, const uint8_t* data, size_t len) {
+    if (!prefix || (!data && len)) return;
+    while (len > 0) {
+        size_t take = 64 - prefix->tail_len;
+        if (take > len) take = len;
+        memcpy(prefix->tail + prefix->tail_len, data, take);
+        prefix->tail_len += take;
+        data += take;
+        len -= take;
+
+        if (prefix->tail_len == 64) {
+            // Registration is a one-off, so a single used lane of the 8-way compressor is fine here.
+            uint32_t states[8][8];
+            uint8_t blocks[8][64];
+            memset(states, 0, sizeof(states));
+            memset(blocks, 0, sizeof(blocks));
+            memcpy(states[0], prefix->state, sizeof(prefix->state));
+            memcpy(blocks[0], prefix->tail, 64);
+            sha256_avx8_compress_states(states, (const uint8_t (*)[64])blocks);
+            memcpy(prefix->state, states[0], sizeof(prefix->state));
+            prefix->absorbed_bytes += 64;
+            prefix->tail_len = 0;
+        }
+    }
+}
+
+void sha256_prefix_init_tagged(Sha256Prefix* prefix, const char* tag, size_t tag_len) {
+    if (!prefix || (!tag && tag_len)) return;
+    const uint8_t* msgs[8];
+    size_t lens[8] = {0};
+    alignas(32) uint8_t digests[8][32];
+    for (int i = 0; i < 8; i++) msgs[i] = (const uint8_t*)tag;
+    lens[0] = tag_len;
+    sha256_avx8_hash_lanes(NULL, 0, msgs, lens, digests);
+
+    sha256_prefix_init(prefix);
+    sha256_prefix_append(prefix, digests[0], 32);
+    sha256_prefix_append(prefix, digests[0], 32);
+}
+
+const Sha256Prefix* sha256_prefix_builtin(Sha256Tag tag) {
+    if ((int)tag < 0 || tag >= SHA256_TAG_COUNT) return NULL;
+    return &builtin_tags[tag];
+}
+
+int sha256_prefix_hash_8(const Sha256Prefix* prefix, const uint8_t* const suffixes[8], const size_t lengths[8], uint8_t hashes_out[8][32]) {
+    if (!prefix || !suffixes || !lengths || !hashes_out) return -1;
+
+    if (prefix->tail_len == 0) {
+        sha256_avx8_hash_lanes(prefix->state, prefix->absorbed_bytes, suffixes, lengths, hashes_out);
+        return 0;
+    }
+
+    // Leftover prefix bytes go in front of every suffix.
+    uint8_t stack_buf[8][PREFIX_STACK_LANE_BYTES];
+    uint8_t* heap_buf[8] = {NULL};
+    const uint8_t* msgs[8];
+    size_t lens[8];
+    int rc = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        size_t total = prefix->tail_len + lengths[lane];
+        uint8_t* buf = stack_buf[lane];
+        if (total > PREFIX_STACK_LANE_BYTES) {
+            buf = heap_buf[lane] = (uint8_t*)malloc(total);
+            if (!buf) { rc = -1; goto cleanup; }
+        }
+        memcpy(buf, prefix->tail, prefix->tail_len);
+        if (lengths[lane]) memcpy(buf + prefix->tail_len, suffixes[lane], lengths[lane]);
+        msgs[lane] = buf;
+        lens[lane] = total;
+    }
+    sha256_avx8_hash_lanes(prefix->state, prefix->absorbed_bytes, msgs, lens, hashes_out);
+
+cleanup:
+    for (int lane = 0; lane < 8; lane++) free(heap_buf[lane]);
+    return rc;
+}
+
+int sha256_prefix_hash_batch(const Sha256Prefix* prefix, const uint8_t* const* suffixes, const size_t* lengths,
+                             size_t count, uint8_t (*hashes_out)[32]) {
+    if (!prefix || !suffixes || !lengths || !hashes_out) return -1;
+    for (size_t base = 0; base < count; base += 8) {
+        size_t n = count - base < 8 ? count - base : 8;
+        const uint8_t* lane_suffixes[8];
+        size_t lane_lens[8];
+        alignas(32) uint8_t lane_out[8][32];
+        for (size_t i = 0; i < 8; i++) {
+            // Spare lanes repeat the first suffix of the batch; their digests are dropped.
+            size_t src = base + (i < n ? i : 0);
+            lane_suffixes[i] = suffixes[src];
+            lane_lens[i] = lengths[src];
+        }
+        if (sha256_prefix_hash_8(prefix, lane_suffixes, lane_lens, lane_out) != 0) return -1;
+        memcpy(hashes_out[base], lane_out, n * 32);
+    }
+    return 0;
+}
+
+int sha256_tagged_hash_8(Sha256Tag tag, const uint8_t* const messages[8], const size_t lengths[8], uint8_t hashes_out[8][32]) {
+    const Sha256Prefix* prefix = sha256_prefix_builtin(tag);
+    if (!prefix) return -1;
+    return sha256_prefix_hash_8(prefix, messages, lengths, hashes_out);
+}
@@ -0,0 +1,96 @@
+/* sha256_prefix_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef SHA256_PREFIX_AVX_H
+#define SHA256_PREFIX_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A registered common prefix: the midstate after its full 64-byte blocks plus the leftover bytes.
+typedef struct {
+    uint32_t state[8];        // chaining state after absorbed_bytes
+    uint64_t absorbed_bytes;  // bytes already compressed into state (multiple of 64)
+    uint8_t tail[64];         // prefix bytes not yet forming a full block
+    size_t tail_len;
+} Sha256Prefix;
+
+// Built-in BIP340/BIP341 tags. Their midstates (after SHA256(tag) || SHA256(tag)) are precomputed constants.
+typedef enum {
+    SHA256_TAG_BIP340_CHALLENGE = 0,
+    SHA256_TAG_BIP340_AUX,
+    SHA256_TAG_BIP340_NONCE,
+    SHA256_TAG_TAPLEAF,
+    SHA256_TAG_TAPBRANCH,
+    SHA256_TAG_TAPTWEAK,
+    SHA256_TAG_TAPSIGHASH,
+    SHA256_TAG_COUNT
+} Sha256Tag;
+
+/**
+* @brief Initializes an empty prefix (plain SHA-256).
+*/
+void sha256_prefix_init(Sha256Prefix* prefix);
+
+/**
+* @brief Appends bytes to a prefix, compressing every completed 64-byte block into the midstate.
+*/
+void sha256_prefix_append(Sha256Prefix* prefix, const uint8_t* data, size_t len);
+
+/**
+* @brief Registers a BIP340 tagged-hash prefix SHA256(tag) || SHA256(tag) for an arbitrary tag.
+*/
+void sha256_prefix_init_tagged(Sha256Prefix* prefix, const char* tag, size_t tag_len);
+
+/**
+* @brief Returns the cached prefix of a built-in tag, or NULL for an unknown tag.
+*/
+const Sha256Prefix* sha256_prefix_builtin(Sha256Tag tag);
+
+/**
+* @brief Hashes prefix || suffix[i] for 8 suffixes of independent lengths, starting every lane from the cached midstate.
+* @param prefix A prefix from sha256_prefix_init/append/init_tagged or sha256_prefix_builtin.
+* @param suffixes Eight suffix pointers.
+* @param lengths Eight suffix lengths (bytes).
+* @param hashes_out An output array to store the 8 32-byte hash results.
+* @return 0 on success, -1 on invalid arguments or allocation failure.
+*/
+int sha256_prefix_hash_8(const Sha256Prefix* prefix, const uint8_t* const suffixes[8], const size_t lengths[8], uint8_t hashes_out[8][32]);
+
+/**
+* @brief Hashes prefix || suffix[i] for any number of suffixes, 8 lanes at a time.
+* @return 0 on success, -1 on invalid arguments or allocation failure.
+*/
+int sha256_prefix_hash_batch(const Sha256Prefix* prefix, const uint8_t* const* suffixes, const size_t* lengths,
+                             size_t count, uint8_t (*hashes_out)[32]);
+
+/**
+* @brief BIP340 tagged hash of 8 messages with a built-in tag: SHA256(SHA256(tag) || SHA256(tag) || msg).
+* @return 0 on success, -1 on invalid arguments or allocation failure.
+*/
+int sha256_tagged_hash_8(Sha256Tag tag, const uint8_t* const messages[8], const size_t lengths[8], uint8_t hashes_out[8][32]);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // SHA256_PREFIX_AVX_H
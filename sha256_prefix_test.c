@@ -0,0 +1,129 @@
+/* sha256_prefix_test.c
+ * gcc -O3 -mavx2 -march=native sha256_prefix_test.c sha256_prefix_avx.c sha256_avx.c -o sha256_prefix_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdalign.h>
+
+#include "sha256_prefix_avx.h"
+
+static const size_t lane_lengths[8] = {0, 3, 32, 55, 56, 64, 100, 200};
+
+// SHA256(SHA256("TapLeaf") || SHA256("TapLeaf") || msg(len))
+static const char* expected_tapleaf[8] = {
+    "5212c288a377d1f8164962a5a13429f9ba6a7b84e59776a52c6637df2106facb",
+    "13378b5b99da9f32f50d06b3fe80e2999ffaf985e6df90f6235e723d248963ba",
+    "3ebd471740bf440ccdf2b3efd9ba58eb9ce7be45dc94af4ee8c8b9fd4f01b140",
+    "5c3fd5b79903de829c4fc9c36a5d97c8521ff247ece0d3942f60976c5940e51a",
+    "ab2a2151169ffe482802272789e037958539e6c73500251faabdd4d31e3a73c3",
+    "947a4111b5a8b06e8b4464cfd7aab5819dc8fad71171ffb4b9d38b1c1159c792",
+    "a4abf11f8957691d638030893b9b84469ba836eba99afd99399c039b39c47e5b",
+    "a38578077749df0c6cdc4e13150056a92b5d0473a701c0d68424d078df0a527c",
+};
+
+// SHA256(bytes 0..69 || msg(len)), a prefix that leaves a 6-byte tail after its midstate
+static const char* expected_prefix70[8] = {
+    "5767d69a906d4860db9079eb7e90ab4a543e5cb032fce846554aef6ceb600e1d",
+    "6ccc0a0cda104a3eb8e11706655d4cd3cb314ce30c454ac389c4220bea563723",
+    "fa38abbcfe2180fcd35aded7117e71bb60e751e500975c43d9ce88d3adc78672",
+    "f4c3629eb8c8ddbfc0078af8f761ef07afadd6e70cf6dd42f927d7b9d474965b",
+    "674e5c86829a01c9b675bd53d637aff9a94393c0daea98acaae21213a8a71b09",
+    "c30a66d098ef4e379e8bd1d61320ea4d6883ac834413c2e37d8681e6a6cefeab",
+    "4e03f5e3d070d04dca6bb20ef48621fadba4c34d7ff0a32c37b829c46d595078",
+    "550b84d36e2a3576d12ca60ce01113a564d8a018fceb023c6ba99605a2664cad",
+};
+
+static int check_lanes(const char* title, const uint8_t hashes[8][32], const char* const expected[8]) {
+    int failed = 0;
+    char hex[65];
+    printf("Test Case: %s\n", title);
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 32; j++) sprintf(hex + j * 2, "%02x", hashes[i][j]);
+        int ok = strcmp(hex, expected[i]) == 0;
+        printf("  Lane %d (len %3zu): %s %s\n", i, lane_lengths[i], hex, ok ? "OK" : "FAIL");
+        if (!ok) failed++;
+    }
+    printf("------------------------------------------\n");
+    return failed;
+}
+
+int main() {
+    printf("--- Correctness Test (Prefix Midstate Cache / Tagged Hashes) ---\n");
+
+    uint8_t messages[8][200];
+    const uint8_t* msg_ptrs[8];
+    for (int lane = 0; lane < 8; lane++) {
+        for (size_t i = 0; i < lane_lengths[lane]; i++) messages[lane][i] = (uint8_t)(i * 7 + lane_lengths[lane]);
+        msg_ptrs[lane] = messages[lane];
+    }
+
+    alignas(32) uint8_t hashes[8][32];
+    int failed = 0;
+
+    sha256_tagged_hash_8(SHA256_TAG_TAPLEAF, msg_ptrs, lane_lengths, hashes);
+    failed += check_lanes("Built-in tag \"TapLeaf\"", hashes, expected_tapleaf);
+
+    Sha256Prefix custom_tag;
+    sha256_prefix_init_tagged(&custom_tag, "TapLeaf", 7);
+    sha256_prefix_hash_8(&custom_tag, msg_ptrs, lane_lengths, hashes);
+    failed += check_lanes("Registered tag \"TapLeaf\" (must match the built-in)", hashes, expected_tapleaf);
+
+    // Every built-in tag: all lanes must match the same tag registered at run time, and lane 6 a known value.
+    static const struct { Sha256Tag tag; const char* name; const char* lane6; } tags[SHA256_TAG_COUNT] = {
+        {SHA256_TAG_BIP340_CHALLENGE, "BIP0340/challenge", "da4f01cbc718929c16a7c5f768969d2f2d5c02944cb1f6695aca1876cda93dba"},
+        {SHA256_TAG_BIP340_AUX, "BIP0340/aux", "85f3e5d25de69d46070ff9079f3d1771564fceb6eb9213cbd30ea7343109e5d5"},
+        {SHA256_TAG_BIP340_NONCE, "BIP0340/nonce", "86996165d4e5c6269fbf8d9b2a9633c4efcd736bc9402753691a4d1d140e0c88"},
+        {SHA256_TAG_TAPLEAF, "TapLeaf", "a4abf11f8957691d638030893b9b84469ba836eba99afd99399c039b39c47e5b"},
+        {SHA256_TAG_TAPBRANCH, "TapBranch", "8f22a151e11b082c8103fa9dbab5f976f725eb8b8078a8c254a3ad29a5041275"},
+        {SHA256_TAG_TAPTWEAK, "TapTweak", "181e23852187d9e0c927ece9368cb6ecbf5214a9c6b910248bad629da06c6e30"},
+        {SHA256_TAG_TAPSIGHASH, "TapSighash", "632220b4d1a01b8e012f8462afb6a0b87280f288693759123f1b22d9121d299b"},
+    };
+    printf("Test Case: Every built-in tag against the registered tag\n");
+    for (int t = 0; t < SHA256_TAG_COUNT; t++) {
+        alignas(32) uint8_t registered[8][32];
+        char hex[65];
+        sha256_tagged_hash_8(tags[t].tag, msg_ptrs, lane_lengths, hashes);
+        sha256_prefix_init_tagged(&custom_tag, tags[t].name, strlen(tags[t].name));
+        sha256_prefix_hash_8(&custom_tag, msg_ptrs, lane_lengths, registered);
+        for (int j = 0; j < 32; j++) sprintf(hex + j * 2, "%02x", hashes[6][j]);
+        int ok = memcmp(hashes, registered, sizeof(registered)) == 0 && strcmp(hex, tags[t].lane6) == 0;
+        printf("  %-17s lane 6: %s %s\n", tags[t].name, hex, ok ? "OK" : "FAIL");
+        if (!ok) failed++;
+    }
+    printf("------------------------------------------\n");
+
+    uint8_t prefix_bytes[70];
+    for (int i = 0; i < 70; i++) prefix_bytes[i] = (uint8_t)i;
+    Sha256Prefix prefix70;
+    sha256_prefix_init(&prefix70);
+    sha256_prefix_append(&prefix70, prefix_bytes, 30);
+    sha256_prefix_append(&prefix70, prefix_bytes + 30, 40);
+    sha256_prefix_hash_8(&prefix70, msg_ptrs, lane_lengths, hashes);
+    failed += check_lanes("70-byte prefix (64-byte midstate + 6-byte tail)", hashes, expected_prefix70);
+
+    printf("--- Summary ---\n");
+    if (failed == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d lane checks failed.\x1b[0m\n\n", failed);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (TapLeaf tagged hash of 32-byte messages) ---\n");
+    const long long NUM_ITERATIONS = 2000000;
+    const size_t lens32[8] = {32, 32, 32, 32, 32, 32, 32, 32};
+    clock_t start = clock();
+    for (long long i = 0; i < NUM_ITERATIONS; i++) {
+        messages[0][0] = (uint8_t)i;
+        sha256_tagged_hash_8(SHA256_TAG_TAPLEAF, msg_ptrs, lens32, hashes);
+    }
+    clock_t end = clock();
+    double total_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("Total tagged hashes: %lld\n", NUM_ITERATIONS * 8);
+    printf("Total time: %.4f seconds\n", total_time);
+    printf("Performance: %.2f Million Hashes/sec (1 compression each instead of 2)\n", NUM_ITERATIONS * 8 / total_time / 1e6);
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+/* sha256_single_test.c
+ * gcc -O3 -mavx2 -march=native sha256_single_test.c sha256_avx.c -o sha256_single_test -lcrypto
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <openssl/sha.h>
+
+#include "sha256_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+int main() {
+    printf("--- Correctness Test (Scalar Single-Message SHA-256) ---\n");
+    int failed_tests = 0;
+    srand(1);
+    const size_t BIG = 1 << 20;
+    uint8_t* data = (uint8_t*)malloc(BIG + 1);
+    for (size_t i = 0; i <= BIG; i++) data[i] = (uint8_t)rand();
+    uint8_t out[32], ref[32];
+
+    // Every length across the one/two padding-block boundary, from an unaligned start.
+    int bad = 0;
+    for (size_t len = 0; len <= 300; len++) {
+        sha256_hash_single(data + 1, len, out);
+        SHA256(data + 1, len, ref);
+        bad += memcmp(out, ref, 32) != 0;
+    }
+    failed_tests += report("sha256_hash_single, 0..300 bytes, matches OpenSSL", bad == 0);
+
+    sha256_hash_single(data, BIG, out);
+    SHA256(data, BIG, ref);
+    failed_tests += report("sha256_hash_single, 1 MiB, matches OpenSSL", memcmp(out, ref, 32) == 0);
+
+    sha256_hash_single(NULL, 0, out);
+    SHA256(NULL, 0, ref);
+    failed_tests += report("Empty message with a NULL pointer", memcmp(out, ref, 32) == 0);
+
+    // Output may alias the input (double SHA-256 in place, as in Base58Check).
+    memcpy(out, data, 32);
+    sha256_hash_single(out, 32, out);
+    SHA256(data, 32, ref);
+    failed_tests += report("In-place hash of a 32-byte digest", memcmp(out, ref, 32) == 0);
+
+    // A scalar midstate resumed by the 8-lane kernel gives the one-shot digest.
+    {
+        static const uint32_t iv[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+        uint32_t state[8];
+        memcpy(state, iv, sizeof(iv));
+        sha256_compress_single(state, data, 3);
+        const uint8_t* tails[8];
+        size_t lens[8];
+        uint8_t digests[8][32];
+        for (int lane = 0; lane < 8; lane++) {
+            tails[lane] = data + 192;
+            lens[lane] = (size_t)lane * 23;
+        }
+        sha256_avx8_hash_lanes(state, 192, tails, lens, digests);
+        int mid_bad = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            SHA256(data, 192 + lens[lane], ref);
+            mid_bad += memcmp(digests[lane], ref, 32) != 0;
+        }
+        failed_tests += report("sha256_compress_single midstate resumes in hash_lanes", mid_bad == 0);
+    }
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (One 78-byte message at a time) ---\n");
+    const long long NUM_ITERATIONS = 2000000;
+    const uint8_t* ptrs[8] = {data, data, data, data, data, data, data, data};
+    const size_t lens[8] = {78, 78, 78, 78, 78, 78, 78, 78};
+    uint8_t digests[8][32];
+    clock_t start = clock();
+    for (long long i = 0; i < NUM_ITERATIONS; i++) {
+        data[0] = (uint8_t)i;
+        sha256_hash_single(data, 78, out);
+    }
+    double scalar_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (long long i = 0; i < NUM_ITERATIONS; i++) {
+        data[0] = (uint8_t)i;
+        sha256_avx8_hash_lanes(NULL, 0, ptrs, lens, digests);
+    }
+    double lanes_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("sha256_hash_single:           %.4f seconds (%.2f Million hashes/sec)\n", scalar_time,
+           NUM_ITERATIONS / scalar_time / 1e6);
+    printf("hash_lanes, one useful lane:  %.4f seconds (%.2f Million hashes/sec)\n", lanes_time,
+           NUM_ITERATIONS / lanes_time / 1e6);
+
+    free(data);
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,341 @@
+/* sha512_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "sha512_avx.h"
+#include <immintrin.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdalign.h>
+#include <stdbool.h>
+
+#if defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__)
+#include <strings.h>
+#else
+static inline void explicit_bzero(void *s, size_t n) { volatile unsigned char *p = s; while (n--) *p++ = 0; }
+#endif
+
+// --- Internal structure definition ---
+typedef struct { alignas(64) __m256i state[8]; } SHA512_CTX_AVX4;
+struct Sha512Avx4_C_Handle { SHA512_CTX_AVX4 ctx; };
+_Static_assert(sizeof(struct Sha512Avx4_C_Handle) <= SHA512_AVX4_HANDLE_SIZE, "SHA512_AVX4_HANDLE_SIZE is too small");
+_Static_assert(_Alignof(struct Sha512Avx4_C_Handle) <= SHA512_AVX4_HANDLE_ALIGN, "SHA512_AVX4_HANDLE_ALIGN is too small");
+
+static const uint64_t sha512_iv[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+static const uint64_t k512_const[80] __attribute__((aligned(64))) = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+#define BSWAP64_MASK _mm256_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, \
+                                     8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7)
+#define ROR8_MASK _mm256_set_epi8(8, 15, 14, 13, 12, 11, 10, 9, 0, 7, 6, 5, 4, 3, 2, 1, \
+                                  8, 15, 14, 13, 12, 11, 10, 9, 0, 7, 6, 5, 4, 3, 2, 1)
+#define CH64(x, y, z)  _mm256_xor_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z))
+#define MAJ64(x, y, z) _mm256_xor_si256(_mm256_and_si256(x, y), _mm256_xor_si256(_mm256_and_si256(x, z), _mm256_and_si256(y, z)))
+#define ROR64(x, n) _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - n))
+#define SIGMA0_64(x) (_mm256_xor_si256(ROR64(x, 28), _mm256_xor_si256(ROR64(x, 34), ROR64(x, 39))))
+#define SIGMA1_64(x) (_mm256_xor_si256(ROR64(x, 14), _mm256_xor_si256(ROR64(x, 18), ROR64(x, 41))))
+// Rotating by 8 is a byte shuffle.
+#define sigma0_64(x) (_mm256_xor_si256(ROR64(x, 1),  _mm256_xor_si256(_mm256_shuffle_epi8(x, ROR8_MASK), _mm256_srli_epi64(x, 7))))
+#define sigma1_64(x) (_mm256_xor_si256(ROR64(x, 19), _mm256_xor_si256(ROR64(x, 61), _mm256_srli_epi64(x, 6))))
+
+#define SHA512_ROUND(a, b, c, d, e, f, g, h, kw) do {                                                             \
+    __m256i t1_ = _mm256_add_epi64(h, _mm256_add_epi64(SIGMA1_64(e), _mm256_add_epi64(CH64(e, f, g), kw)));      \
+    __m256i t2_ = _mm256_add_epi64(SIGMA0_64(a), MAJ64(a, b, c));                                                \
+    h = g; g = f; f = e; e = _mm256_add_epi64(d, t1_); d = c; c = b; b = a; a = _mm256_add_epi64(t1_, t2_);      \
+} while (0)
+
+// 4x4 transpose of 64-bit elements: row i (lane i's words) becomes column i.
+static inline void transpose4x4_epi64(__m256i *rows) {
+    __m256i t0 = _mm256_unpacklo_epi64(rows[0], rows[1]);
+    __m256i t1 = _mm256_unpackhi_epi64(rows[0], rows[1]);
+    __m256i t2 = _mm256_unpacklo_epi64(rows[2], rows[3]);
+    __m256i t3 = _mm256_unpackhi_epi64(rows[2], rows[3]);
+    rows[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+    rows[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+    rows[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+    rows[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+}
+
+static void internal_init_ctx(SHA512_CTX_AVX4 *ctx) {
+    for (int i = 0; i < 8; i++) ctx->state[i] = _mm256_set1_epi64x((long long)sha512_iv[i]);
+}
+
+// Loads one 128-byte block per lane and transposes it into 16 big-endian SoA schedule words.
+static inline void sha512_load_words_avx4(__m256i out[16], const uint8_t* const blocks[4]) {
+    const __m256i bswap_mask = BSWAP64_MASK;
+    for (int g = 0; g < 4; g++) {
+        for (int lane = 0; lane < 4; lane++) {
+            out[4 * g + lane] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(blocks[lane] + 32 * g)), bswap_mask);
+        }
+        transpose4x4_epi64(out + 4 * g);
+    }
+}
+
+// --- Message Extension ---: W[0..15] in SoA form -> W[16..79]
+static inline __attribute__((always_inline)) void sha512_expand_avx4(__m256i W[80]) {
+    for (int i = 16; i < 80; ++i) {
+        W[i] = _mm256_add_epi64(_mm256_add_epi64(sigma1_64(W[i-2]), W[i-7]), _mm256_add_epi64(sigma0_64(W[i-15]), W[i-16]));
+    }
+}
+
+static inline __attribute__((always_inline)) void sha512_compress_avx4(__m256i state[8], const __m256i W[80]) {
+    __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+    __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 80; i++) {
+        SHA512_ROUND(a, b, c, d, e, f, g, h, _mm256_add_epi64(_mm256_set1_epi64x((long long)k512_const[i]), W[i]));
+    }
+    state[0] = _mm256_add_epi64(state[0], a); state[1] = _mm256_add_epi64(state[1], b);
+    state[2] = _mm256_add_epi64(state[2], c); state[3] = _mm256_add_epi64(state[3], d);
+    state[4] = _mm256_add_epi64(state[4], e); state[5] = _mm256_add_epi64(state[5], f);
+    state[6] = _mm256_add_epi64(state[6], g); state[7] = _mm256_add_epi64(state[7], h);
+}
+
+// Two independent 4-lane batches with their rounds interleaved: each round's dependency chain is
+// long, so the second batch fills the pipeline while the first one waits.
+static inline __attribute__((always_inline)) void sha512_compress_x2_avx4(__m256i sa[8], const __m256i WA[80],
+                                                                         __m256i sb[8], const __m256i WB[80]) {
+    __m256i a0 = sa[0], b0 = sa[1], c0 = sa[2], d0 = sa[3], e0 = sa[4], f0 = sa[5], g0 = sa[6], h0 = sa[7];
+    __m256i a1 = sb[0], b1 = sb[1], c1 = sb[2], d1 = sb[3], e1 = sb[4], f1 = sb[5], g1 = sb[6], h1 = sb[7];
+    for (int i = 0; i < 80; i++) {
+        __m256i k = _mm256_set1_epi64x((long long)k512_const[i]);
+        SHA512_ROUND(a0, b0, c0, d0, e0, f0, g0, h0, _mm256_add_epi64(k, WA[i]));
+        SHA512_ROUND(a1, b1, c1, d1, e1, f1, g1, h1, _mm256_add_epi64(k, WB[i]));
+    }
+    sa[0] = _mm256_add_epi64(sa[0], a0); sa[1] = _mm256_add_epi64(sa[1], b0);
+    sa[2] = _mm256_add_epi64(sa[2], c0); sa[3] = _mm256_add_epi64(sa[3], d0);
+    sa[4] = _mm256_add_epi64(sa[4], e0); sa[5] = _mm256_add_epi64(sa[5], f0);
+    sa[6] = _mm256_add_epi64(sa[6], g0); sa[7] = _mm256_add_epi64(sa[7], h0);
+    sb[0] = _mm256_add_epi64(sb[0], a1); sb[1] = _mm256_add_epi64(sb[1], b1);
+    sb[2] = _mm256_add_epi64(sb[2], c1); sb[3] = _mm256_add_epi64(sb[3], d1);
+    sb[4] = _mm256_add_epi64(sb[4], e1); sb[5] = _mm256_add_epi64(sb[5], f1);
+    sb[6] = _mm256_add_epi64(sb[6], g1); sb[7] = _mm256_add_epi64(sb[7], h1);
+}
+
+// Writes the SoA state out as 4 big-endian digests.
+static void sha512_store_digests_avx4(const __m256i state[8], uint8_t hashes_out[4][64]) {
+    const __m256i bswap_mask = BSWAP64_MASK;
+    for (int g = 0; g < 2; g++) {
+        __m256i rows[4];
+        memcpy(rows, state + 4 * g, sizeof(rows));
+        transpose4x4_epi64(rows);
+        for (int lane = 0; lane < 4; lane++) {
+            _mm256_storeu_si256((__m256i*)(hashes_out[lane] + 32 * g), _mm256_shuffle_epi8(rows[lane], bswap_mask));
+        }
+    }
+}
+
+// Per-lane variable-length engine over `groups` (1 or 2) batches of 4 lanes, continuing from `state`
+// after prefix_len_bytes already absorbed. Full blocks are read in place; only tail blocks are staged.
+static inline __attribute__((always_inline)) void sha512_lanes_engine(__m256i state[][8], int groups, uint64_t prefix_len_bytes,
+                                                                     const uint8_t* const messages[], const size_t lengths[],
+                                                                     uint8_t hashes_out[][64]) {
+    const int lanes = 4 * groups;
+    size_t lane_blocks[8];
+    size_t max_blocks = 0;
+    for (int lane = 0; lane < lanes; lane++) {
+        lane_blocks[lane] = (lengths[lane] + 17 + 127) / 128;
+        if (lane_blocks[lane] > max_blocks) max_blocks = lane_blocks[lane];
+    }
+
+    alignas(64) uint8_t staging[8][128];
+    alignas(64) uint8_t digests[4][64];
+    alignas(64) __m256i W[2][80];
+    for (size_t b = 0; b < max_blocks; b++) {
+        const uint8_t* ptrs[8];
+        uint8_t finishing = 0;
+        for (int lane = 0; lane < lanes; lane++) {
+            size_t len = lengths[lane];
+            size_t offset = b * 128;
+            if (b >= lane_blocks[lane]) { // finished lane: hash anything and ignore it
+                ptrs[lane] = staging[lane];
+                continue;
+            }
+            if (offset + 128 <= len) {
+                ptrs[lane] = messages[lane] + offset;
+                continue;
+            }
+            // Tail block(s): remaining bytes, 0x80, zeros, and the 128-bit big-endian bit length in the last block.
+            memset(staging[lane], 0, 128);
+            size_t remaining = offset < len ? len - offset : 0;
+            if (remaining) memcpy(staging[lane], messages[lane] + offset, remaining);
+            if (offset <= len) staging[lane][remaining] = 0x80;
+            if (b == lane_blocks[lane] - 1) {
+                uint64_t bit_length = __builtin_bswap64((prefix_len_bytes + len) * 8);
+                memcpy(staging[lane] + 120, &bit_length, 8);
+                finishing |= (uint8_t)(1u << lane);
+            }
+            ptrs[lane] = staging[lane];
+        }
+
+        for (int g = 0; g < groups; g++) {
+            sha512_load_words_avx4(W[g], ptrs + 4 * g);
+            sha512_expand_avx4(W[g]);
+        }
+        if (groups == 2) sha512_compress_x2_avx4(state[0], W[0], state[1], W[1]);
+        else sha512_compress_avx4(state[0], W[0]);
+
+        for (int g = 0; g < groups; g++) {
+            uint8_t group_mask = (uint8_t)((finishing >> (4 * g)) & 0xf);
+            if (!group_mask) continue;
+            sha512_store_digests_avx4(state[g], digests);
+            for (int lane = 0; lane < 4; lane++) {
+                if (group_mask & (1u << lane)) memcpy(hashes_out[4 * g + lane], digests[lane], 64);
+            }
+        }
+    }
+}
+
+// --- Implementation of public interface functions ---
+Sha512Avx4_C_Handle* sha512_avx4_create() {
+    Sha512Avx4_C_Handle* handle = (Sha512Avx4_C_Handle*)aligned_alloc(64, sizeof(Sha512Avx4_C_Handle));
+    if (!handle) return NULL;
+    internal_init_ctx(&handle->ctx);
+    return handle;
+}
+void sha512_avx4_destroy(Sha512Avx4_C_Handle* handle) {
+    if (handle) {
+        explicit_bzero(handle, sizeof(Sha512Avx4_C_Handle));
+        free(handle);
+    }
+}
+Sha512Avx4_C_Handle* sha512_avx4_init_at(void* storage) {
+    if (!storage || ((uintptr_t)storage % SHA512_AVX4_HANDLE_ALIGN) != 0) return NULL;
+    Sha512Avx4_C_Handle* handle = (Sha512Avx4_C_Handle*)storage;
+    internal_init_ctx(&handle->ctx);
+    return handle;
+}
+void sha512_avx4_init(Sha512Avx4_C_Handle* handle) {
+    if (!handle) return;
+    internal_init_ctx(&handle->ctx);
+}
+void sha512_avx4_update_4_blocks(Sha512Avx4_C_Handle* handle, const uint8_t input_blocks[4][128]) {
+    if (!handle || !input_blocks) return;
+    const uint8_t* ptrs[4] = { input_blocks[0], input_blocks[1], input_blocks[2], input_blocks[3] };
+    alignas(64) __m256i W[80];
+    sha512_load_words_avx4(W, ptrs);
+    sha512_expand_avx4(W);
+    sha512_compress_avx4(handle->ctx.state, W);
+}
+void sha512_avx4_get_final_hashes(Sha512Avx4_C_Handle* handle, uint8_t hashes_out[4][64]) {
+    if (!handle || !hashes_out) return;
+    sha512_store_digests_avx4(handle->ctx.state, hashes_out);
+}
+
+void sha512_avx4_hash_lanes(const uint8_t* const messages[4], const size_t lengths[4], uint8_t hashes_out[4][64]) {
+    if (!messages || !lengths || !hashes_out) return;
+    SHA512_CTX_AVX4 ctx;
+    internal_init_ctx(&ctx);
+    sha512_lanes_engine(&ctx.state, 1, 0, messages, lengths, hashes_out);
+}
+
+void hmac_sha512_avx8(const uint8_t* const keys[8], const size_t key_lengths[8],
+                      const uint8_t* const messages[8], const size_t message_lengths[8], uint8_t macs_out[8][64]) {
+    if (!keys || !key_lengths || !messages || !message_lengths || !macs_out) return;
+
+    // Keys longer than the block size are replaced by their digest.
+    alignas(64) uint8_t hashed_keys[8][64];
+    const uint8_t* key_ptrs[8];
+    size_t key_lens[8];
+    bool any_long = false;
+    for (int lane = 0; lane < 8; lane++) {
+        key_ptrs[lane] = keys[lane];
+        key_lens[lane] = key_lengths[lane];
+        if (key_lens[lane] > 128) any_long = true;
+    }
+    alignas(64) __m256i state[2][8];
+    if (any_long) {
+        size_t lens[8];
+        for (int lane = 0; lane < 8; lane++) lens[lane] = key_lens[lane] > 128 ? key_lens[lane] : 0;
+        for (int g = 0; g < 2; g++)
+            for (int i = 0; i < 8; i++) state[g][i] = _mm256_set1_epi64x((long long)sha512_iv[i]);
+        sha512_lanes_engine(state, 2, 0, key_ptrs, lens, hashed_keys);
+        for (int lane = 0; lane < 8; lane++) {
+            if (key_lens[lane] > 128) {
+                key_ptrs[lane] = hashed_keys[lane];
+                key_lens[lane] = 64;
+            }
+        }
+    }
+
+    // Inner and outer pad states: two block compressions per batch, interleaved across the batches.
+    alignas(64) uint8_t ipad[8][128], opad[8][128];
+    const uint8_t* ipad_ptrs[8];
+    const uint8_t* opad_ptrs[8];
+    for (int lane = 0; lane < 8; lane++) {
+        memset(ipad[lane], 0x36, 128);
+        memset(opad[lane], 0x5c, 128);
+        for (size_t i = 0; i < key_lens[lane]; i++) {
+            ipad[lane][i] ^= key_ptrs[lane][i];
+            opad[lane][i] ^= key_ptrs[lane][i];
+        }
+        ipad_ptrs[lane] = ipad[lane];
+        opad_ptrs[lane] = opad[lane];
+    }
+    alignas(64) __m256i inner_state[2][8], outer_state[2][8];
+    alignas(64) __m256i W[2][80];
+    for (int g = 0; g < 2; g++) {
+        for (int i = 0; i < 8; i++) inner_state[g][i] = outer_state[g][i] = _mm256_set1_epi64x((long long)sha512_iv[i]);
+        sha512_load_words_avx4(W[g], ipad_ptrs + 4 * g);
+        sha512_expand_avx4(W[g]);
+    }
+    sha512_compress_x2_avx4(inner_state[0], W[0], inner_state[1], W[1]);
+    for (int g = 0; g < 2; g++) {
+        sha512_load_words_avx4(W[g], opad_ptrs + 4 * g);
+        sha512_expand_avx4(W[g]);
+    }
+    sha512_compress_x2_avx4(outer_state[0], W[0], outer_state[1], W[1]);
+
+    // Inner hash over the messages, then the outer hash over the 64-byte inner digests.
+    alignas(64) uint8_t inner[8][64];
+    const uint8_t* inner_ptrs[8];
+    size_t inner_lens[8];
+    sha512_lanes_engine(inner_state, 2, 128, messages, message_lengths, inner);
+    for (int lane = 0; lane < 8; lane++) {
+        inner_ptrs[lane] = inner[lane];
+        inner_lens[lane] = 64;
+    }
+    sha512_lanes_engine(outer_state, 2, 128, inner_ptrs, inner_lens, macs_out);
+
+    explicit_bzero(ipad, sizeof(ipad));
+    explicit_bzero(opad, sizeof(opad));
+    explicit_bzero(hashed_keys, sizeof(hashed_keys));
+    explicit_bzero(inner, sizeof(inner));
+}
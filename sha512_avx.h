@@ -0,0 +1,112 @@
+/* sha512_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef SHA512_AVX_H
+#define SHA512_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Compile-time check to ensure AVX2 is enabled
+#if !defined(__AVX2__)
+#error "This implementation requires AVX2 support. Please compile with -mavx2."
+#endif
+
+// --- C++ compatibility ---
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// SHA-512 with 4 lanes of 64-bit words per ymm register, using the same SoA layout as the
+// 8-lane SHA-256 (word i of all 4 lanes in one register).
+
+// --- Opaque pointer definition ---
+struct Sha512Avx4_C_Handle;
+typedef struct Sha512Avx4_C_Handle Sha512Avx4_C_Handle;
+
+// Storage requirements for placing a handle in caller-owned memory (see sha512_avx4_init_at).
+#define SHA512_AVX4_HANDLE_SIZE 256
+#define SHA512_AVX4_HANDLE_ALIGN 64
+
+/**
+* @brief Creates and initializes a new SHA512 AVX4 processor handle.
+* @return Returns a valid handle on success, or NULL if memory allocation fails.
+*/
+Sha512Avx4_C_Handle* sha512_avx4_create();
+
+/**
+* @brief Destroys a handle and safely frees associated memory (this will clear the memory).
+* @param handle The handle created by sha512_avx4_create(). If NULL, no action is performed.
+*/
+void sha512_avx4_destroy(Sha512Avx4_C_Handle* handle);
+
+/**
+* @brief Initializes a handle inside caller-owned storage, without any heap allocation.
+* @param storage At least SHA512_AVX4_HANDLE_SIZE bytes, aligned to SHA512_AVX4_HANDLE_ALIGN.
+* @return The handle (pointing into storage), or NULL if storage is NULL or misaligned.
+*/
+Sha512Avx4_C_Handle* sha512_avx4_init_at(void* storage);
+
+/**
+* @brief Reinitializes the hash state, allowing the handle to be reused for new computations.
+* @param handle A valid handle. If NULL, no action is performed.
+*/
+void sha512_avx4_init(Sha512Avx4_C_Handle* handle);
+
+/**
+* @brief Process four 128-byte data blocks in parallel.
+* @param handle A valid handle.
+* @param input_blocks An array of four 128-byte data blocks (no alignment requirement).
+* If handle or input_blocks is NULL, no action is performed.
+*/
+void sha512_avx4_update_4_blocks(Sha512Avx4_C_Handle* handle, const uint8_t input_blocks[4][128]);
+
+/**
+* @brief Extracts the 4 final hash digests from the internal state.
+* @param handle A valid handle.
+* @param hashes_out An output array to store the 4 64-byte hash results.
+* If handle or hashes_out is NULL, no action is performed.
+*/
+void sha512_avx4_get_final_hashes(Sha512Avx4_C_Handle* handle, uint8_t hashes_out[4][64]);
+
+/**
+* @brief One-shot SHA-512 of four messages of independent lengths.
+* @param messages Four message pointers (no alignment requirement).
+* @param lengths Four message lengths (bytes).
+* @param hashes_out An output array to store the 4 64-byte hash results.
+*/
+void sha512_avx4_hash_lanes(const uint8_t* const messages[4], const size_t lengths[4], uint8_t hashes_out[4][64]);
+
+/**
+* @brief HMAC-SHA512 of eight (key, message) pairs.
+* The eight lanes run as two 4-lane batches whose rounds are interleaved in one instruction stream.
+* Keys longer than 128 bytes are hashed first, as specified by RFC 2104.
+* @param keys Eight key pointers.
+* @param key_lengths Eight key lengths (bytes).
+* @param messages Eight message pointers.
+* @param message_lengths Eight message lengths (bytes).
+* @param macs_out An output array to store the 8 64-byte MACs.
+*/
+void hmac_sha512_avx8(const uint8_t* const keys[8], const size_t key_lengths[8],
+                      const uint8_t* const messages[8], const size_t message_lengths[8], uint8_t macs_out[8][64]);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // SHA512_AVX_H
@@ -0,0 +1,150 @@
+/* sha512_test.c
+ * gcc -O3 -mavx2 -march=native sha512_test.c sha512_avx.c -o sha512_test -lcrypto
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <openssl/sha.h>
+#include <openssl/hmac.h>
+#include <openssl/evp.h>
+
+#include "sha512_avx.h"
+
+static void to_hex(const uint8_t* data, size_t len, char* out) {
+    for (size_t i = 0; i < len; i++) sprintf(out + i * 2, "%02x", data[i]);
+    out[len * 2] = '\0';
+}
+
+static int check_hex(const char* name, const uint8_t* got, size_t len, const char* expected) {
+    char hex[129];
+    to_hex(got, len, hex);
+    int ok = strcmp(hex, expected) == 0;
+    printf("Test Case: %s\n", name);
+    printf("  Expected: %s\n", expected);
+    printf("  Result:   %s\n", hex);
+    printf("  Status:   %s\n\n", ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+static int report(const char* name, int ok) {
+    printf("  %-52s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+int main() {
+    printf("--- Correctness Test (4-lane SHA-512 / 8-lane HMAC-SHA512) ---\n");
+    int failed_tests = 0;
+
+    // Known answers.
+    const char* abc = "abc";
+    const uint8_t* msgs4[4] = {(const uint8_t*)abc, (const uint8_t*)"", (const uint8_t*)abc, (const uint8_t*)abc};
+    size_t lens4[4] = {3, 0, 3, 3};
+    uint8_t sha_out[4][64];
+    sha512_avx4_hash_lanes(msgs4, lens4, sha_out);
+    failed_tests += check_hex("SHA-512(\"abc\")", sha_out[0], 64,
+        "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    failed_tests += check_hex("SHA-512(\"\")", sha_out[1], 64,
+        "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+
+    uint8_t rfc_key[20];
+    memset(rfc_key, 0x0b, sizeof(rfc_key));
+    const uint8_t bip32_seed[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    const uint8_t* keys[8];
+    const uint8_t* msgs[8];
+    size_t key_lens[8], msg_lens[8];
+    for (int i = 0; i < 8; i++) {
+        keys[i] = rfc_key; key_lens[i] = 20;
+        msgs[i] = (const uint8_t*)"Hi There"; msg_lens[i] = 8;
+    }
+    keys[5] = (const uint8_t*)"Bitcoin seed"; key_lens[5] = 12;
+    msgs[5] = bip32_seed; msg_lens[5] = 16;
+    uint8_t macs[8][64];
+    hmac_sha512_avx8(keys, key_lens, msgs, msg_lens, macs);
+    failed_tests += check_hex("HMAC-SHA512 RFC 4231 case 1 (lane 7)", macs[7], 64,
+        "87aa7cdea5ef619d4ff0b4241a1d6cb02379f4e2ce4ec2787ad0b30545e17cdedaa833b7d6b8a702038b274eaea3f4e4be9d914eeb61f1702e696c203a126854");
+    failed_tests += check_hex("BIP32 test vector 1 master key (lane 5)", macs[5], 64,
+        "e8f32e723decf4051aefac8e2c93c9c5b214313817cdb01a1494b917c8436b35873dff81c02f525623fd1fe5167eac3a55a049de3d314bb42ee227ffed37d508");
+
+    // Random lengths across block boundaries, against OpenSSL.
+    srand(32);
+    const size_t MAX_LEN = 400;
+    uint8_t* pool = (uint8_t*)malloc(8 * MAX_LEN);
+    for (size_t i = 0; i < 8 * MAX_LEN; i++) pool[i] = (uint8_t)rand();
+    int sha_failures = 0, hmac_failures = 0;
+    for (int round = 0; round < 500; round++) {
+        const uint8_t* m[8];
+        const uint8_t* k[8];
+        size_t ml[8], kl[8];
+        for (int lane = 0; lane < 8; lane++) {
+            ml[lane] = (size_t)rand() % MAX_LEN;
+            kl[lane] = (size_t)rand() % 200; // includes keys longer than one block
+            m[lane] = pool + lane * MAX_LEN;
+            k[lane] = pool + ((lane + 3) % 8) * MAX_LEN;
+        }
+        uint8_t ref[64];
+        sha512_avx4_hash_lanes(m, ml, sha_out);
+        for (int lane = 0; lane < 4; lane++) {
+            SHA512(m[lane], ml[lane], ref);
+            if (memcmp(ref, sha_out[lane], 64) != 0) sha_failures++;
+        }
+        hmac_sha512_avx8(k, kl, m, ml, macs);
+        for (int lane = 0; lane < 8; lane++) {
+            unsigned int ref_len = 0;
+            HMAC(EVP_sha512(), k[lane], (int)kl[lane], m[lane], ml[lane], ref, &ref_len);
+            if (memcmp(ref, macs[lane], 64) != 0) hmac_failures++;
+        }
+    }
+    failed_tests += report("SHA-512, 0..399-byte messages vs OpenSSL", sha_failures == 0);
+    failed_tests += report("HMAC-SHA512, 0..199-byte keys vs OpenSSL", hmac_failures == 0);
+
+    // Streaming handle: two blocks of "a" * 128 then the padding block.
+    Sha512Avx4_C_Handle* handle = sha512_avx4_create();
+    uint8_t blocks[4][128];
+    memset(blocks, 'a', sizeof(blocks));
+    sha512_avx4_update_4_blocks(handle, (const uint8_t (*)[128])blocks);
+    memset(blocks, 0, sizeof(blocks));
+    for (int lane = 0; lane < 4; lane++) {
+        blocks[lane][0] = 0x80;
+        blocks[lane][126] = 0x04; // 1024 bits
+    }
+    sha512_avx4_update_4_blocks(handle, (const uint8_t (*)[128])blocks);
+    sha512_avx4_get_final_hashes(handle, sha_out);
+    sha512_avx4_destroy(handle);
+    uint8_t a128[128], ref[64];
+    memset(a128, 'a', sizeof(a128));
+    SHA512(a128, sizeof(a128), ref);
+    failed_tests += report("Streaming handle, 128-byte message", memcmp(ref, sha_out[3], 64) == 0);
+    free(pool);
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (HMAC-SHA512, BIP32 CKD shape: 32-byte key, 37-byte data) ---\n");
+    uint8_t chain_codes[8][32], data[8][37];
+    for (int lane = 0; lane < 8; lane++) {
+        memset(chain_codes[lane], lane, 32);
+        memset(data[lane], 0x02, 37);
+        keys[lane] = chain_codes[lane]; key_lens[lane] = 32;
+        msgs[lane] = data[lane]; msg_lens[lane] = 37;
+    }
+    const long long NUM_ITERATIONS = 500000;
+    clock_t start = clock();
+    for (long long i = 0; i < NUM_ITERATIONS; i++) {
+        data[0][33] = (uint8_t)i;
+        hmac_sha512_avx8(keys, key_lens, msgs, msg_lens, macs);
+    }
+    clock_t end = clock();
+
+    double total_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("Total HMACs: %lld\n", NUM_ITERATIONS * 8);
+    printf("Total time: %.4f seconds\n", total_time);
+    printf("Performance: %.2f Million HMAC-SHA512/sec\n", NUM_ITERATIONS * 8 / total_time / 1e6);
+
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,442 @@
+/* sighash_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#include "sighash_avx.h"
+#include "sha256_avx.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Preimage layout classes are identified by this key; within a class the 64-byte blocks that every
+// member shares are compressed once.
+#define KEY_SHIFT 32
+
+// SHA256("TapSighash") || SHA256("TapSighash"), a constant so concurrent callers need no initialisation.
+static const uint8_t tap_sighash_tag[64] = {
+    0xf4, 0x0a, 0x48, 0xdf, 0x4b, 0x2a, 0x70, 0xc8, 0xb4, 0x92, 0x4b, 0xf2, 0x65, 0x46, 0x61, 0xed,
+    0x3d, 0x95, 0xfd, 0x66, 0xa3, 0x13, 0xeb, 0x87, 0x23, 0x75, 0x97, 0xc6, 0x28, 0xe4, 0xa0, 0x31,
+    0xf4, 0x0a, 0x48, 0xdf, 0x4b, 0x2a, 0x70, 0xc8, 0xb4, 0x92, 0x4b, 0xf2, 0x65, 0x46, 0x61, 0xed,
+    0x3d, 0x95, 0xfd, 0x66, 0xa3, 0x13, 0xeb, 0x87, 0x23, 0x75, 0x97, 0xc6, 0x28, 0xe4, 0xa0, 0x31,
+};
+
+static size_t compact_size_len(uint64_t n) {
+    return n < 0xfd ? 1 : n <= 0xffff ? 3 : n <= 0xffffffffu ? 5 : 9;
+}
+
+static uint8_t* put_compact(uint8_t* p, uint64_t n) {
+    if (n < 0xfd) {
+        *p++ = (uint8_t)n;
+        return p;
+    }
+    size_t bytes = n <= 0xffff ? 2 : n <= 0xffffffffu ? 4 : 8;
+    *p++ = bytes == 2 ? 0xfd : bytes == 4 ? 0xfe : 0xff;
+    for (size_t i = 0; i < bytes; i++) *p++ = (uint8_t)(n >> (8 * i));
+    return p;
+}
+
+static uint8_t* put_u32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) *p++ = (uint8_t)(v >> (8 * i));
+    return p;
+}
+
+static uint8_t* put_u64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) *p++ = (uint8_t)(v >> (8 * i));
+    return p;
+}
+
+static uint8_t* put_bytes(uint8_t* p, const void* data, size_t len) {
+    if (len) memcpy(p, data, len);
+    return p + len;
+}
+
+static uint8_t* put_outpoint(uint8_t* p, const SighashInput* in) {
+    p = put_bytes(p, in->prev_txid, 32);
+    return put_u32(p, in->prev_vout);
+}
+
+static uint8_t* put_script(uint8_t* p, const uint8_t* script, size_t len) {
+    p = put_compact(p, len);
+    return put_bytes(p, script, len);
+}
+
+// All outputs serialized back to back; offsets[i]..offsets[i + 1] is output i.
+static uint8_t* serialize_outputs(const SighashTx* tx, size_t* offsets) {
+    size_t total = 0;
+    for (size_t i = 0; i < tx->output_count; i++) {
+        const SighashOutput* o = &tx->outputs[i];
+        total += 8 + compact_size_len(o->script_pubkey_len) + o->script_pubkey_len;
+    }
+    uint8_t* buf = (uint8_t*)malloc(total + 1);
+    if (!buf) return NULL;
+    uint8_t* p = buf;
+    for (size_t i = 0; i < tx->output_count; i++) {
+        const SighashOutput* o = &tx->outputs[i];
+        offsets[i] = (size_t)(p - buf);
+        p = put_u64(p, o->value);
+        p = put_script(p, o->script_pubkey, o->script_pubkey_len);
+    }
+    offsets[tx->output_count] = total;
+    return buf;
+}
+
+// SHA-256 (double SHA-256 if twice) of the messages listed in idx (all n when idx is NULL), 8 lanes at a
+// time, resuming from init_state when the first prefix_len bytes are already compressed. ptrs and lens
+// are indexed by message and point past the prefix; a partial group repeats its first message.
+static void hash_messages(const uint32_t init_state[8], uint64_t prefix_len, const uint8_t* const* ptrs,
+                          const size_t* lens, const size_t* idx, size_t n, int twice, uint8_t (*out)[32]) {
+    for (size_t base = 0; base < n; base += 8) {
+        size_t cnt = n - base < 8 ? n - base : 8;
+        size_t job[8];
+        const uint8_t* lane_ptrs[8];
+        size_t lane_lens[8];
+        uint8_t digests[8][32];
+        for (size_t lane = 0; lane < 8; lane++) {
+            size_t k = base + (lane < cnt ? lane : 0);
+            job[lane] = idx ? idx[k] : k;
+            lane_ptrs[lane] = ptrs[job[lane]];
+            lane_lens[lane] = lens[job[lane]];
+        }
+        sha256_avx8_hash_lanes(init_state, prefix_len, lane_ptrs, lane_lens, digests);
+        if (twice) {
+            uint8_t second[8][32];
+            const uint8_t* firsts[8];
+            for (size_t lane = 0; lane < 8; lane++) firsts[lane] = digests[lane];
+            sha256_avx8_hash_short(firsts, 32, second);
+            memcpy(digests, second, sizeof(digests));
+        }
+        for (size_t lane = 0; lane < cnt; lane++) memcpy(out[job[lane]], digests[lane], 32);
+    }
+}
+
+// Chaining state after the first nblocks 64-byte blocks of data.
+static void midstate(const uint8_t* data, size_t nblocks, uint32_t state[8]) {
+    static const uint32_t iv[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    memcpy(state, iv, sizeof(iv));
+    sha256_compress_single(state, data, nblocks);
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+// Hashes count preimages (buf + offsets[i], lens[i]). Preimages with the same key share a layout:
+// the 64-byte blocks common to every member of a class are compressed once and the remaining tails
+// are hashed from that midstate.
+static int hash_preimages(const uint8_t* buf, const size_t* offsets, const size_t* lens, const uint32_t* keys,
+                          size_t count, int twice, uint8_t (*out)[32]) {
+    uint64_t* sorted = (uint64_t*)malloc(count * sizeof(uint64_t) + 1);
+    size_t* idx = (size_t*)malloc(count * sizeof(size_t) + 1);
+    const uint8_t** tails = (const uint8_t**)malloc(count * sizeof(uint8_t*) + 1);
+    size_t* tail_lens = (size_t*)malloc(count * sizeof(size_t) + 1);
+    if (!sorted || !idx || !tails || !tail_lens) {
+        free(sorted);
+        free(idx);
+        free(tails);
+        free(tail_lens);
+        return -1;
+    }
+    for (size_t i = 0; i < count; i++) sorted[i] = ((uint64_t)keys[i] << KEY_SHIFT) | i;
+    qsort(sorted, count, sizeof(uint64_t), compare_u64);
+    for (size_t i = 0; i < count; i++) idx[i] = (size_t)(sorted[i] & 0xffffffffu);
+
+    for (size_t start = 0; start < count;) {
+        size_t end = start + 1;
+        while (end < count && sorted[end] >> KEY_SHIFT == sorted[start] >> KEY_SHIFT) end++;
+
+        const uint8_t* first = buf + offsets[idx[start]];
+        size_t shared = lens[idx[start]] & ~(size_t)63;
+        for (size_t k = start + 1; k < end && shared; k++) {
+            const uint8_t* other = buf + offsets[idx[k]];
+            size_t limit = lens[idx[k]] < shared ? lens[idx[k]] : shared;
+            size_t p = 0;
+            while (p + 64 <= limit && memcmp(first + p, other + p, 64) == 0) p += 64;
+            shared = p;
+        }
+        uint32_t state[8];
+        if (shared) midstate(first, shared / 64, state);
+        for (size_t k = start; k < end; k++) {
+            tails[idx[k]] = buf + offsets[idx[k]] + shared;
+            tail_lens[idx[k]] = lens[idx[k]] - shared;
+        }
+        hash_messages(shared ? state : NULL, shared, tails, tail_lens, idx + start, end - start, twice, out);
+        start = end;
+    }
+    free(sorted);
+    free(idx);
+    free(tails);
+    free(tail_lens);
+    return 0;
+}
+
+int sighash_precompute(const SighashTx* tx, SighashShared* shared) {
+    if (!tx || !shared || (tx->input_count && !tx->inputs) || (tx->output_count && !tx->outputs)) return -1;
+    if (tx->input_count > 0xffffffffu) return -1;
+    size_t n = tx->input_count;
+    size_t spk_total = 0;
+    for (size_t i = 0; i < n; i++) {
+        spk_total += compact_size_len(tx->inputs[i].script_pubkey_len) + tx->inputs[i].script_pubkey_len;
+    }
+    size_t* out_offsets = (size_t*)malloc((tx->output_count + 1) * sizeof(size_t));
+    uint8_t* outputs = out_offsets ? serialize_outputs(tx, out_offsets) : NULL;
+    uint8_t* buf = (uint8_t*)malloc(n * (36 + 4 + 8) + spk_total + 1);
+    if (!out_offsets || !outputs || !buf) {
+        free(out_offsets);
+        free(outputs);
+        free(buf);
+        return -1;
+    }
+
+    // Lanes: prevouts, sequences, outputs, amounts, scriptPubKeys.
+    const uint8_t* ptrs[5];
+    size_t lens[5];
+    uint8_t* p = buf;
+    ptrs[0] = p;
+    for (size_t i = 0; i < n; i++) p = put_outpoint(p, &tx->inputs[i]);
+    ptrs[1] = p;
+    for (size_t i = 0; i < n; i++) p = put_u32(p, tx->inputs[i].sequence);
+    ptrs[2] = outputs;
+    ptrs[3] = p;
+    for (size_t i = 0; i < n; i++) p = put_u64(p, tx->inputs[i].amount);
+    ptrs[4] = p;
+    for (size_t i = 0; i < n; i++) p = put_script(p, tx->inputs[i].script_pubkey, tx->inputs[i].script_pubkey_len);
+    lens[0] = n * 36;
+    lens[1] = n * 4;
+    lens[2] = out_offsets[tx->output_count];
+    lens[3] = n * 8;
+    lens[4] = spk_total;
+
+    uint8_t singles[5][32];
+    hash_messages(NULL, 0, ptrs, lens, NULL, 5, 0, singles);
+    memcpy(shared->sha_prevouts, singles[0], 32);
+    memcpy(shared->sha_sequences, singles[1], 32);
+    memcpy(shared->sha_outputs, singles[2], 32);
+    memcpy(shared->sha_amounts, singles[3], 32);
+    memcpy(shared->sha_scriptpubkeys, singles[4], 32);
+
+    // BIP143 uses the double SHA-256 of the first three.
+    const uint8_t* firsts[8];
+    uint8_t doubles[8][32];
+    for (size_t lane = 0; lane < 8; lane++) firsts[lane] = singles[lane < 3 ? lane : 0];
+    sha256_avx8_hash_short(firsts, 32, doubles);
+    memcpy(shared->hash_prevouts, doubles[0], 32);
+    memcpy(shared->hash_sequence, doubles[1], 32);
+    memcpy(shared->hash_outputs, doubles[2], 32);
+
+    free(out_offsets);
+    free(outputs);
+    free(buf);
+    return 0;
+}
+
+// Per-job scratch of a batch: preimages, their offsets and lengths, class keys, and the hashes of
+// single outputs and annexes that go into them.
+typedef struct {
+    uint8_t* preimages;
+    size_t* offsets;
+    size_t* lens;
+    uint32_t* keys;
+    uint8_t (*extra)[32];
+    size_t* slots;                // first extra slot of each job
+    const uint8_t** extra_ptrs;
+    size_t* extra_lens;
+    uint8_t* annexes;
+    size_t* out_offsets;
+    uint8_t* outputs;
+} Batch;
+
+static void free_batch(Batch* b) {
+    free(b->preimages);
+    free(b->offsets);
+    free(b->lens);
+    free(b->keys);
+    free(b->extra);
+    free(b->slots);
+    free(b->extra_ptrs);
+    free(b->extra_lens);
+    free(b->annexes);
+    free(b->out_offsets);
+    free(b->outputs);
+}
+
+static int alloc_batch(Batch* b, const SighashTx* tx, size_t count, size_t preimage_bytes, size_t annex_bytes) {
+    memset(b, 0, sizeof(*b));
+    b->preimages = (uint8_t*)malloc(preimage_bytes + 1);
+    b->offsets = (size_t*)malloc(count * sizeof(size_t) + 1);
+    b->lens = (size_t*)malloc(count * sizeof(size_t) + 1);
+    b->keys = (uint32_t*)malloc(count * sizeof(uint32_t) + 1);
+    b->extra = (uint8_t(*)[32])malloc(2 * count * 32 + 1);
+    b->slots = (size_t*)malloc(count * sizeof(size_t) + 1);
+    b->extra_ptrs = (const uint8_t**)malloc(2 * count * sizeof(uint8_t*) + 1);
+    b->extra_lens = (size_t*)malloc(2 * count * sizeof(size_t) + 1);
+    b->annexes = (uint8_t*)malloc(annex_bytes + 1);
+    b->out_offsets = (size_t*)malloc((tx->output_count + 1) * sizeof(size_t));
+    b->outputs = b->out_offsets ? serialize_outputs(tx, b->out_offsets) : NULL;
+    if (!b->preimages || !b->offsets || !b->lens || !b->keys || !b->extra || !b->slots || !b->extra_ptrs ||
+        !b->extra_lens || !b->annexes || !b->outputs) {
+        free_batch(b);
+        return -1;
+    }
+    return 0;
+}
+
+// Queues the serialized output i for hashing into extra slot e.
+static void queue_output(Batch* b, size_t e, size_t i) {
+    b->extra_ptrs[e] = b->outputs + b->out_offsets[i];
+    b->extra_lens[e] = b->out_offsets[i + 1] - b->out_offsets[i];
+}
+
+int sighash_bip143_batch(const SighashTx* tx, const SighashShared* shared, const SighashBip143Job* jobs,
+                         size_t count, uint8_t (*sighashes)[32]) {
+    if (!tx || !shared || (count && (!jobs || !sighashes))) return -1;
+    size_t total = 0;
+    for (size_t j = 0; j < count; j++) {
+        if (jobs[j].input_index >= tx->input_count) return -1;
+        total += 156 + compact_size_len(jobs[j].script_code_len) + jobs[j].script_code_len;
+    }
+    Batch b;
+    if (alloc_batch(&b, tx, count, total, 0) != 0) return -1;
+
+    // hashOutputs of SIGHASH_SINGLE covers only the output at the input's index.
+    size_t nsingle = 0;
+    for (size_t j = 0; j < count; j++) {
+        const SighashBip143Job* job = &jobs[j];
+        if ((job->hash_type & 0x1f) == SIGHASH_SINGLE && job->input_index < tx->output_count) {
+            queue_output(&b, nsingle, job->input_index);
+            b.slots[j] = nsingle++;
+        }
+    }
+    hash_messages(NULL, 0, b.extra_ptrs, b.extra_lens, NULL, nsingle, 1, b.extra);
+
+    static const uint8_t zero[32] = {0};
+    uint8_t* p = b.preimages;
+    for (size_t j = 0; j < count; j++) {
+        const SighashBip143Job* job = &jobs[j];
+        const SighashInput* in = &tx->inputs[job->input_index];
+        uint32_t base = job->hash_type & 0x1f;
+        int acp = (job->hash_type & SIGHASH_ANYONECANPAY) != 0;
+        int all_outputs = base != SIGHASH_SINGLE && base != SIGHASH_NONE;
+        const uint8_t* outputs_hash = zero;
+        if (all_outputs) outputs_hash = shared->hash_outputs;
+        else if (base == SIGHASH_SINGLE && job->input_index < tx->output_count) outputs_hash = b.extra[b.slots[j]];
+
+        uint8_t* start = p;
+        p = put_u32(p, tx->version);
+        p = put_bytes(p, acp ? zero : shared->hash_prevouts, 32);
+        p = put_bytes(p, !acp && all_outputs ? shared->hash_sequence : zero, 32);
+        p = put_outpoint(p, in);
+        p = put_script(p, job->script_code, job->script_code_len);
+        p = put_u64(p, in->amount);
+        p = put_u32(p, in->sequence);
+        p = put_bytes(p, outputs_hash, 32);
+        p = put_u32(p, tx->locktime);
+        p = put_u32(p, job->hash_type);
+        b.offsets[j] = (size_t)(start - b.preimages);
+        b.lens[j] = (size_t)(p - start);
+        b.keys[j] = job->hash_type;
+    }
+    int rc = hash_preimages(b.preimages, b.offsets, b.lens, b.keys, count, 1, sighashes);
+    free_batch(&b);
+    return rc;
+}
+
+static int valid_taproot_hash_type(uint8_t t) {
+    return t == SIGHASH_DEFAULT || (t & ~SIGHASH_ANYONECANPAY) == SIGHASH_ALL ||
+           (t & ~SIGHASH_ANYONECANPAY) == SIGHASH_NONE || (t & ~SIGHASH_ANYONECANPAY) == SIGHASH_SINGLE;
+}
+
+int sighash_bip341_batch(const SighashTx* tx, const SighashShared* shared, const SighashBip341Job* jobs,
+                         size_t count, uint8_t (*sighashes)[32]) {
+    if (!tx || !shared || (count && (!jobs || !sighashes))) return -1;
+    size_t total = 0, annex_total = 0;
+    for (size_t j = 0; j < count; j++) {
+        const SighashBip341Job* job = &jobs[j];
+        int acp = (job->hash_type & SIGHASH_ANYONECANPAY) != 0;
+        if (!valid_taproot_hash_type(job->hash_type) || job->input_index >= tx->input_count) return -1;
+        if ((job->hash_type & 3) == SIGHASH_SINGLE && job->input_index >= tx->output_count) return -1;
+        size_t spk_len = tx->inputs[job->input_index].script_pubkey_len;
+        // Tag block, epoch, hash_type, nVersion, nLockTime, the shared digests, spend_type, input data.
+        total += 64 + 1 + 1 + 4 + 4 + (acp ? 0 : 128) + 32 + 1 +
+                 (acp ? 36 + 8 + compact_size_len(spk_len) + spk_len + 4 : 4) + 32 + 32 + 37;
+        if (job->annex) annex_total += compact_size_len(job->annex_len) + job->annex_len;
+    }
+    Batch b;
+    if (alloc_batch(&b, tx, count, total, annex_total) != 0) return -1;
+
+    // A job's extra slots hold sha_annex, then sha_single_output, for those it has.
+    size_t nextra = 0;
+    uint8_t* a = b.annexes;
+    for (size_t j = 0; j < count; j++) {
+        const SighashBip341Job* job = &jobs[j];
+        b.slots[j] = nextra;
+        if (job->annex) {
+            b.extra_ptrs[nextra] = a;
+            a = put_script(a, job->annex, job->annex_len);
+            b.extra_lens[nextra] = (size_t)(a - b.extra_ptrs[nextra]);
+            nextra++;
+        }
+        if ((job->hash_type & 3) == SIGHASH_SINGLE) queue_output(&b, nextra++, job->input_index);
+    }
+    hash_messages(NULL, 0, b.extra_ptrs, b.extra_lens, NULL, nextra, 0, b.extra);
+
+    uint8_t* p = b.preimages;
+    for (size_t j = 0; j < count; j++) {
+        const SighashBip341Job* job = &jobs[j];
+        const SighashInput* in = &tx->inputs[job->input_index];
+        uint8_t base = job->hash_type & 3;
+        int acp = (job->hash_type & SIGHASH_ANYONECANPAY) != 0;
+        uint8_t spend_type = (uint8_t)((job->tapleaf_hash ? 2 : 0) | (job->annex ? 1 : 0));
+        size_t e = b.slots[j];
+
+        uint8_t* start = p;
+        p = put_bytes(p, tap_sighash_tag, 64);
+        *p++ = 0x00; // epoch
+        *p++ = job->hash_type;
+        p = put_u32(p, tx->version);
+        p = put_u32(p, tx->locktime);
+        if (!acp) {
+            p = put_bytes(p, shared->sha_prevouts, 32);
+            p = put_bytes(p, shared->sha_amounts, 32);
+            p = put_bytes(p, shared->sha_scriptpubkeys, 32);
+            p = put_bytes(p, shared->sha_sequences, 32);
+        }
+        if (base != SIGHASH_NONE && base != SIGHASH_SINGLE) p = put_bytes(p, shared->sha_outputs, 32);
+        *p++ = spend_type;
+        if (acp) {
+            p = put_outpoint(p, in);
+            p = put_u64(p, in->amount);
+            p = put_script(p, in->script_pubkey, in->script_pubkey_len);
+            p = put_u32(p, in->sequence);
+        } else {
+            p = put_u32(p, (uint32_t)job->input_index);
+        }
+        if (job->annex) p = put_bytes(p, b.extra[e++], 32);
+        if (base == SIGHASH_SINGLE) p = put_bytes(p, b.extra[e++], 32);
+        if (job->tapleaf_hash) {
+            p = put_bytes(p, job->tapleaf_hash, 32);
+            *p++ = 0x00; // key_version
+            p = put_u32(p, job->codesep_pos);
+        }
+        b.offsets[j] = (size_t)(start - b.preimages);
+        b.lens[j] = (size_t)(p - start);
+        b.keys[j] = (uint32_t)job->hash_type | (uint32_t)spend_type << 8;
+    }
+    int rc = hash_preimages(b.preimages, b.offsets, b.lens, b.keys, count, 0, sighashes);
+    free_batch(&b);
+    return rc;
+}
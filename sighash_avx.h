@@ -0,0 +1,125 @@
+/* sighash_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef SIGHASH_AVX_H
+#define SIGHASH_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Compile-time check to ensure AVX2 is enabled
+#if !defined(__AVX2__)
+#error "This implementation requires AVX2 support. Please compile with -mavx2."
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Batched segwit signature hashes: BIP143 (segwit v0) and BIP341 (taproot, key and script path).
+// The transaction-wide digests are computed once, in a single 8-lane pass. Preimages with the same
+// layout are grouped, their common prefix is compressed once into a midstate, and only the per-input
+// tails are hashed, 8 lanes at a time with sha256_avx8_hash_lanes. For BIP341 the prefix also covers
+// the 64-byte TapSighash tag block, so a key-path input of a SIGHASH_DEFAULT group costs one compression.
+// Hashes are in internal byte order, as signed.
+
+#define SIGHASH_DEFAULT      0x00 // BIP341 only: as SIGHASH_ALL, with a 64-byte signature
+#define SIGHASH_ALL          0x01
+#define SIGHASH_NONE         0x02
+#define SIGHASH_SINGLE       0x03
+#define SIGHASH_ANYONECANPAY 0x80
+
+typedef struct {
+    uint8_t prev_txid[32];        // internal byte order
+    uint32_t prev_vout;
+    uint32_t sequence;
+    uint64_t amount;              // value of the spent output
+    const uint8_t* script_pubkey; // scriptPubKey of the spent output (BIP341 only)
+    size_t script_pubkey_len;
+} SighashInput;
+
+typedef struct {
+    uint64_t value;
+    const uint8_t* script_pubkey;
+    size_t script_pubkey_len;
+} SighashOutput;
+
+typedef struct {
+    uint32_t version;
+    uint32_t locktime;
+    const SighashInput* inputs;
+    size_t input_count;
+    const SighashOutput* outputs;
+    size_t output_count;
+} SighashTx;
+
+// Digests shared by every input of a transaction.
+typedef struct {
+    uint8_t hash_prevouts[32];     // BIP143: double SHA-256
+    uint8_t hash_sequence[32];
+    uint8_t hash_outputs[32];
+    uint8_t sha_prevouts[32];      // BIP341: single SHA-256
+    uint8_t sha_amounts[32];
+    uint8_t sha_scriptpubkeys[32];
+    uint8_t sha_sequences[32];
+    uint8_t sha_outputs[32];
+} SighashShared;
+
+typedef struct {
+    size_t input_index;
+    uint32_t hash_type;
+    const uint8_t* script_code; // scriptCode without its length prefix, e.g. 76a914{20}88ac for P2WPKH
+    size_t script_code_len;
+} SighashBip143Job;
+
+typedef struct {
+    size_t input_index;
+    uint8_t hash_type;
+    const uint8_t* annex;        // including the 0x50 prefix, or NULL
+    size_t annex_len;
+    const uint8_t* tapleaf_hash; // 32 bytes for a script-path spend, NULL for the key path
+    uint32_t codesep_pos;        // script path: position of the last executed OP_CODESEPARATOR, or 0xFFFFFFFF
+} SighashBip341Job;
+
+/**
+* @brief Computes the shared digests of a transaction (all BIP143 and BIP341 fields in one pass).
+* @return 0 on success, -1 on invalid arguments or allocation failure.
+*/
+int sighash_precompute(const SighashTx* tx, SighashShared* shared);
+
+/**
+* @brief BIP143 signature hashes of count inputs.
+* @param shared The result of sighash_precompute for tx.
+* @return 0 on success, -1 on an input index out of range or allocation failure.
+*/
+int sighash_bip143_batch(const SighashTx* tx, const SighashShared* shared, const SighashBip143Job* jobs,
+                         size_t count, uint8_t (*sighashes)[32]);
+
+/**
+* @brief BIP341 signature hashes (TapSighash) of count inputs.
+* @return 0 on success, -1 on an invalid hash type, an input index out of range, SIGHASH_SINGLE
+*         without a matching output (all of which make the signature invalid), or allocation failure.
+*/
+int sighash_bip341_batch(const SighashTx* tx, const SighashShared* shared, const SighashBip341Job* jobs,
+                         size_t count, uint8_t (*sighashes)[32]);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // SIGHASH_AVX_H
@@ -0,0 +1,475 @@
+/* sighash_test.c
+ * gcc -O3 -mavx2 -march=native sighash_test.c sighash_avx.c sha256_avx.c -o sighash_test -lcrypto
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <openssl/sha.h>
+
+#include "sighash_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+static size_t from_hex(const char* hex, uint8_t* out) {
+    size_t n = strlen(hex) / 2;
+    for (size_t i = 0; i < n; i++) sscanf(hex + 2 * i, "%2hhx", &out[i]);
+    return n;
+}
+
+static int equals_hex(const uint8_t* data, const char* hex) {
+    uint8_t expected[32];
+    from_hex(hex, expected);
+    return memcmp(data, expected, 32) == 0;
+}
+
+// --- Scalar reference: the preimages of BIP143 and BIP341 serialized field by field ---
+
+typedef struct {
+    uint8_t* data;
+    size_t len, cap;
+} Buffer;
+
+static void put(Buffer* b, const void* p, size_t n) {
+    if (b->len + n > b->cap) {
+        b->cap = (b->len + n) * 2;
+        b->data = (uint8_t*)realloc(b->data, b->cap);
+    }
+    if (n) memcpy(b->data + b->len, p, n);
+    b->len += n;
+}
+
+static void put_u8(Buffer* b, uint8_t v) { put(b, &v, 1); }
+static void put_u32(Buffer* b, uint32_t v) { put(b, &v, 4); }
+static void put_u64(Buffer* b, uint64_t v) { put(b, &v, 8); }
+
+static void put_compact(Buffer* b, uint64_t v) {
+    uint8_t tmp[9];
+    if (v < 0xfd) { tmp[0] = (uint8_t)v; put(b, tmp, 1); }
+    else if (v <= 0xffff) { tmp[0] = 0xfd; memcpy(tmp + 1, &v, 2); put(b, tmp, 3); }
+    else { tmp[0] = 0xfe; memcpy(tmp + 1, &v, 4); put(b, tmp, 5); }
+}
+
+static void put_script(Buffer* b, const uint8_t* s, size_t n) {
+    put_compact(b, n);
+    put(b, s, n);
+}
+
+static void put_output(Buffer* b, const SighashOutput* o) {
+    put_u64(b, o->value);
+    put_script(b, o->script_pubkey, o->script_pubkey_len);
+}
+
+static void sha256d(const uint8_t* data, size_t len, uint8_t out[32]) {
+    SHA256(data, len, out);
+    SHA256(out, 32, out);
+}
+
+static void ref_bip143(const SighashTx* tx, const SighashBip143Job* job, uint8_t out[32]) {
+    uint8_t zero[32] = {0}, prevouts[32], sequence[32], outputs[32];
+    Buffer b = {0};
+    for (size_t i = 0; i < tx->input_count; i++) {
+        put(&b, tx->inputs[i].prev_txid, 32);
+        put_u32(&b, tx->inputs[i].prev_vout);
+    }
+    sha256d(b.data, b.len, prevouts);
+    b.len = 0;
+    for (size_t i = 0; i < tx->input_count; i++) put_u32(&b, tx->inputs[i].sequence);
+    sha256d(b.data, b.len, sequence);
+    b.len = 0;
+    uint32_t base = job->hash_type & 0x1f;
+    int acp = (job->hash_type & 0x80) != 0;
+    if (base != SIGHASH_SINGLE && base != SIGHASH_NONE) {
+        for (size_t i = 0; i < tx->output_count; i++) put_output(&b, &tx->outputs[i]);
+        sha256d(b.data, b.len, outputs);
+    } else if (base == SIGHASH_SINGLE && job->input_index < tx->output_count) {
+        put_output(&b, &tx->outputs[job->input_index]);
+        sha256d(b.data, b.len, outputs);
+    } else {
+        memset(outputs, 0, 32);
+    }
+    b.len = 0;
+    const SighashInput* in = &tx->inputs[job->input_index];
+    put_u32(&b, tx->version);
+    put(&b, acp ? zero : prevouts, 32);
+    put(&b, !acp && base != SIGHASH_SINGLE && base != SIGHASH_NONE ? sequence : zero, 32);
+    put(&b, in->prev_txid, 32);
+    put_u32(&b, in->prev_vout);
+    put_script(&b, job->script_code, job->script_code_len);
+    put_u64(&b, in->amount);
+    put_u32(&b, in->sequence);
+    put(&b, outputs, 32);
+    put_u32(&b, tx->locktime);
+    put_u32(&b, job->hash_type);
+    sha256d(b.data, b.len, out);
+    free(b.data);
+}
+
+static void ref_bip341(const SighashTx* tx, const SighashBip341Job* job, uint8_t out[32]) {
+    Buffer b = {0}, field = {0};
+    uint8_t tag[32], h[32];
+    SHA256((const uint8_t*)"TapSighash", 10, tag);
+    put(&b, tag, 32);
+    put(&b, tag, 32);
+    put_u8(&b, 0);
+    put_u8(&b, job->hash_type);
+    put_u32(&b, tx->version);
+    put_u32(&b, tx->locktime);
+    uint8_t base = job->hash_type & 3;
+    if (!(job->hash_type & 0x80)) {
+        for (size_t i = 0; i < tx->input_count; i++) {
+            put(&field, tx->inputs[i].prev_txid, 32);
+            put_u32(&field, tx->inputs[i].prev_vout);
+        }
+        SHA256(field.data, field.len, h), put(&b, h, 32), field.len = 0;
+        for (size_t i = 0; i < tx->input_count; i++) put_u64(&field, tx->inputs[i].amount);
+        SHA256(field.data, field.len, h), put(&b, h, 32), field.len = 0;
+        for (size_t i = 0; i < tx->input_count; i++) {
+            put_script(&field, tx->inputs[i].script_pubkey, tx->inputs[i].script_pubkey_len);
+        }
+        SHA256(field.data, field.len, h), put(&b, h, 32), field.len = 0;
+        for (size_t i = 0; i < tx->input_count; i++) put_u32(&field, tx->inputs[i].sequence);
+        SHA256(field.data, field.len, h), put(&b, h, 32), field.len = 0;
+    }
+    if (base != SIGHASH_NONE && base != SIGHASH_SINGLE) {
+        for (size_t i = 0; i < tx->output_count; i++) put_output(&field, &tx->outputs[i]);
+        SHA256(field.data, field.len, h), put(&b, h, 32), field.len = 0;
+    }
+    put_u8(&b, (uint8_t)((job->tapleaf_hash ? 2 : 0) + (job->annex ? 1 : 0)));
+    if (job->hash_type & 0x80) {
+        const SighashInput* in = &tx->inputs[job->input_index];
+        put(&b, in->prev_txid, 32);
+        put_u32(&b, in->prev_vout);
+        put_u64(&b, in->amount);
+        put_script(&b, in->script_pubkey, in->script_pubkey_len);
+        put_u32(&b, in->sequence);
+    } else {
+        put_u32(&b, (uint32_t)job->input_index);
+    }
+    if (job->annex) {
+        put_script(&field, job->annex, job->annex_len);
+        SHA256(field.data, field.len, h), put(&b, h, 32), field.len = 0;
+    }
+    if (base == SIGHASH_SINGLE) {
+        put_output(&field, &tx->outputs[job->input_index]);
+        SHA256(field.data, field.len, h), put(&b, h, 32), field.len = 0;
+    }
+    if (job->tapleaf_hash) {
+        put(&b, job->tapleaf_hash, 32);
+        put_u8(&b, 0);
+        put_u32(&b, job->codesep_pos);
+    }
+    SHA256(b.data, b.len, out);
+    free(b.data);
+    free(field.data);
+}
+
+// --- Random transactions ---
+
+typedef struct {
+    SighashTx tx;
+    SighashInput* inputs;
+    SighashOutput* outputs;
+    uint8_t* scripts;
+} RandomTx;
+
+static void random_tx(RandomTx* r, size_t n_in, size_t n_out) {
+    r->inputs = (SighashInput*)calloc(n_in, sizeof(SighashInput));
+    r->outputs = (SighashOutput*)calloc(n_out, sizeof(SighashOutput));
+    r->scripts = (uint8_t*)malloc((n_in + n_out) * 300);
+    for (size_t i = 0; i < (n_in + n_out) * 300; i++) r->scripts[i] = (uint8_t)rand();
+    for (size_t i = 0; i < n_in; i++) {
+        SighashInput* in = &r->inputs[i];
+        for (int k = 0; k < 32; k++) in->prev_txid[k] = (uint8_t)rand();
+        in->prev_vout = (uint32_t)rand() % 4;
+        in->sequence = rand() % 2 ? 0xffffffffu : (uint32_t)rand();
+        in->amount = (uint64_t)rand() * 1000;
+        in->script_pubkey = r->scripts + i * 300;
+        in->script_pubkey_len = rand() % 4 ? 34 : (size_t)(rand() % 300); // mostly P2TR
+    }
+    for (size_t i = 0; i < n_out; i++) {
+        SighashOutput* o = &r->outputs[i];
+        o->value = (uint64_t)rand() * 777;
+        o->script_pubkey = r->scripts + (n_in + i) * 300;
+        o->script_pubkey_len = rand() % 2 ? 22 : (size_t)(rand() % 300);
+    }
+    r->tx.version = rand() % 2 ? 2 : 1;
+    r->tx.locktime = rand() % 2 ? 0 : (uint32_t)rand();
+    r->tx.inputs = r->inputs;
+    r->tx.input_count = n_in;
+    r->tx.outputs = r->outputs;
+    r->tx.output_count = n_out;
+}
+
+static void free_random_tx(RandomTx* r) {
+    free(r->inputs);
+    free(r->outputs);
+    free(r->scripts);
+}
+
+static const uint8_t taproot_types[] = {0x00, 0x01, 0x02, 0x03, 0x81, 0x82, 0x83};
+
+int main() {
+    printf("--- Correctness Test (Batched BIP143/BIP341 Signature Hashes) ---\n");
+    int failed_tests = 0;
+    srand(1);
+
+    // BIP143 "Native P2WPKH" example: the shared digests.
+    {
+        uint8_t txid0[32], txid1[32], spk0[25], spk1[25];
+        from_hex("fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f", txid0);
+        from_hex("ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a", txid1);
+        from_hex("76a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac", spk0);
+        from_hex("76a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac", spk1);
+        SighashInput inputs[2] = {{{0}, 0, 0xffffffee, 625000000, NULL, 0}, {{0}, 1, 0xffffffff, 600000000, NULL, 0}};
+        memcpy(inputs[0].prev_txid, txid0, 32);
+        memcpy(inputs[1].prev_txid, txid1, 32);
+        SighashOutput outputs[2] = {{112340000, spk0, 25}, {223450000, spk1, 25}};
+        SighashTx tx = {1, 0x11, inputs, 2, outputs, 2};
+        SighashShared shared;
+        int ok = sighash_precompute(&tx, &shared) == 0;
+        failed_tests += report("BIP143 P2WPKH example: hashPrevouts/Sequence/Outputs",
+                               ok && equals_hex(shared.hash_prevouts, "96b827c8483d4e9b96712b6713a7b68d6e8003a781feba36c31143470b4efd37") &&
+                               equals_hex(shared.hash_sequence, "52b0a642eea2fb7ae638c36f6252b6750293dbe574a806984b8e4d8548339a3b") &&
+                               equals_hex(shared.hash_outputs, "863ef3e1a92afbfdb97f31ad0fc7683ee943e9abcf2501590ff8f6551f47e5e5"));
+    }
+
+    // BIP143 "P2SH-P2WPKH" example.
+    {
+        uint8_t txid[32], spk0[25], spk1[25], code[25];
+        from_hex("db6b1b20aa0fd7b23880be2ecbd4a98130974cf4748fb66092ac4d3ceb1a5477", txid);
+        from_hex("76a914a457b684d7f0d539a46a45bbc043f35b59d0d96388ac", spk0);
+        from_hex("76a914fd270b1ee6abcaea97fea7ad0402e8bd8ad6d77c88ac", spk1);
+        from_hex("76a91479091972186c449eb1ded22b78e40d009bdf008988ac", code);
+        SighashInput input = {{0}, 1, 0xfffffffe, 1000000000, NULL, 0};
+        memcpy(input.prev_txid, txid, 32);
+        SighashOutput outputs[2] = {{199996600, spk0, 25}, {800000000, spk1, 25}};
+        SighashTx tx = {1, 0x492, &input, 1, outputs, 2};
+        SighashShared shared;
+        SighashBip143Job job = {0, SIGHASH_ALL, code, 25};
+        uint8_t sighash[1][32];
+        int ok = sighash_precompute(&tx, &shared) == 0 && sighash_bip143_batch(&tx, &shared, &job, 1, sighash) == 0;
+        failed_tests += report("BIP143 P2SH-P2WPKH example: sigHash",
+                               ok && equals_hex(sighash[0], "64f3b0f4dd2bb3aa1ce8566d220cc74dda9df97d8490cc81d89d735c92e59fb6"));
+    }
+
+    // BIP341 wallet-test-vectors.json, keyPathSpending: the shared digests and every input's sigHash.
+    {
+        static const char* raw_tx =
+            "02000000097de20cbff686da83a54981d2b9bab3586f4ca7e48f57f5b55963115f3b334e9c010000000000000000d7b7"
+            "cab57b1393ace2d064f4d4a2cb8af6def61273e127517d44759b6dafdd990000000000fffffffff8e1f5833843336892"
+            "28c5d28eac13366be082dc57441760d957275419a418420000000000fffffffff0689180aa63b30cb162a73c6d2a38b7"
+            "eeda2a83ece74310fda0843ad604853b0100000000feffffffaa5202bdf6d8ccd2ee0f0202afbbb7461d9264a25e5bfd"
+            "3c5a52ee1239e0ba6c0000000000feffffff956149bdc66faa968eb2be2d2faa29718acbfe3941215893a2a3446d32ac"
+            "d050000000000000000000e664b9773b88c09c32cb70a2a3e4da0ced63b7ba3b22f848531bbb1d5d5f4c940100000000"
+            "00000000e9aa6b8e6c9de67619e6a3924ae25696bb7b694bb677a632a74ef7eadfd4eabf0000000000ffffffffa778eb"
+            "6a263dc090464cd125c466b5a99667720b1c110468831d058aa1b82af10100000000ffffffff0200ca9a3b0000000019"
+            "76a91406afd46bcdfd22ef94ac122aa11f241244a37ecc88ac807840cb0000000020ac9a87f5594be208f8532db38cff"
+            "670c450ed2fea8fcdefcc9a663f78bab962b0065cd1d";
+        static const struct { const char* spk; uint64_t amount; } utxos[9] = {
+            {"512053a1f6e454df1aa2776a2814a721372d6258050de330b3c6d10ee8f4e0dda343", 420000000},
+            {"5120147c9c57132f6e7ecddba9800bb0c4449251c92a1e60371ee77557b6620f3ea3", 462000000},
+            {"76a914751e76e8199196d454941c45d1b3a323f1433bd688ac", 294000000},
+            {"5120e4d810fd50586274face62b8a807eb9719cef49c04177cc6b76a9a4251d5450e", 504000000},
+            {"512091b64d5324723a985170e4dc5a0f84c041804f2cd12660fa5dec09fc21783605", 630000000},
+            {"00147dd65592d0ab2fe0d0257d571abf032cd9db93dc", 378000000},
+            {"512075169f4001aa68f15bbed28b218df1d0a62cbbcf1188c6665110c293c907b831", 672000000},
+            {"5120712447206d7a5238acc7ff53fbe94a3b64539ad291c7cdbc490b7577e4b17df5", 546000000},
+            {"512077e30a5522dd9f894c3f8b8bd4c4b2cf82ca7da8a3ea6a239655c39c050ab220", 588000000},
+        };
+        static const struct { size_t input; uint8_t hash_type; const char* sighash; } vectors[7] = {
+            {0, 0x03, "2514a6272f85cfa0f45eb907fcb0d121b808ed37c6ea160a5a9046ed5526d555"},
+            {1, 0x83, "325a644af47e8a5a2591cda0ab0723978537318f10e6a63d4eed783b96a71a4d"},
+            {3, 0x01, "bf013ea93474aa67815b1b6cc441d23b64fa310911d991e713cd34c7f5d46669"},
+            {4, 0x00, "4f900a0bae3f1446fd48490c2958b5a023228f01661cda3496a11da502a7f7ef"},
+            {6, 0x02, "15f25c298eb5cdc7eb1d638dd2d45c97c4c59dcaec6679cfc16ad84f30876b85"},
+            {7, 0x82, "cd292de50313804dabe4685e83f923d2969577191a3e1d2882220dca88cbeb10"},
+            {8, 0x81, "cccb739eca6c13a8a89e6e5cd317ffe55669bbda23f2fd37b0f18755e008edd2"},
+        };
+        uint8_t raw[1024], spks[9][34];
+        size_t raw_len = from_hex(raw_tx, raw), pos = 4;
+        SighashInput inputs[9];
+        SighashOutput outputs[2];
+        SighashTx tx = {0, 0, inputs, raw[pos++], outputs, 0};
+        memcpy(&tx.version, raw, 4);
+        for (size_t i = 0; i < tx.input_count; i++) {
+            SighashInput* in = &inputs[i];
+            memcpy(in->prev_txid, raw + pos, 32);
+            memcpy(&in->prev_vout, raw + pos + 32, 4);
+            pos += 36 + 1 + raw[pos + 36]; // outpoint, empty scriptSig
+            memcpy(&in->sequence, raw + pos, 4);
+            pos += 4;
+            in->amount = utxos[i].amount;
+            in->script_pubkey = spks[i];
+            in->script_pubkey_len = from_hex(utxos[i].spk, spks[i]);
+        }
+        tx.output_count = raw[pos++];
+        for (size_t i = 0; i < tx.output_count; i++) {
+            memcpy(&outputs[i].value, raw + pos, 8);
+            outputs[i].script_pubkey_len = raw[pos + 8];
+            outputs[i].script_pubkey = raw + pos + 9;
+            pos += 9 + outputs[i].script_pubkey_len;
+        }
+        memcpy(&tx.locktime, raw + pos, 4);
+        SighashShared shared;
+        int ok = pos + 4 == raw_len && sighash_precompute(&tx, &shared) == 0;
+        failed_tests += report("BIP341 key-path vectors: shared digests",
+                               ok && equals_hex(shared.sha_prevouts, "e3b33bb4ef3a52ad1fffb555c0d82828eb22737036eaeb02a235d82b909c4c3f") &&
+                               equals_hex(shared.sha_amounts, "58a6964a4f5f8f0b642ded0a8a553be7622a719da71d1f5befcefcdee8e0fde6") &&
+                               equals_hex(shared.sha_scriptpubkeys, "23ad0f61ad2bca5ba6a7693f50fce988e17c3780bf2b1e720cfbb38fbdd52e21") &&
+                               equals_hex(shared.sha_sequences, "18959c7221ab5ce9e26c3cd67b22c24f8baa54bac281d8e6b05e400e6c3a957e") &&
+                               equals_hex(shared.sha_outputs, "a2e6dab7c1f0dcd297c8d61647fd17d821541ea69c3cc37dcbad7f90d4eb4bc5"));
+        SighashBip341Job jobs[7];
+        uint8_t sighashes[7][32];
+        for (int i = 0; i < 7; i++) jobs[i] = (SighashBip341Job){vectors[i].input, vectors[i].hash_type, NULL, 0, NULL, 0xffffffff};
+        ok = ok && sighash_bip341_batch(&tx, &shared, jobs, 7, sighashes) == 0;
+        for (int i = 0; i < 7; i++) ok = ok && equals_hex(sighashes[i], vectors[i].sighash);
+        failed_tests += report("BIP341 key-path vectors: sigHash of all 7 inputs", ok);
+    }
+
+    // Random transactions, every hash type, mixed in one batch, against the field-by-field reference.
+    int bip143_bad = 0, bip341_bad = 0, rc_bad = 0;
+    for (int t = 0; t < 200; t++) {
+        RandomTx r;
+        size_t n_in = 1 + (size_t)(rand() % 40), n_out = 1 + (size_t)(rand() % 40);
+        random_tx(&r, n_in, n_out);
+        SighashShared shared;
+        if (sighash_precompute(&r.tx, &shared) != 0) rc_bad++;
+
+        size_t count = 1 + (size_t)(rand() % 60);
+        SighashBip143Job* v0 = (SighashBip143Job*)calloc(count, sizeof(SighashBip143Job));
+        SighashBip341Job* v1 = (SighashBip341Job*)calloc(count, sizeof(SighashBip341Job));
+        uint8_t (*got)[32] = (uint8_t(*)[32])malloc(count * 32);
+        uint8_t leaf[32], want[32];
+        for (int k = 0; k < 32; k++) leaf[k] = (uint8_t)rand();
+        for (size_t j = 0; j < count; j++) {
+            static const uint32_t v0_types[] = {0x01, 0x02, 0x03, 0x81, 0x82, 0x83, 0x41, 0x00};
+            v0[j].input_index = (size_t)rand() % n_in;
+            v0[j].hash_type = t % 2 ? SIGHASH_ALL : v0_types[rand() % 8];
+            v0[j].script_code = r.scripts + rand() % 100;
+            v0[j].script_code_len = rand() % 2 ? 25 : (size_t)(rand() % 600);
+
+            do {
+                v1[j].input_index = (size_t)rand() % n_in;
+                v1[j].hash_type = t % 2 ? SIGHASH_DEFAULT : taproot_types[rand() % 7];
+            } while ((v1[j].hash_type & 3) == SIGHASH_SINGLE && v1[j].input_index >= n_out);
+            if (rand() % 4 == 0) {
+                v1[j].annex = r.scripts + rand() % 100;
+                v1[j].annex_len = 1 + (size_t)(rand() % 300);
+            }
+            if (rand() % 3 == 0) {
+                v1[j].tapleaf_hash = leaf;
+                v1[j].codesep_pos = rand() % 2 ? 0xffffffffu : (uint32_t)rand() % 100;
+            }
+        }
+        if (sighash_bip143_batch(&r.tx, &shared, v0, count, got) != 0) rc_bad++;
+        for (size_t j = 0; j < count; j++) {
+            ref_bip143(&r.tx, &v0[j], want);
+            if (memcmp(got[j], want, 32) != 0) bip143_bad++;
+        }
+        if (sighash_bip341_batch(&r.tx, &shared, v1, count, got) != 0) rc_bad++;
+        for (size_t j = 0; j < count; j++) {
+            ref_bip341(&r.tx, &v1[j], want);
+            if (memcmp(got[j], want, 32) != 0) bip341_bad++;
+        }
+        free(v0);
+        free(v1);
+        free(got);
+        free_random_tx(&r);
+    }
+    failed_tests += report("Batch calls succeed on 200 random transactions", rc_bad == 0);
+    failed_tests += report("BIP143: all hash types match the reference", bip143_bad == 0);
+    failed_tests += report("BIP341: key/script path, annex, all hash types match", bip341_bad == 0);
+
+    // Signatures that BIP341 declares invalid.
+    {
+        RandomTx r;
+        random_tx(&r, 3, 1);
+        SighashShared shared;
+        sighash_precompute(&r.tx, &shared);
+        uint8_t out[1][32];
+        SighashBip341Job single = {2, SIGHASH_SINGLE, NULL, 0, NULL, 0};
+        SighashBip341Job bad_type = {0, 0x04, NULL, 0, NULL, 0};
+        SighashBip341Job bad_index = {3, SIGHASH_ALL, NULL, 0, NULL, 0};
+        SighashBip143Job v0_index = {3, SIGHASH_ALL, NULL, 0};
+        failed_tests += report("Rejects SIGHASH_SINGLE without output, bad type/index",
+                               sighash_bip341_batch(&r.tx, &shared, &single, 1, out) == -1 &&
+                               sighash_bip341_batch(&r.tx, &shared, &bad_type, 1, out) == -1 &&
+                               sighash_bip341_batch(&r.tx, &shared, &bad_index, 1, out) == -1 &&
+                               sighash_bip143_batch(&r.tx, &shared, &v0_index, 1, out) == -1);
+        free_random_tx(&r);
+    }
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    const size_t N = 2000;
+    printf("--- Performance Benchmark (%zu-input transaction, all inputs signed) ---\n", N);
+    RandomTx r;
+    random_tx(&r, N, 2);
+    SighashBip143Job* v0 = (SighashBip143Job*)calloc(N, sizeof(SighashBip143Job));
+    SighashBip341Job* v1 = (SighashBip341Job*)calloc(N, sizeof(SighashBip341Job));
+    uint8_t (*out)[32] = (uint8_t(*)[32])malloc(N * 32);
+    for (size_t j = 0; j < N; j++) {
+        v0[j].input_index = j;
+        v0[j].hash_type = SIGHASH_ALL;
+        v0[j].script_code = r.scripts;
+        v0[j].script_code_len = 25;
+        v1[j].input_index = j;
+        v1[j].hash_type = SIGHASH_DEFAULT;
+    }
+    const int ROUNDS = 20;
+    SighashShared shared;
+    clock_t start = clock();
+    for (int k = 0; k < ROUNDS; k++) {
+        sighash_precompute(&r.tx, &shared);
+        sighash_bip143_batch(&r.tx, &shared, v0, N, out);
+    }
+    double v0_batch = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int k = 0; k < ROUNDS; k++) {
+        sighash_precompute(&r.tx, &shared);
+        sighash_bip341_batch(&r.tx, &shared, v1, N, out);
+    }
+    double v1_batch = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // Scalar baseline with the shared digests cached too: only the per-input preimage is hashed.
+    uint8_t pre[256], h[32];
+    start = clock();
+    for (int k = 0; k < ROUNDS; k++) {
+        for (size_t j = 0; j < N; j++) {
+            memset(pre, (int)j, 182);
+            sha256d(pre, 182, h);
+            out[j][0] ^= h[0];
+        }
+    }
+    double v0_scalar = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int k = 0; k < ROUNDS; k++) {
+        for (size_t j = 0; j < N; j++) {
+            memset(pre, (int)j, 239);
+            SHA256(pre, 239, h);
+            out[j][0] ^= h[0];
+        }
+    }
+    double v1_scalar = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    double total = (double)N * ROUNDS;
+    printf("BIP143 batch (P2WPKH):  %.2f M sighashes/sec\n", total / v0_batch / 1e6);
+    printf("BIP143 OpenSSL per input: %.2f M sighashes/sec (%.2fx)\n", total / v0_scalar / 1e6, v0_scalar / v0_batch);
+    printf("BIP341 batch (key path): %.2f M sighashes/sec\n", total / v1_batch / 1e6);
+    printf("BIP341 OpenSSL per input: %.2f M sighashes/sec (%.2fx)\n", total / v1_scalar / 1e6, v1_scalar / v1_batch);
+    free(v0);
+    free(v1);
+    free(out);
+    free_random_tx(&r);
+    return failed_tests == 0 ? 0 : 1;
+}
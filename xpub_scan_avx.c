@@ -0,0 +1,771 @@
+/* xpub_scan_avx.c */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+#define _GNU_SOURCE
+#include "xpub_scan_avx.h"
+#include "address_avx.h"
+#include "hash_index_avx.h"
+#include "nested_segwit_avx.h"
+#include "sha512_avx.h"
+
+#include <secp256k1.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#define JOB_MAGIC "XPUBJOB1"
+#define CKPT_MAGIC "XPCKPT01"
+#define XPUB_PAYLOAD_LEN 78
+#define CHAIN_COUNT 2
+
+#define RECORD_HIT      1
+#define RECORD_PROGRESS 2
+#define RECORD_COMPLETE 3
+
+#define SLOT_COMPLETE 1u
+
+// One board slot per (xpub, chain). Shards of a chain are claimed in order: shard `done` is in
+// flight when claimed > done.
+typedef struct {
+    uint32_t claimed;          // shards handed out
+    uint32_t done;             // shards completed
+    uint32_t last_used_plus1;  // highest used child index + 1 in completed shards (0: none)
+    uint32_t flags;            // SLOT_*
+} BoardSlot;
+
+typedef struct {
+    char magic[8];
+    uint32_t xpub_index;
+    uint32_t chain;
+    uint32_t shard;
+    uint32_t shard_size;
+    uint64_t reserved;
+} CkptHeader;
+
+// Checkpoint records are appended in one write() per checkpoint and fdatasync'd. A torn tail fails
+// the check word; anything after the last valid PROGRESS/COMPLETE record is discarded on resume.
+typedef struct {
+    uint32_t kind;
+    uint32_t value; // child index (hit) or next child index to hash (progress/complete)
+    uint8_t hash160[20];
+    uint32_t check;
+} CkptRecord;
+
+typedef struct {
+    uint8_t chain_code[32];
+    uint8_t key[33];
+} ExtPubKey;
+
+typedef struct {
+    char dir[PATH_MAX];
+    XpubJobParams params;
+    size_t count;
+    ExtPubKey* keys;
+    int lock_fd;
+    int board_fd;
+    size_t cursor; // slot where the next claim starts looking, so workers spread over chains
+} Job;
+
+typedef struct {
+    size_t slot;
+    uint32_t shard;
+    uint32_t last_used_plus1; // from the board at claim time
+    bool resumed;
+    int fd;
+} Claim;
+
+enum { CLAIM_OK, CLAIM_WAIT, CLAIM_NONE, CLAIM_ERROR };
+
+// --- Key derivation ---
+
+static bool parse_xpub(const char* str, ExtPubKey* out) {
+    uint8_t payload[XPUB_PAYLOAD_LEN];
+    if (!str || !base58check_decode(str, strlen(str), payload, sizeof(payload))) return false;
+    if (payload[45] != 0x02 && payload[45] != 0x03) return false; // xprv and friends are rejected
+    memcpy(out->chain_code, payload + 13, 32);
+    memcpy(out->key, payload + 45, 33);
+    return true;
+}
+
+// BIP32 CKDpub for eight non-hardened child indices of one parent. Returns the mask of valid lanes.
+static uint8_t ckd_pub_8(const secp256k1_context* ctx, const ExtPubKey* parent, const uint32_t indices[8],
+                         uint8_t keys_out[8][33], uint8_t chain_codes_out[8][32]) {
+    secp256k1_pubkey parent_point;
+    if (!secp256k1_ec_pubkey_parse(ctx, &parent_point, parent->key, 33)) return 0;
+
+    uint8_t data[8][37];
+    const uint8_t* keys[8];
+    const uint8_t* msgs[8];
+    size_t key_lens[8], msg_lens[8];
+    alignas(32) uint8_t macs[8][64];
+    for (int lane = 0; lane < 8; lane++) {
+        memcpy(data[lane], parent->key, 33);
+        data[lane][33] = (uint8_t)(indices[lane] >> 24);
+        data[lane][34] = (uint8_t)(indices[lane] >> 16);
+        data[lane][35] = (uint8_t)(indices[lane] >> 8);
+        data[lane][36] = (uint8_t)indices[lane];
+        keys[lane] = parent->chain_code;
+        key_lens[lane] = 32;
+        msgs[lane] = data[lane];
+        msg_lens[lane] = 37;
+    }
+    hmac_sha512_avx8(keys, key_lens, msgs, msg_lens, macs);
+
+    uint8_t valid = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        secp256k1_pubkey child = parent_point;
+        size_t len = 33;
+        memset(keys_out[lane], 0, 33);
+        // tweak_add rejects IL >= n and the point at infinity, the two invalid cases of BIP32.
+        if (!secp256k1_ec_pubkey_tweak_add(ctx, &child, macs[lane])) continue;
+        secp256k1_ec_pubkey_serialize(ctx, keys_out[lane], &len, &child, SECP256K1_EC_COMPRESSED);
+        if (chain_codes_out) memcpy(chain_codes_out[lane], macs[lane] + 32, 32);
+        valid |= (uint8_t)(1u << lane);
+    }
+    return valid;
+}
+
+static bool derive_chain_key(const secp256k1_context* ctx, const ExtPubKey* xpub, uint32_t chain, ExtPubKey* out) {
+    uint32_t indices[8] = {chain, chain, chain, chain, chain, chain, chain, chain};
+    uint8_t keys[8][33], codes[8][32];
+    if (!(ckd_pub_8(ctx, xpub, indices, keys, codes) & 1)) return false;
+    memcpy(out->key, keys[0], 33);
+    memcpy(out->chain_code, codes[0], 32);
+    return true;
+}
+
+static void hash160_8(const uint8_t keys[8][33], uint32_t addr_type, uint8_t out[8][20]) {
+    const uint8_t* ptrs[8];
+    for (int lane = 0; lane < 8; lane++) ptrs[lane] = keys[lane];
+    if (addr_type == XPUB_ADDR_P2SH_P2WPKH) hash160_p2sh_p2wpkh_avx8(ptrs, 33, NULL, out);
+    else hash160_p2sh_p2wpkh_avx8(ptrs, 33, out, NULL);
+}
+
+// Eight consecutive children of a chain key; invalid lanes get an all-zero HASH160.
+static uint8_t derive_hash160_8(const secp256k1_context* ctx, const ExtPubKey* chain_key, uint32_t first,
+                                uint32_t addr_type, uint8_t out[8][20]) {
+    uint32_t indices[8];
+    uint8_t keys[8][33];
+    for (int lane = 0; lane < 8; lane++) indices[lane] = first + (uint32_t)lane;
+    uint8_t valid = ckd_pub_8(ctx, chain_key, indices, keys, NULL);
+    hash160_8((const uint8_t (*)[33])keys, addr_type, out);
+    for (int lane = 0; lane < 8; lane++) {
+        if (!(valid & (1u << lane))) memset(out[lane], 0, 20);
+    }
+    return valid;
+}
+
+int xpub_derive_hash160(const char* xpub, uint32_t chain, uint32_t first_index, size_t count, uint32_t addr_type,
+                        uint8_t (*hash160_out)[20]) {
+    if (!hash160_out || addr_type > XPUB_ADDR_P2SH_P2WPKH || chain >= 0x80000000u) return XPUB_JOB_ERR_PARAMS;
+    if (count > 0x80000000u || first_index > 0x80000000u - count) return XPUB_JOB_ERR_PARAMS;
+    ExtPubKey parent, chain_key;
+    if (!parse_xpub(xpub, &parent)) return XPUB_JOB_ERR_XPUB;
+    secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY);
+    if (!derive_chain_key(ctx, &parent, chain, &chain_key)) {
+        secp256k1_context_destroy(ctx);
+        return XPUB_JOB_ERR_XPUB;
+    }
+    for (size_t base = 0; base < count; base += 8) {
+        uint8_t digests[8][20];
+        derive_hash160_8(ctx, &chain_key, first_index + (uint32_t)base, addr_type, digests);
+        size_t n = count - base < 8 ? count - base : 8;
+        memcpy(hash160_out[base], digests, n * 20);
+    }
+    secp256k1_context_destroy(ctx);
+    return XPUB_JOB_OK;
+}
+
+// --- Job files ---
+
+static void job_path(char* out, const char* dir, const char* name) {
+    snprintf(out, PATH_MAX, "%.4000s/%s", dir, name);
+}
+
+static void shard_path(char* out, const Job* job, size_t slot, uint32_t shard) {
+    snprintf(out, PATH_MAX, "%.4000s/s%zu-%zu-%u.ck", job->dir, slot / CHAIN_COUNT, slot % CHAIN_COUNT, shard);
+}
+
+static int fsync_dir(const char* dir) {
+    int fd = open(dir, O_RDONLY | O_DIRECTORY);
+    if (fd < 0) return -1;
+    int rc = fsync(fd);
+    close(fd);
+    return rc;
+}
+
+static bool write_all(int fd, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    while (len) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+int xpub_job_create(const char* dir, const char* const* xpubs, size_t count, const XpubJobParams* params) {
+    if (!dir || !xpubs || !params || count == 0 || count > UINT32_MAX / CHAIN_COUNT) return XPUB_JOB_ERR_PARAMS;
+    if (params->gap_limit == 0 || params->shard_size < params->gap_limit || params->addr_type > XPUB_ADDR_P2SH_P2WPKH)
+        return XPUB_JOB_ERR_PARAMS;
+    for (size_t i = 0; i < count; i++) {
+        ExtPubKey key;
+        if (!parse_xpub(xpubs[i], &key)) return XPUB_JOB_ERR_XPUB;
+    }
+
+    char path[PATH_MAX], tmp[PATH_MAX];
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) return XPUB_JOB_ERR_IO;
+    job_path(path, dir, "job.txt");
+    if (access(path, F_OK) == 0) return XPUB_JOB_ERR_PARAMS;
+
+    // The zeroed board goes first; job.txt appears last (by rename), which commits the job.
+    job_path(tmp, dir, "board.bin");
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return XPUB_JOB_ERR_IO;
+    bool ok = ftruncate(fd, (off_t)(count * CHAIN_COUNT * sizeof(BoardSlot))) == 0 && fsync(fd) == 0;
+    close(fd);
+    if (!ok) return XPUB_JOB_ERR_IO;
+
+    job_path(tmp, dir, "job.txt.tmp");
+    FILE* f = fopen(tmp, "w");
+    if (!f) return XPUB_JOB_ERR_IO;
+    uint32_t interval = params->checkpoint_interval ? (params->checkpoint_interval + 7) & ~7u : 256;
+    fprintf(f, "%s %u %u %u %u %zu\n", JOB_MAGIC, params->gap_limit, params->shard_size, params->addr_type, interval, count);
+    for (size_t i = 0; i < count; i++) fprintf(f, "%s\n", xpubs[i]);
+    ok = fflush(f) == 0 && fsync(fileno(f)) == 0;
+    ok = fclose(f) == 0 && ok;
+    if (!ok || rename(tmp, path) != 0 || fsync_dir(dir) != 0) return XPUB_JOB_ERR_IO;
+    return XPUB_JOB_OK;
+}
+
+static void job_close(Job* job) {
+    free(job->keys);
+    if (job->lock_fd >= 0) close(job->lock_fd);
+    if (job->board_fd >= 0) close(job->board_fd);
+}
+
+static int job_open(Job* job, const char* dir) {
+    memset(job, 0, sizeof(*job));
+    job->lock_fd = job->board_fd = -1;
+    snprintf(job->dir, sizeof(job->dir), "%s", dir);
+
+    char path[PATH_MAX];
+    job_path(path, dir, "job.txt");
+    FILE* f = fopen(path, "r");
+    if (!f) return XPUB_JOB_ERR_FORMAT;
+    char magic[16];
+    XpubJobParams* p = &job->params;
+    if (fscanf(f, "%15s %u %u %u %u %zu", magic, &p->gap_limit, &p->shard_size, &p->addr_type,
+               &p->checkpoint_interval, &job->count) != 6 || strcmp(magic, JOB_MAGIC) != 0 ||
+        job->count == 0 || p->gap_limit == 0 || p->shard_size < p->gap_limit || p->checkpoint_interval == 0) {
+        fclose(f);
+        return XPUB_JOB_ERR_FORMAT;
+    }
+    job->keys = (ExtPubKey*)malloc(job->count * sizeof(ExtPubKey));
+    char line[256];
+    int rc = job->keys ? XPUB_JOB_OK : XPUB_JOB_ERR_IO;
+    for (size_t i = 0; rc == XPUB_JOB_OK && i < job->count; i++) {
+        if (fscanf(f, "%255s", line) != 1 || !parse_xpub(line, &job->keys[i])) rc = XPUB_JOB_ERR_FORMAT;
+    }
+    fclose(f);
+    if (rc != XPUB_JOB_OK) {
+        job_close(job);
+        return rc;
+    }
+
+    job_path(path, dir, "job.lock");
+    job->lock_fd = open(path, O_RDWR | O_CREAT, 0644);
+    job_path(path, dir, "board.bin");
+    job->board_fd = open(path, O_RDWR);
+    struct stat st;
+    if (job->lock_fd < 0 || job->board_fd < 0 || fstat(job->board_fd, &st) != 0 ||
+        (size_t)st.st_size != job->count * CHAIN_COUNT * sizeof(BoardSlot)) {
+        job_close(job);
+        return XPUB_JOB_ERR_FORMAT;
+    }
+    job->cursor = (size_t)getpid() % (job->count * CHAIN_COUNT);
+    return XPUB_JOB_OK;
+}
+
+static bool read_slot(const Job* job, size_t slot, BoardSlot* out) {
+    return pread(job->board_fd, out, sizeof(*out), (off_t)(slot * sizeof(BoardSlot))) == (ssize_t)sizeof(*out);
+}
+
+static bool write_slot(const Job* job, size_t slot, const BoardSlot* in) {
+    return pwrite(job->board_fd, in, sizeof(*in), (off_t)(slot * sizeof(BoardSlot))) == (ssize_t)sizeof(*in) &&
+           fdatasync(job->board_fd) == 0;
+}
+
+// --- Checkpoint files ---
+
+static uint32_t record_check(const CkptRecord* r) {
+    const uint8_t* bytes = (const uint8_t*)r;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < offsetof(CkptRecord, check); i++) h = (h ^ bytes[i]) * 16777619u;
+    return h;
+}
+
+static void make_record(CkptRecord* r, uint32_t kind, uint32_t value, const uint8_t* hash160) {
+    memset(r, 0, sizeof(*r));
+    r->kind = kind;
+    r->value = value;
+    if (hash160) memcpy(r->hash160, hash160, 20);
+    r->check = record_check(r);
+}
+
+typedef struct {
+    uint32_t next_index;      // first child index still to hash
+    bool complete;
+    uint32_t last_used_plus1; // from hits in this shard
+    off_t valid_end;          // file offset after the last PROGRESS/COMPLETE record
+} ShardState;
+
+// Reads the committed prefix of a checkpoint file; hits are passed to on_hit when it is set.
+static bool read_checkpoint(int fd, size_t slot, uint32_t shard, uint32_t shard_size, ShardState* state,
+                            XpubHitCallback on_hit, void* user) {
+    CkptHeader header;
+    state->next_index = shard * shard_size;
+    state->complete = false;
+    state->last_used_plus1 = 0;
+    state->valid_end = sizeof(CkptHeader);
+    if (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) || memcmp(header.magic, CKPT_MAGIC, 8) != 0 ||
+        header.xpub_index != slot / CHAIN_COUNT || header.chain != slot % CHAIN_COUNT || header.shard != shard ||
+        header.shard_size != shard_size)
+        return false;
+
+    // Pass 1: find the last commit record. Hits before it were written together with it.
+    CkptRecord records[64];
+    off_t pos = sizeof(CkptHeader);
+    bool stop = false;
+    while (!stop) {
+        ssize_t n = pread(fd, records, sizeof(records), pos);
+        if (n < (ssize_t)sizeof(CkptRecord)) break;
+        for (size_t i = 0; i < (size_t)n / sizeof(CkptRecord) && !stop; i++) {
+            const CkptRecord* r = &records[i];
+            pos += sizeof(CkptRecord);
+            if (r->check != record_check(r) || r->kind < RECORD_HIT || r->kind > RECORD_COMPLETE) {
+                stop = true;
+            } else if (r->kind != RECORD_HIT) {
+                state->next_index = r->value;
+                state->complete = r->kind == RECORD_COMPLETE;
+                state->valid_end = pos;
+                stop = state->complete;
+            }
+        }
+    }
+
+    // Pass 2: the committed hits.
+    for (pos = sizeof(CkptHeader); pos < state->valid_end;) {
+        size_t want = (size_t)(state->valid_end - pos) < sizeof(records) ? (size_t)(state->valid_end - pos) : sizeof(records);
+        ssize_t n = pread(fd, records, want, pos);
+        if (n < (ssize_t)sizeof(CkptRecord)) return false;
+        for (size_t i = 0; i < (size_t)n / sizeof(CkptRecord); i++) {
+            if (records[i].kind != RECORD_HIT) continue;
+            if (on_hit) on_hit(user, (uint32_t)(slot / CHAIN_COUNT), (uint32_t)(slot % CHAIN_COUNT), records[i].value, records[i].hash160);
+            state->last_used_plus1 = records[i].value + 1;
+        }
+        pos += n - n % (ssize_t)sizeof(CkptRecord);
+    }
+    return true;
+}
+
+static bool write_header(int fd, size_t slot, uint32_t shard, uint32_t shard_size) {
+    CkptHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CKPT_MAGIC, 8);
+    header.xpub_index = (uint32_t)(slot / CHAIN_COUNT);
+    header.chain = (uint32_t)(slot % CHAIN_COUNT);
+    header.shard = shard;
+    header.shard_size = shard_size;
+    return ftruncate(fd, 0) == 0 && pwrite(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header) && fsync(fd) == 0;
+}
+
+// --- Claiming shards ---
+
+static bool chain_needs_shard(const Job* job, const BoardSlot* s) {
+    return (uint64_t)s->done * job->params.shard_size < (uint64_t)s->last_used_plus1 + job->params.gap_limit;
+}
+
+static int claim_shard(Job* job, Claim* claim) {
+    if (flock(job->lock_fd, LOCK_EX) != 0) return CLAIM_ERROR;
+    size_t slots = job->count * CHAIN_COUNT;
+    bool busy = false;
+    int result = CLAIM_NONE;
+    char path[PATH_MAX];
+
+    for (size_t i = 0; i < slots && result == CLAIM_NONE; i++) {
+        size_t slot = (job->cursor + i) % slots;
+        BoardSlot s;
+        if (!read_slot(job, slot, &s)) {
+            result = CLAIM_ERROR;
+            break;
+        }
+        if (s.flags & SLOT_COMPLETE) continue;
+        shard_path(path, job, slot, s.done);
+
+        if (s.claimed > s.done) {
+            // In flight: ours to take over only if its worker no longer holds the lock.
+            int fd = open(path, O_RDWR | O_CREAT, 0644);
+            if (fd < 0) {
+                result = CLAIM_ERROR;
+                break;
+            }
+            if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+                close(fd);
+                busy = true;
+                continue;
+            }
+            claim->resumed = true;
+            claim->fd = fd;
+        } else {
+            if (!chain_needs_shard(job, &s)) { // stale flag: complete the chain now
+                s.flags |= SLOT_COMPLETE;
+                if (!write_slot(job, slot, &s)) result = CLAIM_ERROR;
+                continue;
+            }
+            int fd = open(path, O_RDWR | O_CREAT, 0644);
+            if (fd < 0 || flock(fd, LOCK_EX | LOCK_NB) != 0 || !write_header(fd, slot, s.done, job->params.shard_size) ||
+                fsync_dir(job->dir) != 0) {
+                if (fd >= 0) close(fd);
+                result = CLAIM_ERROR;
+                break;
+            }
+            s.claimed = s.done + 1;
+            if (!write_slot(job, slot, &s)) {
+                close(fd);
+                result = CLAIM_ERROR;
+                break;
+            }
+            claim->resumed = false;
+            claim->fd = fd;
+        }
+        claim->slot = slot;
+        claim->shard = s.done;
+        claim->last_used_plus1 = s.last_used_plus1;
+        job->cursor = slot + 1;
+        result = CLAIM_OK;
+    }
+    flock(job->lock_fd, LOCK_UN);
+    if (result == CLAIM_NONE && busy) result = CLAIM_WAIT;
+    return result;
+}
+
+static int finish_shard(Job* job, const Claim* claim, uint32_t last_used_plus1) {
+    if (flock(job->lock_fd, LOCK_EX) != 0) return XPUB_JOB_ERR_IO;
+    BoardSlot s;
+    int rc = XPUB_JOB_OK;
+    if (!read_slot(job, claim->slot, &s)) rc = XPUB_JOB_ERR_IO;
+    if (rc == XPUB_JOB_OK && s.done == claim->shard) {
+        s.done = claim->shard + 1;
+        if (last_used_plus1 > s.last_used_plus1) s.last_used_plus1 = last_used_plus1;
+        if (!chain_needs_shard(job, &s)) s.flags |= SLOT_COMPLETE;
+        if (!write_slot(job, claim->slot, &s)) rc = XPUB_JOB_ERR_IO;
+    }
+    flock(job->lock_fd, LOCK_UN);
+    return rc;
+}
+
+// --- Scanning ---
+
+typedef struct {
+    CkptRecord* records;
+    size_t count;
+    size_t capacity;
+} RecordBuffer;
+
+static bool push_record(RecordBuffer* buf, uint32_t kind, uint32_t value, const uint8_t* hash160) {
+    if (buf->count == buf->capacity) {
+        size_t cap = buf->capacity ? buf->capacity * 2 : 64;
+        CkptRecord* grown = (CkptRecord*)realloc(buf->records, cap * sizeof(CkptRecord));
+        if (!grown) return false;
+        buf->records = grown;
+        buf->capacity = cap;
+    }
+    make_record(&buf->records[buf->count++], kind, value, hash160);
+    return true;
+}
+
+static bool commit_records(int fd, RecordBuffer* buf) {
+    bool ok = write_all(fd, buf->records, buf->count * sizeof(CkptRecord)) && fdatasync(fd) == 0;
+    buf->count = 0;
+    return ok;
+}
+
+// Hashes a claimed shard from its last checkpoint. *complete is false when the budget ran out first.
+static int run_shard(const Job* job, const HashIndex* index, const secp256k1_context* ctx, const Claim* claim,
+                     uint64_t budget, XpubWorkerStats* stats, uint64_t* hashed, bool* complete, uint32_t* last_used_plus1) {
+    const XpubJobParams* p = &job->params;
+    ShardState state;
+    if (!read_checkpoint(claim->fd, claim->slot, claim->shard, p->shard_size, &state, NULL, NULL)) {
+        // The claimer died before the header reached the disk.
+        if (!write_header(claim->fd, claim->slot, claim->shard, p->shard_size)) return XPUB_JOB_ERR_IO;
+        state.next_index = claim->shard * p->shard_size;
+        state.valid_end = sizeof(CkptHeader);
+    }
+    if (ftruncate(claim->fd, state.valid_end) != 0 || lseek(claim->fd, state.valid_end, SEEK_SET) < 0) return XPUB_JOB_ERR_IO;
+
+    uint32_t used = state.last_used_plus1 > claim->last_used_plus1 ? state.last_used_plus1 : claim->last_used_plus1;
+    *complete = state.complete;
+    *last_used_plus1 = used;
+    if (state.complete) return XPUB_JOB_OK;
+
+    ExtPubKey chain_key;
+    if (!derive_chain_key(ctx, &job->keys[claim->slot / CHAIN_COUNT], (uint32_t)(claim->slot % CHAIN_COUNT), &chain_key))
+        return XPUB_JOB_ERR_XPUB;
+
+    uint64_t shard_end = (uint64_t)(claim->shard + 1) * p->shard_size;
+    if (shard_end > 0x80000000u) shard_end = 0x80000000u; // non-hardened indices only
+    uint64_t idx = state.next_index, last_commit = idx;
+    uint64_t start_hashed = *hashed;
+    RecordBuffer buf = {NULL, 0, 0};
+    uint64_t pending_hits = 0; // buffered hits, counted once their records reach the disk
+    int rc = XPUB_JOB_OK;
+
+    for (;;) {
+        bool gap_reached = idx >= (uint64_t)used + p->gap_limit;
+        if (gap_reached || idx >= shard_end) {
+            if (!push_record(&buf, RECORD_COMPLETE, (uint32_t)idx, NULL) || !commit_records(claim->fd, &buf)) rc = XPUB_JOB_ERR_IO;
+            else stats->hits += pending_hits;
+            *complete = rc == XPUB_JOB_OK;
+            break;
+        }
+        if (budget && *hashed - start_hashed >= budget) {
+            if (!push_record(&buf, RECORD_PROGRESS, (uint32_t)idx, NULL) || !commit_records(claim->fd, &buf)) rc = XPUB_JOB_ERR_IO;
+            else stats->hits += pending_hits;
+            break;
+        }
+
+        uint8_t digests[8][20];
+        uint8_t valid = derive_hash160_8(ctx, &chain_key, (uint32_t)idx, p->addr_type, digests);
+        size_t n = shard_end - idx < 8 ? (size_t)(shard_end - idx) : 8;
+        uint8_t found = hash_index_lookup_h160_8(index, (const uint8_t (*)[20])digests, NULL, NULL) & valid;
+        for (size_t lane = 0; lane < n; lane++) {
+            if (idx + lane >= (uint64_t)used + p->gap_limit) { // past the gap: outside the wallet
+                n = lane;
+                break;
+            }
+            if (!(found & (1u << lane))) continue;
+            if (!push_record(&buf, RECORD_HIT, (uint32_t)(idx + lane), digests[lane])) rc = XPUB_JOB_ERR_IO;
+            used = (uint32_t)(idx + lane + 1);
+            pending_hits++;
+        }
+        if (rc != XPUB_JOB_OK) break;
+        idx += n;
+        *hashed += n;
+        stats->indices_hashed += n;
+
+        if (idx - last_commit >= p->checkpoint_interval) {
+            if (!push_record(&buf, RECORD_PROGRESS, (uint32_t)idx, NULL) || !commit_records(claim->fd, &buf)) {
+                rc = XPUB_JOB_ERR_IO;
+                break;
+            }
+            stats->hits += pending_hits;
+            pending_hits = 0;
+            last_commit = idx;
+        }
+    }
+    free(buf.records);
+    *last_used_plus1 = used;
+    return rc;
+}
+
+int xpub_job_work(const char* dir, const char* index_path, uint64_t budget_indices, XpubWorkerStats* stats) {
+    XpubWorkerStats local;
+    if (!stats) {
+        memset(&local, 0, sizeof(local));
+        stats = &local;
+    }
+    if (!dir || !index_path) return XPUB_JOB_ERR_PARAMS;
+    Job job;
+    int rc = job_open(&job, dir);
+    if (rc != XPUB_JOB_OK) return rc;
+    HashIndex index;
+    if (hash_index_open(&index, index_path) != 0 || index.key_len != HASH_INDEX_KEY_LEN_HASH160) {
+        job_close(&job);
+        return XPUB_JOB_ERR_INDEX;
+    }
+    secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY);
+
+    uint64_t hashed = 0;
+    while (rc == XPUB_JOB_OK && (!budget_indices || hashed < budget_indices)) {
+        Claim claim;
+        memset(&claim, 0, sizeof(claim));
+        int c = claim_shard(&job, &claim);
+        if (c == CLAIM_NONE) break;
+        if (c == CLAIM_ERROR) {
+            rc = XPUB_JOB_ERR_IO;
+            break;
+        }
+        if (c == CLAIM_WAIT) {
+            usleep(2000);
+            continue;
+        }
+        if (claim.resumed) stats->shards_resumed++;
+        bool complete = false;
+        uint32_t used = 0;
+        rc = run_shard(&job, &index, ctx, &claim, budget_indices ? budget_indices - hashed : 0, stats, &hashed, &complete, &used);
+        if (rc == XPUB_JOB_OK && complete) {
+            rc = finish_shard(&job, &claim, used);
+            if (rc == XPUB_JOB_OK) stats->shards_done++;
+        }
+        close(claim.fd); // releases the shard lock
+    }
+
+    secp256k1_context_destroy(ctx);
+    hash_index_close(&index);
+    job_close(&job);
+    return rc;
+}
+
+int xpub_job_status(const char* dir, size_t* chains_total, size_t* chains_done) {
+    if (!dir) return XPUB_JOB_ERR_PARAMS;
+    Job job;
+    int rc = job_open(&job, dir);
+    if (rc != XPUB_JOB_OK) return rc;
+    size_t done = 0;
+    for (size_t slot = 0; slot < job.count * CHAIN_COUNT; slot++) {
+        BoardSlot s;
+        if (!read_slot(&job, slot, &s)) {
+            rc = XPUB_JOB_ERR_IO;
+            break;
+        }
+        if (s.flags & SLOT_COMPLETE) done++;
+    }
+    if (chains_total) *chains_total = job.count * CHAIN_COUNT;
+    if (chains_done) *chains_done = done;
+    job_close(&job);
+    return rc;
+}
+
+int xpub_job_collect(const char* dir, XpubHitCallback on_hit, void* user) {
+    if (!dir || !on_hit) return XPUB_JOB_ERR_PARAMS;
+    Job job;
+    int rc = job_open(&job, dir);
+    if (rc != XPUB_JOB_OK) return rc;
+    char path[PATH_MAX];
+    for (size_t slot = 0; rc == XPUB_JOB_OK && slot < job.count * CHAIN_COUNT; slot++) {
+        BoardSlot s;
+        if (!read_slot(&job, slot, &s)) {
+            rc = XPUB_JOB_ERR_IO;
+            break;
+        }
+        for (uint32_t shard = 0; shard < s.claimed; shard++) {
+            shard_path(path, &job, slot, shard);
+            int fd = open(path, O_RDONLY);
+            if (fd < 0) {
+                if (shard < s.done) rc = XPUB_JOB_ERR_FORMAT;
+                continue;
+            }
+            ShardState state;
+            if (!read_checkpoint(fd, slot, shard, job.params.shard_size, &state, on_hit, user) && shard < s.done)
+                rc = XPUB_JOB_ERR_FORMAT;
+            close(fd);
+        }
+    }
+    job_close(&job);
+    return rc;
+}
+
+// --- Worker processes ---
+
+static pid_t spawn_worker(const char* dir, const char* index_path, int* stats_fd) {
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+    fflush(NULL);
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        XpubWorkerStats s;
+        memset(&s, 0, sizeof(s));
+        int rc = xpub_job_work(dir, index_path, 0, &s);
+        if (rc == XPUB_JOB_OK && !write_all(fds[1], &s, sizeof(s))) rc = XPUB_JOB_ERR_IO;
+        _exit(rc == XPUB_JOB_OK ? 0 : 1);
+    }
+    close(fds[1]);
+    if (pid < 0) {
+        close(fds[0]);
+        return -1;
+    }
+    *stats_fd = fds[0];
+    return pid;
+}
+
+int xpub_job_run(const char* dir, const char* index_path, unsigned workers, XpubWorkerStats* stats) {
+    if (!dir || !index_path || workers == 0 || workers > 1024) return XPUB_JOB_ERR_PARAMS;
+    size_t total, done;
+    int rc = xpub_job_status(dir, &total, &done);
+    if (rc != XPUB_JOB_OK) return rc;
+    if (stats) memset(stats, 0, sizeof(*stats));
+
+    pid_t* pids = (pid_t*)calloc(workers, sizeof(pid_t));
+    int* fds = (int*)calloc(workers, sizeof(int));
+    if (!pids || !fds) {
+        free(pids);
+        free(fds);
+        return XPUB_JOB_ERR_IO;
+    }
+    unsigned running = 0, restarts_left = 2 * workers + 2;
+    for (unsigned i = 0; i < workers; i++) {
+        pids[i] = spawn_worker(dir, index_path, &fds[i]);
+        if (pids[i] > 0) running++;
+    }
+
+    // Children are polled individually so unrelated children of the caller are never reaped.
+    while (running) {
+        bool reaped = false;
+        for (unsigned i = 0; i < workers; i++) {
+            int status;
+            if (pids[i] <= 0 || waitpid(pids[i], &status, WNOHANG) != pids[i]) continue;
+            reaped = true;
+            running--;
+            pids[i] = 0;
+            XpubWorkerStats s;
+            if (read(fds[i], &s, sizeof(s)) == (ssize_t)sizeof(s) && stats) {
+                stats->shards_done += s.shards_done;
+                stats->shards_resumed += s.shards_resumed;
+                stats->indices_hashed += s.indices_hashed;
+                stats->hits += s.hits;
+            }
+            close(fds[i]);
+            bool failed = !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+            if (failed && restarts_left && xpub_job_status(dir, &total, &done) == XPUB_JOB_OK && done < total) {
+                restarts_left--;
+                pids[i] = spawn_worker(dir, index_path, &fds[i]);
+                if (pids[i] > 0) running++;
+            }
+        }
+        if (!reaped) usleep(1000);
+    }
+    free(pids);
+    free(fds);
+
+    rc = xpub_job_status(dir, &total, &done);
+    if (rc != XPUB_JOB_OK) return rc;
+    return done == total ? XPUB_JOB_OK : XPUB_JOB_INCOMPLETE;
+}
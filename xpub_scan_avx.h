@@ -0,0 +1,115 @@
+/* xpub_scan_avx.h */
+/* Apache License, Version 2.0
+   Copyright [2025] [8891689]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+   Author: 8891689 (https://github.com/8891689)
+*/
+
+#ifndef XPUB_SCAN_AVX_H
+#define XPUB_SCAN_AVX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Resumable gap-limit scanning of BIP32 extended public keys against a HASH160 index (hash_index_avx.h).
+//
+// A job directory holds the job description, a board with one slot per (xpub, chain) and one
+// checkpoint file per shard (a range of shard_size child indices of one chain). Workers in any number
+// of processes claim shards under an flock on <dir>/job.lock; a shard stays flock'd by its worker, so
+// the shard of a crashed worker is taken over by the next claimer and resumed from its last fsync'd
+// checkpoint. Shards of a chain run in order, and a chain ends once gap_limit consecutive child
+// indices after the last used one have been checked.
+//
+// Child keys are derived 8 at a time: HMAC-SHA512 with hmac_sha512_avx8(), the point addition with
+// libsecp256k1, and HASH160 with the 8-lane SHA-256 and RIPEMD-160.
+
+#define XPUB_ADDR_P2PKH       0 // HASH160(compressed pubkey): P2PKH and P2WPKH
+#define XPUB_ADDR_P2SH_P2WPKH 1 // HASH160(0x00 0x14 || HASH160(pubkey))
+
+#define XPUB_JOB_OK            0
+#define XPUB_JOB_ERR_IO       -1 // job directory or checkpoint I/O failure
+#define XPUB_JOB_ERR_XPUB     -2 // an extended key failed Base58Check or is not a public key
+#define XPUB_JOB_ERR_FORMAT   -3 // job files are missing or corrupt
+#define XPUB_JOB_ERR_INDEX    -4 // the HASH160 index could not be opened
+#define XPUB_JOB_ERR_PARAMS   -5 // invalid parameters
+#define XPUB_JOB_INCOMPLETE    1 // xpub_job_run(): workers kept failing before the job finished
+
+typedef struct {
+    uint32_t gap_limit;           // unused child indices that end a chain (BIP44: 20)
+    uint32_t shard_size;          // child indices per shard, at least gap_limit
+    uint32_t addr_type;           // XPUB_ADDR_*
+    uint32_t checkpoint_interval; // child indices between fsync'd checkpoints (rounded up to a multiple of 8)
+} XpubJobParams;
+
+typedef struct {
+    uint64_t shards_done;      // shards completed by this worker
+    uint64_t shards_resumed;   // shards taken over from an earlier (crashed or stopped) worker
+    uint64_t indices_hashed;   // child keys derived and looked up
+    uint64_t hits;             // used addresses found, counted once their checkpoint records are committed
+} XpubWorkerStats;
+
+/**
+* @brief Creates a job directory (which must not contain a job yet) for `count` extended public keys.
+* Both chains (0: receive, 1: change) of every xpub are scanned.
+* @return XPUB_JOB_OK or XPUB_JOB_ERR_*.
+*/
+int xpub_job_create(const char* dir, const char* const* xpubs, size_t count, const XpubJobParams* params);
+
+/**
+* @brief Runs one worker in the calling process until no shard is left to claim.
+* While other live workers still hold shards that could extend a chain, the worker waits for them.
+* @param index_path HASH160 index of used addresses (built with hash_index_builder_*).
+* @param budget_indices Stop after about this many child indices (0 = no limit), leaving the current
+* shard checkpointed for the next worker.
+* @param stats Accumulated worker statistics (may be NULL).
+* @return XPUB_JOB_OK or XPUB_JOB_ERR_*.
+*/
+int xpub_job_work(const char* dir, const char* index_path, uint64_t budget_indices, XpubWorkerStats* stats);
+
+/**
+* @brief Forks `workers` worker processes and restarts any that die, until the job is complete.
+* @param stats Sum of the statistics of all workers that exited normally (may be NULL).
+* @return XPUB_JOB_OK when every chain is complete, XPUB_JOB_INCOMPLETE if restarts were exhausted, or XPUB_JOB_ERR_*.
+*/
+int xpub_job_run(const char* dir, const char* index_path, unsigned workers, XpubWorkerStats* stats);
+
+/**
+* @brief Reports the number of chains and how many of them are complete.
+*/
+int xpub_job_status(const char* dir, size_t* chains_total, size_t* chains_done);
+
+typedef void (*XpubHitCallback)(void* user, uint32_t xpub_index, uint32_t chain, uint32_t child_index, const uint8_t hash160[20]);
+
+/**
+* @brief Reports every used address found so far, ordered by xpub, chain and child index.
+*/
+int xpub_job_collect(const char* dir, XpubHitCallback on_hit, void* user);
+
+/**
+* @brief Derives HASH160s of child indices [first_index, first_index + count) of one chain of an xpub.
+* Indices whose derivation is invalid (probability below 2^-127) yield an all-zero HASH160.
+* @return XPUB_JOB_OK, XPUB_JOB_ERR_XPUB or XPUB_JOB_ERR_PARAMS.
+*/
+int xpub_derive_hash160(const char* xpub, uint32_t chain, uint32_t first_index, size_t count, uint32_t addr_type,
+                        uint8_t (*hash160_out)[20]);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // XPUB_SCAN_AVX_H
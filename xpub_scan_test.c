@@ -0,0 +1,312 @@
+/* xpub_scan_test.c
+ * gcc -O3 -mavx2 -march=native xpub_scan_test.c xpub_scan_avx.c nested_segwit_avx.c hash_index_avx.c address_avx.c sha512_avx.c sha256_avx.c ripemd160_avx.c -o xpub_scan_test -lsecp256k1 -lcrypto
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <secp256k1.h>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+#include <openssl/ripemd.h>
+
+#include "xpub_scan_avx.h"
+#include "hash_index_avx.h"
+
+static int report(const char* name, int ok) {
+    printf("  %-56s %s\n", name, ok ? "\x1b[32mPASS\x1b[0m" : "\x1b[31mFAIL\x1b[0m");
+    return ok ? 0 : 1;
+}
+
+// BIP32 test vectors 1 and 2.
+static const char* XPUBS[] = {
+    "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8",
+    "xpub68Gmy5EdvgibQVfPdqkBBCHxA5htiqg55crXYuXoQRKfDBFA1WEjWgP6LHhwBZeNK1VTsfTFUHCdrfp1bgwQ9xv5ski8PX9rL2dZXvgGDnw",
+    "xpub6ASuArnXKPbfEwhqN6e3mwBcDTgzisQN1wXN9BJcM47sSikHjJf3UFHKkNAWbWMiGj7Wf5uMash7SyYq527Hqck2AxYysAA7xmALppuCkwQ",
+    "xpub6FHa3pjLCk84BayeJxFW2SP4XRrFd1JYnxeLeU8EqN3vDfZmbqBqaGJAyiLjTAwm6ZLRQUMv1ZACTj37sR62cfN7fe5JnJ7dh8zL4fiyLHV",
+    "xpub661MyMwAqRbcFW31YEwpkMuc5THy2PSt5bDMsktWQcFF8syAmRUapSCGu8ED9W6oDMSgv6Zz8idoc4a6mr8BDzTJY47LJhkJ8UB7WEGuduB",
+    "xpub69H7F5d8KSRgmmdJg2KhpAK8SR3DjMwAdkxj3ZuxV27CprR9LgpeyGmXUbC6wb7ERfvrnKZjXoUmmDznezpbZb7ap6r1D3tgFxHmwMkQTPH",
+};
+#define XPUB_COUNT 6
+#define GAP 20
+
+// --- Reference BIP32 (OpenSSL HMAC/SHA-256/RIPEMD-160 + libsecp256k1) ---
+
+static int ref_decode_xpub(const char* s, uint8_t payload[78]) {
+    static const char alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    uint8_t num[82] = {0};
+    for (; *s; s++) {
+        const char* p = strchr(alphabet, *s);
+        if (!p) return 0;
+        int carry = (int)(p - alphabet);
+        for (int i = 81; i >= 0; i--) {
+            carry += num[i] * 58;
+            num[i] = (uint8_t)carry;
+            carry >>= 8;
+        }
+        if (carry) return 0;
+    }
+    uint8_t h1[32], h2[32];
+    SHA256(num, 78, h1);
+    SHA256(h1, 32, h2);
+    if (memcmp(h2, num + 78, 4) != 0) return 0;
+    memcpy(payload, num, 78);
+    return 1;
+}
+
+static void ref_ckd(secp256k1_context* ctx, const uint8_t key[33], const uint8_t code[32], uint32_t i,
+                    uint8_t child_key[33], uint8_t child_code[32]) {
+    uint8_t data[37], mac[64];
+    unsigned int mac_len = 64;
+    memcpy(data, key, 33);
+    data[33] = (uint8_t)(i >> 24);
+    data[34] = (uint8_t)(i >> 16);
+    data[35] = (uint8_t)(i >> 8);
+    data[36] = (uint8_t)i;
+    HMAC(EVP_sha512(), code, 32, data, 37, mac, &mac_len);
+    secp256k1_pubkey point;
+    size_t len = 33;
+    secp256k1_ec_pubkey_parse(ctx, &point, key, 33);
+    secp256k1_ec_pubkey_tweak_add(ctx, &point, mac);
+    secp256k1_ec_pubkey_serialize(ctx, child_key, &len, &point, SECP256K1_EC_COMPRESSED);
+    if (child_code) memcpy(child_code, mac + 32, 32);
+}
+
+static void ref_hash160(const uint8_t* data, size_t len, uint8_t out[20]) {
+    uint8_t sha[32];
+    SHA256(data, len, sha);
+    RIPEMD160(sha, 32, out);
+}
+
+static void ref_derive(secp256k1_context* ctx, const char* xpub, uint32_t chain, uint32_t first, size_t count,
+                       int p2sh, uint8_t (*out)[20]) {
+    uint8_t payload[78], chain_key[33], chain_code[32];
+    ref_decode_xpub(xpub, payload);
+    ref_ckd(ctx, payload + 45, payload + 13, chain, chain_key, chain_code);
+    for (size_t i = 0; i < count; i++) {
+        uint8_t key[33];
+        ref_ckd(ctx, chain_key, chain_code, first + (uint32_t)i, key, NULL);
+        ref_hash160(key, 33, out[i]);
+        if (p2sh) {
+            uint8_t script[22] = {0x00, 0x14};
+            memcpy(script + 2, out[i], 20);
+            ref_hash160(script, 22, out[i]);
+        }
+    }
+}
+
+// --- Planted usage: chain (x, c) uses every 13th index up to its end, plus a decoy past the gap ---
+
+static uint32_t chain_end(int x, int c) {
+    return 40 + 29 * (uint32_t)(2 * x + c);
+}
+
+typedef struct {
+    int count;
+    int bad;
+    int order_errors;
+    int last_slot;
+    uint32_t last_index;
+} HitCheck;
+
+static void check_hit(void* user, uint32_t xpub_index, uint32_t chain, uint32_t child_index, const uint8_t hash160[20]) {
+    (void)hash160;
+    HitCheck* h = (HitCheck*)user;
+    int slot = (int)(xpub_index * 2 + chain);
+    if (slot < h->last_slot || (slot == h->last_slot && child_index <= h->last_index)) h->order_errors++;
+    h->last_slot = slot;
+    h->last_index = child_index;
+    h->count++;
+    if (xpub_index >= XPUB_COUNT || child_index % 13 != 0 || child_index > chain_end((int)xpub_index, (int)chain)) h->bad++;
+}
+
+static int expected_hits(void) {
+    int n = 0;
+    for (int x = 0; x < XPUB_COUNT; x++) {
+        for (int c = 0; c < 2; c++) n += (int)(chain_end(x, c) / 13) + 1;
+    }
+    return n;
+}
+
+static int collect_ok(const char* dir) {
+    HitCheck h = {0, 0, 0, -1, 0};
+    int rc = xpub_job_collect(dir, check_hit, &h);
+    return rc == XPUB_JOB_OK && h.bad == 0 && h.order_errors == 0 && h.count == expected_hits();
+}
+
+static void remove_dir(const char* dir) {
+    DIR* d = opendir(dir);
+    if (!d) return;
+    struct dirent* e;
+    char path[512];
+    while ((e = readdir(d)) != NULL) {
+        if (e->d_name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+        unlink(path);
+    }
+    closedir(d);
+    rmdir(dir);
+}
+
+// Appends half a record to every checkpoint file: a write torn by a crash. Returns false on an I/O error.
+static bool tear_checkpoints(const char* dir) {
+    DIR* d = opendir(dir);
+    if (!d) return false;
+    struct dirent* e;
+    char path[512];
+    bool ok = true;
+    while ((e = readdir(d)) != NULL) {
+        if (e->d_name[0] != 's') continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+        int fd = open(path, O_WRONLY | O_APPEND);
+        if (fd < 0 || write(fd, "torn-record-0123", 16) != 16) ok = false;
+        if (fd >= 0) close(fd);
+    }
+    closedir(d);
+    return ok;
+}
+
+int main() {
+    printf("--- Correctness Test (Checkpointed xpub Gap-Limit Scan) ---\n");
+    int failed_tests = 0;
+    secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+
+    // The reference itself: vector 2, M -> M/0.
+    uint8_t m[78], m0[78], key[33], code[32];
+    ref_decode_xpub(XPUBS[4], m);
+    ref_decode_xpub(XPUBS[5], m0);
+    ref_ckd(ctx, m + 45, m + 13, 0, key, code);
+    failed_tests += report("Reference CKDpub matches BIP32 vector 2 (M/0)", memcmp(key, m0 + 45, 33) == 0 && memcmp(code, m0 + 13, 32) == 0);
+
+    int mismatches = 0;
+    for (int x = 0; x < XPUB_COUNT; x++) {
+        for (uint32_t c = 0; c < 2; c++) {
+            for (int p2sh = 0; p2sh < 2; p2sh++) {
+                uint8_t got[45][20], want[45][20];
+                xpub_derive_hash160(XPUBS[x], c, 1000, 45, p2sh ? XPUB_ADDR_P2SH_P2WPKH : XPUB_ADDR_P2PKH, got);
+                ref_derive(ctx, XPUBS[x], c, 1000, 45, p2sh, want);
+                if (memcmp(got, want, sizeof(got)) != 0) mismatches++;
+            }
+        }
+    }
+    failed_tests += report("8-lane derivation matches reference (P2PKH, P2SH-P2WPKH)", mismatches == 0);
+
+    // Index of used HASH160s: the planted indices, the decoys and unrelated keys.
+    char index_path[] = "/tmp/xpub_scan_indexXXXXXX";
+    int fd = mkstemp(index_path);
+    if (fd < 0) {
+        fprintf(stderr, "mkstemp failed.\n");
+        return 1;
+    }
+    close(fd);
+    HashIndexBuilder* builder = hash_index_builder_create(index_path, HASH_INDEX_KEY_LEN_HASH160, 1 << 20);
+    for (int x = 0; x < XPUB_COUNT; x++) {
+        for (uint32_t c = 0; c < 2; c++) {
+            uint32_t end = chain_end(x, (int)c), last = end - end % 13, decoy = last + GAP + 5;
+            uint8_t h[1][20];
+            for (uint32_t i = 0; i <= end; i += 13) {
+                ref_derive(ctx, XPUBS[x], c, i, 1, 0, h);
+                hash_index_builder_add(builder, h[0], (const uint8_t*)"used", 4);
+            }
+            ref_derive(ctx, XPUBS[x], c, decoy, 1, 0, h);
+            hash_index_builder_add(builder, h[0], (const uint8_t*)"decoy", 5);
+        }
+    }
+    for (int i = 0; i < 5000; i++) {
+        uint8_t noise[20];
+        for (int b = 0; b < 20; b++) noise[b] = (uint8_t)rand();
+        hash_index_builder_add(builder, noise, NULL, 0);
+    }
+    hash_index_builder_finish(builder);
+
+    XpubJobParams params = {GAP, 64, XPUB_ADDR_P2PKH, 16};
+    char dir_a[] = "/tmp/xpub_job_aXXXXXX", dir_b[] = "/tmp/xpub_job_bXXXXXX", dir_c[] = "/tmp/xpub_job_cXXXXXX";
+    if (!mkdtemp(dir_a) || !mkdtemp(dir_b) || !mkdtemp(dir_c)) {
+        fprintf(stderr, "mkdtemp failed.\n");
+        return 1;
+    }
+
+    const char* bad[1] = {"xprv9s21ZrQH143K3QTDL4LXw2F7HEK3wJUD2nW2nRk4stbPy6cq3jPPqjiChkVvvNKmPGJxWUtg6LnF5kejMRNNU3TGtRBeJgk33yuGBxrMPHi"};
+    failed_tests += report("Private extended key rejected", xpub_job_create(dir_a, bad, 1, &params) == XPUB_JOB_ERR_XPUB);
+
+    // Uninterrupted single worker.
+    int rc = xpub_job_create(dir_a, XPUBS, XPUB_COUNT, &params);
+    XpubWorkerStats full;
+    memset(&full, 0, sizeof(full));
+    if (rc == XPUB_JOB_OK) rc = xpub_job_work(dir_a, index_path, 0, &full);
+    size_t total = 0, done = 0;
+    xpub_job_status(dir_a, &total, &done);
+    failed_tests += report("Single worker completes every chain", rc == XPUB_JOB_OK && total == 2 * XPUB_COUNT && done == total);
+    failed_tests += report("Hits stop at the gap limit (decoys not reached)", collect_ok(dir_a));
+    failed_tests += report("Second job in the same directory refused", xpub_job_create(dir_a, XPUBS, XPUB_COUNT, &params) == XPUB_JOB_ERR_PARAMS);
+
+    // Interrupted every 100 indices, with torn checkpoint tails: no index is hashed twice.
+    xpub_job_create(dir_b, XPUBS, XPUB_COUNT, &params);
+    XpubWorkerStats sliced;
+    memset(&sliced, 0, sizeof(sliced));
+    int runs = 0;
+    bool torn_ok = true;
+    rc = XPUB_JOB_OK;
+    do {
+        rc = xpub_job_work(dir_b, index_path, 100, &sliced);
+        torn_ok = tear_checkpoints(dir_b) && torn_ok;
+        xpub_job_status(dir_b, &total, &done);
+    } while (rc == XPUB_JOB_OK && done < total && ++runs < 1000);
+    failed_tests += report("Resumes across 100-index slices and torn tails",
+                           torn_ok && rc == XPUB_JOB_OK && done == total && collect_ok(dir_b));
+    failed_tests += report("Resume never rehashes checkpointed work",
+                           sliced.indices_hashed == full.indices_hashed && sliced.hits == full.hits && sliced.shards_resumed > 0);
+
+    // Multi-process: a worker killed mid-job, then three worker processes finish it.
+    xpub_job_create(dir_c, XPUBS, XPUB_COUNT, &params);
+    fflush(NULL);
+    pid_t pid = fork();
+    if (pid == 0) _exit(xpub_job_work(dir_c, index_path, 0, NULL) == XPUB_JOB_OK ? 0 : 1);
+    usleep(20000);
+    kill(pid, SIGKILL);
+    waitpid(pid, NULL, 0);
+    XpubWorkerStats multi;
+    rc = xpub_job_run(dir_c, index_path, 3, &multi);
+    failed_tests += report("Killed worker + 3 worker processes complete the job", rc == XPUB_JOB_OK && collect_ok(dir_c));
+    printf("  (after kill: %llu shards done by workers, %llu resumed)\n", (unsigned long long)multi.shards_done,
+           (unsigned long long)multi.shards_resumed);
+
+    remove_dir(dir_a);
+    remove_dir(dir_b);
+    remove_dir(dir_c);
+
+    printf("--- Summary ---\n");
+    if (failed_tests == 0) {
+        printf("\x1b[32mAll tests passed successfully!\x1b[0m\n\n");
+    } else {
+        printf("\x1b[31m%d tests failed.\x1b[0m\n\n", failed_tests);
+    }
+
+    // --- Performance Testing ---
+    printf("--- Performance Benchmark (6 xpubs x 2 chains, gap limit 1000) ---\n");
+    XpubJobParams bench = {1000, 2048, XPUB_ADDR_P2PKH, 512};
+    char dir_d[] = "/tmp/xpub_job_dXXXXXX";
+    if (!mkdtemp(dir_d)) {
+        fprintf(stderr, "mkdtemp failed.\n");
+        return 1;
+    }
+    xpub_job_create(dir_d, XPUBS, XPUB_COUNT, &bench);
+    XpubWorkerStats bs;
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    rc = xpub_job_run(dir_d, index_path, 1, &bs);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    printf("Scanned %llu child keys in %.4f seconds (%.2f Thousand keys/sec, 1 worker)\n",
+           (unsigned long long)bs.indices_hashed, secs, bs.indices_hashed / secs / 1e3);
+    remove_dir(dir_d);
+    unlink(index_path);
+    secp256k1_context_destroy(ctx);
+    return failed_tests == 0 ? 0 : 1;
+}